@@ -0,0 +1,13 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Config/MBSGenerationTierConfiguration.h"
+
+EMBSGenerationTier FMBSGenerationTierConfiguration::GetTierForDistance(float InDistance) const
+{
+	if (InDistance >= ShellDistance)
+	{
+		return EMBSGenerationTier::Shell;
+	}
+	return InDistance >= FacadeDistance ? EMBSGenerationTier::Facade : EMBSGenerationTier::Full;
+}
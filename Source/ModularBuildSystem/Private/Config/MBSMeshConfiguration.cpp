@@ -9,3 +9,13 @@ bool FMBSMeshConfiguration::IsOfInstancedType() const
 	return Type == EMBSMeshConfigurationType::InstancedStaticMeshes ||
 		Type == EMBSMeshConfigurationType::HierarchicalInstancedStaticMeshes;
 }
+
+bool FMBSMeshConfiguration::UsesSingleComponentPerUniqueMesh() const
+{
+	return IsOfInstancedType() && bUseSingleComponentPerUniqueMesh;
+}
+
+bool FMBSMeshConfiguration::UsesWorldSharedInstancing() const
+{
+	return IsOfInstancedType() && bUseWorldSharedInstancing;
+}
@@ -10,6 +10,10 @@ UMBSSettings::UMBSSettings()
 	, DefaultClampMode(EMBSClampMode::Stretch)
 	, DefaultExecutionMode(EMBSExecutionMode::Smart)
 	, bUseSingleInstancedComponentPerUniqueMesh(false)
+	, SharedInstancingChunkSize(25000.f)
+	, RegenerationFrameBudget(8.f)
+	, TimeSlicedGenerationFrameBudget(4.f)
+	, bDeferInteractiveRegeneration(true)
 	, bAutoAttachVisualizationComponent(false)
 	, DefaultSectionSize(FIntVector(UModularSectionResolution::DefaultSectionSize))
 {
@@ -34,35 +34,87 @@ bool UHouseWindowGeneratorProperty::Init_Implementation(FMBSGeneratorPropertyIni
 		return false;
 	}
 
-	Args.LevelIndex = -1;
-	//int32 WallLevelIndex = -1;
-	//static constexpr int32 MaxWindowCountPerLevel = WindowCountPerLevel;
-		
-	Args.OutIndices->Reserve(WindowCount);
-	for (int32 i = 0; i < WindowCount; i++)
+	// Indices can already be calculated by the layout of the generator
+	if (Args.OutIndices->IsEmpty())
 	{
-		if (i % WindowCountPerLevel == 0)
+		AHouseBuildSystemActor* HouseBuildSystem = Cast<AHouseBuildSystemActor>(Args.BuildSystem);
+		check(HouseBuildSystem);
+
+		TArray<FModularSectionInitializer> WallInitializers;
+		WallInitializers.Reserve(HouseBuildSystem->Walls.Num());
+		for (const FModularLevel& Wall : HouseBuildSystem->Walls)
 		{
-			Args.LevelIndex++;
-			UE_LOG(LogGenerator, Log, TEXT("%s: i=%d, Args.LevelIndex=%d"), *GetName(), i, Args.LevelIndex);
+			WallInitializers.Add(Wall.GetInitializer());
 		}
 
-		Args.AtIndex = i;
-		AddNewWindowIndex(Args);
+		CalculateWindowIndices(WindowCount, WindowCountPerLevel, Data.IndexCalculation, HouseBuildSystem,
+			WallInitializers, *Args.InIndices, *Args.OutIndices);
+	}
+	else
+	{
+		// Entrance could have been moved to the other section after the layout was calculated
+		ExcludeIndices(*Args.InIndices, *Args.OutIndices);
+	}
+	SetWindows(Args);
+	return true;
+}
+
+void UHouseWindowGeneratorProperty::CalculateWindowIndices(int32 InWindowCount, int32 InWindowCountPerLevel,
+	UMBSIndexCalculation* InIndexCalculation, AModularBuildSystemActor* InBuildSystem,
+	TConstArrayView<FModularSectionInitializer> InWallInitializers, const TArray<int32>& InEntranceIndices,
+	TArray<int32>& OutIndices, const FRandomStream* InRandomStream)
+{
+	if (InWindowCountPerLevel <= 0)
+	{
+		return;
+	}
+	
+	// Occupied indices of each wall level are kept for the whole pass and updated with each window
+	TArray<TArray<int32>> LevelIndices;
+	LevelIndices.SetNum(InWallInitializers.Num());
+	TArray<FMBSOccupiedIndices> LevelOccupied;
+	LevelOccupied.Reserve(InWallInitializers.Num());
+	for (const FModularSectionInitializer& WallInitializer : InWallInitializers)
+	{
+		LevelOccupied.Emplace(WallInitializer.GetAdjustedTotalCount());
+	}
+	
+	OutIndices.Reserve(OutIndices.Num() + InWindowCount);
+	for (int32 i = 0; i < InWindowCount; i++)
+	{
+		const int32 LevelIndex = i / InWindowCountPerLevel;
+		if (!InWallInitializers.IsValidIndex(LevelIndex))
+		{
+			UE_LOG(LogGenerator, Error, TEXT("Invalid WallLevelIndex (%d) of the window. Max possible = %d"),
+				LevelIndex, InWallInitializers.Num());
+			continue;
+		}
+		const int32 WindowIndex = CalculateWindowIndex(InIndexCalculation, InBuildSystem, InWallInitializers[LevelIndex],
+			i, LevelIndices[LevelIndex], LevelOccupied[LevelIndex], InRandomStream);
+		LevelIndices[LevelIndex].Add(WindowIndex);
+		LevelOccupied[LevelIndex].Occupy(WindowIndex);
+		OutIndices.Add(WindowIndex);
 	}
 
+	ExcludeIndices(InEntranceIndices, OutIndices);
+}
+
+void UHouseWindowGeneratorProperty::ExcludeIndices(const TArray<int32>& InEntranceIndices, TArray<int32>& InOutIndices)
+{
 	// check if each id is not occupied by entrance or other unique section
-	for (const int32 Index : *Args.InIndices)
+	for (const int32 Index : InEntranceIndices)
 	{
-		while (Args.OutIndices->Contains(Index))
+		while (InOutIndices.Contains(Index))
 		{
-			UE_LOG(LogGenerator, Error, TEXT("%s: OutWindowIndices.Contains(%d) - incrementing index to fix overlap"),
-				*GetName(), Index);
-			Args.OutIndices->Remove(Index);
-			Args.OutIndices->Add(Index + 1);
+			UE_LOG(LogGenerator, Error, TEXT("OutWindowIndices.Contains(%d) - incrementing index to fix overlap"), Index);
+			InOutIndices.Remove(Index);
+			InOutIndices.Add(Index + 1);
 		}
 	}
+}
 
+void UHouseWindowGeneratorProperty::SetWindows(FMBSGeneratorPropertyInitArgs& Args) const
+{
 	// set mesh to the specified index
 	Args.LevelIndex = -1;
 	for (int32 i = 0; i < WindowCount; i++)
@@ -75,8 +127,6 @@ bool UHouseWindowGeneratorProperty::Init_Implementation(FMBSGeneratorPropertyIni
 		Args.AtIndex = i;
 		SetSingleWindow(Args);
 	}
-
-	return true;
 }
 
 bool UHouseWindowGeneratorProperty::IsSet_Implementation() const
@@ -96,60 +146,35 @@ bool UHouseWindowGeneratorProperty::CheckEntrancesCount(FMBSGeneratorPropertyIni
 	return true;
 }
 
-void UHouseWindowGeneratorProperty::AddNewWindowIndex(FMBSGeneratorPropertyInitArgs& Args) const
+int32 UHouseWindowGeneratorProperty::CalculateWindowIndex(UMBSIndexCalculation* InIndexCalculation,
+	AModularBuildSystemActor* InBuildSystem, const FModularSectionInitializer& InWallInitializer, int32 AtIndex,
+	TArray<int32>& InLevelIndices, const FMBSOccupiedIndices& InLevelOccupied, const FRandomStream* InRandomStream)
 {
-	AHouseBuildSystemActor* HouseBuildSystem = Cast<AHouseBuildSystemActor>(Args.BuildSystem);
-	check(HouseBuildSystem);
+	const int32 MaxInRow = InWallInitializer.GetMaxInRow();
+	const int32 TotalCount = InWallInitializer.GetTotalCount();
 	
-	if (HouseBuildSystem->Walls.IsValidIndex(Args.LevelIndex))
-	{
-		const FModularSectionInitializer& WallInitializer = HouseBuildSystem->Walls[Args.LevelIndex].GetInitializer();
-		const int32 MaxInRow = WallInitializer.GetMaxInRow();
-		const int32 TotalCount = WallInitializer.GetTotalCount();
-		
-		int32 WindowIndex;
-		if (Data.IndexCalculation)
-		{
-			WindowIndex = Data.IndexCalculation->CalculateSingle(
-				FMBSIndexCalculationArgs(HouseBuildSystem, Args.AtIndex, Args.OutIndices, &WallInitializer));
-			UE_LOG(LogGenerator, VeryVerbose, TEXT("%s: USING IndexCalculation (i=%d) WindowIndex=%d, (Wall) TotalCount=%d"),
-				*GetName(), Args.AtIndex, WindowIndex, TotalCount);
-		}
-		else
-		{
-			WindowIndex = Args.AtIndex % 2 == 0 ? 0 : TotalCount - MaxInRow + static_cast<bool>(MaxInRow % 2);
-			UE_LOG(LogGenerator, VeryVerbose, TEXT("%s: (i=%d) WindowIndex=%d, (Wall) TotalCount=%d"),
-				*GetName(), Args.AtIndex, WindowIndex, TotalCount);
-			// TODO: 
-			constexpr int32 MaxAdjustmentIteration = 10;
-			for (int32 i = 0; i < MaxAdjustmentIteration; i++)
-			{
-				if (Args.OutIndices->Contains(WindowIndex))
-				{
-					if (WindowIndex + 1 < WallInitializer.GetAdjustedTotalCount())
-					{
-						WindowIndex++;
-					}
-					else
-					{
-						WindowIndex = 0;
-					}
-				}
-				else
-				{
-					UE_LOG(LogGenerator, VeryVerbose, TEXT("%s: WindowIndex after adjustment = %d"), *GetName(), WindowIndex);
-					break;
-				}
-			}
-		}
-		
-		Args.OutIndices->Add(WindowIndex);
+	int32 WindowIndex;
+	if (InIndexCalculation)
+	{
+		WindowIndex = UMBSIndexCalculation::CalculateSingleOrDefault(InIndexCalculation,
+			FMBSIndexCalculationArgs(InBuildSystem, AtIndex, &InLevelIndices, &InWallInitializer, InRandomStream,
+				&InLevelOccupied), 0);
+		UE_LOG(LogGenerator, VeryVerbose, TEXT("USING IndexCalculation (i=%d) WindowIndex=%d, (Wall) TotalCount=%d"),
+			AtIndex, WindowIndex, TotalCount);
 	}
 	else
 	{
-		UE_LOG(LogGenerator, Error, TEXT("%s: Invalid WallLevelIndex (%d). Max possible = %d"),
-			*GetName(), Args.LevelIndex, HouseBuildSystem->Walls.Num());
+		WindowIndex = AtIndex % 2 == 0 ? 0 : TotalCount - MaxInRow + static_cast<bool>(MaxInRow % 2);
+		UE_LOG(LogGenerator, VeryVerbose, TEXT("(i=%d) WindowIndex=%d, (Wall) TotalCount=%d"),
+			AtIndex, WindowIndex, TotalCount);
+		const int32 FreeIndex = InLevelOccupied.FindNextFree(WindowIndex);
+		if (FreeIndex != INDEX_NONE)
+		{
+			WindowIndex = FreeIndex;
+			UE_LOG(LogGenerator, VeryVerbose, TEXT("WindowIndex after adjustment = %d"), WindowIndex);
+		}
 	}
+	return WindowIndex;
 }
 
 void UHouseWindowGeneratorProperty::SetSingleWindow(FMBSGeneratorPropertyInitArgs& Args) const
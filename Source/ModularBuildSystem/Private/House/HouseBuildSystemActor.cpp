@@ -108,24 +108,8 @@ void AHouseBuildSystemActor::PostEditChangeChainProperty(FPropertyChangedChainEv
 		{
 			if (Generator)
 			{
-				UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Root component before generation = %s"), *GetName(),
-					*GetRootComponent()->GetName());
-				
-				// TODO: Test. Maybe move to the other place?
-				TransformBounds.SetBounds(FIntVector(Generator->Bounds.X, Generator->Bounds.Y, Generator->LevelCount),
-					StretchManager.GetScaleCoefficientsSwappedXY());
-				
-				Generator->SetBuildSystemPtr(this);
-				if (IBuildingGeneratorInterface::Execute_Generate(Generator).Succeeded())
-				{
-					ApplyStretch();
-				}
-
-				// TODO: Test. New
-				if (GetInterior() && GetInterior()->ShouldRegenerateOnBuildSystemUpdate())
-				{
-					GetInterior()->GenerateInterior(this);
-				}
+				// Interactive edits are coalesced and only previewed, full regeneration runs after the edit is finalized
+				RequestRegeneration(GetRegenerationTypeForChange(PropertyChangedEvent));
 
 				// NEW. Is used to properly refresh Generator object details after CustomLevelShape is set.
 				// Currently there is a bug that prevents showing the custom level shape properties until it is set again manually.
@@ -146,6 +130,13 @@ void AHouseBuildSystemActor::PostEditChangeChainProperty(FPropertyChangedChainEv
 			UpdateHouseDisplay();
 		}
 
+		// Meshes are reloaded once the level edit is finalized instead of at slider frequency
+		if (PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive)
+		{
+			Super::PostEditChangeChainProperty(PropertyChangedEvent);
+			return;
+		}
+
 		const int32 ModifiedIndex = PropertyChangedEvent.GetArrayIndex(StructName.ToString());
 		const bool bWasLevelUpdate = LevelObserver.OnLevelsUpdate(StructName,
 		{ 
@@ -174,75 +165,118 @@ void AHouseBuildSystemActor::PostEditChangeChainProperty(FPropertyChangedChainEv
 
 void AHouseBuildSystemActor::Init()
 {
-	Super::Init();
-	
-	uint8 ShiftCount = 0;
+	// Same steps as the ones of the time-sliced generation, executed at once
+	FMBSGenerationSteps Steps;
+	AddInitSteps(Steps);
+	Steps.RunToCompletion();
+}
+
+void AHouseBuildSystemActor::AddInitSteps(FMBSGenerationSteps& OutSteps)
+{
+	// State shared between steps, as each step is executed separately in case of time-sliced generation
+	struct FInitState
+	{
+		uint8 ShiftCount = 0;
+		float BasementZMultiplier = 0.f;
+		int32 FloorsIndex = INDEX_NONE;
+		int32 FloorsCount = 0;
+		float FloorsZMultiplier = 0.f;
+		int32 WallsIndex = INDEX_NONE;
+		int32 WallsCount = 0;
+		float WallsZMultiplier = 0.f;
+		int32 CornersIndex = INDEX_NONE;
+		int32 CornersCount = 0;
+		float CornersZMultiplier = 0.f;
+		float RoofZMultiplier = 0.f;
+		float RooftopZMultiplier = 0.f;
+	};
+	const TSharedRef<FInitState> State = MakeShared<FInitState>();
+
+	OutSteps.Add(TEXT("Init"), [this]
+	{
+		Super::Init();
+	});
 
 	// Basement
-	float BasementZMultiplier;
-	LevelInitializer.InitSingleLevel(TEXT("Basement"),
-		Basement,
-		0,
-		ShiftCount,
-		0.f,
-		nullptr,
-		BasementZMultiplier);
+	OutSteps.Add(TEXT("Basement"), [this, State]
+	{
+		LevelInitializer.InitSingleLevel(TEXT("Basement"),
+			Basement,
+			0,
+			State->ShiftCount,
+			0.f,
+			nullptr,
+			State->BasementZMultiplier);
+	});
 	
 	// Floors
 	// for ex if basement next z multiplier returns 1.f - then first floor and first wall levels will be at DefaultSectionSize * 1.f from the basement pivot
 	// if 0.5f - the they will be at DefaultSectionSize * 0.5f from the basement pivot
-	int32 FloorsCount;
-	float FloorsZMultiplier;
-	LevelInitializer.InitMultipleLevels(TEXT("Floors"),
-		Floors, 
-		ShiftCount,
-		BasementZMultiplier,
-		nullptr,
-		FloorsZMultiplier,
-		FloorsCount);
+	OutSteps.AddResumable(TEXT("Floors"), [this, State]
+	{
+		return LevelInitializer.InitNextOfMultipleLevels(TEXT("Floors"),
+			Floors,
+			State->FloorsIndex,
+			State->ShiftCount,
+			State->BasementZMultiplier,
+			nullptr,
+			State->FloorsZMultiplier,
+			State->FloorsCount) ? EMBSGenerationStepResult::Finished : EMBSGenerationStepResult::Pending;
+	});
 
 	// Walls
-	int32 WallsCount;
-	float WallsZMultiplier;
-	LevelInitializer.InitMultipleLevels(TEXT("Walls"),
-		Walls,
-		ShiftCount,
-		BasementZMultiplier,
-		nullptr,
-		WallsZMultiplier,
-		WallsCount);
+	OutSteps.AddResumable(TEXT("Walls"), [this, State]
+	{
+		return LevelInitializer.InitNextOfMultipleLevels(TEXT("Walls"),
+			Walls,
+			State->WallsIndex,
+			State->ShiftCount,
+			State->BasementZMultiplier,
+			nullptr,
+			State->WallsZMultiplier,
+			State->WallsCount) ? EMBSGenerationStepResult::Finished : EMBSGenerationStepResult::Pending;
+	});
 
 	// Corners
-	int32 CornersCount;
-	float CornersZMultiplier;
-	LevelInitializer.InitMultipleLevels(TEXT("Corners"),
-		Corners,
-		ShiftCount,
-		BasementZMultiplier,
-		nullptr,
-		CornersZMultiplier,
-		CornersCount);
+	OutSteps.AddResumable(TEXT("Corners"), [this, State]
+	{
+		return LevelInitializer.InitNextOfMultipleLevels(TEXT("Corners"),
+			Corners,
+			State->CornersIndex,
+			State->ShiftCount,
+			State->BasementZMultiplier,
+			nullptr,
+			State->CornersZMultiplier,
+			State->CornersCount) ? EMBSGenerationStepResult::Finished : EMBSGenerationStepResult::Pending;
+	});
 
 	// Roof
-	float RoofZMultiplier;
-	LevelInitializer.InitSingleLevel(TEXT("Roof"),
-		Roof,
-		FMath::Max(FloorsCount, WallsCount) + 1,
-		ShiftCount,
-		FMath::Max(FloorsZMultiplier, WallsZMultiplier),
-		nullptr,
-		RoofZMultiplier);
-
-	float RooftopZMultiplier;
-	LevelInitializer.InitSingleLevel(TEXT("Rooftop"),
-		Rooftop,
-		FMath::Max(FloorsCount, WallsCount) + 2,
-		ShiftCount,
-		RoofZMultiplier,
-		Roof.GetInitializer().GetResolution(),
-		RooftopZMultiplier);
-	
-	EndInit();
+	OutSteps.Add(TEXT("Roof"), [this, State]
+	{
+		LevelInitializer.InitSingleLevel(TEXT("Roof"),
+			Roof,
+			FMath::Max(State->FloorsCount, State->WallsCount) + 1,
+			State->ShiftCount,
+			FMath::Max(State->FloorsZMultiplier, State->WallsZMultiplier),
+			nullptr,
+			State->RoofZMultiplier);
+	});
+
+	OutSteps.Add(TEXT("Rooftop"), [this, State]
+	{
+		LevelInitializer.InitSingleLevel(TEXT("Rooftop"),
+			Rooftop,
+			FMath::Max(State->FloorsCount, State->WallsCount) + 2,
+			State->ShiftCount,
+			State->RoofZMultiplier,
+			Roof.GetInitializer().GetResolution(),
+			State->RooftopZMultiplier);
+	});
+
+	OutSteps.Add(TEXT("EndInit"), [this]
+	{
+		EndInit();
+	});
 }
 
 TScriptInterface<IBuildingGeneratorInterface> AHouseBuildSystemActor::GetGenerator() const
@@ -282,10 +316,62 @@ void AHouseBuildSystemActor::OnUpdateTransformBounds()
 	}
 	else
 	{
+		PrepareTieredGeneration(Generator);
 		IBuildingGeneratorInterface::Execute_Generate(Generator);
+		MarkChanged();
 	}
 }
 
+void AHouseBuildSystemActor::RegenerateOnChange()
+{
+	if (!Generator)
+	{
+		return;
+	}
+
+	UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Root component before generation = %s"), *GetName(),
+		*GetRootComponent()->GetName());
+	
+	// TODO: Test. Maybe move to the other place?
+	TransformBounds.SetBounds(FIntVector(Generator->Bounds.X, Generator->Bounds.Y, Generator->LevelCount),
+		StretchManager.GetScaleCoefficientsSwappedXY());
+	
+	Generator->SetBuildSystemPtr(this);
+	PrepareTieredGeneration(Generator);
+	if (IBuildingGeneratorInterface::Execute_Generate(Generator).Succeeded())
+	{
+		ApplyStretch();
+		MarkChanged();
+	}
+
+	// TODO: Test. New
+	RegenerateInteriorOnUpdate();
+}
+
+void AHouseBuildSystemActor::PreviewRegeneration()
+{
+	if (!Generator)
+	{
+		return;
+	}
+
+	// Transform bounds still hold the bounds of the last generation, so existing sections are scaled to the new ones
+	const FIntVector GeneratedBounds = TransformBounds.GetBounds();
+	const FIntVector NewBounds(Generator->Bounds.X, Generator->Bounds.Y, Generator->LevelCount);
+	if (GeneratedBounds.X <= 0 || GeneratedBounds.Y <= 0 || GeneratedBounds.Z <= 0 || NewBounds == GeneratedBounds)
+	{
+		return;
+	}
+
+	const FVector PreviewScale(
+		static_cast<float>(FMath::Max(NewBounds.X, 1)) / GeneratedBounds.X,
+		static_cast<float>(FMath::Max(NewBounds.Y, 1)) / GeneratedBounds.Y,
+		static_cast<float>(FMath::Max(NewBounds.Z, 1)) / GeneratedBounds.Z);
+	UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Previewing bounds %s with scale %s"), *GetName(),
+		*NewBounds.ToString(), *PreviewScale.ToCompactString());
+	SetRegenerationPreviewScale(PreviewScale);
+}
+
 void AHouseBuildSystemActor::OnBoundsTransformChange()
 {
 	Super::OnBoundsTransformChange();
@@ -308,16 +394,15 @@ void AHouseBuildSystemActor::OnBoundsTransformChange()
 			*InitialTransformName.ToString(),
 			*InitialTransformLocation.ToCompactString());
 		// TODO: Test this!! Was just Generator->Generate() before
+		PrepareTieredGeneration(Generator);
 		if (IBuildingGeneratorInterface::Execute_Generate(Generator).Succeeded())
 		{
 			ApplyStretch();
+			MarkChanged();
 		}
 	}
 
-	if (GetInterior() && GetInterior()->ShouldRegenerateOnBuildSystemUpdate())
-	{
-		GetInterior()->GenerateInterior(this);
-	}
+	RegenerateInteriorOnUpdate();
 }
 
 FModularLevel* AHouseBuildSystemActor::GetLevelWithId(int32 Id) const
@@ -449,6 +534,7 @@ void AHouseBuildSystemActor::ApplyStretch()
 					Args.Section->Scale(FVector(CurrentScale.X, CurrentScale.Y, Args.LocationMultiplier.Z));
 				}
 			});
+		MarkChanged();
 		//return;
 	}
 }
@@ -26,6 +26,8 @@
 #include "Timer.h"
 #include "Shape/ModularLevelShape.h"
 
+#include "Async/Async.h"
+#include "UObject/StrongObjectPtr.h"
 #include "Engine/StaticMeshActor.h"
 
 UHouseBuildSystemGenerator::UHouseBuildSystemGenerator()
@@ -42,6 +44,9 @@ FGeneratedModularSections UHouseBuildSystemGenerator::Generate_Implementation()
 	TIMER_THIS
 	Super::Generate_Implementation();
 
+	// Layout of the cancelled time-sliced generation is not awaited
+	LayoutFuture = TFuture<FHouseBuildSystemLayout>();
+
 	//// TODO: Clear MBS actor when Generator changes. Currently overridden PivotLocations of modular levels are not reset - but should be.
 	if (!PreGenerate(BuildSystemPtr))
 	{
@@ -49,51 +54,296 @@ FGeneratedModularSections UHouseBuildSystemGenerator::Generate_Implementation()
 		return FGeneratedModularSections();
 	}
 
+	FMBSGenerationSteps Steps;
+	AddGenerationSteps(Steps);
+	Steps.RunToCompletion();
+
+	TIMER_SHOW
+	return FGeneratedModularSections(BuildSystemPtr.Get());
+}
+
+bool UHouseBuildSystemGenerator::GenerateTierDetails()
+{
+	TIMER_THIS
+	UE_LOG(LogGenerator, Log, TEXT("%s: === Generating details of %s tier ==="), *GetName(),
+		*UEnum::GetValueAsString(GetGenerationTier()));
+	if (!BuildSystemPtr || !CheckProperties())
+	{
+		TIMER_SHOW
+		return false;
+	}
+
+	LayoutFuture = TFuture<FHouseBuildSystemLayout>();
+	FMBSGenerationSteps Steps;
+	AddTierDetailSteps(Steps);
+	const bool bSucceeded = Steps.RunToCompletion();
+	TIMER_SHOW
+	return bSucceeded;
+}
+
+void UHouseBuildSystemGenerator::AddGenerationSteps(FMBSGenerationSteps& OutSteps)
+{
 	// Offset floors
 	// TODO: implement for loop for Floors and offset them if
-	for (auto& Floor : BuildSystemPtr->Floors)
+	OutSteps.Add(TEXT("Offsets"), [this]
+	{
+		for (auto& Floor : BuildSystemPtr->Floors)
+		{
+			BuildSystemPtr->OffsetModularLevel(Floor, FVector(0.f, 0.f, Floor_New->FloorZOffset));
+		}
+
+		BuildSystemPtr->OffsetModularLevel(BuildSystemPtr->Roof, /*RoofOffset*/Roof_New->RoofOffset);
+	});
+
+	// Details are split from the shell, so other tiers can be generated on top of it later
+	OutSteps.Add(TEXT("TierDetails"), [this]
 	{
-		BuildSystemPtr->OffsetModularLevel(Floor, FVector(0.f, 0.f, Floor_New->FloorZOffset));
+		BuildSystemPtr->BeginTierDetails();
+	});
+
+	// Shell tier ends here - only structural levels are generated
+	if (!ShouldGenerateTier(EMBSGenerationTier::Facade))
+	{
+		OutSteps.Add(TEXT("FinishGeneration"), [this]
+		{
+			UE_LOG(LogGenerator, Log, TEXT("%s: Generated shell tier only."), *GetName());
+			FinishGeneration();
+		});
+		return;
 	}
+	AddTierDetailSteps(OutSteps);
+}
 
-	BuildSystemPtr->OffsetModularLevel(BuildSystemPtr->Roof, /*RoofOffset*/Roof_New->RoofOffset);
+void UHouseBuildSystemGenerator::AddTierDetailSteps(FMBSGenerationSteps& OutSteps)
+{
+	// Indices shared between steps
+	struct FDetailsState
+	{
+		TArray<int32> EntranceIndices;
+		TArray<FTransform> EntranceTransforms;
+		TArray<int32> WindowIndices;
+		FHouseBuildSystemLayout Layout;
+	};
+	const TSharedRef<FDetailsState> State = MakeShared<FDetailsState>();
+
+	// - Decide where details are placed without modifying any section
+	// Layout started at the beginning of the time-sliced generation is awaited without blocking the game thread
+	OutSteps.AddResumable(TEXT("Layout"), [this, State]
+	{
+		if (LayoutFuture.IsValid())
+		{
+			if (!LayoutFuture.IsReady())
+			{
+				return EMBSGenerationStepResult::Pending;
+			}
+			SetPrecomputedLayout(LayoutFuture.Get());
+			LayoutFuture = TFuture<FHouseBuildSystemLayout>();
+		}
+		State->Layout = TakeLayout();
+		return EMBSGenerationStepResult::Finished;
+	});
 
 	// - Update meshes and/or add new sections
 	// Entrances
-	TArray<int32> EntranceIndices;
-	TArray<FTransform> EntranceTransforms;
-	SetEntrances(EntranceIndices, EntranceTransforms);
+	OutSteps.Add(TEXT("Entrances"), [this, State]
+	{
+		SetEntrances(State->Layout, State->EntranceIndices, State->EntranceTransforms);
+	});
 
 	// Doors
-	SetDoors(EntranceIndices, EntranceTransforms);
+	OutSteps.Add(TEXT("Doors"), [this, State]
+	{
+		SetDoors(State->EntranceIndices, State->EntranceTransforms);
+	});
 	 
 	// Stairs
-	SetStairs(EntranceIndices, EntranceTransforms);
+	if (ShouldGenerateTier(EMBSGenerationTier::Full))
+	{
+		OutSteps.Add(TEXT("Stairs"), [this, State]
+		{
+			SetStairs(State->EntranceIndices, State->EntranceTransforms);
+		});
+	}
 	
 	// Windows
-	TArray<int32> WindowIndices;
-	FMBSGeneratorPropertyInitArgs WindowsArgs;
-	WindowsArgs.Generator = this;
-	WindowsArgs.InIndices = &EntranceIndices;
-	WindowsArgs.OutIndices = &WindowIndices;
-	WindowsArgs.InLevelName = "windows";
-	WindowsArgs.BuildSystem = BuildSystemPtr;
-	Windows_New->Init(WindowsArgs);
+	OutSteps.Add(TEXT("Windows"), [this, State]
+	{
+		State->WindowIndices = State->Layout.WindowIndices;
+		
+		FMBSGeneratorPropertyInitArgs WindowsArgs;
+		WindowsArgs.Generator = this;
+		WindowsArgs.InIndices = &State->EntranceIndices;
+		WindowsArgs.OutIndices = &State->WindowIndices;
+		WindowsArgs.InLevelName = "windows";
+		WindowsArgs.BuildSystem = BuildSystemPtr;
+		Windows_New->Init(WindowsArgs);
+	});
 
 	// TODO: Move to the subclasses?
-	SetChimney();
-	SetRoofWindows();
-	SetInterWallCorners();
-	SetVegetation();
+	OutSteps.Add(TEXT("Chimney"), [this, State]
+	{
+		SetChimney(State->Layout);
+	});
+	OutSteps.Add(TEXT("RoofWindows"), [this, State]
+	{
+		SetRoofWindows(State->Layout);
+	});
+	OutSteps.Add(TEXT("InterWallCorners"), [this]
+	{
+		SetInterWallCorners();
+	});
+	OutSteps.Add(TEXT("Vegetation"), [this, State]
+	{
+		SetVegetation(State->Layout);
+	});
 
-	SetFloorHoles(Floor_New->FloorHoleIdTransforms);
-	SetFloorHoleDoor(Floor_New->FloorHoleIdTransforms);
+	// Floor holes are only visible from the inside, so they are skipped below the full tier
+	if (ShouldGenerateTier(EMBSGenerationTier::Full))
+	{
+		OutSteps.Add(TEXT("FloorHoles"), [this, State]
+		{
+			SetFloorHoles(State->Layout, Floor_New->FloorHoleIdTransforms);
+			SetFloorHoleDoor(Floor_New->FloorHoleIdTransforms);
+		});
+	}
 
 	//LogGenerationSummary();
-	FinishGeneration();
+	OutSteps.Add(TEXT("FinishGeneration"), [this]
+	{
+		FinishGeneration();
+	});
+}
 
-	TIMER_SHOW
-	return FGeneratedModularSections(BuildSystemPtr.Get());
+FHouseBuildSystemLayoutInput UHouseBuildSystemGenerator::MakeLayoutInput() const
+{
+	check(IsInGameThread());
+
+	FHouseBuildSystemLayoutInput Input;
+	Input.DebugName = GetName();
+	Input.Tier = GetGenerationTier();
+	Input.Seed = FMath::Rand();
+
+	// Initializers are made the same way as by PrepareBuildSystem, so the input doesn't change when the levels are
+	// prepared. Only the skipped counts are taken from the levels, as they are known after initialization only
+	if (Walls_New)
+	{
+		Input.WallInitializer = MakeLevelInitializer(Walls_New, Walls_New->MeshIndex, GetPerimeter(),
+			Bounds.X + 2, BuildSystemPtr && !BuildSystemPtr->Walls.IsEmpty() ? &BuildSystemPtr->Walls[0] : nullptr);
+		Input.WallLevelCount = LevelCount;
+	}
+
+	if (Floor_New && Floor_New->bEnabled)
+	{
+		const int32 MeshListIndex = Floor_New->bUniqueFirstFloor ? Floor_New->FirstFloorMeshIndex : Floor_New->OtherFloorMeshIndex;
+		Input.FloorInitializer = MakeLevelInitializer(Floor_New, MeshListIndex, GetArea(), Bounds.X,
+			BuildSystemPtr && !BuildSystemPtr->Floors.IsEmpty() ? &BuildSystemPtr->Floors[0] : nullptr);
+		Input.FloorLevelCount = GetFloorLevelCount();
+	}
+
+	if (Roof_New && Roof_New->bEnabled)
+	{
+		Input.RoofInitializer = MakeLevelInitializer(Roof_New, Roof_New->MeshIndex, GetPerimeter(), Bounds.X + 2,
+			BuildSystemPtr ? &BuildSystemPtr->Roof : nullptr);
+	}
+
+	Input.bEntrances = Entrances_New && Entrances_New->bEnabled;
+	Input.bShiftEntrance = CustomLevelShape && CustomLevelShape->HasFrontIndicesInverted()
+		&& CustomLevelShape->SkipsSections();
+
+	if (Windows_New && Windows_New->bEnabled)
+	{
+		Input.bWindows = true;
+		Input.WindowCount = Windows_New->WindowCount;
+		Input.WindowCountPerLevel = Windows_New->WindowCountPerLevel;
+		Input.WindowIndexCalculation = Windows_New->Data.IndexCalculation;
+	}
+
+	Input.bChimney = Chimney_New && Chimney_New->bEnabled;
+
+	Input.bRoofWindows = RoofWindows.bEnabled;
+	Input.RoofWindowIndexCalculation = RoofWindows.Data.IndexCalculation;
+
+	if (Vegetation_New && Vegetation_New->bEnabled)
+	{
+		Input.bVegetation = true;
+		Input.VegetationCount = Vegetation_New->VegetationCount;
+		Input.VegetationIndexCalculation = Vegetation_New->Data.IndexCalculation;
+	}
+
+	if (Floor_New && Floor_New->bWithFloorHoles)
+	{
+		Input.bFloorHoles = true;
+		Input.FloorHoleIndexCalculation = Floor_New->FloorHoles.IndexCalculation;
+	}
+	return Input;
+}
+
+FModularSectionInitializer UHouseBuildSystemGenerator::MakeLevelInitializer(const UMBSGeneratorProperty* InProperty,
+	int32 InMeshListIndex, int32 InTotalCount, int32 InMaxInRow, const FModularLevel* InLevel)
+{
+	FModularSectionInitializer Initializer;
+	Initializer.SetMeshList(InProperty->Data.MeshList);
+	Initializer.SetMeshListIndex(InMeshListIndex);
+	Initializer.SetResolution(InProperty->Data.Resolution);
+	Initializer.SetTotalCount(InTotalCount);
+	Initializer.SetMaxInRow(InMaxInRow);
+	if (InLevel)
+	{
+		Initializer.SetSkippedCount(InLevel->GetInitializer().GetSkippedCount());
+	}
+	return Initializer;
+}
+
+TFuture<FHouseBuildSystemLayout> UHouseBuildSystemGenerator::ComputeLayoutAsync() const
+{
+	FHouseBuildSystemLayoutInput Input = MakeLayoutInput();
+	if (!Input.IsThreadSafe())
+	{
+		UE_LOG(LogGenerator, Verbose, TEXT("%s: Index calculations are not thread safe. Computing layout on the game thread."),
+			*GetName());
+		TPromise<FHouseBuildSystemLayout> Promise;
+		Promise.SetValue(FHouseBuildSystemLayout::Compute(Input, BuildSystemPtr.Get()));
+		return Promise.GetFuture();
+	}
+
+	// Generator may be changed or collected while the layout is computed, so referenced objects are kept alive by the
+	// task itself, and are released on the game thread once it is done
+	TArray<UObject*> ReferencedObjects;
+	Input.GetReferencedObjects(ReferencedObjects);
+	TSharedPtr<TArray<TStrongObjectPtr<UObject>>> KeepAlive = MakeShared<TArray<TStrongObjectPtr<UObject>>>();
+	for (UObject* Object : ReferencedObjects)
+	{
+		KeepAlive->Emplace(Object);
+	}
+
+	return Async(EAsyncExecution::ThreadPool, [Input = MoveTemp(Input), KeepAlive = MoveTemp(KeepAlive)]() mutable
+	{
+		FHouseBuildSystemLayout Layout = FHouseBuildSystemLayout::Compute(Input);
+		AsyncTask(ENamedThreads::GameThread, [KeepAlive = MoveTemp(KeepAlive)] {});
+		return Layout;
+	});
+}
+
+void UHouseBuildSystemGenerator::SetPrecomputedLayout(FHouseBuildSystemLayout InLayout)
+{
+	PrecomputedLayout = MoveTemp(InLayout);
+}
+
+FHouseBuildSystemLayout UHouseBuildSystemGenerator::TakeLayout()
+{
+	const FHouseBuildSystemLayoutInput Input = MakeLayoutInput();
+	if (PrecomputedLayout.IsSet())
+	{
+		FHouseBuildSystemLayout Layout = MoveTemp(PrecomputedLayout.GetValue());
+		PrecomputedLayout.Reset();
+		if (Layout.bComputed && Layout.InputHash == Input.GetLayoutHash())
+		{
+			UE_LOG(LogGenerator, Verbose, TEXT("%s: Using precomputed layout."), *GetName());
+			return Layout;
+		}
+		UE_LOG(LogGenerator, Log, TEXT("%s: Precomputed layout is outdated. Computing new one."), *GetName());
+	}
+	return FHouseBuildSystemLayout::Compute(Input, BuildSystemPtr.Get());
 }
 
 bool UHouseBuildSystemGenerator::CheckBounds() const
@@ -239,11 +489,19 @@ void UHouseBuildSystemGenerator::PreGenerateClear() const
 	}
 }
 
+void UHouseBuildSystemGenerator::OnBeginTimeSlicedGeneration()
+{
+	Super::OnBeginTimeSlicedGeneration();
+
+	// Layout is computed on the thread pool while the levels are initialized
+	LayoutFuture = ComputeLayoutAsync();
+}
+
 void UHouseBuildSystemGenerator::PrepareBuildSystem() const
 {
 	// - Generate levels
-	const int32 Area = Bounds.X * Bounds.Y;
-	const int32 Perimeter = (Bounds.X + Bounds.Y) * 2;
+	const int32 Area = GetArea();
+	const int32 Perimeter = GetPerimeter();
 
 	int32 BasementTotalCount, BasementMaxInRow;
 	if (Basement_New->Data.Resolution->GetSnapMode() == EModularSectionResolutionSnapMode::Wall)
@@ -294,13 +552,7 @@ void UHouseBuildSystemGenerator::PrepareBuildSystem() const
 	// Set floors
 	if (Floor_New && Floor_New->bEnabled)
 	{
-		int32 Num = Floor_New->bFloorForEachLevel ? LevelCount : Floor_New->MaxFloorCount;
-		// TODO: Put member property from Attic gen property here
-		if (bCanHaveAttic)
-		{
-			Num++;
-		}
-		
+		const int32 Num = GetFloorLevelCount();
 		BuildSystemPtr->Floors.SetNum(Num);
 		int32 FloorIndex = 0;
 		for (auto& Floor : BuildSystemPtr->Floors)
@@ -424,10 +676,11 @@ void UHouseBuildSystemGenerator::SetDoors(const TArray<int32>& InEntranceIndices
 	}*/
 }
 
-void UHouseBuildSystemGenerator::SetEntrances(TArray<int32>& OutEntranceIndices,
-	TArray<FTransform>& OutEntranceTransforms) const
+void UHouseBuildSystemGenerator::SetEntrances(const FHouseBuildSystemLayout& InLayout,
+	TArray<int32>& OutEntranceIndices, TArray<FTransform>& OutEntranceTransforms) const
 {
-	if (!Entrances_New || !Entrances_New->bEnabled || BuildSystemPtr->Walls.IsEmpty())
+	if (!Entrances_New || !Entrances_New->bEnabled || BuildSystemPtr->Walls.IsEmpty()
+		|| InLayout.EntranceIndex == INDEX_NONE)
 	{
 		return;
 	}
@@ -440,15 +693,7 @@ void UHouseBuildSystemGenerator::SetEntrances(TArray<int32>& OutEntranceIndices,
 	//const int32 CentralElement = Entrances_New->bEntranceFromFront ? 0 : Bounds.X / 2;
 	//const int32 CentralRow = Entrances_New->bEntranceFromFront ? Bounds.Y / 2 - 1 : 0;
 
-	const int32 WallsMaxInRow = WallLevel.GetInitializer().GetMaxInRow();
-	int32 ElementIndex = WallsMaxInRow + (WallsMaxInRow % 2);
-
-	// TODO: If MBS actor uses Shape that swaps front and back indices - decrement index
-	// TODO: Also, add new virtual function for MBS actor or Shape objects that will return if Front is Odd or Even index
-	if (CustomLevelShape && CustomLevelShape->HasFrontIndicesInverted() && CustomLevelShape->SkipsSections())
-	{
-		ElementIndex--;
-	}
+	int32 ElementIndex = InLayout.EntranceIndex;
 
 	//UE_LOG(LogGenerator, VeryVerbose, TEXT("%s: CentralElement=%d, CentralRow=%d, ElementIndex=%d"), *GetName(),
 	//	CentralElement, CentralRow, ElementIndex);
@@ -525,18 +770,27 @@ void UHouseBuildSystemGenerator::SetStairs(const TArray<int32>& InEntranceIndice
 	}
 }
 
-void UHouseBuildSystemGenerator::SetChimney() const
+void UHouseBuildSystemGenerator::SetChimney(const FHouseBuildSystemLayout& InLayout) const
 {
-	if (!Chimney_New || !Chimney_New->bEnabled)
+	if (!Chimney_New || !Chimney_New->bEnabled || InLayout.ChimneyIndex == INDEX_NONE)
 	{
 		return;
 	}
 	
 	PrintHeader(TEXT("chimneys"));
-		
+
+	// Layout doesn't know which roof sections were skipped by the level shape
+	const int32 AdjustedTotalCount = BuildSystemPtr->Roof.GetInitializer().GetAdjustedTotalCount();
+	if (AdjustedTotalCount <= 0)
+	{
+		UE_LOG(LogGenerator, Warning, TEXT("%s: Roof has no sections. Skipping chimney."), *GetName());
+		return;
+	}
+	
 	const int32 LevelId = BuildSystemPtr->Roof.GetId();	
-	FTransform CalculatedTransform = BuildSystemPtr->GetSectionTransformAtRandom(
+	FTransform CalculatedTransform = BuildSystemPtr->GetSectionTransformAt(
 		LevelId,
+		InLayout.ChimneyIndex % AdjustedTotalCount,
 		BuildSystemPtr->IsOfInstancedMeshConfigurationType(),
 		false);
 
@@ -546,7 +800,7 @@ void UHouseBuildSystemGenerator::SetChimney() const
 		Chimney_New->ChimneyIndex, CalculatedTransform, LevelId, true, true);
 }
 
-void UHouseBuildSystemGenerator::SetVegetation() const
+void UHouseBuildSystemGenerator::SetVegetation(const FHouseBuildSystemLayout& InLayout) const
 {
 	if (!Vegetation_New || !Vegetation_New->bEnabled)
 	{
@@ -554,26 +808,15 @@ void UHouseBuildSystemGenerator::SetVegetation() const
 	}
 	
 	PrintHeader(TEXT("vegetation"));
-	for (auto& Wall : BuildSystemPtr->Walls)
+	const int32 WallCount = FMath::Min(BuildSystemPtr->Walls.Num(), InLayout.VegetationIndices.Num());
+	for (int32 WallIndex = 0; WallIndex < WallCount; WallIndex++)
 	{
-		TArray<int32> OccupiedIndices;
-		for (int32 i = 0; i < Vegetation_New->VegetationCount; i++)
+		const FModularLevel& Wall = BuildSystemPtr->Walls[WallIndex];
+		for (const int32 Index : InLayout.VegetationIndices[WallIndex])
 		{
-			int32 Index;
-			if (Vegetation_New->Data.IndexCalculation)
-			{
-				Index = Vegetation_New->Data.IndexCalculation->CalculateSingle(
-					{ BuildSystemPtr, i, &OccupiedIndices, &Wall.GetInitializer() });
-			}
-			else
-			{
-				Index = 0;
-			}
 			FTransform CalculatedTransform = BuildSystemPtr->GetSectionTransformAt(
 				Wall, Index, BuildSystemPtr->IsOfInstancedMeshConfigurationType(), false);
 
-			OccupiedIndices.Add(Index);
-
 			MBS::FSectionBuilder(BuildSystemPtr, &Wall)
 				.Mesh(Vegetation_New->Data.GetRandomMesh())
 				.At(CalculatedTransform)
@@ -593,7 +836,7 @@ void UHouseBuildSystemGenerator::SetVegetation() const
 	}
 }
 
-void UHouseBuildSystemGenerator::SetRoofWindows() const
+void UHouseBuildSystemGenerator::SetRoofWindows(const FHouseBuildSystemLayout& InLayout) const
 {
 	if (!RoofWindows.bEnabled)
 	{
@@ -601,22 +844,8 @@ void UHouseBuildSystemGenerator::SetRoofWindows() const
 	}
 	
 	PrintHeader(TEXT("roof windows"));
-
-	constexpr int32 Count = 1;
-	TArray<int32> OccupiedIndices;
-	for (int32 i = 0; i < Count; i++)
+	for (const int32 Index : InLayout.RoofWindowIndices)
 	{
-		int32 Index;
-		if (RoofWindows.Data.IndexCalculation)
-		{
-			Index = RoofWindows.Data.IndexCalculation->CalculateSingle(
-				{ BuildSystemPtr, i, &OccupiedIndices, &BuildSystemPtr->Roof.GetInitializer() });
-		}
-		else
-		{
-			Index = 0;
-		}
-
 		MBS::FSectionBuilder(BuildSystemPtr, &BuildSystemPtr->Roof)
 			.Actor(RoofWindows.Data.GetRandomActorClass())
 			.AtInstanced(Index, BuildSystemPtr->IsOfInstancedMeshConfigurationType())
@@ -695,7 +924,8 @@ void UHouseBuildSystemGenerator::SetInterWallCorners() const
 	}
 }
 
-void UHouseBuildSystemGenerator::SetFloorHoles(TArray<FMBSLevelIdTransformPair>& OutFloorHoleIdTransforms)
+void UHouseBuildSystemGenerator::SetFloorHoles(const FHouseBuildSystemLayout& InLayout,
+	TArray<FMBSLevelIdTransformPair>& OutFloorHoleIdTransforms)
 {
 	Floor_New->FloorHoleIdTransforms.Empty();
 	if (!Floor_New->bWithFloorHoles)
@@ -713,14 +943,18 @@ void UHouseBuildSystemGenerator::SetFloorHoles(TArray<FMBSLevelIdTransformPair>&
 		return;
 	}
 
-	TArray<int32> OccupiedIndices;
 	for (int32 i = 1; i < BuildSystemPtr->Floors.Num(); i++)
 	{
+		if (!InLayout.FloorHoleIndices.IsValidIndex(i - 1))
+		{
+			UE_LOG(LogGenerator, Warning, TEXT("%s: Layout has no floor hole for the floor %d. Skipping."),
+				*GetName(), i);
+			break;
+		}
+		
 		const FModularLevel& Floor = BuildSystemPtr->Floors[i];
 		UStaticMesh* Mesh = Floor_New->FloorHoles.GetMesh(Floor_New->FloorHoleMeshIndex);
-		const int32 SectionIndex = Floor_New->FloorHoles.GetIndex(
-			FMBSIndexCalculationArgs(BuildSystemPtr, i, &OccupiedIndices, &Floor.GetInitializer()),
-			0);
+		const int32 SectionIndex = InLayout.FloorHoleIndices[i - 1];
 
 		FTransform OutTransform;
 		MBS::FSectionBuilder(BuildSystemPtr, &Floor).Mesh(Mesh).At(SectionIndex).ReplaceIfInstancedOrSet();
@@ -804,6 +1038,17 @@ bool UHouseBuildSystemGenerator::CheckProperties() const
 	return bResult;
 }
 
+int32 UHouseBuildSystemGenerator::GetFloorLevelCount() const
+{
+	int32 Num = Floor_New->bFloorForEachLevel ? LevelCount : Floor_New->MaxFloorCount;
+	// TODO: Put member property from Attic gen property here
+	if (bCanHaveAttic)
+	{
+		Num++;
+	}
+	return Num;
+}
+
 bool UHouseBuildSystemGenerator::CheckEntrancesCount(const FString& InLevelName, const TArray<int32>& InEntranceIndices) const
 {
 	const int32 CountOfEntrances = InEntranceIndices.Num();
@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "House/HouseBuildSystemLayout.h"
+
+#include "MBSIndexCalculation.h"
+#include "House/GenProperty/HouseWindowGeneratorProperty.h"
+
+bool FHouseBuildSystemLayoutInput::IsThreadSafe() const
+{
+	return UMBSIndexCalculation::IsThreadSafe(WindowIndexCalculation)
+		&& UMBSIndexCalculation::IsThreadSafe(RoofWindowIndexCalculation)
+		&& UMBSIndexCalculation::IsThreadSafe(VegetationIndexCalculation)
+		&& UMBSIndexCalculation::IsThreadSafe(FloorHoleIndexCalculation);
+}
+
+void FHouseBuildSystemLayoutInput::GetReferencedObjects(TArray<UObject*>& OutObjects) const
+{
+	auto AddObject = [&OutObjects](UObject* Object)
+	{
+		if (Object)
+		{
+			OutObjects.AddUnique(Object);
+		}
+	};
+
+	for (const FModularSectionInitializer* Initializer : { &WallInitializer, &FloorInitializer, &RoofInitializer })
+	{
+		AddObject(Initializer->GetStaticMesh());
+		AddObject(Initializer->GetMeshList());
+		AddObject(Initializer->GetResolution());
+	}
+	AddObject(WindowIndexCalculation);
+	AddObject(RoofWindowIndexCalculation);
+	AddObject(VegetationIndexCalculation);
+	AddObject(FloorHoleIndexCalculation);
+}
+
+uint32 FHouseBuildSystemLayoutInput::GetLayoutHash() const
+{
+	uint32 Hash = GetTypeHash(Tier);
+	Hash = HashCombine(Hash, GetTypeHash(WallInitializer.GetTotalCount()));
+	Hash = HashCombine(Hash, GetTypeHash(WallInitializer.GetMaxInRow()));
+	Hash = HashCombine(Hash, GetTypeHash(WallInitializer.GetAdjustedTotalCount()));
+	Hash = HashCombine(Hash, GetTypeHash(FloorInitializer.GetTotalCount()));
+	Hash = HashCombine(Hash, GetTypeHash(FloorInitializer.GetMaxInRow()));
+	Hash = HashCombine(Hash, GetTypeHash(FloorInitializer.GetAdjustedTotalCount()));
+	Hash = HashCombine(Hash, GetTypeHash(RoofInitializer.GetTotalCount()));
+	Hash = HashCombine(Hash, GetTypeHash(RoofInitializer.GetMaxInRow()));
+	Hash = HashCombine(Hash, GetTypeHash(RoofInitializer.GetAdjustedTotalCount()));
+	Hash = HashCombine(Hash, GetTypeHash(WallLevelCount));
+	Hash = HashCombine(Hash, GetTypeHash(FloorLevelCount));
+	Hash = HashCombine(Hash, GetTypeHash(bEntrances));
+	Hash = HashCombine(Hash, GetTypeHash(bShiftEntrance));
+	Hash = HashCombine(Hash, GetTypeHash(bWindows));
+	Hash = HashCombine(Hash, GetTypeHash(WindowCount));
+	Hash = HashCombine(Hash, GetTypeHash(WindowCountPerLevel));
+	Hash = HashCombine(Hash, GetTypeHash(WindowIndexCalculation));
+	Hash = HashCombine(Hash, GetTypeHash(bChimney));
+	Hash = HashCombine(Hash, GetTypeHash(bRoofWindows));
+	Hash = HashCombine(Hash, GetTypeHash(RoofWindowIndexCalculation));
+	Hash = HashCombine(Hash, GetTypeHash(bVegetation));
+	Hash = HashCombine(Hash, GetTypeHash(VegetationCount));
+	Hash = HashCombine(Hash, GetTypeHash(VegetationIndexCalculation));
+	Hash = HashCombine(Hash, GetTypeHash(bFloorHoles));
+	Hash = HashCombine(Hash, GetTypeHash(FloorHoleIndexCalculation));
+	return Hash;
+}
+
+FHouseBuildSystemLayout FHouseBuildSystemLayout::Compute(const FHouseBuildSystemLayoutInput& Input,
+	AModularBuildSystemActor* BuildSystem)
+{
+	check(IsInGameThread() || (Input.IsThreadSafe() && !BuildSystem));
+
+	FHouseBuildSystemLayout Layout;
+	Layout.InputHash = Input.GetLayoutHash();
+	Layout.bComputed = true;
+
+	// Shell tier has no details
+	if (Input.Tier < EMBSGenerationTier::Facade)
+	{
+		return Layout;
+	}
+
+	FRandomStream Stream(Input.Seed);
+
+	// Entrances
+	TArray<int32> EntranceIndices;
+	if (Input.bEntrances && Input.WallLevelCount > 0)
+	{
+		const int32 WallsMaxInRow = Input.WallInitializer.GetMaxInRow();
+		Layout.EntranceIndex = WallsMaxInRow + (WallsMaxInRow % 2);
+		if (Input.bShiftEntrance)
+		{
+			Layout.EntranceIndex--;
+		}
+		EntranceIndices.Add(Layout.EntranceIndex);
+	}
+
+	// Windows
+	if (Input.bWindows && !EntranceIndices.IsEmpty())
+	{
+		TArray<FModularSectionInitializer> WallInitializers;
+		WallInitializers.Init(Input.WallInitializer, Input.WallLevelCount);
+		UHouseWindowGeneratorProperty::CalculateWindowIndices(Input.WindowCount, Input.WindowCountPerLevel,
+			Input.WindowIndexCalculation, BuildSystem, WallInitializers, EntranceIndices, Layout.WindowIndices,
+			&Stream);
+	}
+
+	// Chimney
+	if (Input.bChimney && Input.RoofInitializer.GetTotalCount() > 0)
+	{
+		Layout.ChimneyIndex = Stream.RandRange(0, Input.RoofInitializer.GetTotalCount() - 1);
+	}
+
+	// Roof windows
+	if (Input.bRoofWindows)
+	{
+		constexpr int32 Count = 1;
+		TArray<int32> OccupiedIndices;
+		const FMBSOccupiedIndices Occupied(Input.RoofInitializer.GetAdjustedTotalCount());
+		for (int32 i = 0; i < Count; i++)
+		{
+			Layout.RoofWindowIndices.Add(UMBSIndexCalculation::CalculateSingleOrDefault(Input.RoofWindowIndexCalculation,
+				{ BuildSystem, i, &OccupiedIndices, &Input.RoofInitializer, &Stream, &Occupied }, 0));
+		}
+	}
+
+	// Vegetation
+	if (Input.bVegetation)
+	{
+		Layout.VegetationIndices.SetNum(Input.WallLevelCount);
+		for (TArray<int32>& OccupiedIndices : Layout.VegetationIndices)
+		{
+			// Bitset of the level is updated together with its indices
+			FMBSOccupiedIndices Occupied(Input.WallInitializer.GetAdjustedTotalCount());
+			for (int32 i = 0; i < Input.VegetationCount; i++)
+			{
+				const int32 Index = UMBSIndexCalculation::CalculateSingleOrDefault(Input.VegetationIndexCalculation,
+					{ BuildSystem, i, &OccupiedIndices, &Input.WallInitializer, &Stream, &Occupied }, 0);
+				OccupiedIndices.Add(Index);
+				Occupied.Occupy(Index);
+			}
+		}
+	}
+
+	// Floor holes are only visible from the inside
+	if (Input.bFloorHoles && Input.Tier >= EMBSGenerationTier::Full)
+	{
+		TArray<int32> OccupiedIndices;
+		const FMBSOccupiedIndices Occupied(Input.FloorInitializer.GetAdjustedTotalCount());
+		for (int32 i = 1; i < Input.FloorLevelCount; i++)
+		{
+			Layout.FloorHoleIndices.Add(UMBSIndexCalculation::CalculateSingleOrDefault(Input.FloorHoleIndexCalculation,
+				{ BuildSystem, i, &OccupiedIndices, &Input.FloorInitializer, &Stream, &Occupied }, 0));
+		}
+	}
+
+	return Layout;
+}
@@ -8,6 +8,7 @@
 #include "LSystem/MBSLSystem.h"
 #include "House/HouseBuildSystemActor.h"
 #include "Interior/MBSInteriorPropList.h"
+#include "Interior/MBSRoomOccupancy.h"
 #include "ModularBuildSystem.h"
 #include "List/ModularBuildSystemMeshList.h"
 #include "List/ModularBuildSystemActorList.h"
@@ -260,8 +261,18 @@ void UHouseInteriorGenerator::FillRooms(const FModularLevel& InLevel, int32 InFl
 {
 	// For each room
 	FInteriorLevel& InteriorLevel = OutGenerated.InteriorLevels[InFloorIndex];
+	const FRandomStream Stream(FMath::Rand());
 	for (const auto& Room : InteriorLevel.Rooms)
 	{
+		// Rooms without bounds are filled using random locations with overlap tests
+		MBS::FRoomOccupancyGrid Grid;
+		if (Settings.bUseOccupancyGrid && Room.Bounds.IsValid)
+		{
+			FBox AllowedBox = Room.Bounds;
+			AdjustBoxToInteriorAllowedArea(AllowedBox, nullptr);
+			Grid = MBS::FRoomOccupancyGrid(AllowedBox, Settings.OccupancyCellSize);
+		}
+
 		// Spawn static mesh props
 		for (auto& StaticMesh : Floors.StaticMeshes)
 		{
@@ -274,7 +285,7 @@ void UHouseInteriorGenerator::FillRooms(const FModularLevel& InLevel, int32 InFl
 
 				// Component should have overlap events enabled for transform adjusting using box trace.
 				NewStaticMesh->GetStaticMeshComponent()->SetGenerateOverlapEvents(true);
-				AddNewInteriorActorChecked(NewStaticMesh, InteriorLevel, Room, InteriorLevel.StaticMeshActors, true);
+				AddNewInteriorActorChecked(NewStaticMesh, InteriorLevel, Room, Grid, Stream, InteriorLevel.StaticMeshActors, true);
 			}
 		}
 
@@ -290,7 +301,7 @@ void UHouseInteriorGenerator::FillRooms(const FModularLevel& InLevel, int32 InFl
 				
 				// Component should have overlap events enabled for transform adjusting using box trace.
 				NewSkeletalMesh->GetSkeletalMeshComponent()->SetGenerateOverlapEvents(true);
-				AddNewInteriorActorChecked(NewSkeletalMesh, InteriorLevel, Room, InteriorLevel.SkeletalMeshActors, true);
+				AddNewInteriorActorChecked(NewSkeletalMesh, InteriorLevel, Room, Grid, Stream, InteriorLevel.SkeletalMeshActors, true);
 			}
 		}
 
@@ -301,7 +312,7 @@ void UHouseInteriorGenerator::FillRooms(const FModularLevel& InLevel, int32 InFl
 			for (int32 PropIndex = 0; PropIndex < MaxCount; PropIndex++)
 			{
 				AActor* NewActor = GetWorld()->SpawnActor<AActor>(Actor.Key, CalculateNewTransform(Room));
-				AddNewInteriorActorChecked(NewActor, InteriorLevel, Room, InteriorLevel.Actors, true);
+				AddNewInteriorActorChecked(NewActor, InteriorLevel, Room, Grid, Stream, InteriorLevel.Actors, true);
 			}
 		}
 	}
@@ -519,6 +530,46 @@ bool UHouseInteriorGenerator::AddNewInteriorActor(AActor* Actor, const FInterior
 	return true;
 }
 
+bool UHouseInteriorGenerator::AddNewInteriorActor(AActor* Actor, const FInteriorLevel& InteriorLevel,
+	const FMBSRoom& Room, MBS::FRoomOccupancyGrid& Grid, const FRandomStream& Stream) const
+{
+	if (!Grid.IsValid())
+	{
+		return AddNewInteriorActor(Actor, InteriorLevel, Room);
+	}
+
+	// Props placed using the grid never overlap each other, so no overlap tests are needed
+	if (!PlaceInOccupancyGrid(Actor, Grid, Stream))
+	{
+		UE_LOG(LogInteriorGenerator, Verbose, TEXT("%s: No free place for %s in %s (FillRatio=%.2f), skipping it."),
+			*GetName(), *Actor->GetName(), *Room.Name.ToString(), Grid.GetFillRatio());
+		Actor->Destroy();
+		return false;
+	}
+	return true;
+}
+
+bool UHouseInteriorGenerator::PlaceInOccupancyGrid(AActor* Actor, MBS::FRoomOccupancyGrid& Grid,
+	const FRandomStream& Stream) const
+{
+	const FBox ActorBox = Actor->GetComponentsBoundingBox(true);
+	const FIntPoint Footprint = Grid.GetFootprint(ActorBox.IsValid ? ActorBox.GetSize() : FVector::ZeroVector);
+
+	FIntPoint FirstCell;
+	if (!Grid.FindRandomPlacement(Footprint, Stream, FirstCell))
+	{
+		return false;
+	}
+
+	// Only X and Y are changed, so the prop stays on the floor
+	const FBox CellsBox = Grid.GetCellsBox(FirstCell, Footprint);
+	FVector Offset = CellsBox.GetCenter() - (ActorBox.IsValid ? ActorBox.GetCenter() : Actor->GetActorLocation());
+	Offset.Z = 0.f;
+	Actor->AddActorWorldOffset(Offset);
+	Grid.Occupy(FirstCell, Footprint);
+	return true;
+}
+
 void UHouseInteriorGenerator::CreateSingleRoom(FMBSRoom& Room, const FModularLevel& CurrentLevel, int32 InFloorIndex,
 	FBox BSBounds) const
 {
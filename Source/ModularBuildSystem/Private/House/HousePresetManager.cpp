@@ -36,7 +36,7 @@ void UHousePresetManager::SavePreset_Implementation()
 	UHouseBuildSystemPreset* NewAsset = NewObject<UHouseBuildSystemPreset>(Package, 
 		UHouseBuildSystemPreset::StaticClass(), *SavedFileName, EObjectFlags::RF_Public | EObjectFlags::RF_Standalone);
 
-	NewAsset->SaveProperties(BS.Get());
+	NewAsset->Save(BS.Get());
 
 	FAssetRegistryModule::AssetCreated(NewAsset);
 	NewAsset->MarkPackageDirty();
@@ -60,8 +60,15 @@ void UHousePresetManager::LoadPreset_Implementation()
 	if (Preset)
 	{
 		BS->ResetBuildSystem();
-		Preset->LoadProperties(BS.Get());
-		if (BS->Generator && IBuildingGeneratorInterface::Execute_Generate(BS->Generator).Succeeded())
+		bPresetLayoutApplied = Preset->Apply(BS.Get());
+		if (bPresetLayoutApplied)
+		{
+			// Saved sections are already stretched, so only bounds are updated
+			BS->TransformBounds.SetBounds(
+				FIntVector(BS->GetBuildStats().GetBoundsVector()),
+				BS->GetStretchManager().GetScaleCoefficientsSwappedXY());
+		}
+		else if (BS->Generator && IBuildingGeneratorInterface::Execute_Generate(BS->Generator).Succeeded())
 		{
 			BS->TransformBounds.SetBounds(
 				FIntVector(BS->GetBuildStats().GetBoundsVector()),
@@ -90,8 +97,11 @@ void UHousePresetManager::PostEditChangeProperty(FPropertyChangedEvent& Property
 		if (PropertyName == GET_MEMBER_NAME_CHECKED(AHouseBuildSystemActor, PresetManager->PresetSlider))
 		{
 			LoadPreset();
-			BS->ResetBuildSystem();
-			BS->Init();
+			if (!bPresetLayoutApplied)
+			{
+				BS->ResetBuildSystem();
+				BS->Init();
+			}
 		}
 	}
 	UObject::PostEditChangeProperty(PropertyChangedEvent);
@@ -24,7 +24,7 @@ FTransform UHouseWallTransformSolver::GetNextTransform_Implementation(FNextTrans
         else if (IsFacingBack())
         {
             Args.OutRotation.Yaw -= 90.f;
-            Args.OutLocation.X += (DefaultSectionSize * (Args.InBuildStats.Bounds.X + 1)) - DefaultSectionSize;
+            Args.OutLocation.X += (DefaultSectionSize * (Args.GetBuildStats().Bounds.X + 1)) - DefaultSectionSize;
         }
         else if (IsFacingLeft())
         {
@@ -45,7 +45,7 @@ FTransform UHouseWallTransformSolver::GetNextTransform_Implementation(FNextTrans
                 (MiddleWallsCount > 0 || (Remainder == 0 && MiddleWallsCount == 0) ? 2 : 0));
             
             Args.OutLocation.X += (DefaultSectionSize * ShiftMultiplier);
-            Args.OutLocation.Y += (DefaultSectionSize * Args.InBuildStats.Bounds.Y) - DefaultSectionSize;
+            Args.OutLocation.Y += (DefaultSectionSize * Args.GetBuildStats().Bounds.Y) - DefaultSectionSize;
         }
     }
     else // Middle
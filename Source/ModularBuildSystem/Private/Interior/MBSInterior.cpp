@@ -69,6 +69,18 @@ void UMBSInterior::UpdateInterior()
 	}
 }
 
+void UMBSInterior::SetInteriorVisibility(bool bVisible)
+{
+	UE_LOG(LogMBSInterior, Verbose, TEXT("%s: Setting interior visibility to %d."), *GetName(), static_cast<int32>(bVisible));
+	for (const auto& InteriorActor : InteriorActors)
+	{
+		if (IsValid(InteriorActor) && InteriorActor->GetRootComponent())
+		{
+			InteriorActor->GetRootComponent()->SetVisibility(bVisible, true);
+		}
+	}
+}
+
 void UMBSInterior::ApplyInteriorPreset()
 {
 	UE_LOG(LogMBSInterior, Log, TEXT("%s: Applying interior..."), *GetName());
@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Interior/MBSRoomOccupancy.h"
+
+#include "MBSGridCell.h"
+#include "ModularSectionResolution.h"
+
+MBS::FRoomOccupancyGrid::FRoomOccupancyGrid(const FBox& InBounds, float InCellSize)
+	: Origin(InBounds.Min)
+	, CellSize(InCellSize)
+{
+	if (CellSize > 0.f && InBounds.IsValid)
+	{
+		const FVector Size = InBounds.GetSize();
+		CellCount = FIntPoint(FMath::FloorToInt(Size.X / CellSize), FMath::FloorToInt(Size.Y / CellSize));
+		Occupied.Init(false, CellCount.X * CellCount.Y);
+	}
+}
+
+float MBS::FRoomOccupancyGrid::GetFillRatio() const
+{
+	const int32 Count = CellCount.X * CellCount.Y;
+	return Count > 0 ? static_cast<float>(OccupiedCount) / Count : 1.f;
+}
+
+bool MBS::FRoomOccupancyGrid::IsOccupied(FIntPoint Cell) const
+{
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= CellCount.X || Cell.Y >= CellCount.Y)
+	{
+		return true;
+	}
+	return Occupied[GetIndex(Cell.X, Cell.Y)];
+}
+
+FIntPoint MBS::FRoomOccupancyGrid::GetFootprint(const FVector& Size) const
+{
+	return FIntPoint(
+		FMath::Max(1, FMath::CeilToInt(Size.X / CellSize - KINDA_SMALL_NUMBER)),
+		FMath::Max(1, FMath::CeilToInt(Size.Y / CellSize - KINDA_SMALL_NUMBER)));
+}
+
+FBox MBS::FRoomOccupancyGrid::GetCellsBox(FIntPoint FirstCell, FIntPoint Footprint) const
+{
+	// Cells of the same size as the grid cells, relative to the grid origin
+	const FVector Multiplier = FVector(CellSize / UModularSectionResolution::DefaultSectionSize);
+	const FTransform RelativeTo(Origin);
+	const FGridCell3D First(FirstCell.X, FirstCell.Y, 0, RelativeTo, Multiplier, true);
+	const FGridCell3D Last(FirstCell.X + Footprint.X - 1, FirstCell.Y + Footprint.Y - 1, 0, RelativeTo, Multiplier, true);
+	return FBox(First.BottomLeftRelative(), Last.TopRightRelative());
+}
+
+void MBS::FRoomOccupancyGrid::Occupy(const FBox& Box)
+{
+	if (!IsValid() || !Box.IsValid)
+	{
+		return;
+	}
+
+	// Cells which are only touched by the box are not occupied
+	const FVector Min = (Box.Min - Origin) / CellSize;
+	const FVector Max = (Box.Max - Origin) / CellSize;
+	const FIntPoint FirstCell(
+		FMath::Max(0, FMath::FloorToInt(Min.X + KINDA_SMALL_NUMBER)),
+		FMath::Max(0, FMath::FloorToInt(Min.Y + KINDA_SMALL_NUMBER)));
+	const FIntPoint LastCell(
+		FMath::Min(CellCount.X - 1, FMath::CeilToInt(Max.X - KINDA_SMALL_NUMBER) - 1),
+		FMath::Min(CellCount.Y - 1, FMath::CeilToInt(Max.Y - KINDA_SMALL_NUMBER) - 1));
+	if (LastCell.X >= FirstCell.X && LastCell.Y >= FirstCell.Y)
+	{
+		Occupy(FirstCell, LastCell - FirstCell + FIntPoint(1, 1));
+	}
+}
+
+void MBS::FRoomOccupancyGrid::Occupy(FIntPoint FirstCell, FIntPoint Footprint)
+{
+	const int32 EndX = FMath::Min(FirstCell.X + Footprint.X, CellCount.X);
+	const int32 EndY = FMath::Min(FirstCell.Y + Footprint.Y, CellCount.Y);
+	for (int32 Y = FMath::Max(0, FirstCell.Y); Y < EndY; Y++)
+	{
+		for (int32 X = FMath::Max(0, FirstCell.X); X < EndX; X++)
+		{
+			FBitReference Bit = Occupied[GetIndex(X, Y)];
+			if (!Bit)
+			{
+				Bit = true;
+				OccupiedCount++;
+			}
+		}
+	}
+}
+
+bool MBS::FRoomOccupancyGrid::FindRandomPlacement(FIntPoint Footprint, const FRandomStream& Stream,
+	FIntPoint& OutFirstCell) const
+{
+	if (!IsValid() || Footprint.X > CellCount.X || Footprint.Y > CellCount.Y || Footprint.X * Footprint.Y > GetFreeCount())
+	{
+		return false;
+	}
+
+	// Summed-area table of occupied cells, so each placement is checked in constant time
+	const int32 StrideX = CellCount.X + 1;
+	TArray<int32> Sums;
+	Sums.SetNumZeroed(StrideX * (CellCount.Y + 1));
+	for (int32 Y = 0; Y < CellCount.Y; Y++)
+	{
+		for (int32 X = 0; X < CellCount.X; X++)
+		{
+			Sums[(Y + 1) * StrideX + X + 1] = (Occupied[GetIndex(X, Y)] ? 1 : 0)
+				+ Sums[Y * StrideX + X + 1] + Sums[(Y + 1) * StrideX + X] - Sums[Y * StrideX + X];
+		}
+	}
+
+	TArray<FIntPoint> Placements;
+	for (int32 Y = 0; Y + Footprint.Y <= CellCount.Y; Y++)
+	{
+		for (int32 X = 0; X + Footprint.X <= CellCount.X; X++)
+		{
+			const int32 X1 = X + Footprint.X;
+			const int32 Y1 = Y + Footprint.Y;
+			const int32 OccupiedInFootprint = Sums[Y1 * StrideX + X1] - Sums[Y * StrideX + X1]
+				- Sums[Y1 * StrideX + X] + Sums[Y * StrideX + X];
+			if (OccupiedInFootprint == 0)
+			{
+				Placements.Add(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	if (Placements.IsEmpty())
+	{
+		return false;
+	}
+	OutFirstCell = Placements[Stream.RandHelper(Placements.Num())];
+	return true;
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "List/MBSListLookup.h"
+
+uint32 MBS::NextListLookupRevision()
+{
+	check(IsInGameThread());
+	static uint32 Revision = 0;
+	if (++Revision == 0)
+	{
+		++Revision;
+	}
+	return Revision;
+}
+
+void FMBSAliasTable::Build(TConstArrayView<float> Weights, TArrayView<float> OutProbabilities,
+	TArrayView<int32> OutAliases)
+{
+	const int32 Count = Weights.Num();
+	check(OutProbabilities.Num() == Count && OutAliases.Num() == Count);
+
+	double TotalWeight = 0.0;
+	for (const float Weight : Weights)
+	{
+		TotalWeight += FMath::Max(0.f, Weight);
+	}
+
+	// Vose's method: each index is filled up to the average weight by the weight of a single larger index
+	TArray<double, TInlineAllocator<64>> Scaled;
+	TArray<int32, TInlineAllocator<64>> Small;
+	TArray<int32, TInlineAllocator<64>> Large;
+	Scaled.Reserve(Count);
+	for (int32 i = 0; i < Count; i++)
+	{
+		Scaled.Add(TotalWeight > 0.0 ? FMath::Max(0.f, Weights[i]) * Count / TotalWeight : 1.0);
+		(Scaled[i] < 1.0 ? Small : Large).Add(i);
+	}
+
+	while (!Small.IsEmpty() && !Large.IsEmpty())
+	{
+		const int32 SmallIndex = Small.Pop(false);
+		const int32 LargeIndex = Large.Pop(false);
+		OutProbabilities[SmallIndex] = Scaled[SmallIndex];
+		OutAliases[SmallIndex] = LargeIndex;
+
+		Scaled[LargeIndex] += Scaled[SmallIndex] - 1.0;
+		(Scaled[LargeIndex] < 1.0 ? Small : Large).Add(LargeIndex);
+	}
+
+	// Remaining indices have the average weight, up to rounding errors, so they are always picked themselves
+	for (const int32 Index : Large)
+	{
+		OutProbabilities[Index] = 1.f;
+		OutAliases[Index] = Index;
+	}
+	for (const int32 Index : Small)
+	{
+		OutProbabilities[Index] = 1.f;
+		OutAliases[Index] = Index;
+	}
+}
@@ -21,18 +21,85 @@ TSubclassOf<AActor> UModularBuildSystemActorList::GetActorClass(int32 AtIndex, U
 		return nullptr;
 	}
 	
-	const FModularBuildSystemActorListElement* Element = Elements.Find(Resolution);
-	if (Element && Element->ActorClasses.IsValidIndex(AtIndex))
+	const FLookup& ActorLookup = GetLookup();
+	if (UClass* const* ActorClass = ActorLookup.Find(ActorLookup.FindResolutionId(Resolution), AtIndex))
 	{
-		return Element->ActorClasses[AtIndex];
+		return *ActorClass;
 	}
 	UE_LOG(LogMBS, Error, TEXT("%s: Actor class is not found"), *GetName());
 	return nullptr;
 }
 
+TSubclassOf<AActor> UModularBuildSystemActorList::GetRandomActorClass(UModularSectionResolution* Resolution) const
+{
+	const FLookup& ActorLookup = GetLookup();
+	if (UClass* const* ActorClass = ActorLookup.FindRandom(ActorLookup.FindResolutionId(Resolution)))
+	{
+		return *ActorClass;
+	}
+	UE_LOG(LogMBS, Error, TEXT("%s: No actor classes of resolution %s"), *GetName(),
+		Resolution ? *Resolution->GetName() : TEXT("nullptr"));
+	return nullptr;
+}
+
 int32 UModularBuildSystemActorList::GetLength(UModularSectionResolution* Resolution) const
 {
-	return Resolution && Elements.Contains(Resolution)
-		? Elements[Resolution].ActorClasses.Num()
-		: Elements.Num();
+	const FLookup& ActorLookup = GetLookup();
+	const int32 ResolutionId = Resolution ? ActorLookup.FindResolutionId(Resolution) : INDEX_NONE;
+	return ResolutionId != INDEX_NONE
+		? ActorLookup.Num(ResolutionId)
+		: ActorLookup.GetResolutionCount();
+}
+
+void UModularBuildSystemActorList::SetElements(
+	const TMap<UModularSectionResolution*, FModularBuildSystemActorListElement>& InElements)
+{
+	Elements = InElements;
+	InvalidateLookup();
+}
+
+const UModularBuildSystemActorList::FLookup& UModularBuildSystemActorList::GetLookup() const
+{
+	if (!Lookup.IsSet())
+	{
+		check(IsInGameThread());
+		Lookup.Emplace(Elements, [](const FModularBuildSystemActorListElement& Element)
+			-> const TArray<TSubclassOf<AActor>>&
+		{
+			return Element.ActorClasses;
+		},
+		[](const FModularBuildSystemActorListElement& Element)
+		{
+			return TConstArrayView<float>(Element.Weights);
+		});
+	}
+	return Lookup.GetValue();
+}
+
+void UModularBuildSystemActorList::InvalidateLookup()
+{
+	Lookup.Reset();
+}
+
+void UModularBuildSystemActorList::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+	if (UModularBuildSystemActorList* This = CastChecked<UModularBuildSystemActorList>(InThis); This->Lookup.IsSet())
+	{
+		This->Lookup->AddReferencedObjects(Collector);
+	}
+}
+
+#if WITH_EDITOR
+void UModularBuildSystemActorList::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateLookup();
+}
+
+void UModularBuildSystemActorList::PostEditUndo()
+{
+	Super::PostEditUndo();
+	InvalidateLookup();
 }
+#endif
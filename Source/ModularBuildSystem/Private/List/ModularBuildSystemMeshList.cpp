@@ -4,13 +4,15 @@
 #include "List/ModularBuildSystemMeshList.h"
 #include "ModularBuildSystem.h"
 #include "ModularSectionResolution.h"
+#include "Engine/StaticMesh.h"
 #include "Slate/SlateTextures.h"
 
 int32 UModularBuildSystemMeshList::GetCountOfMeshesWithResolution(UModularSectionResolution* Resolution) const
 {
-	if (const FModularBuildSystemMeshListElement* Element = Elements.Find(Resolution))
+	const FLookup& MeshLookup = GetLookup();
+	if (const int32 ResolutionId = MeshLookup.FindResolutionId(Resolution); ResolutionId != INDEX_NONE)
 	{
-		return Element->StaticMeshes.Num();
+		return MeshLookup.Num(ResolutionId);
 	}
 	UE_LOG(LogMBS, Error, TEXT("%s: Resolution not found"), *GetName());
 	return 0;
@@ -27,14 +29,14 @@ const UStaticMesh* UModularBuildSystemMeshList::GetConstMesh(int32 AtIndex, cons
 	UE_LOG(LogMBS, Verbose, TEXT("%s: Getting mesh at index %d with resolution %s"), *GetName(), AtIndex,
 		*Resolution->GetName());
 
-	const FModularBuildSystemMeshListElement* Element = Elements.Find(Resolution);
-	if (Element && Element->StaticMeshes.IsValidIndex(AtIndex))
+	const FLookup& MeshLookup = GetLookup();
+	if (UStaticMesh* const* Mesh = MeshLookup.Find(MeshLookup.FindResolutionId(Resolution), AtIndex))
 	{
-		if (!Element->StaticMeshes[AtIndex])
+		if (!*Mesh)
 		{
 			UE_LOG(LogMBS, Error, TEXT("%s: Found mesh at index %d is nullptr"), *GetName(), AtIndex);
 		}
-		return const_cast<UStaticMesh*>(Element->StaticMeshes[AtIndex]);
+		return *Mesh;
 	}
 	UE_LOG(LogMBS, Error, TEXT("%s: Mesh not found (AtIndex=%d, Resolution=%s)"), *GetName(),
 		AtIndex, Resolution ? *Resolution->GetName() : TEXT("nullptr"));
@@ -46,9 +48,113 @@ UStaticMesh* UModularBuildSystemMeshList::GetMesh(int32 AtIndex, UModularSection
 	return const_cast<UStaticMesh*>(GetConstMesh(AtIndex, Resolution));
 }
 
+UStaticMesh* UModularBuildSystemMeshList::GetRandomMesh(UModularSectionResolution* Resolution) const
+{
+	const FLookup& MeshLookup = GetLookup();
+	if (UStaticMesh* const* Mesh = MeshLookup.FindRandom(MeshLookup.FindResolutionId(Resolution)))
+	{
+		return *Mesh;
+	}
+	UE_LOG(LogMBS, Error, TEXT("%s: No meshes of resolution %s"), *GetName(),
+		Resolution ? *Resolution->GetName() : TEXT("nullptr"));
+	return nullptr;
+}
+
+void UModularBuildSystemMeshList::SetElements(
+	const TMap<UModularSectionResolution*, FModularBuildSystemMeshListElement>& InElements)
+{
+	Elements = InElements;
+	InvalidateLookup();
+}
+
+const UModularBuildSystemMeshList::FLookup& UModularBuildSystemMeshList::GetLookup() const
+{
+	if (!Lookup.IsSet())
+	{
+		check(IsInGameThread());
+		Lookup.Emplace(Elements, [](const FModularBuildSystemMeshListElement& Element)
+			-> const TArray<UStaticMesh*>&
+		{
+			return Element.StaticMeshes;
+		},
+		[](const FModularBuildSystemMeshListElement& Element)
+		{
+			return TConstArrayView<float>(Element.Weights);
+		});
+	}
+	return Lookup.GetValue();
+}
+
+void UModularBuildSystemMeshList::InvalidateLookup()
+{
+	Lookup.Reset();
+}
+
+void UModularBuildSystemMeshList::ClassifyMeshes(TMap<FIntVector, TArray<UStaticMesh*>>& OutBuckets) const
+{
+	for (const auto& [Resolution, Element] : Elements)
+	{
+		for (UStaticMesh* Mesh : Element.StaticMeshes)
+		{
+			if (Mesh)
+			{
+				OutBuckets.FindOrAdd(UModularSectionResolution::GetResolutionFromMesh(Mesh)).Add(Mesh);
+			}
+		}
+	}
+}
+
+int32 UModularBuildSystemMeshList::FindMismatchedMeshes(TArray<UStaticMesh*>& OutMeshes, float Tolerance) const
+{
+	const int32 PreviousCount = OutMeshes.Num();
+	for (const auto& [Resolution, Element] : Elements)
+	{
+		if (!Resolution)
+		{
+			continue;
+		}
+		const FVector ExpectedBounds(Resolution->GetValue());
+		for (UStaticMesh* Mesh : Element.StaticMeshes)
+		{
+			if (Mesh && !Mesh->GetBoundingBox().GetSize().Equals(ExpectedBounds, Tolerance))
+			{
+				UE_LOG(LogMBS, Verbose, TEXT("%s: Bounds of %s don't match resolution %s"), *GetName(),
+					*Mesh->GetName(), *Resolution->GetName());
+				OutMeshes.Add(Mesh);
+			}
+		}
+	}
+	return OutMeshes.Num() - PreviousCount;
+}
+
 int32 UModularBuildSystemMeshList::GetLength(UModularSectionResolution* Resolution) const
 {
-	return Resolution && Elements.Contains(Resolution)
-		? Elements[Resolution].StaticMeshes.Num()
-		: Elements.Num();
+	const FLookup& MeshLookup = GetLookup();
+	const int32 ResolutionId = Resolution ? MeshLookup.FindResolutionId(Resolution) : INDEX_NONE;
+	return ResolutionId != INDEX_NONE
+		? MeshLookup.Num(ResolutionId)
+		: MeshLookup.GetResolutionCount();
+}
+
+void UModularBuildSystemMeshList::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+	if (UModularBuildSystemMeshList* This = CastChecked<UModularBuildSystemMeshList>(InThis); This->Lookup.IsSet())
+	{
+		This->Lookup->AddReferencedObjects(Collector);
+	}
+}
+
+#if WITH_EDITOR
+void UModularBuildSystemMeshList::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateLookup();
+}
+
+void UModularBuildSystemMeshList::PostEditUndo()
+{
+	Super::PostEditUndo();
+	InvalidateLookup();
 }
+#endif
@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSBuildSystemRegistry.h"
+
+#include "ModularBuildSystem.h"
+#include "ModularBuildSystemActor.h"
+
+UMBSBuildSystemRegistry* UMBSBuildSystemRegistry::Get(const UWorld* InWorld)
+{
+	return InWorld ? InWorld->GetSubsystem<UMBSBuildSystemRegistry>() : nullptr;
+}
+
+void UMBSBuildSystemRegistry::Deinitialize()
+{
+	Entries.Empty();
+	CountByClass.Empty();
+	MergedCount = 0;
+
+	Super::Deinitialize();
+}
+
+void UMBSBuildSystemRegistry::Register(AModularBuildSystemActor* InBuildSystem)
+{
+	if (!InBuildSystem || Entries.Contains(InBuildSystem))
+	{
+		return;
+	}
+
+	FEntry& NewEntry = Entries.Add(InBuildSystem);
+	NewEntry.BuildSystem = InBuildSystem;
+	NewEntry.Class = InBuildSystem->GetClass();
+	NewEntry.bMerged = InBuildSystem->IsMerged();
+
+	CountByClass.FindOrAdd(NewEntry.Class)++;
+	MergedCount += NewEntry.bMerged ? 1 : 0;
+
+	UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Registered %s (TotalCount=%d)."), *GetName(), *InBuildSystem->GetName(), Entries.Num());
+}
+
+void UMBSBuildSystemRegistry::Unregister(AModularBuildSystemActor* InBuildSystem)
+{
+	FEntry RemovedEntry;
+	if (!Entries.RemoveAndCopyValue(InBuildSystem, RemovedEntry))
+	{
+		return;
+	}
+
+	if (int32* ClassCount = CountByClass.Find(RemovedEntry.Class); ClassCount && --(*ClassCount) <= 0)
+	{
+		CountByClass.Remove(RemovedEntry.Class);
+	}
+	MergedCount -= RemovedEntry.bMerged ? 1 : 0;
+
+	UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Unregistered %s (TotalCount=%d)."), *GetName(), *InBuildSystem->GetName(), Entries.Num());
+}
+
+void UMBSBuildSystemRegistry::UpdateMergeState(AModularBuildSystemActor* InBuildSystem)
+{
+	FEntry* Entry = Entries.Find(InBuildSystem);
+	if (!Entry)
+	{
+		return;
+	}
+
+	const bool bMerged = InBuildSystem->IsMerged();
+	if (Entry->bMerged != bMerged)
+	{
+		Entry->bMerged = bMerged;
+		MergedCount += bMerged ? 1 : -1;
+	}
+}
+
+int32 UMBSBuildSystemRegistry::GetCountOf(TSubclassOf<AModularBuildSystemActor> InClass) const
+{
+	if (!InClass)
+	{
+		return 0;
+	}
+
+	// There are only a few build system classes, so summing up per class counters is cheap
+	int32 OutCount = 0;
+	for (const auto& Pair : CountByClass)
+	{
+		if (const UClass* Class = Pair.Key.Get(); Class && Class->IsChildOf(InClass))
+		{
+			OutCount += Pair.Value;
+		}
+	}
+	return OutCount;
+}
+
+TArray<AModularBuildSystemActor*> UMBSBuildSystemRegistry::GetBuildSystems() const
+{
+	TArray<AModularBuildSystemActor*> OutBuildSystems;
+	OutBuildSystems.Reserve(Entries.Num());
+	for (const auto& Pair : Entries)
+	{
+		if (AModularBuildSystemActor* BuildSystem = Pair.Value.BuildSystem.Get())
+		{
+			OutBuildSystems.Add(BuildSystem);
+		}
+	}
+	return OutBuildSystems;
+}
+
+void UMBSBuildSystemRegistry::ForEachBuildSystem(TFunctionRef<void(AModularBuildSystemActor&)> InFunction) const
+{
+	for (AModularBuildSystemActor* BuildSystem : GetBuildSystems())
+	{
+		if (IsValid(BuildSystem))
+		{
+			InFunction(*BuildSystem);
+		}
+	}
+}
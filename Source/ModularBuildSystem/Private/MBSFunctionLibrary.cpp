@@ -10,6 +10,7 @@
 #include "ModularLevel.h"
 #include "ModularBuildSystem.h"
 #include "ModularBuildSystemActor.h"
+#include "MBSBuildSystemRegistry.h"
 #include "Components/BillboardComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "List/ModularBuildSystemActorList.h"
@@ -48,7 +49,7 @@ void UMBSFunctionLibrary::ScaleSections(const TArray<FModularSection*>& InSectio
 	}
 }
 
-void UMBSFunctionLibrary::ForEachBuildSystem(void (*InFunction)(TActorIterator<AModularBuildSystemActor> It))
+void UMBSFunctionLibrary::ForEachBuildSystem(TFunctionRef<void(AModularBuildSystemActor&)> InFunction)
 {
 	const UWorld* World = GEditor->GetEditorWorldContext().World();
 	if (!World)
@@ -56,10 +57,26 @@ void UMBSFunctionLibrary::ForEachBuildSystem(void (*InFunction)(TActorIterator<A
 		UE_LOG(LogMBS, Error, TEXT("World was nullptr!"));
 		return;
 	}
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
+	{
+		InFunction(*BuildSystem);
+	}
+}
+
+TArray<AModularBuildSystemActor*> UMBSFunctionLibrary::GetAllBuildSystems(const UWorld* World)
+{
+	if (const UMBSBuildSystemRegistry* Registry = UMBSBuildSystemRegistry::Get(World))
+	{
+		return Registry->GetBuildSystems();
+	}
+
+	// Registry is not created for some world types (e.g. editor previews), so iterating actors is the only option there
+	TArray<AModularBuildSystemActor*> OutBuildSystems;
 	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
 	{
-		InFunction(It);
+		OutBuildSystems.Add(*It);
 	}
+	return OutBuildSystems;
 }
 
 void UMBSFunctionLibrary::ForEachLevel(const TArray<FModularLevel*>& InLevels,
@@ -240,11 +257,11 @@ void UMBSFunctionLibrary::FixAllBuildSystemsTransform(const UWorld* World)
 	UE_LOG(LogMBS, Warning, TEXT("=== Fixing all build systems transforms ==="));
 	int32 Count = 0;
 
-	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
 	{
-		UE_LOG(LogMBS, Log, TEXT("[Index=%d] Fixing modular sections transforms of %s build system."), Count, *It->GetName());
-		It->FixModularSectionsTransform();
-		UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s modular section transforms has been fixed."), Count, *It->GetName());
+		UE_LOG(LogMBS, Log, TEXT("[Index=%d] Fixing modular sections transforms of %s build system."), Count, *BuildSystem->GetName());
+		BuildSystem->FixModularSectionsTransform();
+		UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s modular section transforms has been fixed."), Count, *BuildSystem->GetName());
 		Count++;
 	}
 	UE_LOG(LogMBS, Warning, TEXT("=== All [TotalCount=%d] build systems transforms were fixed ==="), Count);
@@ -254,17 +271,17 @@ void UMBSFunctionLibrary::AllToBuildModeOn(const UWorld* World)
 {
 	check(World);
 	UE_LOG(LogMBS, Warning, TEXT("Setting all build systems bBuildModeIsActivated to true."));
-	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
 	{
-		if (!It->IsBuildModeActivated())
+		if (!BuildSystem->IsBuildModeActivated())
 		{
-			UE_LOG(LogMBS, Log, TEXT("%s had bBuildModeIsActivated == false"), *It->GetName());
-			It->SetBuildModeActivated(true);
-			UE_LOG(LogMBS, Log, TEXT("Set bBuildModeIsActivated of %s to true."), *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("%s had bBuildModeIsActivated == false"), *BuildSystem->GetName());
+			BuildSystem->SetBuildModeActivated(true);
+			UE_LOG(LogMBS, Log, TEXT("Set bBuildModeIsActivated of %s to true."), *BuildSystem->GetName());
 		}
 		else
 		{
-			UE_LOG(LogMBS, Log, TEXT("bBuildModeIsActivated of %s is already true."), *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("bBuildModeIsActivated of %s is already true."), *BuildSystem->GetName());
 		}
 	}
 	UE_LOG(LogMBS, Warning, TEXT("End AllToBuildModeOn."));
@@ -274,17 +291,17 @@ void UMBSFunctionLibrary::AllToBuildModeOff(const UWorld* World)
 {
 	check(World);
 	UE_LOG(LogMBS, Warning, TEXT("Setting all build systems bBuildModeIsActivated to false."));
-	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
 	{
-		if (It->IsBuildModeActivated())
+		if (BuildSystem->IsBuildModeActivated())
 		{
-			UE_LOG(LogMBS, Log, TEXT("%s had bBuildModeIsActivated == true"), *It->GetName());
-			It->SetBuildModeActivated(false);
-			UE_LOG(LogMBS, Log, TEXT("Set bBuildModeIsActivated of %s to false."), *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("%s had bBuildModeIsActivated == true"), *BuildSystem->GetName());
+			BuildSystem->SetBuildModeActivated(false);
+			UE_LOG(LogMBS, Log, TEXT("Set bBuildModeIsActivated of %s to false."), *BuildSystem->GetName());
 		}
 		else
 		{
-			UE_LOG(LogMBS, Log, TEXT("bBuildModeIsActivated of %s is already false."), *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("bBuildModeIsActivated of %s is already false."), *BuildSystem->GetName());
 		}
 	}
 	UE_LOG(LogMBS, Warning, TEXT("End AllToBuildModeOff."));
@@ -294,17 +311,17 @@ void UMBSFunctionLibrary::AllToSectionReloadModeNone(const UWorld* World)
 {
 	check(World);
 	UE_LOG(LogMBS, Warning, TEXT("Setting all build systems ReloadMode to None."));
-	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
 	{
-		if (It->GetReloadMode() != EModularSectionReloadMode::None)
+		if (BuildSystem->GetReloadMode() != EModularSectionReloadMode::None)
 		{
-			UE_LOG(LogMBS, Log, TEXT("%s had ReloadMode != EModularSectionReloadMode::None"), *It->GetName());
-			It->SetReloadMode(EModularSectionReloadMode::None);
-			UE_LOG(LogMBS, Log, TEXT("Set ReloadMode of %s to None."), *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("%s had ReloadMode != EModularSectionReloadMode::None"), *BuildSystem->GetName());
+			BuildSystem->SetReloadMode(EModularSectionReloadMode::None);
+			UE_LOG(LogMBS, Log, TEXT("Set ReloadMode of %s to None."), *BuildSystem->GetName());
 		}
 		else
 		{
-			UE_LOG(LogMBS, Log, TEXT("ReloadMode of %s is already None."), *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("ReloadMode of %s is already None."), *BuildSystem->GetName());
 		}
 	}
 	UE_LOG(LogMBS, Warning, TEXT("End AllToSectionReloadModeNone."));
@@ -317,13 +334,13 @@ void UMBSFunctionLibrary::RegenerateAllBuildSystems(const UWorld* World)
 	UE_LOG(LogMBS, Warning, TEXT("=== Regenerating all build systems that have generators ==="));
 	int32 Count = 0;
 
-	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
 	{
-		if (UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(It->GetGenerator().GetObject()))
+		if (UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(BuildSystem->GetGenerator().GetObject()))
 		{
-			UE_LOG(LogMBS, Log, TEXT("[Index=%d] Regenerating %s build system."), Count, *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("[Index=%d] Regenerating %s build system."), Count, *BuildSystem->GetName());
 			IBuildingGeneratorInterface::Execute_Generate(Generator);
-			UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s has been regenerated."), Count, *It->GetName());
+			UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s has been regenerated."), Count, *BuildSystem->GetName());
 			Count++;
 		}
 	}
@@ -337,11 +354,11 @@ void UMBSFunctionLibrary::MergeAllBuildSystems(const UWorld* World)
 	UE_LOG(LogMBS, Warning, TEXT("=== Merging all build systems ==="));
 	int32 Count = 0;
 
-	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
 	{
-		UE_LOG(LogMBS, Log, TEXT("[Index=%d] Merging %s build system."), Count, *It->GetName());
-		It->MergeIntoStaticMesh();
-		UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s has been merged."), Count, *It->GetName());
+		UE_LOG(LogMBS, Log, TEXT("[Index=%d] Merging %s build system."), Count, *BuildSystem->GetName());
+		BuildSystem->MergeIntoStaticMesh();
+		UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s has been merged."), Count, *BuildSystem->GetName());
 		Count++;
 	}
 	UE_LOG(LogMBS, Warning, TEXT("=== All [TotalCount=%d] build systems were merged ==="), Count);
@@ -354,11 +371,11 @@ void UMBSFunctionLibrary::UnmergeAllBuildSystems(const UWorld* World)
 	UE_LOG(LogMBS, Warning, TEXT("=== Unmerging all build systems ==="));
 	int32 Count = 0;
 
-	for (TActorIterator<AModularBuildSystemActor> It(World); It; ++It)
+	for (AModularBuildSystemActor* BuildSystem : GetAllBuildSystems(World))
 	{
-		UE_LOG(LogMBS, Log, TEXT("[Index=%d] Unmerging %s build system into modular sections."), Count, *It->GetName());
-		It->UnmergeIntoModularSections();
-		UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s has been unmerged back into modular sections."), Count, *It->GetName());
+		UE_LOG(LogMBS, Log, TEXT("[Index=%d] Unmerging %s build system into modular sections."), Count, *BuildSystem->GetName());
+		BuildSystem->UnmergeIntoModularSections();
+		UE_LOG(LogMBS, Log, TEXT("[Index=%d] %s has been unmerged back into modular sections."), Count, *BuildSystem->GetName());
 		Count++;
 	}
 	UE_LOG(LogMBS, Warning, TEXT("=== All [TotalCount=%d] build systems were unmerged ==="), Count);
@@ -376,6 +393,21 @@ FTransform UMBSFunctionLibrary::CalculateNewTransform(AModularBuildSystemActor*
 		->GetNextTransform(ActorTransform, InIndex, Args.Initializer.GetMaxInRow(), Args.Initializer.GetTotalCount(),
 			Args.InLevelZMultiplier, BuildStats, Args.InSolver, Args.InPreviousLevelResolution);
 
+	ShapeNewTransform(BuildSystem, BuildStats, InIndex, Args, NewTransform, bOutShouldBeSkipped);
+	return NewTransform;
+}
+
+void UMBSFunctionLibrary::CalculateNewTransforms(const FModularBuildStats& BuildStats, const FTransform& ActorTransform,
+	const FInitModularSectionsArgs& Args, TArray<FTransform>& OutTransforms)
+{
+	Args.Initializer.GetResolution()->GetNextTransforms(ActorTransform, Args.Initializer.GetTotalCount(),
+		Args.Initializer.GetMaxInRow(), Args.Initializer.GetTotalCount(), Args.InLevelZMultiplier, BuildStats,
+		Args.InSolver, Args.InPreviousLevelResolution, OutTransforms);
+}
+
+void UMBSFunctionLibrary::ShapeNewTransform(AModularBuildSystemActor* BuildSystem, const FModularBuildStats& BuildStats,
+	int32 InIndex, const FInitModularSectionsArgs& Args, FTransform& InOutTransform, bool& bOutShouldBeSkipped)
+{
 	// Adjust calculated transform depend on shape of a level if provided
 	if (Args.InShape)
 	{
@@ -388,11 +420,9 @@ FTransform UMBSFunctionLibrary::CalculateNewTransform(AModularBuildSystemActor*
 				&Args.Initializer,
 				BuildSystem,
 				Args.InLevelId,
-				&NewTransform,
+				&InOutTransform,
 				&bOutShouldBeSkipped));
 	}
-
-	return NewTransform;
 }
 
 FBox UMBSFunctionLibrary::GetModularLevelInteriorBox(const AModularBuildSystemActor* BuildSystem, const FModularLevel* InLevel)
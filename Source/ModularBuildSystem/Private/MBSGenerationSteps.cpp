@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSGenerationSteps.h"
+
+#include "ModularBuildSystem.h"
+
+void FMBSGenerationSteps::Add(const FName& InName, TFunction<void()> InFunction)
+{
+	AddResumable(InName, [Function = MoveTemp(InFunction)]
+	{
+		Function();
+		return EMBSGenerationStepResult::Finished;
+	});
+}
+
+void FMBSGenerationSteps::AddResumable(const FName& InName, TFunction<EMBSGenerationStepResult()> InFunction)
+{
+	check(InFunction);
+	Steps.Add({InName, MoveTemp(InFunction)});
+}
+
+bool FMBSGenerationSteps::Advance(double InBudgetSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	bool bExecutedAny = false;
+
+	while (!IsDone())
+	{
+		if (InBudgetSeconds > 0.0 && bExecutedAny && FPlatformTime::Seconds() - StartTime >= InBudgetSeconds)
+		{
+			break;
+		}
+
+		const FMBSGenerationStep& Step = Steps[CurrentIndex];
+		UE_LOG(LogGenerator, VeryVerbose, TEXT("Executing generation step %s (%d/%d)"), *Step.Name.ToString(),
+			CurrentIndex + 1, Steps.Num());
+
+		switch (Step.Function())
+		{
+		case EMBSGenerationStepResult::Finished:
+			CurrentIndex++;
+			break;
+		case EMBSGenerationStepResult::Failed:
+			UE_LOG(LogGenerator, Warning, TEXT("Generation step %s has failed. Skipping %d remaining steps."),
+				*Step.Name.ToString(), Steps.Num() - CurrentIndex - 1);
+			bFailed = true;
+			break;
+		default:
+			break;
+		}
+		bExecutedAny = true;
+	}
+	return IsDone();
+}
+
+bool FMBSGenerationSteps::RunToCompletion()
+{
+	Advance(0.0);
+	return !bFailed;
+}
+
+void FMBSGenerationSteps::Reset()
+{
+	Steps.Reset();
+	CurrentIndex = 0;
+	bFailed = false;
+}
@@ -24,7 +24,20 @@ UStaticMesh* FMBSGeneratorPropertyData::GetMesh(int32 AtIndex, UModularSectionRe
 			*DebugPropertyName.ToString(), bUseActorList ? TEXT("true") : TEXT("false"));
 		return nullptr;
 	}
-	return MeshList->GetMesh(AtIndex, OverrideResolution ? OverrideResolution : Resolution);
+	if (bAlwaysPickRandom)
+	{
+		return GetRandomMesh(OverrideResolution);
+	}
+	UModularSectionResolution* ChosenResolution = OverrideResolution ? OverrideResolution : Resolution;
+	const UModularBuildSystemMeshList::FLookup& Lookup = MeshList->GetLookup();
+	if (UStaticMesh* const* Mesh = Lookup.Find(MeshResolutionId.Get(Lookup, ChosenResolution), AtIndex))
+	{
+		return *Mesh;
+	}
+	UE_LOG(LogMBSProperty, Error, TEXT("%s.GetMesh found no mesh at index %d of resolution %s in %s"),
+		*DebugPropertyName.ToString(), AtIndex, ChosenResolution ? *ChosenResolution->GetName() : TEXT("nullptr"),
+		*MeshList->GetName());
+	return nullptr;
 }
 
 UStaticMesh* FMBSGeneratorPropertyData::GetRandomMesh(UModularSectionResolution* OverrideResolution) const
@@ -36,8 +49,15 @@ UStaticMesh* FMBSGeneratorPropertyData::GetRandomMesh(UModularSectionResolution*
 			*DebugPropertyName.ToString(), bUseActorList ? TEXT("true") : TEXT("false"));
 		return nullptr;
 	}
-	const int32 Index = FMath::RandRange(0, MeshList->GetMaxIndex(ChosenResolution));
-	return MeshList->GetMesh(Index, ChosenResolution);
+	const UModularBuildSystemMeshList::FLookup& Lookup = MeshList->GetLookup();
+	if (UStaticMesh* const* Mesh = Lookup.FindRandom(MeshResolutionId.Get(Lookup, ChosenResolution)))
+	{
+		return *Mesh;
+	}
+	UE_LOG(LogMBSProperty, Error, TEXT("%s.GetRandomMesh found no meshes of resolution %s in %s"),
+		*DebugPropertyName.ToString(), ChosenResolution ? *ChosenResolution->GetName() : TEXT("nullptr"),
+		*MeshList->GetName());
+	return nullptr;
 }
 
 TSubclassOf<AActor> FMBSGeneratorPropertyData::GetActorClass(int32 AtIndex, UModularSectionResolution* OverrideResolution) const
@@ -48,7 +68,20 @@ TSubclassOf<AActor> FMBSGeneratorPropertyData::GetActorClass(int32 AtIndex, UMod
 			*DebugPropertyName.ToString(), bUseActorList ? TEXT("true") : TEXT("false"));
 		return {};
 	}
-	return ActorList->GetActorClass(AtIndex, OverrideResolution ? OverrideResolution : Resolution);
+	if (bAlwaysPickRandom)
+	{
+		return GetRandomActorClass(OverrideResolution);
+	}
+	UModularSectionResolution* ChosenResolution = OverrideResolution ? OverrideResolution : Resolution;
+	const UModularBuildSystemActorList::FLookup& Lookup = ActorList->GetLookup();
+	if (UClass* const* ActorClass = Lookup.Find(ActorResolutionId.Get(Lookup, ChosenResolution), AtIndex))
+	{
+		return *ActorClass;
+	}
+	UE_LOG(LogGenerator, Error, TEXT("%s.GetActorClass() found no actor class at index %d of resolution %s in %s"),
+		*DebugPropertyName.ToString(), AtIndex, ChosenResolution ? *ChosenResolution->GetName() : TEXT("nullptr"),
+		*ActorList->GetName());
+	return {};
 }
 
 TSubclassOf<AActor> FMBSGeneratorPropertyData::GetRandomActorClass(UModularSectionResolution* OverrideResolution) const
@@ -60,13 +93,20 @@ TSubclassOf<AActor> FMBSGeneratorPropertyData::GetRandomActorClass(UModularSecti
 		return {};
 	}
 	UModularSectionResolution* ChosenResolution = OverrideResolution ? OverrideResolution : Resolution;
-	const int32 Index = FMath::RandRange(0, ActorList->GetMaxIndex(ChosenResolution));
-	return ActorList->GetActorClass(Index, ChosenResolution);
+	const UModularBuildSystemActorList::FLookup& Lookup = ActorList->GetLookup();
+	if (UClass* const* ActorClass = Lookup.FindRandom(ActorResolutionId.Get(Lookup, ChosenResolution)))
+	{
+		return *ActorClass;
+	}
+	UE_LOG(LogGenerator, Error, TEXT("%s.GetRandomActorClass() found no actor classes of resolution %s in %s"),
+		*DebugPropertyName.ToString(), ChosenResolution ? *ChosenResolution->GetName() : TEXT("nullptr"),
+		*ActorList->GetName());
+	return {};
 }
 
 int32 FMBSGeneratorPropertyData::GetIndex(const FMBSIndexCalculationArgs& Args, int32 Default) const
 {
-	return IndexCalculation ? IndexCalculation->CalculateSingle(Args) : Default;
+	return UMBSIndexCalculation::CalculateSingleOrDefault(IndexCalculation, Args, Default);
 }
 
 bool FMBSGeneratorPropertyData::IsSet() const
@@ -10,6 +10,14 @@ namespace
 	constexpr float GDss = UModularSectionResolution::DefaultSectionSize;
 }
 
+MBS::FGridCellKey::FGridCellKey(int32 X, int32 Y, int32 Z)
+{
+	checkSlow(X >= MinIndex && X <= MaxIndex && Y >= MinIndex && Y <= MaxIndex && Z >= MinIndex && Z <= MaxIndex);
+	Packed = (static_cast<uint64>(X - MinIndex) & AxisMask)
+		| (static_cast<uint64>(Y - MinIndex) & AxisMask) << BitsPerAxis
+		| (static_cast<uint64>(Z - MinIndex) & AxisMask) << BitsPerAxis * 2;
+}
+
 FVector MBS::FGridCellBase::BottomLeftRelative() const
 {
 	return Relative(BottomLeft());
@@ -53,7 +61,7 @@ int32 MBS::FGridCellBase::SecX(float V) const
 	Multiplier.X,
 	FMath::RoundToInt(V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * Multiplier.X) : 0),
 	V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * Multiplier.X) : 0);*/
-	return FMath::RoundToInt(V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * Multiplier.X) : 0);
+	return SecRounded(V, Multiplier.X);
 }
 
 int32 MBS::FGridCellBase::SecY(float V) const
@@ -64,12 +72,12 @@ int32 MBS::FGridCellBase::SecY(float V) const
 		Multiplier.Y,
 		FMath::RoundToInt(V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * Multiplier.Y) : 0),
 		V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * Multiplier.Y) : 0);*/
-	return FMath::RoundToInt(V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * Multiplier.Y) : 0);
+	return SecRounded(V, Multiplier.Y);
 }
 
 int32 MBS::FGridCellBase::SecZ(float V) const
 {
-	return V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * Multiplier.Z) : 0;
+	return Sec(V, Multiplier.Z);
 }
 
 int32 MBS::FGridCellBase::Sec(float V, const float InMultiplierComponent)
@@ -77,6 +85,11 @@ int32 MBS::FGridCellBase::Sec(float V, const float InMultiplierComponent)
 	return V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * InMultiplierComponent) : 0;
 }
 
+int32 MBS::FGridCellBase::SecRounded(float V, const float InMultiplierComponent)
+{
+	return FMath::RoundToInt(V != 0 ? V / (UModularSectionResolution::DefaultSectionSize * InMultiplierComponent) : 0);
+}
+
 FVector MBS::FGridCellBase::Relative(const FVector V) const
 {
 	return V + RelativePivot;
@@ -185,6 +198,16 @@ FIntVector MBS::FGridCell3D::GetIndexXYZ() const
 	return FIntVector(SecX(Min.X), SecY(Min.Y), SecZ(Min.Z));
 }
 
+MBS::FGridCellKey MBS::FGridCell3D::GetKeyAt(const FVector V, const FTransform& RelativeTo, const FVector InMultiplier)
+{
+	// Same as the index of the cell constructed relative to RelativeTo at V
+	const FVector Min = FTransform(V).GetRelativeTransform(RelativeTo).GetLocation();
+	return FGridCellKey(
+		SecRounded(Min.X, InMultiplier.X),
+		SecRounded(Min.Y, InMultiplier.Y),
+		Sec(Min.Z, InMultiplier.Z));
+}
+
 MBS::FGridCell3D::FGridCell3D(int32 XIndex, int32 YIndex, int32 ZIndex, bool bFlatten)
 {
 	const FVector Min(MulX(XIndex), MulY(YIndex), MulZ(ZIndex));
@@ -274,7 +297,7 @@ MBS::FGridCell3D::FGridCell3D(int32 XIndex, int32 YIndex, int32 ZIndex, const FT
 	this->bRelative = true;
 }
 
-MBS::FGridMultiCell2D::FGridMultiCell2D(TArray<FGridCell2D> GridCells)
+MBS::FGridMultiCell2D::FGridMultiCell2D(TConstArrayView<FGridCell2D> GridCells)
 {
 	BoundsBoxes.Reserve(GridCells.Num());
 	for (const auto& Cell : GridCells)
@@ -312,7 +335,7 @@ MBS::FGridMultiCell2D::FGridMultiCell2D(const FBox& Bounds, const FTransform& Re
 	}
 }
 
-MBS::FGridMultiCell3D::FGridMultiCell3D(TArray<FGridCell3D> GridCells)
+MBS::FGridMultiCell3D::FGridMultiCell3D(TConstArrayView<FGridCell3D> GridCells)
 {
 	BoundsBoxes.Reserve(GridCells.Num());
 	for (const auto& Cell : GridCells)
@@ -14,41 +14,147 @@ void UMBSIndexCalculation::BreakIndexCalculationArgs(const FMBSIndexCalculationA
 	OccupiedIndices = *InArgs.OccupiedIndices;
 }
 
+int32 UMBSIndexCalculation::CalculateSingleOrDefault(UMBSIndexCalculation* InCalculation,
+	const FMBSIndexCalculationArgs& Args, int32 InDefault)
+{
+	if (!InCalculation)
+	{
+		return InDefault;
+	}
+
+	if (IsInGameThread())
+	{
+		return InCalculation->CalculateSingle(Args);
+	}
+
+	// Native implementation is called directly, as events can't be processed outside of the game thread
+	checkf(IsThreadSafe(InCalculation), TEXT("%s: Blueprint index calculation can't be used outside of the game thread."),
+		*InCalculation->GetName());
+	return InCalculation->CalculateSingle_Implementation(Args);
+}
+
+bool UMBSIndexCalculation::IsThreadSafe(const UMBSIndexCalculation* InCalculation)
+{
+	return !InCalculation || InCalculation->GetClass()->HasAnyClassFlags(CLASS_Native);
+}
+
 int32 UMBSIndexCalculation::AdjustIndexIfPossible_Implementation(int32& Index, int32 TotalCount,
 	const TArray<int32>& OccupiedIndices)
 {
-	const int32 InitialIndex = Index;
-	for (int32 i = 0; i < MaxAdjustIterationCount; i++)
-	{
-		if (OccupiedIndices.Contains(Index))
-		{
-			if (Index + 1 < TotalCount)
-			{
-				Index++;
-			}
-			else
-			{
-				Index = 0;
-			}
-		}
-		else
-		{
-#if WITH_EDITOR
-			if (MaxAdjustIterationCount == 0)
-			{
-				UE_LOG(LogMBSIndexCalculation, VeryVerbose, TEXT("%s: Index=%d is already valid and should not be adjusted."),
-					*GetName(), Index);
-			}
-			else
-			{
-				UE_LOG(LogMBSIndexCalculation, Verbose, TEXT("%s: Index=%d (Initial=%d) has been adjusted (It=%d)."),
-					*GetName(), Index, InitialIndex, i);
-			}
-#endif			
-			return Index;
-		}
-	}
-	UE_LOG(LogMBSIndexCalculation, Error, TEXT("%s: Index=%d (Initial=%d) can't be adjusted."),
-		*GetName(), Index, InitialIndex);
+	return AdjustIndex(Index, FMBSOccupiedIndices(TotalCount, OccupiedIndices));
+}
+
+int32 UMBSIndexCalculation::AdjustIndexIfPossible(const FMBSIndexCalculationArgs& Args, int32& Index,
+	int32 TotalCount) const
+{
+	return WithOccupied(Args, TotalCount, [this, &Index](const FMBSOccupiedIndices& Occupied)
+	{
+		return AdjustIndex(Index, Occupied);
+	});
+}
+
+int32 UMBSIndexCalculation::AdjustIndex(int32& Index, const FMBSOccupiedIndices& Occupied) const
+{
+	if (!Occupied.IsOccupied(Index))
+	{
+		UE_LOG(LogMBSIndexCalculation, VeryVerbose, TEXT("%s: Index=%d is already valid and should not be adjusted."),
+			*GetName(), Index);
+		return Index;
+	}
+
+	const int32 FreeIndex = Occupied.FindNextFree(Index);
+	if (FreeIndex == INDEX_NONE)
+	{
+		UE_LOG(LogMBSIndexCalculation, Error, TEXT("%s: Index=%d can't be adjusted, all %d indices are occupied."),
+			*GetName(), Index, Occupied.Num());
+		return Index;
+	}
+	
+	UE_LOG(LogMBSIndexCalculation, Verbose, TEXT("%s: Index=%d (Initial=%d) has been adjusted."),
+		*GetName(), FreeIndex, Index);
+	Index = FreeIndex;
+	return Index;
+}
+
+int32 UMBSIndexCalculation::GetRandomFreeIndex(int32 TotalCount, const TArray<int32>& OccupiedIndices) const
+{
+	return FMBSOccupiedIndices(TotalCount, OccupiedIndices).PickRandomFree();
+}
+
+int32 UMBSIndexCalculation::GetRandomFreeIndex(const FMBSIndexCalculationArgs& Args, int32 TotalCount)
+{
+	return WithOccupied(Args, TotalCount, [&Args](const FMBSOccupiedIndices& Occupied)
+	{
+		return Args.RandomStream ? Occupied.PickRandomFree(*Args.RandomStream) : Occupied.PickRandomFree();
+	});
+}
+
+FMBSOccupiedIndices::FMBSOccupiedIndices(int32 InCount)
+	: Bits(false, FMath::Max(InCount, 0))
+{
+}
+
+FMBSOccupiedIndices::FMBSOccupiedIndices(int32 InCount, TConstArrayView<int32> InIndices)
+	: FMBSOccupiedIndices(InCount)
+{
+	for (const int32 Index : InIndices)
+	{
+		Occupy(Index);
+	}
+}
+
+void FMBSOccupiedIndices::Occupy(int32 Index)
+{
+	if (Bits.IsValidIndex(Index) && !Bits[Index])
+	{
+		Bits[Index] = true;
+		OccupiedCount++;
+	}
+}
+
+void FMBSOccupiedIndices::Free(int32 Index)
+{
+	if (Bits.IsValidIndex(Index) && Bits[Index])
+	{
+		Bits[Index] = false;
+		OccupiedCount--;
+	}
+}
+
+int32 FMBSOccupiedIndices::FindNextFree(int32 Index) const
+{
+	if (GetFreeCount() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 StartIndex = Bits.IsValidIndex(Index) ? Index : 0;
+	const int32 FreeIndex = Bits.FindFrom(false, StartIndex);
+	
+	// Any free index before the start index, as there are no free indices after it
+	return FreeIndex != INDEX_NONE ? FreeIndex : Bits.Find(false);
+}
+
+int32 FMBSOccupiedIndices::PickRandomFree(const FRandomStream& Stream) const
+{
+	const int32 FreeCount = GetFreeCount();
+	return FreeCount > 0 ? PickFree(Stream.RandRange(0, FreeCount - 1)) : INDEX_NONE;
+}
+
+int32 FMBSOccupiedIndices::PickRandomFree() const
+{
+	check(IsInGameThread());
+	const int32 FreeCount = GetFreeCount();
+	return FreeCount > 0 ? PickFree(FMath::RandRange(0, FreeCount - 1)) : INDEX_NONE;
+}
+
+int32 FMBSOccupiedIndices::PickFree(int32 FreeIndex) const
+{
+	// FreeIndex-th unset bit
+	int32 Index = Bits.Find(false);
+	for (int32 i = 0; i < FreeIndex && Index != INDEX_NONE; i++)
+	{
+		Index = Bits.FindFrom(false, Index + 1);
+	}
 	return Index;
 }
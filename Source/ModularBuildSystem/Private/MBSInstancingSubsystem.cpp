@@ -0,0 +1,352 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSInstancingSubsystem.h"
+
+#include "MBSSections.h"
+#include "ModularBuildSystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Config/MBSSettings.h"
+
+void UMBSInstancingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (const UMBSSettings* Settings = GetDefault<UMBSSettings>())
+	{
+		ChunkSize = FMath::Max(Settings->SharedInstancingChunkSize, 100.f);
+	}
+}
+
+void UMBSInstancingSubsystem::Deinitialize()
+{
+	Chunks.Empty();
+	ChunksByHandle.Empty();
+
+	if (IsValid(HostActor))
+	{
+		HostActor->Destroy();
+	}
+	HostActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UMBSInstancingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	Flush();
+}
+
+TStatId UMBSInstancingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMBSInstancingSubsystem, STATGROUP_Tickables);
+}
+
+FMBSSharedInstancesHandle UMBSInstancingSubsystem::CreateHandle()
+{
+	FMBSSharedInstancesHandle NewHandle;
+	NewHandle.Id = NextHandleId++;
+	ChunksByHandle.Add(NewHandle.Id);
+	return NewHandle;
+}
+
+void UMBSInstancingSubsystem::SetInstances(const FMBSSharedInstancesHandle& InHandle, UStaticMesh* InMesh,
+	UMaterialInterface* InMaterial, const TArray<FTransform>& InWorldTransforms)
+{
+	if (!InHandle.IsValid() || !InMesh)
+	{
+		UE_LOG(LogMBS, Error, TEXT("Can't set shared instances. Handle or mesh is invalid (HandleId=%d, Mesh=%s)."),
+			InHandle.Id, InMesh ? *InMesh->GetName() : TEXT("nullptr"));
+		return;
+	}
+
+	RemoveInstancesOfMesh(InHandle.Id, InMesh, InMaterial);
+
+	TSet<FMBSSharedInstancesChunkKey>& HandleChunks = ChunksByHandle.FindOrAdd(InHandle.Id);
+	for (const FTransform& Transform : InWorldTransforms)
+	{
+		const FMBSSharedInstancesChunkKey Key = MakeChunkKey(InMesh, InMaterial, Transform.GetLocation());
+		FMBSSharedInstancesChunk& Chunk = Chunks.FindOrAdd(Key);
+		Chunk.Mesh = InMesh;
+		Chunk.Material = InMaterial;
+		Chunk.InstancesByHandle.FindOrAdd(InHandle.Id).Add(Transform);
+		Chunk.DirtyHandles.Add(InHandle.Id);
+		HandleChunks.Add(Key);
+	}
+}
+
+void UMBSInstancingSubsystem::SetInstancesFromSections(const FMBSSharedInstancesHandle& InHandle, const FMBSSections& InSections)
+{
+	RemoveInstances(InHandle);
+
+	// Group world transforms of all instanced sections by mesh and material, so each pair is set only once
+	TMap<TPair<UStaticMesh*, UMaterialInterface*>, TArray<FTransform>> TransformsByMesh;
+	for (const FModularSectionInstanced& Section : InSections.GetInstanced())
+	{
+		const UInstancedStaticMeshComponent* Component = Section.GetISMC();
+		if (!Section.IsValid() || !Component->GetStaticMesh())
+		{
+			continue;
+		}
+
+		TArray<FTransform>& Transforms = TransformsByMesh.FindOrAdd({Component->GetStaticMesh(), Component->GetMaterial(0)});
+		const int32 Count = Section.GetInstanceCount();
+		Transforms.Reserve(Transforms.Num() + Count);
+		for (int32 i = 0; i < Count; i++)
+		{
+			FTransform InstanceTransform;
+			// Hidden instances are scaled to zero and are not shared
+			if (Component->GetInstanceTransform(Section.ToComponentIndex(i), InstanceTransform, true)
+				&& !InstanceTransform.GetScale3D().IsNearlyZero())
+			{
+				Transforms.Add(InstanceTransform);
+			}
+		}
+	}
+
+	for (const auto& Pair : TransformsByMesh)
+	{
+		SetInstances(InHandle, Pair.Key.Key, Pair.Key.Value, Pair.Value);
+	}
+}
+
+void UMBSInstancingSubsystem::RemoveInstances(const FMBSSharedInstancesHandle& InHandle)
+{
+	TSet<FMBSSharedInstancesChunkKey>* HandleChunks = ChunksByHandle.Find(InHandle.Id);
+	if (!HandleChunks)
+	{
+		return;
+	}
+
+	for (const FMBSSharedInstancesChunkKey& Key : *HandleChunks)
+	{
+		if (FMBSSharedInstancesChunk* Chunk = Chunks.Find(Key); Chunk && Chunk->InstancesByHandle.Remove(InHandle.Id) > 0)
+		{
+			Chunk->DirtyHandles.Add(InHandle.Id);
+		}
+	}
+	HandleChunks->Empty();
+}
+
+void UMBSInstancingSubsystem::ReleaseHandle(FMBSSharedInstancesHandle& InOutHandle)
+{
+	RemoveInstances(InOutHandle);
+	ChunksByHandle.Remove(InOutHandle.Id);
+	InOutHandle.Invalidate();
+}
+
+void UMBSInstancingSubsystem::Flush()
+{
+	for (auto It = Chunks.CreateIterator(); It; ++It)
+	{
+		FMBSSharedInstancesChunk& Chunk = It.Value();
+		if (Chunk.DirtyHandles.IsEmpty())
+		{
+			continue;
+		}
+
+		if (Chunk.InstancesByHandle.IsEmpty())
+		{
+			if (UHierarchicalInstancedStaticMeshComponent* Component = Chunk.Component.Get())
+			{
+				Component->DestroyComponent();
+			}
+			It.RemoveCurrent();
+			continue;
+		}
+
+		RebuildChunk(Chunk);
+	}
+}
+
+int32 UMBSInstancingSubsystem::GetInstanceCount() const
+{
+	int32 OutCount = 0;
+	for (const auto& Pair : Chunks)
+	{
+		for (const auto& HandleInstances : Pair.Value.InstancesByHandle)
+		{
+			OutCount += HandleInstances.Value.Num();
+		}
+	}
+	return OutCount;
+}
+
+const FMBSSharedInstancesChunk* UMBSInstancingSubsystem::FindChunk(UStaticMesh* InMesh, UMaterialInterface* InMaterial,
+	const FVector& InLocation) const
+{
+	return Chunks.Find(MakeChunkKey(InMesh, InMaterial, InLocation));
+}
+
+FMBSSharedInstancesChunkKey UMBSInstancingSubsystem::MakeChunkKey(UStaticMesh* InMesh, UMaterialInterface* InMaterial,
+	const FVector& InLocation) const
+{
+	FMBSSharedInstancesChunkKey OutKey;
+	OutKey.Mesh = InMesh;
+	OutKey.Material = InMaterial;
+	OutKey.Cell = FIntPoint(FMath::FloorToInt(InLocation.X / ChunkSize), FMath::FloorToInt(InLocation.Y / ChunkSize));
+	return OutKey;
+}
+
+void UMBSInstancingSubsystem::RemoveInstancesOfMesh(int32 InHandleId, UStaticMesh* InMesh, UMaterialInterface* InMaterial)
+{
+	TSet<FMBSSharedInstancesChunkKey>* HandleChunks = ChunksByHandle.Find(InHandleId);
+	if (!HandleChunks)
+	{
+		return;
+	}
+
+	const TObjectKey<UStaticMesh> MeshKey(InMesh);
+	const TObjectKey<UMaterialInterface> MaterialKey(InMaterial);
+	for (auto It = HandleChunks->CreateIterator(); It; ++It)
+	{
+		if (It->Mesh != MeshKey || It->Material != MaterialKey)
+		{
+			continue;
+		}
+
+		if (FMBSSharedInstancesChunk* Chunk = Chunks.Find(*It); Chunk && Chunk->InstancesByHandle.Remove(InHandleId) > 0)
+		{
+			Chunk->DirtyHandles.Add(InHandleId);
+		}
+		It.RemoveCurrent();
+	}
+}
+
+void UMBSInstancingSubsystem::RebuildChunk(FMBSSharedInstancesChunk& InChunk)
+{
+	TSet<int32> DirtyHandles = MoveTemp(InChunk.DirtyHandles);
+	InChunk.DirtyHandles.Reset();
+
+	UHierarchicalInstancedStaticMeshComponent* Component = InChunk.Component.Get();
+	if (!Component)
+	{
+		InChunk.ComponentRanges.Reset();
+		if (InChunk.InstancesByHandle.IsEmpty())
+		{
+			return;
+		}
+		Component = CreateChunkComponent(InChunk);
+		if (!Component)
+		{
+			return;
+		}
+		InChunk.Component = Component;
+	}
+
+	// Host actor is placed at the world origin, so world transforms are used as they are.
+	// Ranges that kept their instance count are updated in place
+	int32 StartIndex = 0;
+	int32 KeptRangeCount = 0;
+	for (; KeptRangeCount < InChunk.ComponentRanges.Num(); KeptRangeCount++)
+	{
+		const TPair<int32, int32>& Range = InChunk.ComponentRanges[KeptRangeCount];
+		const TArray<FTransform>* Transforms = InChunk.InstancesByHandle.Find(Range.Key);
+		if (!Transforms || Transforms->Num() != Range.Value)
+		{
+			break;
+		}
+
+		if (DirtyHandles.Contains(Range.Key))
+		{
+			Component->BatchUpdateInstancesTransforms(StartIndex, *Transforms, false, false, true);
+		}
+		StartIndex += Range.Value;
+	}
+
+	// Instances starting from the first removed or resized range are removed and added again together with new ranges
+	int32 AddedCount = 0;
+	if (KeptRangeCount < InChunk.ComponentRanges.Num() || KeptRangeCount < InChunk.InstancesByHandle.Num())
+	{
+		TArray<int32> RemovedIndices;
+		for (int32 i = Component->GetInstanceCount() - 1; i >= StartIndex; i--)
+		{
+			RemovedIndices.Add(i);
+		}
+		if (!RemovedIndices.IsEmpty())
+		{
+			Component->RemoveInstances(RemovedIndices);
+		}
+
+		InChunk.ComponentRanges.SetNum(KeptRangeCount);
+		TSet<int32> KeptHandles;
+		for (const TPair<int32, int32>& Range : InChunk.ComponentRanges)
+		{
+			KeptHandles.Add(Range.Key);
+		}
+
+		TArray<FTransform> Transforms;
+		for (const auto& Pair : InChunk.InstancesByHandle)
+		{
+			if (!KeptHandles.Contains(Pair.Key))
+			{
+				Transforms.Append(Pair.Value);
+				InChunk.ComponentRanges.Emplace(Pair.Key, Pair.Value.Num());
+			}
+		}
+		Component->AddInstances(Transforms, false, true);
+		AddedCount = Transforms.Num();
+	}
+	Component->MarkRenderStateDirty();
+
+	UE_LOG(LogMBS, VeryVerbose, TEXT("Shared instances chunk %s was updated. Instances: %d kept in place, %d added."),
+		*Component->GetName(), StartIndex, AddedCount);
+}
+
+UHierarchicalInstancedStaticMeshComponent* UMBSInstancingSubsystem::CreateChunkComponent(const FMBSSharedInstancesChunk& InChunk)
+{
+	UStaticMesh* Mesh = InChunk.Mesh.Get();
+	AActor* Host = GetOrSpawnHostActor();
+	if (!Mesh || !Host)
+	{
+		return nullptr;
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* NewComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(Host,
+		MakeUniqueObjectName(Host, UHierarchicalInstancedStaticMeshComponent::StaticClass(), *FString::Printf(TEXT("Shared_%s"), *Mesh->GetName())),
+		RF_Transient);
+	NewComponent->SetMobility(EComponentMobility::Static);
+	NewComponent->SetupAttachment(Host->GetRootComponent());
+	NewComponent->SetStaticMesh(Mesh);
+	if (UMaterialInterface* Material = InChunk.Material.Get())
+	{
+		NewComponent->SetMaterial(0, Material);
+	}
+
+	// Collision stays on the components of each build system, shared chunks are used for rendering only
+	NewComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	NewComponent->RegisterComponent();
+	Host->AddInstanceComponent(NewComponent);
+	return NewComponent;
+}
+
+AActor* UMBSInstancingSubsystem::GetOrSpawnHostActor()
+{
+	if (IsValid(HostActor))
+	{
+		return HostActor;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = MakeUniqueObjectName(World->PersistentLevel, AActor::StaticClass(), TEXT("MBSSharedInstances"));
+	SpawnParams.ObjectFlags = RF_Transient;
+#if WITH_EDITOR
+	SpawnParams.bHideFromSceneOutliner = true;
+#endif
+	HostActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (HostActor)
+	{
+		USceneComponent* Root = NewObject<USceneComponent>(HostActor, TEXT("Root"), RF_Transient);
+		Root->SetMobility(EComponentMobility::Static);
+		HostActor->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+	return HostActor;
+}
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSPresetLayout.h"
+
+#include "Algo/AllOf.h"
+#include "Engine/StaticMesh.h"
+
+void FMBSPresetLayout::Reset()
+{
+	Meshes.Reset();
+	StaticMeshIds.Reset();
+	StaticLevelIds.Reset();
+	StaticTransforms.Reset();
+	ActorClasses.Reset();
+	ActorClassIds.Reset();
+	ActorLevelIds.Reset();
+	ActorTransforms.Reset();
+	Instanced.Reset();
+	BuildStats = FModularBuildStats();
+}
+
+bool FMBSPresetLayout::IsEmpty() const
+{
+	return StaticLevelIds.IsEmpty() && ActorLevelIds.IsEmpty() && Instanced.IsEmpty();
+}
+
+bool FMBSPresetLayout::IsValid() const
+{
+	if (StaticMeshIds.Num() != StaticLevelIds.Num() || StaticTransforms.Num() != StaticLevelIds.Num()
+		|| ActorClassIds.Num() != ActorLevelIds.Num() || ActorTransforms.Num() != ActorLevelIds.Num())
+	{
+		return false;
+	}
+
+	for (const UStaticMesh* Mesh : Meshes)
+	{
+		if (!Mesh)
+		{
+			return false;
+		}
+	}
+	for (const TSubclassOf<AActor>& Class : ActorClasses)
+	{
+		if (!Class)
+		{
+			return false;
+		}
+	}
+	for (const FMBSPresetInstancedLevel& Level : Instanced)
+	{
+		if (!Level.Mesh)
+		{
+			return false;
+		}
+	}
+
+	auto IsValidId = [](int32 Id, int32 Count) { return Id >= 0 && Id < Count; };
+	return Algo::AllOf(StaticMeshIds, [&](int32 Id) { return IsValidId(Id, Meshes.Num()); })
+		&& Algo::AllOf(ActorClassIds, [&](int32 Id) { return IsValidId(Id, ActorClasses.Num()); });
+}
+
+void FMBSPresetLayout::AddStatic(UStaticMesh* InMesh, int32 InLevelId, const FTransform& InTransform)
+{
+	check(InMesh);
+	StaticMeshIds.Add(Meshes.AddUnique(InMesh));
+	StaticLevelIds.Add(InLevelId);
+	StaticTransforms.Add(InTransform);
+}
+
+void FMBSPresetLayout::AddActor(TSubclassOf<AActor> InClass, int32 InLevelId, const FTransform& InTransform)
+{
+	check(InClass);
+	ActorClassIds.Add(ActorClasses.AddUnique(InClass));
+	ActorLevelIds.Add(InLevelId);
+	ActorTransforms.Add(InTransform);
+}
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSRandomIndexCalculation.h"
+#include "ModularBuildSystem.h"
+
+int32 UMBSRandomIndexCalculation::CalculateSingle_Implementation(const FMBSIndexCalculationArgs& Args)
+{
+	if (!Args.Initializer)
+	{
+		return 0;
+	}
+
+	const int32 Index = GetRandomFreeIndex(Args, Args.Initializer->GetAdjustedTotalCount());
+	if (Index == INDEX_NONE)
+	{
+		UE_LOG(LogMBSIndexCalculation, Warning, TEXT("%s: All %d indices are occupied. Using the first one."),
+			*GetName(), Args.Initializer->GetAdjustedTotalCount());
+		return 0;
+	}
+	return Index;
+}
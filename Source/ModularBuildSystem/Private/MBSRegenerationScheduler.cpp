@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSRegenerationScheduler.h"
+
+#include "ModularBuildSystem.h"
+#include "ModularBuildSystemActor.h"
+#include "Config/MBSSettings.h"
+
+void UMBSRegenerationScheduler::Deinitialize()
+{
+	Pending.Empty();
+	TimeSliced.Empty();
+	Super::Deinitialize();
+}
+
+void UMBSRegenerationScheduler::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UMBSSettings* Settings = GetDefault<UMBSSettings>();
+	if (!Pending.IsEmpty())
+	{
+		const double BudgetSeconds = Settings ? Settings->RegenerationFrameBudget / 1000.0 : 0.0;
+
+		// Budget must never be zero on tick, otherwise all pending requests would be processed at once
+		Flush(FMath::Max(BudgetSeconds, UE_DOUBLE_SMALL_NUMBER));
+	}
+
+	if (!TimeSliced.IsEmpty())
+	{
+		const double BudgetSeconds = Settings ? Settings->TimeSlicedGenerationFrameBudget / 1000.0 : 0.0;
+		AdvanceTimeSliced(FMath::Max(BudgetSeconds, UE_DOUBLE_SMALL_NUMBER));
+	}
+}
+
+TStatId UMBSRegenerationScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMBSRegenerationScheduler, STATGROUP_Tickables);
+}
+
+UMBSRegenerationScheduler* UMBSRegenerationScheduler::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UMBSRegenerationScheduler>() : nullptr;
+}
+
+void UMBSRegenerationScheduler::Schedule(AModularBuildSystemActor* InBuildSystem, EMBSRegenerationType InType)
+{
+	if (!InBuildSystem || InType == EMBSRegenerationType::None)
+	{
+		return;
+	}
+
+	FMBSPendingRegeneration* Existing = Pending.FindByPredicate([InBuildSystem](const FMBSPendingRegeneration& Request)
+	{
+		return Request.BuildSystem.Get() == InBuildSystem;
+	});
+
+	if (Existing)
+	{
+		Existing->Type = FMath::Max(Existing->Type, InType);
+		UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Regeneration request was coalesced (type %s)."),
+			*InBuildSystem->GetName(), *UEnum::GetValueAsString(Existing->Type));
+		return;
+	}
+
+	FMBSPendingRegeneration& NewRequest = Pending.AddDefaulted_GetRef();
+	NewRequest.BuildSystem = InBuildSystem;
+	NewRequest.Type = InType;
+}
+
+void UMBSRegenerationScheduler::Cancel(const AModularBuildSystemActor* InBuildSystem)
+{
+	Pending.RemoveAll([InBuildSystem](const FMBSPendingRegeneration& Request)
+	{
+		return Request.BuildSystem.Get() == InBuildSystem;
+	});
+}
+
+int32 UMBSRegenerationScheduler::Flush(double InBudgetSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32 ProcessedCount = 0;
+
+	// Requests are appended in order, so the oldest one is always at the front
+	while (!Pending.IsEmpty())
+	{
+		if (InBudgetSeconds > 0.0 && ProcessedCount > 0 && FPlatformTime::Seconds() - StartTime >= InBudgetSeconds)
+		{
+			break;
+		}
+
+		// Request is removed before processing, as regeneration might schedule a new one for the same build system
+		const FMBSPendingRegeneration Request = Pending[0];
+		Pending.RemoveAt(0);
+
+		if (AModularBuildSystemActor* BuildSystem = Request.BuildSystem.Get(); IsValid(BuildSystem))
+		{
+			BuildSystem->RunScheduledRegeneration(Request.Type);
+			ProcessedCount++;
+		}
+	}
+
+	if (!Pending.IsEmpty())
+	{
+		UE_LOG(LogMBS, Verbose, TEXT("Regeneration frame budget was spent. %d requests are left for the next frame."),
+			Pending.Num());
+	}
+	return ProcessedCount;
+}
+
+EMBSRegenerationType UMBSRegenerationScheduler::GetPendingType(const AModularBuildSystemActor* InBuildSystem) const
+{
+	const FMBSPendingRegeneration* Existing = Pending.FindByPredicate([InBuildSystem](const FMBSPendingRegeneration& Request)
+	{
+		return Request.BuildSystem.Get() == InBuildSystem;
+	});
+	return Existing ? Existing->Type : EMBSRegenerationType::None;
+}
+
+void UMBSRegenerationScheduler::StartTimeSliced(AModularBuildSystemActor* InBuildSystem)
+{
+	if (InBuildSystem)
+	{
+		TimeSliced.AddUnique(InBuildSystem);
+	}
+}
+
+void UMBSRegenerationScheduler::StopTimeSliced(const AModularBuildSystemActor* InBuildSystem)
+{
+	TimeSliced.RemoveAll([InBuildSystem](const TWeakObjectPtr<AModularBuildSystemActor>& BuildSystem)
+	{
+		return BuildSystem.Get() == InBuildSystem;
+	});
+}
+
+int32 UMBSRegenerationScheduler::AdvanceTimeSliced(double InBudgetSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32 CompletedCount = 0;
+
+	// Oldest generation takes the whole budget, so buildings are completed one by one instead of all at the end
+	while (!TimeSliced.IsEmpty())
+	{
+		const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+		if (InBudgetSeconds > 0.0 && ElapsedSeconds >= InBudgetSeconds)
+		{
+			break;
+		}
+
+		AModularBuildSystemActor* BuildSystem = TimeSliced[0].Get();
+		if (!IsValid(BuildSystem))
+		{
+			TimeSliced.RemoveAt(0);
+			continue;
+		}
+
+		// Build system removes itself once its generation has ended
+		const double RemainingSeconds = InBudgetSeconds > 0.0 ? InBudgetSeconds - ElapsedSeconds : 0.0;
+		if (!BuildSystem->AdvanceTimeSlicedGeneration(RemainingSeconds))
+		{
+			break;
+		}
+		CompletedCount++;
+	}
+	return CompletedCount;
+}
+
+bool UMBSRegenerationScheduler::IsTimeSliced(const AModularBuildSystemActor* InBuildSystem) const
+{
+	return TimeSliced.ContainsByPredicate([InBuildSystem](const TWeakObjectPtr<AModularBuildSystemActor>& BuildSystem)
+	{
+		return BuildSystem.Get() == InBuildSystem;
+	});
+}
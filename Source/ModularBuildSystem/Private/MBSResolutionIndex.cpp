@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSResolutionIndex.h"
+
+#include "ModularBuildSystem.h"
+#include "Algo/BinarySearch.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+void FMBSResolutionIndex::Build()
+{
+	Reset();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UModularSectionResolution::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (FString Directory : MBS::FPaths::GetSectionResolutionDirectories())
+	{
+		Directory.RemoveFromEnd(TEXT("/"));
+		Filter.PackagePaths.Add(*Directory);
+	}
+
+	TArray<FAssetData> FoundResolutions;
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	AssetRegistryModule.Get().GetAssets(Filter, FoundResolutions);
+
+	Entries.Reserve(FoundResolutions.Num());
+	for (const FAssetData& AssetData : FoundResolutions)
+	{
+		if (Add(AssetData))
+		{
+			continue;
+		}
+
+		// Resolutions saved before the tags were added have to be loaded once
+		if (const UModularSectionResolution* Resolution = Cast<UModularSectionResolution>(AssetData.GetAsset()))
+		{
+			UE_LOG(LogMBSResolutionRecognizer, Verbose, TEXT("%s has no resolution tags. Resave it to avoid loading it."),
+				*AssetData.GetObjectPathString());
+			Add({ AssetData.GetSoftObjectPath(), Resolution->GetValue(), Resolution->GetSnapMode() });
+		}
+	}
+}
+
+bool FMBSResolutionIndex::Add(const FAssetData& AssetData)
+{
+	FString ValueTag;
+	FString SnapModeTag;
+	if (!AssetData.GetTagValue(UModularSectionResolution::GetValueTagName(), ValueTag)
+		|| !AssetData.GetTagValue(UModularSectionResolution::GetSnapModeTagName(), SnapModeTag))
+	{
+		return false;
+	}
+
+	FMBSResolutionIndexEntry Entry;
+	Entry.Path = AssetData.GetSoftObjectPath();
+	if (!ParseValueTag(ValueTag, Entry.Value) || !ParseSnapModeTag(SnapModeTag, Entry.SnapMode))
+	{
+		UE_LOG(LogMBSResolutionRecognizer, Warning, TEXT("Invalid resolution tags of %s: Value=%s, SnapMode=%s"),
+			*AssetData.GetObjectPathString(), *ValueTag, *SnapModeTag);
+		return false;
+	}
+
+	Add(Entry);
+	return true;
+}
+
+void FMBSResolutionIndex::Add(const FMBSResolutionIndexEntry& Entry)
+{
+	const int32 Index = Algo::UpperBoundBy(Entries, Entry.Value.X, [](const FMBSResolutionIndexEntry& Other)
+	{
+		return Other.Value.X;
+	});
+	Entries.Insert(Entry, Index);
+}
+
+int32 FMBSResolutionIndex::FindNearest(const FVector& Size, float MaxDistance,
+	TOptional<EModularSectionResolutionSnapMode> SnapMode) const
+{
+	int32 NearestIndex = INDEX_NONE;
+	double NearestDistSquared = MaxDistance > 0.f
+		? FMath::Square(static_cast<double>(MaxDistance))
+		: TNumericLimits<double>::Max();
+
+	const auto TestEntry = [&](int32 Index)
+	{
+		const FMBSResolutionIndexEntry& Entry = Entries[Index];
+		if (SnapMode.IsSet() && Entry.SnapMode != SnapMode.GetValue())
+		{
+			return;
+		}
+
+		const double DistSquared = FVector::DistSquared(Size, FVector(Entry.Value));
+		if (DistSquared > NearestDistSquared)
+		{
+			return;
+		}
+		if (NearestIndex == INDEX_NONE || DistSquared < NearestDistSquared
+			|| Entry.Path.ToString() < Entries[NearestIndex].Path.ToString())
+		{
+			NearestIndex = Index;
+			NearestDistSquared = DistSquared;
+		}
+	};
+
+	// Entries are searched in both directions from the X of the size, until X alone is farther than the nearest one
+	const int32 Start = Algo::LowerBoundBy(Entries, Size.X, [](const FMBSResolutionIndexEntry& Entry)
+	{
+		return static_cast<double>(Entry.Value.X);
+	});
+	for (int32 Index = Start; Index < Entries.Num() && FMath::Square(Entries[Index].Value.X - Size.X) <= NearestDistSquared; Index++)
+	{
+		TestEntry(Index);
+	}
+	for (int32 Index = Start - 1; Index >= 0 && FMath::Square(Size.X - Entries[Index].Value.X) <= NearestDistSquared; Index--)
+	{
+		TestEntry(Index);
+	}
+	return NearestIndex;
+}
+
+bool FMBSResolutionIndex::ParseValueTag(const FString& TagValue, FIntVector& OutValue)
+{
+	return FParse::Value(*TagValue, TEXT("X="), OutValue.X)
+		&& FParse::Value(*TagValue, TEXT("Y="), OutValue.Y)
+		&& FParse::Value(*TagValue, TEXT("Z="), OutValue.Z);
+}
+
+bool FMBSResolutionIndex::ParseSnapModeTag(const FString& TagValue, EModularSectionResolutionSnapMode& OutSnapMode)
+{
+	const int64 Value = StaticEnum<EModularSectionResolutionSnapMode>()->GetValueByNameString(TagValue);
+	if (Value == INDEX_NONE)
+	{
+		return false;
+	}
+	OutSnapMode = static_cast<EModularSectionResolutionSnapMode>(Value);
+	return true;
+}
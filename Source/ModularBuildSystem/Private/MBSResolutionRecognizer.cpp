@@ -4,24 +4,47 @@
 #include "MBSResolutionRecognizer.h"
 
 #include "AssetSelection.h"
-#include "AssetViewUtils.h"
 #include "ModularBuildSystem.h"
 #include "ModularSectionResolution.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/StaticMesh.h"
+
+void UMBSResolutionRecognizer::PostInitProperties()
+{
+	Super::PostInitProperties();
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		AssetRegistry.OnAssetAdded().AddUObject(this, &UMBSResolutionRecognizer::OnAssetChanged);
+		AssetRegistry.OnAssetRemoved().AddUObject(this, &UMBSResolutionRecognizer::OnAssetChanged);
+		AssetRegistry.OnAssetUpdated().AddUObject(this, &UMBSResolutionRecognizer::OnAssetChanged);
+		AssetRegistry.OnAssetRenamed().AddUObject(this, &UMBSResolutionRecognizer::OnAssetRenamed);
+	}
+}
+
+void UMBSResolutionRecognizer::BeginDestroy()
+{
+	// Asset registry can be unloaded already on shutdown
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	}
+	Super::BeginDestroy();
+}
 
 UModularSectionResolution* UMBSResolutionRecognizer::RecognizeFromSelection()
 {
 	TArray<FAssetData> SelectedAssets;
 	AssetSelectionUtils::GetSelectedAssets(SelectedAssets);
 
-	// Find all resolutions available in the project dir and MBS plugin dir
-	TArray<FAssetData> FoundResolutions;
-	AssetViewUtils::GetAssetsInPaths(MBS::FPaths::GetSectionResolutionDirectories(), FoundResolutions);
-	
 	for (auto& SelectedAsset : SelectedAssets)
 	{
 		UE_LOG(LogMBSResolutionRecognizer, Log, TEXT("%s: Selected asset name = %s"),
 			*GetName(), *SelectedAsset.AssetName.ToString());
-		SelectedAsset.PrintAssetData();
 		
 		if (!SelectedAsset.IsUAsset())
 		{
@@ -29,50 +52,18 @@ UModularSectionResolution* UMBSResolutionRecognizer::RecognizeFromSelection()
 			continue;
 		}
 		
-		// TODO: Implement
-		// Check if static mesh
-		UObject* Asset = SelectedAsset.GetAsset();
-		if (const UStaticMesh* SM = Cast<UStaticMesh>(Asset))
+		// Resolution of the first selected static mesh is returned
+		if (const UStaticMesh* SM = Cast<UStaticMesh>(SelectedAsset.GetAsset()))
 		{
-			// Get bounds of a static mesh
-			// Save FIntVector from bounds clamped
-			const FVector Bounds = SM->GetBoundingBox().GetSize();
-			UModularSectionResolution* ClosestResolution = nullptr;
-
-			// Check if there is any Resolution that is close enough to saved FIntVector with specified tolerance
-			if (FoundResolutions.Num() == 0)
+			if (GetIndex().IsEmpty())
 			{
 				UE_LOG(LogMBSResolutionRecognizer, Error, TEXT("%s: No modular section resolutions found."),
 					*GetName());
 				break;
 			}
-			
-			// Loop all found resolutions to find the closest to the saved bounds vector
-			FVector ClosestVec = {};
-			float ClosestDistance = 0.f;
-			for (const auto& FoundAsset : FoundResolutions)
-			{
-				if (UModularSectionResolution* Resolution = Cast<UModularSectionResolution>(FoundAsset.GetAsset()))
-				{
-					const FVector ResolutionVec = FVector(Resolution->GetValue());
-					const float CurrentDistance = FVector::Dist(ClosestVec, ResolutionVec);
-					if (ClosestResolution && CurrentDistance < ClosestDistance)
-					{
-						// Close enough resolution found
-						ClosestResolution = Resolution;
-						ClosestVec = ResolutionVec;
-						ClosestDistance = CurrentDistance;
-					}
-					else if (ResolutionVec.Equals(Bounds, 0.1))
-					{
-						ClosestResolution = Resolution;
-						break;
-					}
-				}
-			}
 
-			// If there is no close enough Resolution - then create new one and return pointer to it
-			if (!ClosestResolution)
+			const int32 EntryIndex = Recognize(SM);
+			if (EntryIndex == INDEX_NONE)
 			{
 				// If we didn't found any resolution - return the Undefined
 				if (bReturnUndefinedIfNotRecognized)
@@ -84,10 +75,85 @@ UModularSectionResolution* UMBSResolutionRecognizer::RecognizeFromSelection()
 				return nullptr;
 			}
 			
-			// Else return pointer to the found Resolution
-			return ClosestResolution;
+			return Cast<UModularSectionResolution>(Index[EntryIndex].Path.TryLoad());
 		}
 	}
 	
 	return nullptr;
 }
+
+void UMBSResolutionRecognizer::RecognizeMeshes(const TArray<UStaticMesh*>& Meshes,
+	TArray<UModularSectionResolution*>& OutResolutions)
+{
+	OutResolutions.Reset(Meshes.Num());
+
+	// Many meshes share the same resolution, so each recognized entry is loaded once
+	TMap<int32, UModularSectionResolution*> LoadedResolutions;
+	for (const UStaticMesh* Mesh : Meshes)
+	{
+		const int32 EntryIndex = Recognize(Mesh);
+		if (EntryIndex == INDEX_NONE)
+		{
+			OutResolutions.Add(nullptr);
+			continue;
+		}
+
+		UModularSectionResolution*& Resolution = LoadedResolutions.FindOrAdd(EntryIndex);
+		if (!Resolution)
+		{
+			Resolution = Cast<UModularSectionResolution>(Index[EntryIndex].Path.TryLoad());
+		}
+		OutResolutions.Add(Resolution);
+	}
+}
+
+int32 UMBSResolutionRecognizer::Recognize(const UStaticMesh* Mesh)
+{
+	if (!Mesh)
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector Bounds = Mesh->GetBoundingBox().GetSize();
+	TOptional<EModularSectionResolutionSnapMode> RequiredSnapMode;
+	if (bFilterBySnapMode)
+	{
+		RequiredSnapMode = SnapMode;
+	}
+	const int32 EntryIndex = GetIndex().FindNearest(Bounds, MaxDistance, RequiredSnapMode);
+
+	UE_LOG(LogMBSResolutionRecognizer, Verbose, TEXT("%s: Bounds of %s = %s, recognized resolution = %s"),
+		*GetName(), *Mesh->GetName(), *Bounds.ToString(),
+		EntryIndex != INDEX_NONE ? *Index[EntryIndex].Path.ToString() : TEXT("None"));
+	return EntryIndex;
+}
+
+void UMBSResolutionRecognizer::RebuildIndex()
+{
+	Index.Build();
+	bIndexOutdated = false;
+	UE_LOG(LogMBSResolutionRecognizer, Log, TEXT("%s: Resolution index is built, %d resolutions found."),
+		*GetName(), Index.Num());
+}
+
+const FMBSResolutionIndex& UMBSResolutionRecognizer::GetIndex()
+{
+	if (bIndexOutdated)
+	{
+		RebuildIndex();
+	}
+	return Index;
+}
+
+void UMBSResolutionRecognizer::OnAssetChanged(const FAssetData& AssetData)
+{
+	if (AssetData.IsInstanceOf(UModularSectionResolution::StaticClass()))
+	{
+		bIndexOutdated = true;
+	}
+}
+
+void UMBSResolutionRecognizer::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	OnAssetChanged(AssetData);
+}
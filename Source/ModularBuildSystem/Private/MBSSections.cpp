@@ -7,6 +7,7 @@
 #include "ModularBuildSystem.h"
 #include "ModularBuildSystemActor.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Engine/StaticMeshActor.h"
 
 FModularSection FMBSSections::InitStatic(UStaticMesh* InStaticMesh, const FTransform& InTransform,
@@ -27,6 +28,7 @@ FModularSection FMBSSections::InitStatic(UStaticMesh* InStaticMesh, const FTrans
 	if (bAddToSections)
 	{
 		Static.Add(NewSection);
+		MarkLayoutDirty();
 	}
 
 #if WITH_EDITOR
@@ -49,6 +51,7 @@ FModularSectionActor FMBSSections::InitActor(const FTransform& InTransform, int3
 	if (bAddToActorSections)
 	{
 		Actor.Add(NewSectionActor);
+		MarkLayoutDirty();
 	}
 	
 #if WITH_EDITOR	
@@ -65,6 +68,12 @@ FModularSectionInstanced FMBSSections::InitInstanced(int32 InLevelId, bool bAddT
 	check(FModularLevel::IsValidLevelId(InLevelId));
 	FModularSectionInstanced NewSection = FModularSectionInstanced(InLevelId, InInstancedStaticMeshComponent);
 
+	// New instances are always appended to the end of a shared component, so the range of this section starts there
+	if (UsesSharedInstancedComponents())
+	{
+		NewSection.SetInstanceRange(InInstancedStaticMeshComponent->GetInstanceCount(), 0);
+	}
+
 	if (bAddToInstancedSections)
 	{
 		Instanced.Add(NewSection);
@@ -77,9 +86,44 @@ FModularSection* FMBSSections::ReplaceWithNonInstancedSection(UStaticMesh* InNew
 	int32 InLevelId, UInstancedStaticMeshComponent* InComponent, FTransform& OutReplacedInstanceTransform)
 {
 	check(InComponent);
-	if (InComponent->GetInstanceTransform(InInstanceIndex, OutReplacedInstanceTransform))
+	if (UsesSharedInstancedComponents())
+	{
+		// InInstanceIndex is an index within the level, so it must be converted into the index within one of its ranges
+		int32 RangeIndex = InInstanceIndex;
+		const FModularSectionInstanced* RangeSection = FindInstancedSectionOfLevel(InLevelId, RangeIndex);
+		if (!RangeSection || !RangeSection->IsInstanceRange()
+			|| !RangeSection->GetISMC()->GetInstanceTransform(RangeSection->ToComponentIndex(RangeIndex), OutReplacedInstanceTransform))
+		{
+			UE_LOG(LogMBSSection, Error, TEXT("%s: Can't replace with non instanced section. InInstanceIndex = %d, LevelId = %d"),
+				*UMBSFunctionLibrary::GetDisplayName(BS), InInstanceIndex, InLevelId);
+			return nullptr;
+		}
+		if (RangeSection->IsHidden())
+		{
+			OutReplacedInstanceTransform = RangeSection->GetHiddenTransforms()[RangeIndex];
+		}
+		if (bRecordShellOverrides && !RangeSection->IsHidden())
+		{
+			HideShellInstance(RangeSection->GetISMC(), RangeSection->ToComponentIndex(RangeIndex), OutReplacedInstanceTransform);
+		}
+		else
+		{
+			RebuildSharedComponent(RangeSection->GetISMC(), [RangeSection, RangeIndex](const FModularSectionInstanced& Owner, int32 Index)
+			{
+				return &Owner != RangeSection || Index != RangeIndex;
+			});
+		}
+	}
+	else if (InComponent->GetInstanceTransform(InInstanceIndex, OutReplacedInstanceTransform))
 	{
-		InComponent->RemoveInstance(InInstanceIndex);
+		if (bRecordShellOverrides)
+		{
+			HideShellInstance(InComponent, InInstanceIndex, OutReplacedInstanceTransform);
+		}
+		else
+		{
+			InComponent->RemoveInstance(InInstanceIndex);
+		}
 	}
 	else
 	{
@@ -90,6 +134,7 @@ FModularSection* FMBSSections::ReplaceWithNonInstancedSection(UStaticMesh* InNew
 
 	const int32 NewSectionIndex = Static.Add(InitStatic(InNewStaticMesh, OutReplacedInstanceTransform,
 		InLevelId, false, true));
+	MarkLayoutDirty();
 	return &Static[NewSectionIndex];
 }
 
@@ -115,7 +160,12 @@ void FMBSSections::AddNewInstance(const FTransform& InTransform, bool bWithRelat
 {
 	if (InInstancedStaticMeshComponent)
 	{
-		InInstancedStaticMeshComponent->AddInstance(InTransform, !bWithRelativeTransform);
+		const int32 Index = InInstancedStaticMeshComponent->AddInstance(InTransform, !bWithRelativeTransform);
+		if (bRecordShellOverrides)
+		{
+			RecordAddedInstance(InInstancedStaticMeshComponent, Index);
+		}
+		MarkChanged();
 	}
 #if WITH_EDITOR
 	else
@@ -126,33 +176,53 @@ void FMBSSections::AddNewInstance(const FTransform& InTransform, bool bWithRelat
 #endif
 }
 
+void FMBSSections::AddNewInstances(const TArray<FTransform>& InTransforms, bool bWithRelativeTransform,
+	UInstancedStaticMeshComponent* InInstancedStaticMeshComponent)
+{
+	if (InInstancedStaticMeshComponent)
+	{
+		const TArray<int32> Indices = InInstancedStaticMeshComponent->AddInstances(InTransforms, bRecordShellOverrides,
+			!bWithRelativeTransform);
+		for (const int32 Index : Indices)
+		{
+			RecordAddedInstance(InInstancedStaticMeshComponent, Index);
+		}
+		MarkChanged();
+	}
+#if WITH_EDITOR
+	else
+	{
+		UE_LOG(LogMBS, Error, TEXT("%s: Can't init modular sections with InstancedStaticMeshes of HierarchicalInstancedStaticMeshes mesh configuration type when"
+			" InInstancedStaticMeshComponent is nullptr."), *UMBSFunctionLibrary::GetDisplayName(BS));
+	}
+#endif
+}
+
 void FMBSSections::SetMeshForEach(const FModularLevel& InLevel, int32 InEachElement, UStaticMesh* InMesh)
 {
 	check(InMesh);
 
 	UE_LOG(LogMBSSection, Verbose, TEXT("%s: Updating each %d section mesh of level with Id=%d"),
 		*UMBSFunctionLibrary::GetDisplayName(BS), InEachElement, InLevel.GetId());
-	const int32 SectionsLength = Static.Num();
 
-	TArray<int32> Indices;
-	Indices.Reserve(SectionsLength);
-
-	for (int32 i = 0; i < SectionsLength; i++)
+	if (UsesSharedInstancedComponents())
 	{
-		if (Static[i].GetLevelId() == InLevel.GetId())
-		{
-			Indices.Add(i);
-		}
+		MoveInstancesOfLevel(InLevel.GetId(), InMesh, InEachElement);
 	}
+	
+	const FMBSSectionsLayout& CurrentLayout = GetLayout();
+	TArray<int32> Indices;
+	CurrentLayout.GetIndicesOfLevel(InLevel.GetId(), Indices, true);
 
 	const int32 IndicesCount = Indices.Num();
-	for (int32 i = 0; i < IndicesCount; i++)
+	TArray<FModularSection*> UpdatedSections;
+	UpdatedSections.Reserve(IndicesCount / InEachElement + 1);
+	for (int32 i = 0; i < IndicesCount; i += InEachElement)
 	{
-		if (i % InEachElement == 0)
-		{
-			Static[Indices[i]].SetMesh(InMesh);
-		}
+		UpdatedSections.Add(&Static[Indices[i]]);
 	}
+	FModularSection::BatchSetMesh(UpdatedSections, InMesh);
+	MarkChanged();
 	UE_LOG(LogMBSSection, Verbose, TEXT("%s: %d sections were updated."), *UMBSFunctionLibrary::GetDisplayName(BS), IndicesCount);
 }
 
@@ -181,7 +251,9 @@ void FMBSSections::SetMeshAt(const FModularLevel& InLevel, int32 InElement, int3
 		}
 		else
 		{
+			RecordShellMesh(*Section, InMesh);
 			Section->SetMesh(InMesh);
+			MarkChanged();
 		}
 	}
 }
@@ -210,7 +282,9 @@ void FMBSSections::SetMeshAt(const FModularLevel& InLevel, int32 InIndex, UStati
 		}
 		else
 		{
+			RecordShellMesh(*Section, InMesh);
 			Section->SetMesh(InMesh);
+			MarkChanged();
 		}
 	}
 }
@@ -223,6 +297,20 @@ void FMBSSections::UpdateInstanceCount(FModularSectionInstanced& InSection)
 {
 	if (ensure(InSection.GetISMC()))
 	{
+		if (InSection.IsInstanceRange())
+		{
+			// Instances after the start of the range are owned by this section up to the start of the next range
+			int32 RangeEnd = InSection.GetISMC()->GetInstanceCount();
+			for (const FModularSectionInstanced& Section : Instanced)
+			{
+				if (Section.GetISMC() == InSection.GetISMC() && Section.IsInstanceRange()
+					&& Section.GetFirstInstanceIndex() > InSection.GetFirstInstanceIndex())
+				{
+					RangeEnd = FMath::Min(RangeEnd, Section.GetFirstInstanceIndex());
+				}
+			}
+			InSection.SetInstanceRange(InSection.GetFirstInstanceIndex(), RangeEnd - InSection.GetFirstInstanceIndex());
+		}
 #if WITH_EDITOR
 		const int32 CurrentInstanceCount = InSection.GetInstanceCount();
 		TotalInstanceCount += CurrentInstanceCount - InSection.GetPreviousInstanceCount();
@@ -257,6 +345,16 @@ FMBSSections::FMBSSections(const TScriptInterface<IModularBuildSystemInterface>
 	Static		= BS->GetSections().Static;
 	Actor		= BS->GetSections().Actor;
 	Instanced	= BS->GetSections().Instanced;
+	Shared		= BS->GetSections().Shared;
+
+	// Shared components are also referenced by their instance ranges, so the map is restored if it is incomplete
+	for (const FModularSectionInstanced& Section : Instanced)
+	{
+		if (Section.IsInstanceRange() && IsValid(Section.GetISMC()) && Section.GetISMC()->GetStaticMesh())
+		{
+			Shared.FindOrAdd(Section.GetISMC()->GetStaticMesh(), Section.GetISMC());
+		}
+	}
 }
 
 FModularSection* FMBSSections::GetSectionAt(const FModularLevel& InLevel, int32 InIndex) const
@@ -326,10 +424,11 @@ FTransform FMBSSections::GetSectionTransformAt(const FModularLevel& InLevel, int
 	}
 	else
 	{
-		if (const FModularSectionInstanced* Section = GetInstancedSectionOfLevel(InLevel))
+		int32 SectionIndex = InIndex;
+		if (const FModularSectionInstanced* Section = FindInstancedSectionOfLevel(InLevel.GetId(), SectionIndex))
 		{
 			FTransform OutTransform;
-			if (!Section->GetISMC()->GetInstanceTransform(InIndex, OutTransform, bWorldSpace))
+			if (!Section->GetISMC()->GetInstanceTransform(Section->ToComponentIndex(SectionIndex), OutTransform, bWorldSpace))
 			{
 				UE_LOG(LogMBSSection, Error, TEXT("%s: Instance with index=%d (LevelId=%d) not found on GetInstanceTransform."),
 					*UMBSFunctionLibrary::GetDisplayName(BS), InIndex, InLevel.GetId());
@@ -386,17 +485,15 @@ TArray<FModularSection*> FMBSSections::GetStaticSectionsOfLevel(const FModularLe
 TArray<FModularSection*> FMBSSections::GetStaticSectionsOfLevel(const int32 InLevelId) const
 {
 	//UE_LOG(LogBuildSystem, Log, TEXT("%s: Get sections of level"), *GetName());
-	TArray<FModularSection*> OutSections;
-	OutSections.Reserve(Static.Num());
+	TArray<int32> Indices;
+	GetLayout().GetIndicesOfLevel(InLevelId, Indices, true);
 
-	for (auto& Section : Static)
+	TArray<FModularSection*> OutSections;
+	OutSections.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
 	{
-		if (Section.GetLevelId() == InLevelId)
-		{
-			OutSections.Add(const_cast<FModularSection*>(&Section));
-		}
+		OutSections.Add(const_cast<FModularSection*>(&Static[Index]));
 	}
-
 	return OutSections;
 }
 
@@ -407,17 +504,19 @@ TArray<FModularSectionActor*> FMBSSections::GetActorSectionsOfLevel(const FModul
 
 TArray<FModularSectionActor*> FMBSSections::GetActorSectionsOfLevel(const int32 InLevelId) const
 {
-	TArray<FModularSectionActor*> OutSections;
-	OutSections.Reserve(Actor.Num());
+	const FMBSSectionsLayout& CurrentLayout = GetLayout();
+	TArray<int32> Indices;
+	CurrentLayout.GetIndicesOfLevel(InLevelId, Indices, false);
 
-	for (auto& Section : Actor)
+	TArray<FModularSectionActor*> OutSections;
+	OutSections.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
 	{
-		if (Section.GetLevelId() == InLevelId)
+		if (CurrentLayout.IsActorAt(Index))
 		{
-			OutSections.Add(const_cast<FModularSectionActor*>(&Section));
+			OutSections.Add(const_cast<FModularSectionActor*>(&Actor[Index - CurrentLayout.GetStaticNum()]));
 		}
 	}
-
 	return OutSections;
 }
 
@@ -448,6 +547,39 @@ FModularSectionInstanced* FMBSSections::GetInstancedSectionOfLevel(const int32 I
 	return OutSection;
 }
 
+TArray<FModularSectionInstanced*> FMBSSections::GetInstancedSectionsOfLevel(const int32 InLevelId) const
+{
+	TArray<FModularSectionInstanced*> OutSections;
+	for (auto& Section : Instanced)
+	{
+		if (Section.GetLevelId() == InLevelId)
+		{
+			OutSections.Add(const_cast<FModularSectionInstanced*>(&Section));
+		}
+	}
+	return OutSections;
+}
+
+FModularSectionInstanced* FMBSSections::FindInstancedSectionOfLevel(int32 InLevelId, int32& InOutIndex) const
+{
+	int32 LevelIndex = InOutIndex;
+	for (FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(InLevelId))
+	{
+		if (!Section->IsInstanceRange())
+		{
+			// Section owns the whole component, so the index is the same
+			return Section;
+		}
+		if (LevelIndex < Section->GetInstanceCount())
+		{
+			InOutIndex = LevelIndex;
+			return Section;
+		}
+		LevelIndex -= Section->GetInstanceCount();
+	}
+	return nullptr;
+}
+
 TArray<FModularSectionBase*> FMBSSections::GetAll()
 {
 	TArray<FModularSectionBase*> OutSections;
@@ -473,11 +605,14 @@ void FMBSSections::SelectSections(const FModularLevel& InLevel) const
 	UE_LOG(LogMBS, Log, TEXT("%s: Start single level selection."), *UMBSFunctionLibrary::GetDisplayName(BS));
 	if (BS->GetMeshConfiguration().IsOfInstancedType())
 	{
-		if (const FModularSectionInstanced* Section = GetInstancedSectionOfLevel(InLevel); Section->IsValid())
+		for (const FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(InLevel.GetId()))
 		{
-			Section->GetISMC()->SelectInstance(true, 0, Section->GetInstanceCount());
+			if (Section->IsValid())
+			{
+				Section->GetISMC()->SelectInstance(true, Section->GetFirstInstanceIndex(), Section->GetInstanceCount());
+			}
 		}
-		if (InLevel.InstancedStaticMeshComponent)
+		if (InLevel.InstancedStaticMeshComponent && !UsesSharedInstancedComponents())
 		{
 			InLevel.InstancedStaticMeshComponent->SelectInstance(true, 0,
 				InLevel.InstancedStaticMeshComponent->GetInstanceCount());
@@ -507,7 +642,14 @@ void FMBSSections::SelectSections(const TArray<FModularLevel>& InLevels) const
 void FMBSSections::UnselectSections(const FModularLevel& InLevel) const
 {
 	UE_LOG(LogMBS, Log, TEXT("%s: Unselecting single level."), *UMBSFunctionLibrary::GetDisplayName(BS));
-	if (BS->GetMeshConfiguration().IsOfInstancedType())
+	if (UsesSharedInstancedComponents())
+	{
+		for (const FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(InLevel.GetId()))
+		{
+			Section->GetISMC()->SelectInstance(false, Section->GetFirstInstanceIndex(), Section->GetInstanceCount());
+		}
+	}
+	else if (BS->GetMeshConfiguration().IsOfInstancedType())
 	{
 		if (InLevel.InstancedStaticMeshComponent)
 		{
@@ -618,7 +760,12 @@ bool FMBSSections::IsValidSectionIndex(const FModularLevel& InLevel, int32 Index
 
 void FMBSSections::OffsetLevel(const FModularLevel& Level, FVector Offset, bool bUpdateZMultiplier) const
 {
-	if (BS->GetMeshConfiguration().IsOfInstancedType())
+	if (UsesSharedInstancedComponents())
+	{
+		// Shared component can't be moved as a whole, as it also holds instances of other levels
+		OffsetInstancesOfLevel(Level.GetId(), Offset);
+	}
+	else if (BS->GetMeshConfiguration().IsOfInstancedType())
 	{
 		if (const FModularSectionInstanced* InstancedLevelSection = GetInstancedSectionOfLevel(Level))
 		{
@@ -627,11 +774,19 @@ void FMBSSections::OffsetLevel(const FModularLevel& Level, FVector Offset, bool
 	}
 	else
 	{
-		for (const FModularSection* LevelSection : GetStaticSectionsOfLevel(Level))
+		const FMBSSectionsLayout& CurrentLayout = GetLayout();
+		TArray<int32> Indices;
+		CurrentLayout.GetIndicesOfLevel(Level.GetId(), Indices, true);
+
+		TArray<FModularSection*> LevelSections;
+		LevelSections.Reserve(Indices.Num());
+		for (const int32 Index : Indices)
 		{
-			LevelSection->GetStaticMeshActor()->AddActorWorldOffset(Offset);
+			LevelSections.Add(const_cast<FModularSection*>(&Static[Index]));
 		}
+		FModularSection::BatchOffset(LevelSections, Offset, false);
 	}
+	MarkChanged();
 
 	if (bUpdateZMultiplier)
 	{
@@ -646,6 +801,7 @@ void FMBSSections::OffsetSection(const FModularLevel& Level, int32 SectionIndex,
 	if (FModularSection* Section = GetSectionAt(Level, SectionIndex))
 	{
 		Section->Offset(Offset, bRelative);
+		MarkChanged();
 	}
 }
 
@@ -668,6 +824,7 @@ void FMBSSections::ResetSingleLevel(int32 LevelId)
 			Section.Reset();
 		}
 	}
+	ClearShell();
 }
 
 int32 FMBSSections::GetFirstIndexOfSectionWithLevelId(const int32 InLevelId) const
@@ -707,6 +864,11 @@ void FMBSSections::RemoveSectionsOfLevel(int32 LevelId)
 				Section.Reset();
 			}
 		}
+
+		if (UsesSharedInstancedComponents())
+		{
+			RemoveInstancesOfLevel(LevelId, true);
+		}
 		ClearInvalidSections();
 
 		const FModularLevel* CurrentLevel = BS->GetLevelWithId(LevelId);
@@ -760,7 +922,12 @@ void FMBSSections::RemoveSectionsAfterIndex(int32 Index, int32 LevelId)
 
 void FMBSSections::ResetInstancedSectionOfLevel(int32 LevelId)
 {
-	if (FModularLevel::IsValidLevelId(LevelId))
+	if (FModularLevel::IsValidLevelId(LevelId) && UsesSharedInstancedComponents())
+	{
+		// Shared component stays alive (and assigned to the level), only the instances of this level are removed
+		RemoveInstancesOfLevel(LevelId, true);
+	}
+	else if (FModularLevel::IsValidLevelId(LevelId))
 	{
 		if (FModularSectionInstanced* InstancedSection = GetInstancedSectionOfLevel(LevelId))
 		{
@@ -779,17 +946,23 @@ void FMBSSections::ResetInstancedSectionOfLevel(int32 LevelId)
 			{
 				return !Section.IsValid();
 			});
+			MarkChanged();
 		}
 	}
 }
 
 void FMBSSections::ClearInstancedSectionOfLevel(int32 LevelId)
 {
-	if (FModularLevel::IsValidLevelId(LevelId))
+	if (FModularLevel::IsValidLevelId(LevelId) && UsesSharedInstancedComponents())
+	{
+		RemoveInstancesOfLevel(LevelId, false);
+	}
+	else if (FModularLevel::IsValidLevelId(LevelId))
 	{
 		if (const FModularSectionInstanced* InstancedSection = GetInstancedSectionOfLevel(LevelId))
 		{
 			InstancedSection->GetISMC()->ClearInstances();
+			MarkChanged();
 		}
 	}
 }
@@ -800,6 +973,7 @@ void FMBSSections::ClearInvalidSections()
 	// Removing sections with NULL static mesh
 	const int32 InitialCount = Static.Num();
 	Static.RemoveAll([&](const FModularSection& Section) -> bool { return !Section.IsValid(); });
+	MarkLayoutDirty();
 
 	const int32 NewCount = Static.Num();
 	UE_LOG(LogMBSSection, Verbose, TEXT("%s: %d invalid sections removed out of %d. Current sections count is %d"),
@@ -812,6 +986,12 @@ void FMBSSections::ClearInvalidSections()
 	UE_LOG(LogMBSSection, Verbose, TEXT("%s: %d invalid actor sections removed out of %d. Current actor sections count is %d"),
 		*UMBSFunctionLibrary::GetDisplayName(BS), InitialActorSectionCount - NewActorSectionCount, InitialActorSectionCount, NewActorSectionCount);
 
+	// Indices of the shell sections are no longer valid
+	if (NewCount != InitialCount || NewActorSectionCount != InitialActorSectionCount)
+	{
+		ClearShell();
+	}
+
 	// TODO: Instanced static mesh components?
 	const int32 InitialInstancedSectionCount = Instanced.Num();
 	Instanced.RemoveAll([&](const FModularSectionInstanced& Section) -> bool { return !Section.IsValid(); });
@@ -855,6 +1035,33 @@ void FMBSSections::RemoveInstancedSectionInstancesAfterIndex(int32 Index, int32
 		*UMBSFunctionLibrary::GetDisplayName(BS), Index, LevelId);
 	if (FModularLevel::IsValidLevelId(LevelId))
 	{
+		if (UsesSharedInstancedComponents())
+		{
+			// Index is an index within the whole level, so instances are counted through all ranges of a level
+			TMap<const FModularSectionInstanced*, int32> LevelIndexOffsets;
+			TArray<UInstancedStaticMeshComponent*> Components;
+			int32 LevelInstanceCount = 0;
+			for (const FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(LevelId))
+			{
+				if (Section->IsInstanceRange())
+				{
+					LevelIndexOffsets.Add(Section, LevelInstanceCount);
+					LevelInstanceCount += Section->GetInstanceCount();
+					Components.AddUnique(Section->GetISMC());
+				}
+			}
+
+			for (UInstancedStaticMeshComponent* Component : Components)
+			{
+				RebuildSharedComponent(Component, [&LevelIndexOffsets, Index](const FModularSectionInstanced& Owner, int32 InstanceIndex)
+				{
+					const int32* LevelIndexOffset = LevelIndexOffsets.Find(&Owner);
+					return !LevelIndexOffset || *LevelIndexOffset + InstanceIndex < Index;
+				});
+			}
+			return;
+		}
+
 		const FModularSectionInstanced* InstancedSection = GetInstancedSectionOfLevel(LevelId);
 		check(InstancedSection);
 		check(InstancedSection->IsValid());
@@ -869,20 +1076,21 @@ void FMBSSections::RemoveInstancedSectionInstancesAfterIndex(int32 Index, int32
 		{
 			InstancedSection->GetISMC()->RemoveInstance(InstanceCount - 1);
 		}
+		MarkChanged();
 	}
 }
 
 void FMBSSections::SetVisibility(bool bVisible)
 {
-	for (const auto& Section : Static)
+	const FMBSSectionsLayout& CurrentLayout = GetLayout();
+	for (int32 i = 0; i < CurrentLayout.Num(); i++)
 	{
-		Section.GetStaticMeshActor()->GetRootComponent()->SetVisibility(bVisible, true);
-	}
-
-	for (const auto& Section : Actor)
-	{
-		Section.GetActor()->GetRootComponent()->SetVisibility(bVisible, true);
+		if (const AActor* Handle = CurrentLayout.GetHandleAt(i))
+		{
+			Handle->GetRootComponent()->SetVisibility(bVisible, true);
+		}
 	}
+	MarkChanged();
 
 	for (const auto& Section : Instanced)
 	{
@@ -892,19 +1100,30 @@ void FMBSSections::SetVisibility(bool bVisible)
 
 void FMBSSections::SetVisibility(const FModularLevel& InLevel, bool bVisible) const
 {
-	for (const auto& Section : GetStaticSectionsOfLevel(InLevel))
+	const FMBSSectionsLayout& CurrentLayout = GetLayout();
+	TArray<int32> Indices;
+	CurrentLayout.GetIndicesOfLevel(InLevel.GetId(), Indices, false);
+
+	for (const int32 Index : Indices)
 	{
-		check(Section);
-		Section->GetStaticMeshActor()->GetRootComponent()->SetVisibility(bVisible, true);
+		const AActor* Handle = CurrentLayout.GetHandleAt(Index);
+		check(Handle);
+		Handle->GetRootComponent()->SetVisibility(bVisible, true);
 	}
+	MarkChanged();
 
-	for (const auto& Section : GetActorSectionsOfLevel(InLevel))
+	if (UsesSharedInstancedComponents())
 	{
-		check(Section);
-		Section->GetActor()->GetRootComponent()->SetVisibility(bVisible, true);
+		// Shared component also holds instances of other levels, so only the ranges of this level are hidden
+		for (FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(InLevel.GetId()))
+		{
+			if (Section->IsValid() && Section->IsInstanceRange())
+			{
+				Section->SetRangeVisibility(bVisible);
+			}
+		}
 	}
-
-	if (BS->GetMeshConfiguration().IsOfInstancedType())
+	else if (BS->GetMeshConfiguration().IsOfInstancedType())
 	{
 		if (const FModularSectionInstanced* InstancedSection = GetInstancedSectionOfLevel(InLevel))
 		{
@@ -913,6 +1132,50 @@ void FMBSSections::SetVisibility(const FModularLevel& InLevel, bool bVisible) co
 	}
 }
 
+void FMBSSections::SetCollisionEnabled(bool bEnabled) const
+{
+	const FMBSSectionsLayout& CurrentLayout = GetLayout();
+	for (int32 i = 0; i < CurrentLayout.Num(); i++)
+	{
+		if (AActor* Handle = CurrentLayout.GetHandleAt(i))
+		{
+			Handle->SetActorEnableCollision(bEnabled);
+		}
+	}
+}
+
+void FMBSSections::SetTransient(bool bTransient) const
+{
+	auto SetTransientFlag = [bTransient](UObject* Object)
+	{
+		if (bTransient)
+		{
+			Object->SetFlags(RF_Transient);
+		}
+		else
+		{
+			Object->ClearFlags(RF_Transient);
+		}
+	};
+
+	const FMBSSectionsLayout& CurrentLayout = GetLayout();
+	for (int32 i = 0; i < CurrentLayout.Num(); i++)
+	{
+		if (AActor* Handle = CurrentLayout.GetHandleAt(i))
+		{
+			SetTransientFlag(Handle);
+		}
+	}
+
+	for (const auto& Section : Instanced)
+	{
+		if (UInstancedStaticMeshComponent* ISMC = Section.GetISMC())
+		{
+			SetTransientFlag(ISMC);
+		}
+	}
+}
+
 void FMBSSections::ReloadMeshes(int32 InLevelId)
 {
 	UE_LOG(LogMBS, Log, TEXT("%s: Reloading meshes of sections with %d level id"), *UMBSFunctionLibrary::GetDisplayName(BS), InLevelId);
@@ -927,14 +1190,13 @@ void FMBSSections::ReloadMeshes(int32 InLevelId)
 		UE_LOG(LogMBS, Error, TEXT("%s: Level with Id=%d was nullptr on mesh reload."), *UMBSFunctionLibrary::GetDisplayName(BS), InLevelId);
 	}
 	
-	for (const auto& Section : Static)
+	const FMBSSectionsLayout& CurrentLayout = GetLayout();
+	TArray<int32> Indices;
+	CurrentLayout.GetIndicesOfLevel(InLevelId, Indices, true);
+	
+	for (const int32 Index : Indices)
 	{
-		if (Section.GetLevelId() != InLevelId)
-		{
-			continue;
-		}
-
-		if (Section.IsValid())
+		if (const FModularSection& Section = Static[Index]; Section.IsValid())
 		{
 			Section.SetMesh(Level->GetInitializer().GetStaticMesh());
 		}
@@ -943,6 +1205,7 @@ void FMBSSections::ReloadMeshes(int32 InLevelId)
 			UE_LOG(LogMBS, Error, TEXT("%s: Error while mesh reload."), *UMBSFunctionLibrary::GetDisplayName(BS));
 		}
 	}
+	MarkChanged();
 	UE_LOG(LogMBS, Log, TEXT("%s: Mesh reload completed"), *UMBSFunctionLibrary::GetDisplayName(BS));
 }
 
@@ -950,6 +1213,7 @@ void FMBSSections::Reset(bool bResetSections, bool bResetActorSections, bool bRe
 {
 	// Removing sections with NULL static mesh
 	ClearInvalidSections();
+	ClearShell();
 	
 	if (bResetSections)
 	{
@@ -985,5 +1249,407 @@ void FMBSSections::Reset(bool bResetSections, bool bResetActorSections, bool bRe
 #endif
 
 		EmptyInstanced();
+		ResetSharedComponents();
+	}
+}
+
+void FMBSSections::BeginTierDetails()
+{
+	if (!HasShell())
+	{
+		ShellStaticNum = Static.Num();
+		ShellActorNum = Actor.Num();
+		ShellOverrides.Reset();
+	}
+	bRecordShellOverrides = true;
+}
+
+FMBSSections FMBSSections::DetachTierDetails(TArray<FMBSShellOverride>& OutOverrides)
+{
+	check(HasShell());
+	FMBSSections OutDetails;
+	OutDetails.BS = BS;
+	OutDetails.SectionSpawnParams = SectionSpawnParams;
+	for (int32 i = ShellStaticNum; i < Static.Num(); i++)
+	{
+		OutDetails.Static.Add(MoveTemp(Static[i]));
+	}
+	for (int32 i = ShellActorNum; i < Actor.Num(); i++)
+	{
+		OutDetails.Actor.Add(MoveTemp(Actor[i]));
+	}
+	Static.SetNum(ShellStaticNum);
+	Actor.SetNum(ShellActorNum);
+	MarkLayoutDirty();
+
+	ApplyShellOverrides(false);
+	OutOverrides = MoveTemp(ShellOverrides);
+	ShellOverrides.Reset();
+	return OutDetails;
+}
+
+void FMBSSections::AttachTierDetails(FMBSSections&& InDetails, TArray<FMBSShellOverride>&& InOverrides)
+{
+	check(HasShell());
+	ensure(Static.Num() == ShellStaticNum && Actor.Num() == ShellActorNum && ShellOverrides.IsEmpty());
+	Static.Append(MoveTemp(InDetails.Static));
+	Actor.Append(MoveTemp(InDetails.Actor));
+	MarkLayoutDirty();
+
+	ShellOverrides = MoveTemp(InOverrides);
+	ApplyShellOverrides(true);
+}
+
+void FMBSSections::ClearShell()
+{
+	ShellStaticNum = INDEX_NONE;
+	ShellActorNum = INDEX_NONE;
+	ShellOverrides.Reset();
+	bRecordShellOverrides = false;
+}
+
+void FMBSSections::ApplyShellOverrides(bool bTier)
+{
+	TSet<UInstancedStaticMeshComponent*> UpdatedComponents;
+	for (int32 i = 0; i < ShellOverrides.Num(); i++)
+	{
+		// Shell state is restored in reverse order, so the first override of the same section wins
+		const FMBSShellOverride& Override = ShellOverrides[bTier ? i : ShellOverrides.Num() - 1 - i];
+		if (Override.Component)
+		{
+			if (IsValid(Override.Component))
+			{
+				Override.Component->UpdateInstanceTransform(Override.Index,
+					bTier ? Override.TierTransform : Override.ShellTransform, false, false, true);
+				UpdatedComponents.Add(Override.Component);
+			}
+		}
+		else if (Static.IsValidIndex(Override.Index))
+		{
+			Static[Override.Index].SetMesh(bTier ? Override.TierMesh : Override.ShellMesh);
+		}
+	}
+
+	for (UInstancedStaticMeshComponent* Component : UpdatedComponents)
+	{
+		Component->MarkRenderStateDirty();
+	}
+	MarkChanged();
+}
+
+void FMBSSections::HideShellInstance(UInstancedStaticMeshComponent* InComponent, int32 InIndex, const FTransform& InTransform)
+{
+	FMBSShellOverride& Override = ShellOverrides.AddDefaulted_GetRef();
+	Override.Component = InComponent;
+	Override.Index = InIndex;
+	Override.ShellTransform = InTransform;
+	Override.TierTransform = InTransform;
+	Override.TierTransform.SetScale3D(FVector::ZeroVector);
+	InComponent->UpdateInstanceTransform(InIndex, Override.TierTransform, false, true, true);
+}
+
+void FMBSSections::RecordAddedInstance(UInstancedStaticMeshComponent* InComponent, int32 InIndex)
+{
+	FMBSShellOverride& Override = ShellOverrides.AddDefaulted_GetRef();
+	Override.Component = InComponent;
+	Override.Index = InIndex;
+	InComponent->GetInstanceTransform(InIndex, Override.TierTransform, false);
+	Override.ShellTransform = Override.TierTransform;
+	Override.ShellTransform.SetScale3D(FVector::ZeroVector);
+}
+
+void FMBSSections::RecordShellMesh(const FModularSection& InSection, UStaticMesh* InNewMesh)
+{
+	const int32 Index = static_cast<int32>(&InSection - Static.GetData());
+	if (!bRecordShellOverrides || Index < 0 || Index >= ShellStaticNum)
+	{
+		return;
+	}
+
+	FMBSShellOverride& Override = ShellOverrides.AddDefaulted_GetRef();
+	Override.Index = Index;
+	Override.ShellMesh = InSection.GetStaticMeshActor()->GetStaticMeshComponent()->GetStaticMesh();
+	Override.TierMesh = InNewMesh;
+}
+
+const FMBSSectionsLayout& FMBSSections::GetLayout() const
+{
+	Layout.Update(Static, Actor);
+	return Layout;
+}
+
+bool FMBSSections::UsesSharedInstancedComponents() const
+{
+	return BS && BS->GetMeshConfiguration().UsesSingleComponentPerUniqueMesh();
+}
+
+UInstancedStaticMeshComponent* FMBSSections::GetOrCreateSharedComponent(UStaticMesh* InStaticMesh)
+{
+	check(BS);
+	if (!InStaticMesh)
+	{
+		UE_LOG(LogMBSSection, Error, TEXT("%s: Can't get shared instanced static mesh component because InStaticMesh was nullptr."),
+			*UMBSFunctionLibrary::GetDisplayName(BS));
+		return nullptr;
+	}
+
+	if (const TObjectPtr<UInstancedStaticMeshComponent>* ExistingComponent = Shared.Find(InStaticMesh);
+		ExistingComponent && IsValid(*ExistingComponent))
+	{
+		return *ExistingComponent;
+	}
+
+	const TSubclassOf<UInstancedStaticMeshComponent> ComponentClass =
+		BS->GetMeshConfiguration().Type == EMBSMeshConfigurationType::HierarchicalInstancedStaticMeshes
+			? UHierarchicalInstancedStaticMeshComponent::StaticClass()
+			: UInstancedStaticMeshComponent::StaticClass();
+
+	const FName ComponentName = MakeUniqueObjectName(BS.GetObject(), ComponentClass,
+		*FString::Printf(TEXT("Shared_%s"), *InStaticMesh->GetName()));
+	UInstancedStaticMeshComponent* NewComponent = NewObject<UInstancedStaticMeshComponent>(BS.GetObject(), ComponentClass, ComponentName);
+	NewComponent->SetMobility(EComponentMobility::Static);
+	NewComponent->SetupAttachment(BS->GetRoot());
+	NewComponent->SetStaticMesh(InStaticMesh);
+	NewComponent->RegisterComponent();
+	Shared.Add(InStaticMesh, NewComponent);
+
+	UE_LOG(LogMBSSection, Verbose, TEXT("%s: Created new shared instanced static mesh component named %s"),
+		*UMBSFunctionLibrary::GetDisplayName(BS), *ComponentName.ToString());
+	return NewComponent;
+}
+
+void FMBSSections::MoveInstancesOfLevel(int32 InLevelId, UStaticMesh* InNewMesh, int32 InEachElement)
+{
+	check(InNewMesh);
+	check(InEachElement > 0);
+	
+	UInstancedStaticMeshComponent* TargetComponent = GetOrCreateSharedComponent(InNewMesh);
+	if (!TargetComponent)
+	{
+		return;
+	}
+
+	// Index of the first instance of each section within the whole level, so each N-th element is counted through all ranges of a level
+	TMap<const FModularSectionInstanced*, int32> LevelIndexOffsets;
+	TArray<UInstancedStaticMeshComponent*> SourceComponents;
+	int32 LevelInstanceCount = 0;
+	bool bLevelIsHidden = false;
+	for (const FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(InLevelId))
+	{
+		if (!Section->IsInstanceRange())
+		{
+			continue;
+		}
+		bLevelIsHidden |= Section->IsHidden();
+		LevelIndexOffsets.Add(Section, LevelInstanceCount);
+		LevelInstanceCount += Section->GetInstanceCount();
+		if (Section->GetISMC() != TargetComponent)
+		{
+			SourceComponents.AddUnique(Section->GetISMC());
+		}
+	}
+
+	TArray<FTransform> MovedTransforms;
+	for (UInstancedStaticMeshComponent* SourceComponent : SourceComponents)
+	{
+		RebuildSharedComponent(SourceComponent, [&LevelIndexOffsets, InEachElement](const FModularSectionInstanced& Owner, int32 Index)
+		{
+			const int32* LevelIndexOffset = LevelIndexOffsets.Find(&Owner);
+			return !LevelIndexOffset || (*LevelIndexOffset + Index) % InEachElement != 0;
+		}, &MovedTransforms);
+	}
+
+	if (!MovedTransforms.IsEmpty())
+	{
+		FModularSectionInstanced NewSection = InitInstanced(InLevelId, false, TargetComponent);
+		TargetComponent->AddInstances(MovedTransforms, false);
+		UpdateInstanceCount(NewSection);
+		if (bLevelIsHidden)
+		{
+			NewSection.SetRangeVisibility(false);
+		}
+		Instanced.Add(NewSection);
+		MarkChanged();
+	}
+
+	// Ranges that were fully moved out are not needed anymore
+	Instanced.RemoveAll([InLevelId](const FModularSectionInstanced& Section) -> bool
+	{
+		return Section.IsInLevel(InLevelId) && Section.IsInstanceRange() && Section.GetInstanceCount() == 0;
+	});
+
+	UE_LOG(LogMBSSection, Verbose, TEXT("%s: %d instances of level with Id=%d were moved to %s component."),
+		*UMBSFunctionLibrary::GetDisplayName(BS), MovedTransforms.Num(), InLevelId, *TargetComponent->GetName());
+}
+
+void FMBSSections::RebuildSharedComponent(UInstancedStaticMeshComponent* InComponent,
+	TFunctionRef<bool(const FModularSectionInstanced&, int32)> ShouldKeep, TArray<FTransform>* OutRemovedTransforms)
+{
+	check(InComponent);
+
+	TArray<FModularSectionInstanced*> Owners;
+	for (FModularSectionInstanced& Section : Instanced)
+	{
+		if (Section.GetISMC() == InComponent && Section.IsInstanceRange())
+		{
+			Owners.Add(&Section);
+		}
+	}
+	Owners.Sort([](const FModularSectionInstanced& A, const FModularSectionInstanced& B)
+	{
+		return A.GetFirstInstanceIndex() < B.GetFirstInstanceIndex();
+	});
+
+	TArray<int32> NewFirstIndices;
+	TArray<int32> NewCounts;
+	TArray<TArray<FTransform>> NewHiddenTransforms;
+	NewFirstIndices.Init(INDEX_NONE, Owners.Num());
+	NewCounts.Init(0, Owners.Num());
+	NewHiddenTransforms.SetNum(Owners.Num());
+
+	const int32 InstanceCount = InComponent->GetInstanceCount();
+	TArray<FTransform> KeptTransforms;
+	KeptTransforms.Reserve(InstanceCount);
+
+	// Ranges are sorted and don't overlap, so the owner of each instance can be found by walking the ranges once
+	int32 OwnerIndex = 0;
+	for (int32 i = 0; i < InstanceCount; i++)
+	{
+		FTransform InstanceTransform;
+		InComponent->GetInstanceTransform(i, InstanceTransform, false);
+
+		while (Owners.IsValidIndex(OwnerIndex) && i >= Owners[OwnerIndex]->ToComponentIndex(Owners[OwnerIndex]->GetInstanceCount()))
+		{
+			OwnerIndex++;
+		}
+
+		const bool bOwned = Owners.IsValidIndex(OwnerIndex) && i >= Owners[OwnerIndex]->GetFirstInstanceIndex();
+		if (bOwned && NewFirstIndices[OwnerIndex] == INDEX_NONE)
+		{
+			NewFirstIndices[OwnerIndex] = KeptTransforms.Num();
+		}
+
+		// Instances of hidden ranges are scaled to zero, so their actual transforms are taken from the range itself
+		const bool bHidden = bOwned && Owners[OwnerIndex]->IsHidden();
+		const FTransform CollapsedTransform = InstanceTransform;
+		if (bHidden)
+		{
+			InstanceTransform = Owners[OwnerIndex]->GetHiddenTransforms()[i - Owners[OwnerIndex]->GetFirstInstanceIndex()];
+		}
+
+		if (!bOwned || ShouldKeep(*Owners[OwnerIndex], i - Owners[OwnerIndex]->GetFirstInstanceIndex()))
+		{
+			KeptTransforms.Add(bHidden ? CollapsedTransform : InstanceTransform);
+			if (bOwned)
+			{
+				NewCounts[OwnerIndex]++;
+			}
+			if (bHidden)
+			{
+				NewHiddenTransforms[OwnerIndex].Add(InstanceTransform);
+			}
+		}
+		else if (OutRemovedTransforms)
+		{
+			OutRemovedTransforms->Add(InstanceTransform);
+		}
+	}
+
+	for (int32 i = 0; i < Owners.Num(); i++)
+	{
+		Owners[i]->SetInstanceRange(NewFirstIndices[i] != INDEX_NONE ? NewFirstIndices[i] : KeptTransforms.Num(), NewCounts[i]);
+		if (Owners[i]->IsHidden())
+		{
+			Owners[i]->SetHiddenTransforms(MoveTemp(NewHiddenTransforms[i]));
+		}
+	}
+
+	const int32 RemovedCount = InstanceCount - KeptTransforms.Num();
+	if (RemovedCount > 0)
+	{
+		// Removing instances one by one may reorder them (HISMC removes with swap), which would break the ranges,
+		// so the component is refilled with all kept instances in a single batch instead.
+		InComponent->ClearInstances();
+		InComponent->AddInstances(KeptTransforms, false);
+#if WITH_EDITOR
+		TotalInstanceCount -= RemovedCount;
+#endif
+		MarkChanged();
+	}
+
+	UE_LOG(LogMBSSection, Verbose, TEXT("%s: Shared component %s was rebuilt. %d instances removed, %d instances kept."),
+		*UMBSFunctionLibrary::GetDisplayName(BS), *InComponent->GetName(), RemovedCount, KeptTransforms.Num());
+}
+
+void FMBSSections::RemoveInstancesOfLevel(int32 InLevelId, bool bRemoveSections)
+{
+	TArray<UInstancedStaticMeshComponent*> Components;
+	for (const FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(InLevelId))
+	{
+		if (Section->IsInstanceRange())
+		{
+			Components.AddUnique(Section->GetISMC());
+		}
+	}
+
+	for (UInstancedStaticMeshComponent* Component : Components)
+	{
+		RebuildSharedComponent(Component, [InLevelId](const FModularSectionInstanced& Owner, int32 Index)
+		{
+			return !Owner.IsInLevel(InLevelId);
+		});
+	}
+
+	if (bRemoveSections)
+	{
+		Instanced.RemoveAll([InLevelId](const FModularSectionInstanced& Section) -> bool
+		{
+			return Section.IsInLevel(InLevelId) && Section.IsInstanceRange();
+		});
+	}
+}
+
+void FMBSSections::OffsetInstancesOfLevel(int32 InLevelId, FVector Offset) const
+{
+	for (FModularSectionInstanced* Section : GetInstancedSectionsOfLevel(InLevelId))
+	{
+		if (!Section->GetISMC() || Section->GetInstanceCount() == 0)
+		{
+			continue;
+		}
+
+		// All instances of a range are contiguous, so they are updated with a single batch call
+		TArray<int32> Indices;
+		Indices.SetNumUninitialized(Section->GetInstanceCount());
+		for (int32 i = 0; i < Indices.Num(); i++)
+		{
+			Indices[i] = i;
+		}
+
+		// Hidden range is shown for the time of the offset, so its stored transforms are offset as well
+		const bool bHidden = Section->IsHidden();
+		if (bHidden)
+		{
+			Section->SetRangeVisibility(true);
+		}
+		Section->OffsetRange(Indices, Offset, false);
+		if (bHidden)
+		{
+			Section->SetRangeVisibility(false);
+		}
+	}
+}
+
+void FMBSSections::ResetSharedComponents()
+{
+	for (const auto& Pair : Shared)
+	{
+		if (UInstancedStaticMeshComponent* Component = Pair.Value; IsValid(Component))
+		{
+			Component->ClearInstances();
+			Component->UnregisterComponent();
+			Component->DestroyComponent();
+		}
 	}
+	Shared.Empty();
 }
@@ -0,0 +1,278 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSSectionsBVH.h"
+
+#include "ModularBuildSystem.h"
+#include "ModularBuildSystemActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+bool FMBSSectionsBVH::IsOutdated(const AModularBuildSystemActor* InBuildSystem) const
+{
+	if (bDirty || BuildSystem.Get() != InBuildSystem)
+	{
+		return true;
+	}
+	if (!InBuildSystem)
+	{
+		return false;
+	}
+	if (!Transform.Equals(InBuildSystem->GetActorTransform(), 0.0))
+	{
+		return true;
+	}
+
+	// Signature is calculated again only after the build system was marked as changed
+	return Revision != InBuildSystem->GetRevision() && Signature != CalculateSignature(InBuildSystem);
+}
+
+void FMBSSectionsBVH::Build(AModularBuildSystemActor* InBuildSystem)
+{
+	Nodes.Reset();
+	Primitives.Reset();
+	BuildSystem = InBuildSystem;
+	Transform = InBuildSystem ? InBuildSystem->GetActorTransform() : FTransform::Identity;
+	Revision = InBuildSystem ? InBuildSystem->GetRevision() : 0;
+	Signature = CalculateSignature(InBuildSystem);
+	bDirty = false;
+
+	if (!InBuildSystem)
+	{
+		return;
+	}
+
+	const FMBSSections& Sections = InBuildSystem->GetSections();
+	const FMBSSectionsLayout& Layout = Sections.GetLayout();
+	Primitives.Reserve(Layout.Num());
+	for (int32 i = 0; i < Layout.Num(); i++)
+	{
+		AActor* Handle = Layout.GetHandleAt(i);
+		if (!Handle || !Handle->GetRootComponent() || !Handle->GetRootComponent()->IsVisible())
+		{
+			continue;
+		}
+
+		FPrimitive& Primitive = Primitives.AddDefaulted_GetRef();
+		Primitive.Bounds = Handle->GetComponentsBoundingBox(true);
+		Primitive.Type = Layout.IsActorAt(i) ? EMBSSectionHitType::Actor : EMBSSectionHitType::Static;
+		Primitive.SectionIndex = Layout.IsActorAt(i) ? i - Layout.GetStaticNum() : i;
+		Primitive.LevelId = Layout.GetLevelIdAt(i);
+		Primitive.Object = Handle;
+	}
+
+	const TArray<FModularSectionInstanced>& Instanced = Sections.GetInstanced();
+	for (int32 SectionIndex = 0; SectionIndex < Instanced.Num(); SectionIndex++)
+	{
+		const FModularSectionInstanced& Section = Instanced[SectionIndex];
+		UInstancedStaticMeshComponent* Component = Section.GetISMC();
+		if (!Section.IsValid() || !Component->IsVisible() || !Component->GetStaticMesh())
+		{
+			continue;
+		}
+
+		const FBox MeshBox = Component->GetStaticMesh()->GetBounds().GetBox();
+		const int32 InstanceCount = Section.GetInstanceCount();
+		Primitives.Reserve(Primitives.Num() + InstanceCount);
+		for (int32 InstanceIndex = 0; InstanceIndex < InstanceCount; InstanceIndex++)
+		{
+			FTransform InstanceTransform;
+			// Hidden instances are scaled to zero and can't be hit
+			if (!Component->GetInstanceTransform(Section.ToComponentIndex(InstanceIndex), InstanceTransform, true)
+				|| InstanceTransform.GetScale3D().IsNearlyZero())
+			{
+				continue;
+			}
+
+			FPrimitive& Primitive = Primitives.AddDefaulted_GetRef();
+			Primitive.Bounds = MeshBox.TransformBy(InstanceTransform);
+			Primitive.Type = EMBSSectionHitType::Instanced;
+			Primitive.SectionIndex = SectionIndex;
+			Primitive.LevelId = Section.GetLevelId();
+			Primitive.InstanceIndex = InstanceIndex;
+			Primitive.Object = Component;
+		}
+	}
+
+	if (Primitives.IsEmpty())
+	{
+		return;
+	}
+
+	// Median splits keep at least two primitives per leaf, so there are never more nodes than primitives
+	Nodes.Reserve(Primitives.Num());
+	Nodes.AddDefaulted();
+	BuildNode(0, 0, Primitives.Num());
+
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Sections BVH was built (Primitives=%d, Nodes=%d)."),
+		*InBuildSystem->GetName(), Primitives.Num(), Nodes.Num());
+}
+
+bool FMBSSectionsBVH::Update(AModularBuildSystemActor* InBuildSystem)
+{
+	if (!IsOutdated(InBuildSystem))
+	{
+		// Build system might have been marked as changed without any change of its signature
+		Revision = InBuildSystem ? InBuildSystem->GetRevision() : 0;
+		return false;
+	}
+	Build(InBuildSystem);
+	return true;
+}
+
+bool FMBSSectionsBVH::RaycastBounds(const FVector& InOrigin, const FVector& InDirection, double InMaxDistance,
+	double& OutDistance) const
+{
+	return !Nodes.IsEmpty() && IntersectRay(Nodes[0].Bounds, InOrigin, GetInvDirection(InDirection), InMaxDistance, OutDistance);
+}
+
+bool FMBSSectionsBVH::Raycast(const FVector& InOrigin, const FVector& InDirection, double InMaxDistance,
+	FMBSSectionHit& OutHit) const
+{
+	if (Nodes.IsEmpty())
+	{
+		return false;
+	}
+
+	const FVector InvDirection = GetInvDirection(InDirection);
+
+	double ClosestDistance = InMaxDistance;
+	int32 ClosestPrimitive = INDEX_NONE;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+	while (!Stack.IsEmpty())
+	{
+		const FNode& Node = Nodes[Stack.Pop(false)];
+		double NodeDistance;
+		if (!IntersectRay(Node.Bounds, InOrigin, InvDirection, ClosestDistance, NodeDistance))
+		{
+			continue;
+		}
+
+		if (Node.Count == 0)
+		{
+			Stack.Add(Node.First);
+			Stack.Add(Node.First + 1);
+			continue;
+		}
+
+		for (int32 i = Node.First; i < Node.First + Node.Count; i++)
+		{
+			double PrimitiveDistance;
+			if (IntersectRay(Primitives[i].Bounds, InOrigin, InvDirection, ClosestDistance, PrimitiveDistance)
+				&& PrimitiveDistance < ClosestDistance)
+			{
+				ClosestDistance = PrimitiveDistance;
+				ClosestPrimitive = i;
+			}
+		}
+	}
+
+	if (ClosestPrimitive == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FPrimitive& Primitive = Primitives[ClosestPrimitive];
+	OutHit.BuildSystem = BuildSystem;
+	OutHit.Type = Primitive.Type;
+	OutHit.SectionIndex = Primitive.SectionIndex;
+	OutHit.LevelId = Primitive.LevelId;
+	OutHit.InstanceIndex = Primitive.InstanceIndex;
+	OutHit.Distance = ClosestDistance;
+	OutHit.Actor = Primitive.Type != EMBSSectionHitType::Instanced ? Cast<AActor>(Primitive.Object.Get()) : nullptr;
+	OutHit.Component = Primitive.Type == EMBSSectionHitType::Instanced ? Cast<UInstancedStaticMeshComponent>(Primitive.Object.Get()) : nullptr;
+	return true;
+}
+
+uint32 FMBSSectionsBVH::CalculateSignature(const AModularBuildSystemActor* InBuildSystem)
+{
+	if (!InBuildSystem)
+	{
+		return 0;
+	}
+
+	uint32 OutSignature = GetTypeHash(InBuildSystem->GetSections().GetRevision());
+
+	// Instances are not tracked by the layout, so instance count and bounds of each component are used instead
+	for (const FModularSectionInstanced& Section : InBuildSystem->GetSections().GetInstanced())
+	{
+		const UInstancedStaticMeshComponent* Component = Section.GetISMC();
+		OutSignature = HashCombine(OutSignature, GetTypeHash(Component));
+		if (Section.IsValid())
+		{
+			OutSignature = HashCombine(OutSignature, GetTypeHash(Section.GetInstanceCount()));
+			OutSignature = HashCombine(OutSignature, GetTypeHash(Component->Bounds.Origin));
+			OutSignature = HashCombine(OutSignature, GetTypeHash(Component->Bounds.BoxExtent));
+			OutSignature = HashCombine(OutSignature, static_cast<uint32>(Component->IsVisible()));
+		}
+	}
+	return OutSignature;
+}
+
+FVector FMBSSectionsBVH::GetInvDirection(const FVector& InDirection)
+{
+	const auto SafeInverse = [](double Value)
+	{
+		return FMath::Abs(Value) > UE_DOUBLE_SMALL_NUMBER ? 1.0 / Value : (Value < 0.0 ? -UE_DOUBLE_BIG_NUMBER : UE_DOUBLE_BIG_NUMBER);
+	};
+	return FVector(SafeInverse(InDirection.X), SafeInverse(InDirection.Y), SafeInverse(InDirection.Z));
+}
+
+bool FMBSSectionsBVH::IntersectRay(const FBox& InBox, const FVector& InOrigin, const FVector& InInvDirection,
+	double InMaxDistance, double& OutDistance)
+{
+	double TMin = 0.0;
+	double TMax = InMaxDistance;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		double T0 = (InBox.Min[Axis] - InOrigin[Axis]) * InInvDirection[Axis];
+		double T1 = (InBox.Max[Axis] - InOrigin[Axis]) * InInvDirection[Axis];
+		if (T0 > T1)
+		{
+			Swap(T0, T1);
+		}
+		TMin = FMath::Max(TMin, T0);
+		TMax = FMath::Min(TMax, T1);
+		if (TMin > TMax)
+		{
+			return false;
+		}
+	}
+	OutDistance = TMin;
+	return true;
+}
+
+void FMBSSectionsBVH::BuildNode(int32 NodeIndex, int32 First, int32 Count)
+{
+	FBox NodeBounds(ForceInit);
+	FBox CenterBounds(ForceInit);
+	for (int32 i = First; i < First + Count; i++)
+	{
+		NodeBounds += Primitives[i].Bounds;
+		CenterBounds += Primitives[i].Bounds.GetCenter();
+	}
+	Nodes[NodeIndex].Bounds = NodeBounds;
+
+	if (Count <= MaxLeafSize)
+	{
+		Nodes[NodeIndex].First = First;
+		Nodes[NodeIndex].Count = Count;
+		return;
+	}
+
+	// Median split along the longest axis of primitive centers
+	const FVector CenterExtent = CenterBounds.GetExtent();
+	const int32 Axis = CenterExtent.X >= CenterExtent.Y && CenterExtent.X >= CenterExtent.Z ? 0 : (CenterExtent.Y >= CenterExtent.Z ? 1 : 2);
+	MakeArrayView(Primitives.GetData() + First, Count).Sort([Axis](const FPrimitive& A, const FPrimitive& B)
+	{
+		return A.Bounds.GetCenter()[Axis] < B.Bounds.GetCenter()[Axis];
+	});
+
+	const int32 LeftCount = Count / 2;
+	const int32 LeftIndex = Nodes.AddDefaulted(2);
+	Nodes[NodeIndex].First = LeftIndex;
+	Nodes[NodeIndex].Count = 0;
+	BuildNode(LeftIndex, First, LeftCount);
+	BuildNode(LeftIndex + 1, First + LeftCount, Count - LeftCount);
+}
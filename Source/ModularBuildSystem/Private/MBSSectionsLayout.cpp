@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSSectionsLayout.h"
+
+#include "ModularSection.h"
+#include "Engine/StaticMeshActor.h"
+
+void FMBSSectionsLayout::Update(const TArray<FModularSection>& InStatic, const TArray<FModularSectionActor>& InActor)
+{
+	if (!bDirty)
+	{
+		return;
+	}
+
+	LevelIds.Reset();
+	Handles.Reset();
+
+	const int32 TotalNum = InStatic.Num() + InActor.Num();
+	LevelIds.Reserve(TotalNum);
+	Handles.Reserve(TotalNum);
+
+	for (const FModularSection& Section : InStatic)
+	{
+		LevelIds.Add(Section.GetLevelId());
+		Handles.Add(Section.GetStaticMeshActor());
+	}
+	StaticNum = InStatic.Num();
+
+	for (const FModularSectionActor& Section : InActor)
+	{
+		LevelIds.Add(Section.GetLevelId());
+		Handles.Add(Section.GetActor());
+	}
+
+	bDirty = false;
+}
+
+void FMBSSectionsLayout::GetIndicesOfLevel(int32 InLevelId, TArray<int32>& OutIndices, bool bStaticOnly) const
+{
+	const int32 EndIndex = bStaticOnly ? StaticNum : LevelIds.Num();
+	for (int32 i = 0; i < EndIndex; i++)
+	{
+		if (LevelIds[i] == InLevelId)
+		{
+			OutIndices.Add(i);
+		}
+	}
+}
@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBSSplinePath.h"
+
+#include "Algo/BinarySearch.h"
+#include "Components/SplineComponent.h"
+
+namespace
+{
+	uint32 GetSplinePointHash(const USplineComponent& Spline, int32 PointIndex)
+	{
+		const FSplinePoint Point = Spline.GetSplinePointAt(PointIndex, ESplineCoordinateSpace::Local);
+		uint32 Hash = FCrc::MemCrc32(&Point.Position, sizeof(Point.Position));
+		Hash = FCrc::MemCrc32(&Point.Rotation, sizeof(Point.Rotation), Hash);
+
+		// Tangents of linear points are updated from the next point, while they don't change the shape of a segment
+		if (Point.Type != ESplinePointType::Linear && Point.Type != ESplinePointType::Constant)
+		{
+			Hash = FCrc::MemCrc32(&Point.ArriveTangent, sizeof(Point.ArriveTangent), Hash);
+			Hash = FCrc::MemCrc32(&Point.LeaveTangent, sizeof(Point.LeaveTangent), Hash);
+		}
+		return HashCombine(Hash, GetTypeHash(Point.Type));
+	}
+}
+
+void FMBSSplineArcLengthTable::Build(const USplineComponent& Spline, float SampleLength)
+{
+	Reset();
+
+	const int32 PointCount = Spline.GetNumberOfSplinePoints();
+	const int32 SegmentCount = Spline.GetNumberOfSplineSegments();
+	if (SegmentCount <= 0 || SampleLength <= 0.f)
+	{
+		return;
+	}
+
+	const float SplineLength = Spline.GetSplineLength();
+	SegmentDistances.Reserve(SegmentCount + 1);
+	SegmentHashes.Reserve(SegmentCount);
+	for (int32 Segment = 0; Segment < SegmentCount; Segment++)
+	{
+		// Last segment of a closed loop ends at the first point
+		const float Start = Spline.GetDistanceAlongSplineAtSplinePoint(Segment);
+		const float End = Segment + 1 < PointCount ? Spline.GetDistanceAlongSplineAtSplinePoint(Segment + 1) : SplineLength;
+		SegmentDistances.Add(Start);
+		SegmentHashes.Add(HashCombine(GetSplinePointHash(Spline, Segment),
+			GetSplinePointHash(Spline, (Segment + 1) % PointCount)));
+
+		// Each segment is sampled separately, so changing it doesn't move samples of other segments.
+		// End of a segment is added as the start of the next one.
+		const int32 SampleCount = FMath::Max(1, FMath::CeilToInt((End - Start) / SampleLength));
+		for (int32 i = 0; i < SampleCount; i++)
+		{
+			AddSample(Spline, FMath::Lerp(Start, End, static_cast<float>(i) / SampleCount));
+		}
+	}
+	SegmentDistances.Add(SplineLength);
+	AddSample(Spline, SplineLength);
+}
+
+void FMBSSplineArcLengthTable::Reset()
+{
+	Distances.Reset();
+	Locations.Reset();
+	Rotations.Reset();
+	SegmentDistances.Reset();
+	SegmentHashes.Reset();
+}
+
+FTransform FMBSSplineArcLengthTable::GetTransformAtDistance(float Distance) const
+{
+	if (Distances.IsEmpty())
+	{
+		return FTransform::Identity;
+	}
+	if (Distances.Num() == 1)
+	{
+		return FTransform(Rotations[0], Locations[0]);
+	}
+
+	const float ClampedDistance = FMath::Clamp(Distance, 0.f, GetLength());
+	const int32 Upper = FMath::Clamp(Algo::UpperBound(Distances, ClampedDistance), 1, Distances.Num() - 1);
+	const int32 Lower = Upper - 1;
+
+	const float Range = Distances[Upper] - Distances[Lower];
+	const float Alpha = Range > KINDA_SMALL_NUMBER ? (ClampedDistance - Distances[Lower]) / Range : 0.f;
+	return FTransform(
+		FQuat::Slerp(Rotations[Lower], Rotations[Upper], Alpha),
+		FMath::Lerp(Locations[Lower], Locations[Upper], Alpha));
+}
+
+void FMBSSplineArcLengthTable::AddSample(const USplineComponent& Spline, float Distance)
+{
+	Distances.Add(Distance);
+	Locations.Add(Spline.GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local));
+	Rotations.Add(Spline.GetQuaternionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local));
+}
+
+void FMBSSplinePath::Build(const USplineComponent& Spline, float InSectionLength)
+{
+	Reset();
+	if (InSectionLength <= 0.f)
+	{
+		return;
+	}
+
+	SectionLength = InSectionLength;
+	Table.Build(Spline, SectionLength / SamplesPerSection);
+
+	const int32 SegmentCount = Table.GetSegmentCount();
+	SegmentFirstSections.Reserve(SegmentCount + 1);
+	SegmentFirstSections.Add(0);
+	for (int32 Segment = 0; Segment < SegmentCount; Segment++)
+	{
+		// Segments of zero length (e.g. duplicated points) get no sections
+		const float SegmentLength = Table.GetSegmentLength(Segment);
+		const int32 Count = SegmentLength > KINDA_SMALL_NUMBER
+			? FMath::Max(1, FMath::RoundToInt(SegmentLength / SectionLength))
+			: 0;
+		SegmentFirstSections.Add(SegmentFirstSections.Last() + Count);
+	}
+}
+
+void FMBSSplinePath::Reset()
+{
+	Table.Reset();
+	SectionLength = 0.f;
+	SegmentFirstSections.Reset();
+}
+
+int32 FMBSSplinePath::GetSegmentAt(float StraightX) const
+{
+	if (!IsValid())
+	{
+		return INDEX_NONE;
+	}
+	const int32 SectionIndex = FMath::Clamp(FMath::FloorToInt(StraightX / SectionLength), 0, GetSectionCount() - 1);
+	return GetSegmentOfSection(SectionIndex);
+}
+
+FTransform FMBSSplinePath::Warp(const FTransform& StraightTransform) const
+{
+	if (!IsValid())
+	{
+		return StraightTransform;
+	}
+
+	const FVector Location = StraightTransform.GetLocation();
+	const int32 Segment = GetSegmentAt(Location.X);
+	const int32 SegmentSectionCount = SegmentFirstSections[Segment + 1] - SegmentFirstSections[Segment];
+
+	// Sections of a segment are stretched to fill the whole segment
+	const float Stretch = Table.GetSegmentLength(Segment) / (SegmentSectionCount * SectionLength);
+	const float LocationInSegment = Location.X - SegmentFirstSections[Segment] * SectionLength;
+	const float Distance = Table.GetSegmentStart(Segment) + LocationInSegment * Stretch;
+
+	// Beyond the ends of the spline sections continue straight
+	const float ClampedDistance = FMath::Clamp(Distance, 0.f, Table.GetLength());
+	const FTransform Frame = Table.GetTransformAtDistance(ClampedDistance);
+
+	// Section is stretched along its axis that is the closest to the spline direction
+	FVector Scale = StraightTransform.GetScale3D();
+	const FVector LocalForward = StraightTransform.GetRotation().UnrotateVector(FVector::ForwardVector).GetAbs();
+	const int32 Axis = LocalForward.X >= LocalForward.Y && LocalForward.X >= LocalForward.Z
+		? 0
+		: (LocalForward.Y >= LocalForward.Z ? 1 : 2);
+	Scale[Axis] *= Stretch;
+
+	return FTransform(
+		Frame.GetRotation() * StraightTransform.GetRotation(),
+		Frame.TransformPosition(FVector(Distance - ClampedDistance, Location.Y, Location.Z)),
+		Scale);
+}
+
+bool FMBSSplinePath::HasSameSections(const FMBSSplinePath& Other) const
+{
+	return SectionLength == Other.SectionLength && SegmentFirstSections == Other.SegmentFirstSections;
+}
+
+void FMBSSplinePath::GetChangedSegments(const FMBSSplinePath& Other, TArray<int32>& OutSegments) const
+{
+	check(HasSameSections(Other));
+	for (int32 Segment = 0; Segment < Table.GetSegmentCount(); Segment++)
+	{
+		if (Table.GetSegmentHash(Segment) != Other.Table.GetSegmentHash(Segment))
+		{
+			OutSegments.Add(Segment);
+		}
+	}
+}
+
+int32 FMBSSplinePath::GetSegmentOfSection(int32 SectionIndex) const
+{
+	// Segments without sections have the same first section as the next segment, so the last of them is found
+	return Algo::UpperBound(SegmentFirstSections, SectionIndex) - 1;
+}
@@ -3,6 +3,7 @@
 
 #include "ModularBuildSystemActor.h"
 #include "ModularBuildSystem.h"
+#include "MBSBuildSystemRegistry.h"
 #include "List/ModularBuildSystemMeshList.h"
 #include "ModularBuildSystemPreset.h"
 #include "List/ModularBuildSystemPresetList.h"
@@ -20,6 +21,11 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -33,9 +39,12 @@
 #endif
 
 #include "MBSFunctionLibrary.h"
+#include "MBSPresetLayout.h"
+#include "MBSSplinePath.h"
 #include "Config/MBSSettings.h"
 #include "Config/MBSSpawnConfiguration.h"
 #include "Timer.h"
+#include "Algo/AllOf.h"
 #include "Components/SplineComponent.h"
 #include "Interior/MBSInteriorGenerator.h"
 
@@ -99,6 +108,7 @@ void AModularBuildSystemActor::PostActorCreated()
 	{
 		MeshConfiguration.DefaultType = Settings->DefaultMeshConfigurationType;
 		MeshConfiguration.Type = MeshConfiguration.DefaultType;
+		MeshConfiguration.bUseSingleComponentPerUniqueMesh = Settings->bUseSingleInstancedComponentPerUniqueMesh;
 		
 		SpawnConfiguration.DefaultClampMode = Settings->DefaultClampMode;
 		SpawnConfiguration.ClampMode = SpawnConfiguration.DefaultClampMode;
@@ -115,15 +125,116 @@ void AModularBuildSystemActor::PostEditChangeProperty(FPropertyChangedEvent& Pro
 {
 	UpdateTransformBounds(PropertyChangedEvent);
 	//SetupSpline();
+	MarkChanged();
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 }
 
 void AModularBuildSystemActor::PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent)
 {
 	UpdateTransformBounds(PropertyChangedEvent);
+	MarkChanged();
 	Super::PostEditChangeChainProperty(PropertyChangedEvent);
 }
 
+#if WITH_EDITOR
+void AModularBuildSystemActor::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// Preview scale is not transacted, so the scale from before the preview is restored together with the properties
+	ClearRegenerationPreview();
+
+	// Sections arrays were restored from the transaction, so the transient layout must be rebuilt
+	Sections.MarkLayoutDirty();
+	UpdateRegistryMergeState();
+	MarkChanged();
+	UpdateSharedInstances();
+}
+
+void AModularBuildSystemActor::PostEditMove(bool bFinished)
+{
+	Super::PostEditMove(bFinished);
+
+	// Shared chunks store world transforms, so they are outdated after the build system was moved
+	if (bFinished)
+	{
+		UpdateSharedInstances();
+	}
+}
+#endif
+
+void AModularBuildSystemActor::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// Preview scale is temporary and must not end up in the saved transform
+	ClearRegenerationPreview();
+
+	// Own components are hidden only while this build system is registered in the shared instancing subsystem,
+	// so they are saved visible and hidden again once the package was saved
+	if (SharedInstancesHandle.IsValid())
+	{
+		SetInstancedComponentsVisibility(true);
+#if WITH_EDITOR
+		if (!PackageSavedHandle.IsValid())
+		{
+			PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddUObject(this, &AModularBuildSystemActor::OnPackageSaved);
+		}
+#endif
+	}
+}
+
+#if WITH_EDITOR
+void AModularBuildSystemActor::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	// Package is either the level or the external package of this actor
+	if (Package != GetPackage())
+	{
+		return;
+	}
+
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	PackageSavedHandle.Reset();
+
+	if (SharedInstancesHandle.IsValid())
+	{
+		SetInstancedComponentsVisibility(false);
+	}
+}
+#endif
+
+void AModularBuildSystemActor::PostRegisterAllComponents()
+{
+	Super::PostRegisterAllComponents();
+
+	if (UMBSBuildSystemRegistry* Registry = UMBSBuildSystemRegistry::Get(GetWorld()))
+	{
+		Registry->Register(this);
+	}
+
+	// Handle is transient, so loaded build systems are registered in the shared instancing subsystem again
+	UpdateSharedInstances();
+}
+
+void AModularBuildSystemActor::PostUnregisterAllComponents()
+{
+	if (UMBSBuildSystemRegistry* Registry = UMBSBuildSystemRegistry::Get(GetWorld()))
+	{
+		Registry->Unregister(this);
+	}
+
+	if (UMBSRegenerationScheduler* Scheduler = UMBSRegenerationScheduler::Get(GetWorld()))
+	{
+		Scheduler->Cancel(this);
+	}
+	ClearRegenerationPreview();
+
+	// Instances of unregistered build systems (e.g. of unloaded levels or world partition cells) must not stay in the shared chunks
+	ReleaseSharedInstances();
+
+	Super::PostUnregisterAllComponents();
+}
+
 void AModularBuildSystemActor::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
@@ -131,6 +242,8 @@ void AModularBuildSystemActor::OnConstruction(const FTransform& Transform)
 	// Currently there is a bug that invalidates RootComponent (set it to InstancedStaticMeshComponent instead of DefaultSceneRoot after PostEditChangeProperty)
 	// So we need to handle it here. Fixing root component here if necessary.
 	UMBSFunctionLibrary::FixRootComponent(this);
+	MarkChanged();
+	UpdateSharedInstances();
 }
 
 // Called when the game starts or when spawned
@@ -150,6 +263,28 @@ void AModularBuildSystemActor::BeginPlay()
 		UE_LOG(LogMBS, Error, TEXT("%s: Root component was nullptr on BeginPlay!"), *GetName());
 	}
 #endif
+
+	UpdateSharedInstances();
+
+	if (TierConfiguration.bSwitchByDistance)
+	{
+		GetWorldTimerManager().SetTimer(GenerationTierTimerHandle, this,
+			&AModularBuildSystemActor::UpdateGenerationTierByDistance, TierConfiguration.UpdateInterval, true);
+	}
+}
+
+void AModularBuildSystemActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(GenerationTierTimerHandle);
+	CancelTimeSlicedGeneration();
+	ReleaseSharedInstances();
+	Super::EndPlay(EndPlayReason);
+}
+
+void AModularBuildSystemActor::Destroyed()
+{
+	ReleaseSharedInstances();
+	Super::Destroyed();
 }
 
 TArray<FModularSection> AModularBuildSystemActor::InitModularSections(const FInitModularSectionsArgs& Args)
@@ -161,12 +296,16 @@ TArray<FModularSection> AModularBuildSystemActor::InitModularSections(const FIni
 	//const FIntPoint Bounds = BuildStats.Bounds;
 	//UE_LOG(LogMBS, Verbose, TEXT("%s: Bounds calculated: x = %d, y = %d"), *GetName(), Bounds.X, Bounds.Y);
 
+	TArray<FTransform> NewTransforms;
+	UMBSFunctionLibrary::CalculateNewTransforms(BuildStats, ActorTransform, Args, NewTransforms);
+	OutSections.Reserve(Args.Initializer.GetTotalCount());
+	
 	for (int32 i = 0; i < Args.Initializer.GetTotalCount(); i++)
 	{
 		UE_LOG(LogMBS, Verbose, TEXT("%s: --- Initializing section at index=%d"), *GetName(), i);
 		bool bOutShouldBeSkipped = false;
-		FTransform NewTransform = UMBSFunctionLibrary::CalculateNewTransform(
-			this, BuildStats, i, ActorTransform, Args, bOutShouldBeSkipped);
+		FTransform NewTransform = NewTransforms[i];
+		UMBSFunctionLibrary::ShapeNewTransform(this, BuildStats, i, Args, NewTransform, bOutShouldBeSkipped);
 
 		if (bOutShouldBeSkipped)
 		{
@@ -220,22 +359,24 @@ void AModularBuildSystemActor::UpdateModularSections(const FInitModularSectionsA
 		TEXT("%s: CurrentLevelSectionsCount=%d >= Args.Initializer.TotalCount=%d; Args.InLevelId=%d, LevelName=%s"),
 		*GetName(), CurrentLevelSectionsCount, TotalCount, Args.InLevelId, *CurrentLevel->GetName());
 	
+	TArray<FTransform> NewTransforms;
+	UMBSFunctionLibrary::CalculateNewTransforms(BuildStats, ActorTransform, Args, NewTransforms);
 	for (int32 i = 0; i < TotalCount; i++) // TODO: Maybe use SectionsOfThisLevel.Num()?
 	{
 		UE_LOG(LogMBS, Verbose, TEXT("%s: --- Updating section (%s) at index=%d"),
 			*GetName(), *CurrentLevelSections[i]->GetName(), i);
 		bool bOutShouldBeSkipped = false;
-		FTransform NewTransform = UMBSFunctionLibrary::CalculateNewTransform(
-			this, BuildStats, i, ActorTransform, Args, bOutShouldBeSkipped);
+		UMBSFunctionLibrary::ShapeNewTransform(this, BuildStats, i, Args, NewTransforms[i], bOutShouldBeSkipped);
 		// TODO: Do we need to skip here (due to shape adjustment)?
-
-		// Update existing section with newly calculated transform
-		CurrentLevelSections[i]->SetTransform(NewTransform);
-
-		// Update mesh in case it is not the same as initializer's
-		CurrentLevelSections[i]->SetMesh(Args.Initializer.GetStaticMesh());
 	}
 
+	// Update existing sections with newly calculated transforms and mesh (in case it is not the same as initializer's)
+	// in a single batch, so each section actor is moved only once
+	const TConstArrayView<FModularSection*> UpdatedSections = MakeArrayView(CurrentLevelSections.GetData(), TotalCount);
+	FModularSection::BatchSetTransforms(UpdatedSections, NewTransforms);
+	FModularSection::BatchSetMesh(UpdatedSections, Args.Initializer.GetStaticMesh());
+	MarkChanged();
+
 	// TODO: Remove existing or leave it to the Generator implementer? Removing for now.
 	if (CurrentLevelSectionsCount > TotalCount)
 	{
@@ -254,51 +395,86 @@ FTransform AModularBuildSystemActor::GetAdjustedBuildSystemActorTransform(EModul
 	return ActorTransform;
 }
 
-void AModularBuildSystemActor::AdjustSectionsUsingSpline(USplineComponent* InSpline)
+bool AModularBuildSystemActor::PlaceSectionsAlongSpline(const USplineComponent& InSpline, const FMBSSplinePath& InPath,
+	TArray<FTransform>& InOutStraightTransforms, TConstArrayView<int32> InSegments)
 {
-	// TODO: Implement
-	if (!InSpline)
+	const TArray<FModularLevel*> Levels = GetAllLevels();
+
+	// Sections are always visited in the same order, so straight transforms are matched with them by index
+	int32 SectionCount = 0;
+	for (const FModularLevel* Level : Levels)
 	{
-		return;
+		for (const FModularSectionInstanced* Section : Sections.GetInstancedSectionsOfLevel(Level->GetId()))
+		{
+			SectionCount += Section->GetInstanceCount();
+		}
+		SectionCount += Sections.GetStaticSectionsOfLevel(Level->GetId()).Num();
+	}
+
+	const bool bCollect = InOutStraightTransforms.IsEmpty();
+	if (!bCollect && InOutStraightTransforms.Num() != SectionCount)
+	{
+		UE_LOG(LogMBS, Warning, TEXT("%s: Sections were changed after they were placed along the spline (StraightTransforms=%d, Sections=%d)"),
+			*GetName(), InOutStraightTransforms.Num(), SectionCount);
+		return false;
 	}
+	InOutStraightTransforms.Reserve(SectionCount);
+
+	const FTransform SplineTransform = InSpline.GetComponentTransform();
+	int32 TransformIndex = 0;
+	TArray<int32> Indices;
+	TArray<FTransform> NewTransforms;
 
-	// TODO: Calculate position
-	const FTransform Point0 = InSpline->GetTransformAtSplinePoint(0, ESplineCoordinateSpace::World);
-	const FTransform Point1 = InSpline->GetTransformAtSplinePoint(1, ESplineCoordinateSpace::World);
+	// SectionToSpline converts transforms of a section into the local space of the spline
+	const auto AddSection = [&](int32 Index, const FTransform& SectionToSpline, const FTransform& CurrentTransform)
+	{
+		if (bCollect)
+		{
+			InOutStraightTransforms.Add(CurrentTransform * SectionToSpline);
+		}
+		
+		const FTransform& StraightTransform = InOutStraightTransforms[TransformIndex++];
+		if (InSegments.IsEmpty() || InSegments.Contains(InPath.GetSegmentAt(StraightTransform.GetLocation().X)))
+		{
+			Indices.Add(Index);
+			NewTransforms.Add(InPath.Warp(StraightTransform).GetRelativeTransform(SectionToSpline));
+		}
+	};
 
-	// Update sections
-	if (MeshConfiguration.IsOfInstancedType())
+	// Transforms of static sections are in world space
+	const FTransform WorldToSpline = SplineTransform.Inverse();
+	for (const FModularLevel* Level : Levels)
 	{
-		for (auto& Section : Sections.GetInstanced())
+		for (FModularSectionInstanced* Section : Sections.GetInstancedSectionsOfLevel(Level->GetId()))
 		{
-			for (int32 i = 0; i < Section.GetInstanceCount(); i++)
+			const FTransform ComponentToSpline = Section->GetISMC()->GetComponentTransform().GetRelativeTransform(SplineTransform);
+			Indices.Reset();
+			NewTransforms.Reset();
+			for (int32 i = 0; i < Section->GetInstanceCount(); i++)
 			{
-				// Get current section transform
-				FTransform SectionTransform = Section.GetSectionTransform(i);
-				
-				// Find the coefficient (where location of a section is between Point0 and Point1)
-				const float InterpCoefficient = 0.f;
-				
-				// Calculate offset from the coefficient
-				const FVector Offset = FVector::ZeroVector;
-				
-				// Apply adjustment to section transform
-				SectionTransform.AddToTranslation(Offset);
-				
-				Section.GetISMC()->UpdateInstanceTransform(
-					i,
-					SectionTransform,
-					true);
+				AddSection(i, ComponentToSpline, bCollect ? Section->GetTransform(i) : FTransform::Identity);
 			}
+			Section->SetTransforms(Indices, NewTransforms, true);
 		}
-	}
-	else
-	{
-		for (auto& Section : Sections.GetStatic())
+
+		const TArray<FModularSection*> StaticSections = Sections.GetStaticSectionsOfLevel(Level->GetId());
+		Indices.Reset();
+		NewTransforms.Reset();
+		for (int32 i = 0; i < StaticSections.Num(); i++)
 		{
-			//Section.StaticMesh->AddActorWorldOffset()
+			AddSection(i, WorldToSpline, bCollect ? StaticSections[i]->GetTransform() : FTransform::Identity);
 		}
+		
+		TArray<FModularSection*> MovedSections;
+		MovedSections.Reserve(Indices.Num());
+		for (const int32 Index : Indices)
+		{
+			MovedSections.Add(StaticSections[Index]);
+		}
+		FModularSection::BatchSetTransforms(MovedSections, NewTransforms, false);
+		MarkChanged();
 	}
+	return true;
 }
 
 TArray<FModularSectionInstanced> AModularBuildSystemActor::InitInstancedModularSections(const FInitModularSectionsArgs& Args)
@@ -306,16 +482,21 @@ TArray<FModularSectionInstanced> AModularBuildSystemActor::InitInstancedModularS
 	// Get transform shifted by section pivot location configuration
 	const FTransform& ActorTransform = GetAdjustedBuildSystemActorTransform(Args.InPivotLocationOverride);
 
-	// If instanced - initializing here and adding new instances to it's component in for loop.
+	// If instanced - initializing here and adding all new instances to it's component at once after the loop.
 	FModularSectionInstanced NewSection = Sections.InitInstanced(Args.InLevelId, false,
 		Args.InInstancedStaticMeshComponent);
 	
+	TArray<FTransform> NewTransforms;
+	UMBSFunctionLibrary::CalculateNewTransforms(BuildStats, ActorTransform, Args, NewTransforms);
+
+	// Skipped sections are removed in place, so kept transforms stay in the order of their indices
+	int32 KeptCount = 0;
 	for (int32 i = 0; i < Args.Initializer.GetTotalCount(); i++)
 	{
 		UE_LOG(LogMBS, Verbose, TEXT("%s: --- Initializing section at index=%d"), *GetName(), i);
 		bool bOutShouldBeSkipped = false;
-		FTransform NewTransform = UMBSFunctionLibrary::CalculateNewTransform(
-			this, BuildStats, i, ActorTransform, Args, bOutShouldBeSkipped);
+		FTransform NewTransform = NewTransforms[i];
+		UMBSFunctionLibrary::ShapeNewTransform(this, BuildStats, i, Args, NewTransform, bOutShouldBeSkipped);
 
 		if (bOutShouldBeSkipped)
 		{
@@ -324,12 +505,14 @@ TArray<FModularSectionInstanced> AModularBuildSystemActor::InitInstancedModularS
 			Args.OutSkippedIndices.Add(i);
 			continue;
 		}
-
-		// Adding new instance to instanced static mesh component of section
-		AddNewInstance(NewTransform, SpawnConfiguration.bUseRelativeTransform, Args.InInstancedStaticMeshComponent);
-
-		UE_LOG(LogMBS, Verbose, TEXT("%s: --- %s - has been initialized"), *GetName(), *NewSection.GetSectionName(i));
+		NewTransforms[KeptCount++] = NewTransform;
 	}
+	NewTransforms.SetNum(KeptCount);
+
+	// Adding new instances to instanced static mesh component of section
+	AddNewInstances(NewTransforms, SpawnConfiguration.bUseRelativeTransform, Args.InInstancedStaticMeshComponent);
+	UE_LOG(LogMBS, Verbose, TEXT("%s: --- %d instances of %s have been initialized"), *GetName(), KeptCount,
+		*NewSection.GetName());
 
 	Sections.UpdateInstanceCount(NewSection);
 	Args.Initializer.SetSkippedCount(Args.OutSkippedIndices.Num());
@@ -348,9 +531,15 @@ void AModularBuildSystemActor::UpdateInstancedModularSections(const FInitModular
 	UE_LOG(LogMBS, Log, TEXT("%s: Updating %s level (Args.InLevelId=%d, InstanceCount=%d, Args.Initializer.TotalCount=%d)"),
 		*GetName(), *CurrentLevel->GetName(), Args.InLevelId, TestInstanceCount, TotalCount);
 	
-	FModularSectionInstanced* ExistingSection = Sections.GetInstancedSectionOfLevel(Args.InLevelId);
-	check(ExistingSection);
-	const int32 CurrentLevelSectionCount = ExistingSection->GetInstanceCount();
+	// With shared instanced components level may own multiple instance ranges, so all of them are counted
+	const TArray<FModularSectionInstanced*> ExistingSections = Sections.GetInstancedSectionsOfLevel(Args.InLevelId);
+	check(!ExistingSections.IsEmpty());
+	FModularSectionInstanced* ExistingSection = ExistingSections.Last();
+	int32 CurrentLevelSectionCount = 0;
+	for (const FModularSectionInstanced* Section : ExistingSections)
+	{
+		CurrentLevelSectionCount += Section->GetInstanceCount();
+	}
 
 	check(Sections.GetInstanced().Num() > 0);
 	if (CurrentLevelSectionCount == 0)
@@ -359,8 +548,10 @@ void AModularBuildSystemActor::UpdateInstancedModularSections(const FInitModular
 		return;
 	}
 	
-	if (CurrentLevelSectionCount < TotalCount)
+	if (CurrentLevelSectionCount < TotalCount || ExistingSections.Num() > 1)
 	{
+		// Instances of a level split between multiple ranges (see FMBSSections::MoveInstancesOfLevel) can't be updated
+		// by their indices, so such level is initialized again as well.
 		// TODO: Currently clear this level if not all sections are set.
 		// TODO: It is necessary to find which instances were removed before updating existing, as it can break easily.
 		Sections.ResetInstancedSectionOfLevel(Args.InLevelId);
@@ -368,18 +559,26 @@ void AModularBuildSystemActor::UpdateInstancedModularSections(const FInitModular
 		return;
 	}
 
+	TArray<FTransform> NewTransforms;
+	UMBSFunctionLibrary::CalculateNewTransforms(BuildStats, ActorTransform, Args, NewTransforms);
+	TArray<int32> UpdatedIndices;
+	UpdatedIndices.Reserve(TotalCount);
 	for (int32 i = 0; i < TotalCount; i++)
 	{
 		UE_LOG(LogMBS, Verbose, TEXT("%s: --- Updating section at index=%d"), *GetName(), i);
 		bool bOutShouldBeSkipped = false;
-		FTransform NewTransform = UMBSFunctionLibrary::CalculateNewTransform(
-			this, BuildStats, i, ActorTransform, Args, bOutShouldBeSkipped);
+		FTransform& NewTransform = NewTransforms[i];
+		UMBSFunctionLibrary::ShapeNewTransform(this, BuildStats, i, Args, NewTransform, bOutShouldBeSkipped);
 		// TODO: Skip here?
-		
-		// Update existing instance with newly calculated transform
-		ExistingSection->SetTransform(NewTransform, true, i);
+		UpdatedIndices.Add(i);
 	}
 
+	// Update existing instances with newly calculated transforms in a single batch. Transforms are in the same space
+	// as the ones new instances are added with in InitInstancedModularSections
+	ExistingSection->SetTransforms(UpdatedIndices, MakeArrayView(NewTransforms.GetData(), TotalCount),
+		SpawnConfiguration.bUseRelativeTransform);
+	MarkChanged();
+
 	// TODO: Remove existing or leave it to the Generator implementer? Removing for now.
 	if (CurrentLevelSectionCount > TotalCount)
 	{
@@ -443,6 +642,12 @@ void AModularBuildSystemActor::AddNewInstance(const FTransform& InTransform, boo
 	Sections.AddNewInstance(InTransform, bWithRelativeTransform, InInstancedStaticMeshComponent);
 }
 
+void AModularBuildSystemActor::AddNewInstances(const TArray<FTransform>& InTransforms, bool bWithRelativeTransform,
+	UInstancedStaticMeshComponent* InInstancedStaticMeshComponent)
+{
+	Sections.AddNewInstances(InTransforms, bWithRelativeTransform, InInstancedStaticMeshComponent);
+}
+
 void AModularBuildSystemActor::SelectAll_Implementation()
 {
 #if WITH_EDITOR
@@ -477,6 +682,109 @@ void AModularBuildSystemActor::Init()
 }
 
 void AModularBuildSystemActor::Generate_Implementation()
+{
+	ClearGenerationTierCache();
+	RunGenerator();
+}
+
+void AModularBuildSystemActor::SetGenerationTier(EMBSGenerationTier NewTier)
+{
+	if (NewTier == GenerationTier)
+	{
+		return;
+	}
+
+	if (bBuildModeIsActivated || IsMerged())
+	{
+		UE_LOG(LogMBS, Warning, TEXT("%s: Can't switch generation tier while build system is merged or build mode is active."),
+			*GetName());
+		return;
+	}
+
+	// Partially generated sections of the previous tier must not be cached
+	CancelTimeSlicedGeneration();
+
+	UE_LOG(LogMBS, Log, TEXT("%s: Switching generation tier from %s to %s."), *GetName(),
+		*UEnum::GetValueAsString(GenerationTier), *UEnum::GetValueAsString(NewTier));
+
+	ReleaseSharedInstances();
+	const EMBSGenerationTier PreviousTier = GenerationTier;
+	GenerationTier = NewTier;
+
+	// Shell is kept and only the details are switched, unless it was not split from the details by the generator
+	bool bSwitched = false;
+	if (TierConfiguration.bCacheTiers && Sections.HasShell())
+	{
+		StashGenerationTier(PreviousTier);
+		bSwitched = NewTier == EMBSGenerationTier::Shell || RestoreGenerationTier(NewTier) || GenerateTierDetails();
+	}
+
+	if (bSwitched)
+	{
+		UpdateSharedInstances();
+	}
+	else
+	{
+		ClearGenerationTierCache();
+		ResetBuildSystem(true, true, true, false);
+		RunGenerator();
+	}
+
+	// Interior is only shown with the full tier, and is kept hidden otherwise so it is generated only once
+	if (Interior)
+	{
+		const bool bFullTier = NewTier == EMBSGenerationTier::Full;
+		if (bFullTier && !Interior->HasInterior())
+		{
+			Interior->GenerateInterior(this);
+		}
+		Interior->SetInteriorVisibility(bFullTier);
+	}
+	MarkChanged();
+}
+
+void AModularBuildSystemActor::RegenerateInteriorOnUpdate()
+{
+	if (Interior && Interior->ShouldRegenerateOnBuildSystemUpdate() && GenerationTier == EMBSGenerationTier::Full)
+	{
+		Interior->GenerateInterior(this);
+	}
+}
+
+void AModularBuildSystemActor::ClearGenerationTierCache()
+{
+	if (GenerationTierCache.IsEmpty())
+	{
+		return;
+	}
+
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Clearing %d cached generation tiers."), *GetName(), GenerationTierCache.Num());
+	for (auto& Pair : GenerationTierCache)
+	{
+		// Instances of the cached details belong to the shell components and stay hidden
+		Pair.Value.Sections.Reset(true, true, false);
+	}
+	GenerationTierCache.Empty();
+}
+
+void AModularBuildSystemActor::BeginTierDetails()
+{
+	if (TierConfiguration.bCacheTiers)
+	{
+		Sections.BeginTierDetails();
+	}
+}
+
+void AModularBuildSystemActor::PrepareTieredGeneration(UModularBuildSystemGenerator* InGenerator)
+{
+	ClearGenerationTierCache();
+	if (InGenerator)
+	{
+		InGenerator->SetGenerationTier(GenerationTier);
+	}
+}
+
+bool AModularBuildSystemActor::RunGenerator()
 {
 	UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(GetGenerator().GetObject());
 	if (Generator && !bBuildModeIsActivated)
@@ -486,17 +794,23 @@ void AModularBuildSystemActor::Generate_Implementation()
 		{
 			UE_LOG(LogMBS, Warning, TEXT("%s: Build system actor is merged. Skipping generation."),
 				*GetName());
-			return;
+			return false;
 		}
 #endif
 
-		UE_LOG(LogMBS, Log, TEXT("%s: Generating new modular building using %s generator"), *GetName(),
-			*Generator->GetName());
+		UE_LOG(LogMBS, Log, TEXT("%s: Generating new modular building using %s generator (tier %s)"), *GetName(),
+			*Generator->GetName(), *UEnum::GetValueAsString(GenerationTier));
 		
 		Generator->SetBuildSystemPtr(this);
-		if (IBuildingGeneratorInterface::Execute_Generate(Generator).Succeeded())
+		Generator->SetGenerationTier(GenerationTier);
+		const bool bSucceeded = IBuildingGeneratorInterface::Execute_Generate(Generator).Succeeded();
+		EndTierDetails();
+		if (bSucceeded)
 		{
 			ApplyStretch();
+			UpdateSharedInstances();
+			MarkChanged();
+			return true;
 		}
 	}
 	else if (!Generator)
@@ -507,6 +821,379 @@ void AModularBuildSystemActor::Generate_Implementation()
 	{
 		UE_LOG(LogMBS, Error, TEXT("%s: Cannot generate because build mode is active."), *GetName());
 	}
+	return false;
+}
+
+void AModularBuildSystemActor::StashGenerationTier(EMBSGenerationTier InTier)
+{
+	// Shell is shared by all tiers, so it has no details to cache
+	if (InTier == EMBSGenerationTier::Shell)
+	{
+		return;
+	}
+
+	FMBSGenerationTierCache& Cache = GenerationTierCache.FindOrAdd(InTier);
+	Cache.Sections = Sections.DetachTierDetails(Cache.ShellOverrides);
+	Cache.Sections.SetVisibility(false);
+	Cache.Sections.SetCollisionEnabled(false);
+	// Cache is not saved, so its sections are not saved either
+	Cache.Sections.SetTransient(true);
+
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Details of generation tier %s were cached."), *GetName(), *UEnum::GetValueAsString(InTier));
+}
+
+bool AModularBuildSystemActor::RestoreGenerationTier(EMBSGenerationTier InTier)
+{
+	FMBSGenerationTierCache Cache;
+	if (!GenerationTierCache.RemoveAndCopyValue(InTier, Cache))
+	{
+		return false;
+	}
+
+	Cache.Sections.SetVisibility(true);
+	Cache.Sections.SetCollisionEnabled(true);
+	Cache.Sections.SetTransient(false);
+	Sections.AttachTierDetails(MoveTemp(Cache.Sections), MoveTemp(Cache.ShellOverrides));
+
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Details of generation tier %s were restored from cache."), *GetName(), *UEnum::GetValueAsString(InTier));
+	return true;
+}
+
+bool AModularBuildSystemActor::GenerateTierDetails()
+{
+	UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(GetGenerator().GetObject());
+	if (!Generator)
+	{
+		return false;
+	}
+
+	UE_LOG(LogMBS, Log, TEXT("%s: Generating details of tier %s using %s generator"), *GetName(),
+		*UEnum::GetValueAsString(GenerationTier), *Generator->GetName());
+	Generator->SetBuildSystemPtr(this);
+	Generator->SetGenerationTier(GenerationTier);
+	Sections.BeginTierDetails();
+	const bool bGenerated = Generator->GenerateTierDetails();
+	Sections.EndTierDetails();
+	return bGenerated;
+}
+
+void AModularBuildSystemActor::UpdateRegistryMergeState()
+{
+	if (UMBSBuildSystemRegistry* Registry = UMBSBuildSystemRegistry::Get(GetWorld()))
+	{
+		Registry->UpdateMergeState(this);
+	}
+}
+
+void AModularBuildSystemActor::UpdateGenerationTierByDistance()
+{
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!PlayerController || !PlayerController->PlayerCameraManager)
+	{
+		return;
+	}
+
+	const float Distance = FVector::Dist(PlayerController->PlayerCameraManager->GetCameraLocation(), GetActorLocation());
+	SetGenerationTier(TierConfiguration.GetTierForDistance(Distance));
+}
+
+void AModularBuildSystemActor::CapturePresetLayout(FMBSPresetLayout& OutLayout) const
+{
+	OutLayout.Reset();
+	OutLayout.BuildStats = BuildStats;
+
+	// Transforms and meshes are read from the section actors, the layout only tells which actors belong to which level
+	const FMBSSectionsLayout& SectionsLayout = Sections.GetLayout();
+	for (int32 i = 0; i < SectionsLayout.Num(); i++)
+	{
+		const AActor* SectionActor = SectionsLayout.GetHandleAt(i);
+		if (!SectionActor || !SectionActor->GetRootComponent())
+		{
+			continue;
+		}
+
+		const FTransform& RelativeTransform = SectionActor->GetRootComponent()->GetRelativeTransform();
+		if (SectionsLayout.IsActorAt(i))
+		{
+			OutLayout.AddActor(SectionActor->GetClass(), SectionsLayout.GetLevelIdAt(i), RelativeTransform);
+		}
+		else if (const UStaticMeshComponent* MeshComponent = CastChecked<AStaticMeshActor>(SectionActor)->GetStaticMeshComponent();
+			MeshComponent && MeshComponent->GetStaticMesh())
+		{
+			OutLayout.AddStatic(MeshComponent->GetStaticMesh(), SectionsLayout.GetLevelIdAt(i), RelativeTransform);
+		}
+	}
+
+	for (const FModularSectionInstanced& Section : Sections.GetInstanced())
+	{
+		const UInstancedStaticMeshComponent* Component = Section.GetISMC();
+		if (!Component || !Component->GetStaticMesh() || Section.GetInstanceCount() == 0)
+		{
+			continue;
+		}
+		FMBSPresetInstancedLevel& Level = OutLayout.Instanced.AddDefaulted_GetRef();
+		Level.LevelId = Section.GetLevelId();
+		Level.Mesh = Component->GetStaticMesh();
+		Level.Transforms.Reserve(Section.GetInstanceCount());
+		for (int32 i = 0; i < Section.GetInstanceCount(); i++)
+		{
+			Level.Transforms.Add(Section.GetSectionTransform(i));
+		}
+	}
+
+	UE_LOG(LogMBS, Log, TEXT("%s: Captured preset layout of %d static, %d actor sections and %d instanced levels."),
+		*GetName(), OutLayout.StaticLevelIds.Num(), OutLayout.ActorLevelIds.Num(), OutLayout.Instanced.Num());
+}
+
+bool AModularBuildSystemActor::ApplyPresetLayout(const FMBSPresetLayout& InLayout)
+{
+	if (!InLayout.IsValid())
+	{
+		UE_LOG(LogMBS, Warning, TEXT("%s: Preset layout references missing meshes or actor classes."), *GetName());
+		return false;
+	}
+
+	// Validating all levels first, so the build system is never left with a partially applied layout
+	auto HasLevel = [this](int32 LevelId) { return GetLevelWithId(LevelId) != nullptr; };
+	if (!Algo::AllOf(InLayout.StaticLevelIds, HasLevel) || !Algo::AllOf(InLayout.ActorLevelIds, HasLevel)
+		|| !Algo::AllOf(InLayout.Instanced, [&HasLevel](const FMBSPresetInstancedLevel& Level) { return HasLevel(Level.LevelId); }))
+	{
+		UE_LOG(LogMBS, Warning, TEXT("%s: Preset layout references levels that do not exist."), *GetName());
+		return false;
+	}
+
+	BuildStats = InLayout.BuildStats;
+
+	for (int32 i = 0; i < InLayout.StaticLevelIds.Num(); i++)
+	{
+		InitModularSection(InLayout.Meshes[InLayout.StaticMeshIds[i]], InLayout.StaticTransforms[i],
+			InLayout.StaticLevelIds[i], true, true);
+	}
+
+	for (int32 i = 0; i < InLayout.ActorLevelIds.Num(); i++)
+	{
+		InitModularSectionActor(InLayout.ActorTransforms[i], InLayout.ActorLevelIds[i],
+			InLayout.ActorClasses[InLayout.ActorClassIds[i]], true, true);
+	}
+
+	for (const FMBSPresetInstancedLevel& Level : InLayout.Instanced)
+	{
+		FModularLevel* ModularLevel = GetLevelWithId(Level.LevelId);
+		ModularLevel->SetInstancedStaticMeshComponent(Level.Mesh, this, false);
+		UInstancedStaticMeshComponent* Component = ModularLevel->InstancedStaticMeshComponent;
+		if (!Component)
+		{
+			// Mesh configuration of this build system does not use instancing, so instances become static sections
+			InitMultipleModularSections(Level.Mesh, Level.Transforms, Level.LevelId, true, true);
+			continue;
+		}
+		FModularSectionInstanced NewSection = Sections.InitInstanced(Level.LevelId, false, Component);
+		AddNewInstances(Level.Transforms, true, Component);
+		Sections.UpdateInstanceCount(NewSection);
+		Sections.Add(NewSection);
+	}
+
+	EndInit();
+	UpdateSharedInstances();
+	MarkChanged();
+	UE_LOG(LogMBS, Log, TEXT("%s: Applied preset layout without running the generator."), *GetName());
+	return true;
+}
+
+void AModularBuildSystemActor::RequestRegeneration(EMBSRegenerationType InType)
+{
+	const UMBSSettings* Settings = GetDefault<UMBSSettings>();
+	UMBSRegenerationScheduler* Scheduler = UMBSRegenerationScheduler::Get(GetWorld());
+	if (!Scheduler || !Settings || !Settings->bDeferInteractiveRegeneration)
+	{
+		RunScheduledRegeneration(EMBSRegenerationType::Full);
+		return;
+	}
+
+	Scheduler->Schedule(this, InType);
+}
+
+void AModularBuildSystemActor::RunScheduledRegeneration(EMBSRegenerationType InType)
+{
+	switch (InType)
+	{
+	case EMBSRegenerationType::Preview:
+		if (!IsMerged() && !bBuildModeIsActivated)
+		{
+			PreviewRegeneration();
+			MarkChanged();
+		}
+		break;
+	case EMBSRegenerationType::Full:
+		ClearRegenerationPreview();
+		RegenerateOnChange();
+		break;
+	default:
+		break;
+	}
+}
+
+bool AModularBuildSystemActor::GenerateTimeSliced()
+{
+	UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(GetGenerator().GetObject());
+	UMBSRegenerationScheduler* Scheduler = UMBSRegenerationScheduler::Get(GetWorld());
+	CancelTimeSlicedGeneration();
+
+	if (!Generator || !Generator->SupportsTimeSlicing() || !Scheduler)
+	{
+		UE_LOG(LogMBS, Verbose, TEXT("%s: Time-sliced generation is not available. Generating at once."), *GetName());
+		ClearGenerationTierCache();
+		const bool bSucceeded = RunGenerator();
+		OnGenerationCompleted.Broadcast(this, bSucceeded);
+		return bSucceeded;
+	}
+
+	if (bBuildModeIsActivated || IsMerged())
+	{
+		UE_LOG(LogMBS, Error, TEXT("%s: Cannot generate because build system is merged or build mode is active."),
+			*GetName());
+		OnGenerationCompleted.Broadcast(this, false);
+		return false;
+	}
+
+	UE_LOG(LogMBS, Log, TEXT("%s: Starting time-sliced generation using %s generator (tier %s)"), *GetName(),
+		*Generator->GetName(), *UEnum::GetValueAsString(GenerationTier));
+
+	Generator->SetBuildSystemPtr(this);
+	PrepareTieredGeneration(Generator);
+	Generator->BeginTimeSlicedGeneration(this, [this]
+	{
+		if (SpawnConfiguration.bShowShellWhileGenerating)
+		{
+			bHideSectionsWhileGenerating = false;
+			Sections.SetVisibility(true);
+		}
+	});
+
+	// Existing sections are hidden too, as they are going to be cleared by the first step anyway
+	bHideSectionsWhileGenerating = true;
+	Sections.SetVisibility(false);
+	Scheduler->StartTimeSliced(this);
+	return true;
+}
+
+void AModularBuildSystemActor::CancelTimeSlicedGeneration()
+{
+	UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(GetGenerator().GetObject());
+	if (!Generator || !Generator->IsTimeSlicedGenerationActive())
+	{
+		return;
+	}
+
+	// Partially generated building is never left behind
+	if (Generator->HasTimeSlicedGenerationModifiedBuildSystem())
+	{
+		ResetBuildSystem();
+	}
+	Generator->CancelTimeSlicedGeneration();
+	FinishTimeSlicedGeneration(false);
+}
+
+bool AModularBuildSystemActor::IsGeneratingTimeSliced() const
+{
+	const UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(GetGenerator().GetObject());
+	return Generator && Generator->IsTimeSlicedGenerationActive();
+}
+
+bool AModularBuildSystemActor::AdvanceTimeSlicedGeneration(double InBudgetSeconds)
+{
+	UModularBuildSystemGenerator* Generator = Cast<UModularBuildSystemGenerator>(GetGenerator().GetObject());
+	if (!Generator || !Generator->IsTimeSlicedGenerationActive())
+	{
+		UE_LOG(LogMBS, Warning, TEXT("%s: Time-sliced generation was interrupted."), *GetName());
+		FinishTimeSlicedGeneration(false);
+		return true;
+	}
+
+	switch (Generator->AdvanceTimeSlicedGeneration(InBudgetSeconds))
+	{
+	case EMBSGenerationStepResult::Pending:
+		// Hide sections that were spawned by steps of this frame
+		if (bHideSectionsWhileGenerating)
+		{
+			Sections.SetVisibility(false);
+		}
+		return false;
+	case EMBSGenerationStepResult::Finished:
+		ApplyStretch();
+		// Interior depends on the final sections, so it can't be a step of the generator itself
+		RegenerateInteriorOnUpdate();
+		FinishTimeSlicedGeneration(true);
+		return true;
+	default:
+		FinishTimeSlicedGeneration(false);
+		return true;
+	}
+}
+
+void AModularBuildSystemActor::FinishTimeSlicedGeneration(bool bSucceeded)
+{
+	if (UMBSRegenerationScheduler* Scheduler = UMBSRegenerationScheduler::Get(GetWorld()))
+	{
+		Scheduler->StopTimeSliced(this);
+	}
+
+	bHideSectionsWhileGenerating = false;
+	Sections.SetVisibility(true);
+	if (bSucceeded)
+	{
+		UpdateSharedInstances();
+	}
+	MarkChanged();
+
+	UE_LOG(LogMBS, Log, TEXT("%s: Time-sliced generation has %s."), *GetName(),
+		bSucceeded ? TEXT("succeeded") : TEXT("failed or was cancelled"));
+	OnGenerationCompleted.Broadcast(this, bSucceeded);
+}
+
+void AModularBuildSystemActor::AddInitSteps(FMBSGenerationSteps& OutSteps)
+{
+	OutSteps.Add(TEXT("Init"), [this]
+	{
+		Init();
+	});
+}
+
+#if WITH_EDITOR
+EMBSRegenerationType AModularBuildSystemActor::GetRegenerationTypeForChange(const FPropertyChangedEvent& PropertyChangedEvent)
+{
+	return PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive
+		? EMBSRegenerationType::Preview
+		: EMBSRegenerationType::Full;
+}
+#endif
+
+void AModularBuildSystemActor::RegenerateOnChange()
+{
+	Generate();
+}
+
+void AModularBuildSystemActor::SetRegenerationPreviewScale(const FVector& InScale)
+{
+	if (!RootComponent)
+	{
+		return;
+	}
+
+	if (!PreviewBaseScale.IsSet())
+	{
+		PreviewBaseScale = RootComponent->GetRelativeScale3D();
+	}
+	RootComponent->SetRelativeScale3D(PreviewBaseScale.GetValue() * InScale);
+}
+
+void AModularBuildSystemActor::ClearRegenerationPreview()
+{
+	if (PreviewBaseScale.IsSet() && RootComponent)
+	{
+		RootComponent->SetRelativeScale3D(PreviewBaseScale.GetValue());
+	}
+	PreviewBaseScale.Reset();
 }
 
 #if WITH_EDITOR
@@ -520,6 +1207,8 @@ void AModularBuildSystemActor::ToggleShowOnlyInterior_Implementation()
 void AModularBuildSystemActor::MergeIntoStaticMesh()
 {
 	Merger.MergeIntoStaticMesh(this);
+	UpdateRegistryMergeState();
+	MarkChanged();
 }
 
 void AModularBuildSystemActor::UnmergeIntoModularSections()
@@ -533,6 +1222,8 @@ void AModularBuildSystemActor::UnmergeIntoModularSections()
 			TransformBounds.SetBounds(TransformBounds.GetBounds(), StretchManager.GetScaleCoefficientsSwappedXY());
 			ApplyStretch();
 		}
+		UpdateRegistryMergeState();
+		MarkChanged();
 	}
 }
 
@@ -623,6 +1314,11 @@ void AModularBuildSystemActor::ResetBuildSystem(bool bResetSections, bool bReset
 	UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Build system root component name before reset: %s"),
 		*GetName(), *GetRootComponent()->GetName());
 
+	if (bResetInstancedSections)
+	{
+		ReleaseSharedInstances();
+	}
+	
 	Sections.Reset(bResetSections, bResetActorSections, bResetInstancedSections);
 
 	if (SpawnConfiguration.bResetRotationAlso)
@@ -633,12 +1329,69 @@ void AModularBuildSystemActor::ResetBuildSystem(bool bResetSections, bool bReset
 	if (bResetMergedSectionsStaticMeshActor)
 	{
 		Merger.Reset(this);
+		UpdateRegistryMergeState();
 	}
 
 	Sections.SetWasReset(true);
+	MarkChanged();
 	UE_LOG(LogMBS, Verbose, TEXT("%s: Build system transform after reset: %s"), *GetName(), *GetActorTransform().ToHumanReadableString());
 }
 
+void AModularBuildSystemActor::UpdateSharedInstances()
+{
+	if (!MeshConfiguration.UsesWorldSharedInstancing())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	UMBSInstancingSubsystem* Subsystem = World ? World->GetSubsystem<UMBSInstancingSubsystem>() : nullptr;
+	if (!Subsystem)
+	{
+		// Subsystem is not created for preview worlds, for example
+		UE_LOG(LogMBS, Verbose, TEXT("%s: Can't update shared instances, instancing subsystem is not available."), *GetName());
+		return;
+	}
+
+	if (!SharedInstancesHandle.IsValid())
+	{
+		SharedInstancesHandle = Subsystem->CreateHandle();
+	}
+	Subsystem->SetInstancesFromSections(SharedInstancesHandle, Sections);
+
+	// Own components are kept for collision and editing, while rendering is done by the shared chunks
+	SetInstancedComponentsVisibility(false);
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Instanced sections were registered in the shared instancing subsystem (HandleId=%d)."),
+		*GetName(), SharedInstancesHandle.Id);
+}
+
+void AModularBuildSystemActor::ReleaseSharedInstances()
+{
+	if (!SharedInstancesHandle.IsValid())
+	{
+		return;
+	}
+
+	if (UMBSInstancingSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UMBSInstancingSubsystem>() : nullptr)
+	{
+		Subsystem->ReleaseHandle(SharedInstancesHandle);
+	}
+	SharedInstancesHandle.Invalidate();
+	SetInstancedComponentsVisibility(true);
+}
+
+void AModularBuildSystemActor::SetInstancedComponentsVisibility(bool bVisible)
+{
+	for (const FModularSectionInstanced& Section : Sections.GetInstanced())
+	{
+		if (Section.IsValid())
+		{
+			Section.GetISMC()->SetVisibility(bVisible);
+		}
+	}
+	MarkChanged();
+}
+
 void AModularBuildSystemActor::RemoveSectionsOfLevel(int32 LevelId)
 {
 	Sections.RemoveSectionsOfLevel(LevelId);
@@ -875,6 +1628,11 @@ FModularSectionInstanced* AModularBuildSystemActor::GetInstancedSectionOfLevel(c
 	return Sections.GetInstancedSectionOfLevel(InLevelId);
 }
 
+TArray<FModularSectionInstanced*> AModularBuildSystemActor::GetInstancedSectionsOfLevel(const FModularLevel& InLevel) const
+{
+	return Sections.GetInstancedSectionsOfLevel(InLevel.GetId());
+}
+
 FBox AModularBuildSystemActor::GetBoundsBox(bool bRelative) const
 {
 	if (bRelative)
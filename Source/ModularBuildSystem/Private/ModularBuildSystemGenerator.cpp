@@ -23,11 +23,21 @@ FGeneratedModularSections::FGeneratedModularSections(const TScriptInterface<IMod
 FGeneratedModularSections UModularBuildSystemGenerator::Generate_Implementation()
 {
 	UE_LOG(LogGenerator, Log, TEXT("%s: === Generating ==="), *GetName());
+
+	// Every regeneration path ends up here, and pending steps would otherwise continue on top of the new sections
+	if (AModularBuildSystemActor* MBS = Cast<AModularBuildSystemActor>(GetBuildSystemPtr().GetObject()))
+	{
+		MBS->CancelTimeSlicedGeneration();
+	}
 	return FGeneratedModularSections();
 }
 
 void UModularBuildSystemGenerator::FinishGeneration_Implementation()
 {
+	if (AModularBuildSystemActor* MBS = Cast<AModularBuildSystemActor>(GetBuildSystemPtr().GetObject()))
+	{
+		MBS->EndTierDetails();
+	}
 	LogGenerationSummary();
 	UE_LOG(LogGenerator, Log, TEXT("%s: === End generation === "), *GetName());
 }
@@ -95,3 +105,66 @@ bool UModularBuildSystemGenerator::PreGenerate(AModularBuildSystemActor* MBS) co
 	
 	return true;
 }
+
+bool UModularBuildSystemGenerator::BeginTimeSlicedGeneration(AModularBuildSystemActor* MBS,
+	TFunction<void()> InOnShellGenerated)
+{
+	CancelTimeSlicedGeneration();
+	if (!SupportsTimeSlicing())
+	{
+		UE_LOG(LogGenerator, Warning, TEXT("%s: Time-sliced generation is not supported."), *GetName());
+		return false;
+	}
+
+	checkf(MBS, TEXT("%s: BuildSystemPtr was nullptr! This should never happen"), *GetName());
+	UE_LOG(LogGenerator, Log, TEXT("%s: === Generating (time-sliced) ==="), *GetName());
+
+	// Same as PreGenerate, but initialization of each level is a separate step
+	TimeSlicedSteps.AddResumable(TEXT("PreGenerate"), [this]
+	{
+		if (!CanGenerate())
+		{
+			UE_LOG(LogGenerator, Warning, TEXT("%s: Can't generate while conditions not met."), *GetName());
+			return EMBSGenerationStepResult::Failed;
+		}
+		PreGenerateClear();
+		PrepareBuildSystem();
+		return EMBSGenerationStepResult::Finished;
+	});
+	
+	MBS->AddInitSteps(TimeSlicedSteps);
+	if (InOnShellGenerated)
+	{
+		TimeSlicedSteps.Add(TEXT("Shell"), MoveTemp(InOnShellGenerated));
+	}
+	
+	AddGenerationSteps(TimeSlicedSteps);
+	OnBeginTimeSlicedGeneration();
+	return true;
+}
+
+EMBSGenerationStepResult UModularBuildSystemGenerator::AdvanceTimeSlicedGeneration(double InBudgetSeconds)
+{
+	if (!TimeSlicedSteps.Advance(InBudgetSeconds))
+	{
+		UE_LOG(LogGenerator, VeryVerbose, TEXT("%s: Time-sliced generation is paused before %s step."), *GetName(),
+			*TimeSlicedSteps.GetCurrentStepName().ToString());
+		return EMBSGenerationStepResult::Pending;
+	}
+
+	const EMBSGenerationStepResult Result = TimeSlicedSteps.HasFailed()
+		? EMBSGenerationStepResult::Failed
+		: EMBSGenerationStepResult::Finished;
+	TimeSlicedSteps.Reset();
+	return Result;
+}
+
+void UModularBuildSystemGenerator::CancelTimeSlicedGeneration()
+{
+	if (IsTimeSlicedGenerationActive())
+	{
+		UE_LOG(LogGenerator, Log, TEXT("%s: Time-sliced generation was cancelled before %s step."), *GetName(),
+			*TimeSlicedSteps.GetCurrentStepName().ToString());
+	}
+	TimeSlicedSteps.Reset();
+}
@@ -3,3 +3,150 @@
 
 #include "ModularBuildSystemPreset.h"
 
+#include "ModularBuildSystem.h"
+#include "ModularBuildSystemActor.h"
+#include "List/ModularBuildSystemListBase.h"
+#include "Serialization/ArchiveObjectCrc32.h"
+
+namespace
+{
+	/**
+	 * Skips the layout properties of the base preset class, so only the configuration is taken into account.
+	 * Collects the referenced lists, as only their paths are part of the checksum.
+	 */
+	class FPresetConfigurationCrc32 : public FArchiveObjectCrc32
+	{
+	public:
+		TArray<UModularBuildSystemListBase*> ReferencedLists;
+
+		virtual bool ShouldSkipProperty(const FProperty* InProperty) const override
+		{
+			return InProperty->GetOwnerClass() == UModularBuildSystemPreset::StaticClass()
+				|| FArchiveObjectCrc32::ShouldSkipProperty(InProperty);
+		}
+
+		using FArchiveObjectCrc32::operator<<;
+		virtual FArchive& operator<<(UObject*& Object) override
+		{
+			if (UModularBuildSystemListBase* List = Cast<UModularBuildSystemListBase>(Object))
+			{
+				ReferencedLists.AddUnique(List);
+			}
+			return FArchiveObjectCrc32::operator<<(Object);
+		}
+	};
+}
+
+void UModularBuildSystemPreset::SaveProperties(TScriptInterface<IModularBuildSystemInterface> InBuildSystem)
+{
+	UE_LOG(LogMBS, Log, TEXT("%s: Saving properties"), *GetName());
+	if (UObject* BuildSystem = InBuildSystem.GetObject())
+	{
+		CopyProperties(*BuildSystem, true);
+	}
+}
+
+void UModularBuildSystemPreset::LoadProperties(TScriptInterface<IModularBuildSystemInterface> InBuildSystem)
+{
+	UE_LOG(LogMBS, Log, TEXT("%s: Loading properties"), *GetName());
+	if (UObject* BuildSystem = InBuildSystem.GetObject())
+	{
+		CopyProperties(*BuildSystem, false);
+	}
+}
+
+void UModularBuildSystemPreset::Save(TScriptInterface<IModularBuildSystemInterface> InBuildSystem)
+{
+	SaveProperties(InBuildSystem);
+
+	Layout.Reset();
+	SavedLayoutVersion = INDEX_NONE;
+	if (bSaveLayout)
+	{
+		if (const AModularBuildSystemActor* BuildSystem = Cast<AModularBuildSystemActor>(InBuildSystem.GetObject()))
+		{
+			BuildSystem->CapturePresetLayout(Layout);
+			SavedLayoutVersion = LayoutVersion;
+		}
+	}
+	SavedConfigurationCrc = CalculateConfigurationCrc();
+}
+
+bool UModularBuildSystemPreset::Apply(TScriptInterface<IModularBuildSystemInterface> InBuildSystem)
+{
+	LoadProperties(InBuildSystem);
+
+	if (!bSaveLayout || Layout.IsEmpty())
+	{
+		return false;
+	}
+
+	if (!HasValidLayout())
+	{
+		UE_LOG(LogMBS, Log, TEXT("%s: Saved layout is outdated, build system will be regenerated."), *GetName());
+		return false;
+	}
+
+	AModularBuildSystemActor* BuildSystem = Cast<AModularBuildSystemActor>(InBuildSystem.GetObject());
+	return BuildSystem && BuildSystem->ApplyPresetLayout(Layout);
+}
+
+bool UModularBuildSystemPreset::HasValidLayout() const
+{
+	return SavedLayoutVersion == LayoutVersion
+		&& SavedConfigurationCrc == CalculateConfigurationCrc()
+		&& Layout.IsValid();
+}
+
+uint32 UModularBuildSystemPreset::CalculateConfigurationCrc() const
+{
+	UModularBuildSystemPreset* MutableThis = const_cast<UModularBuildSystemPreset*>(this);
+	FPresetConfigurationCrc32 Archive;
+	uint32 Crc = Archive.Crc32(MutableThis, MutableThis);
+
+	// Lists are separate assets, so the saved layout must also be outdated when their elements are changed
+	for (UModularBuildSystemListBase* List : Archive.ReferencedLists)
+	{
+		FArchiveObjectCrc32 ListArchive;
+		Crc = ListArchive.Crc32(List, Crc);
+	}
+	return Crc;
+}
+
+void UModularBuildSystemPreset::CopyProperties(UObject& InBuildSystem, bool bToPreset)
+{
+	UObject& Source = bToPreset ? InBuildSystem : *this;
+	UObject& Target = bToPreset ? *this : InBuildSystem;
+
+	for (TFieldIterator<FProperty> It(GetClass()); It; ++It)
+	{
+		const FProperty* PresetProperty = *It;
+		if (PresetProperty->GetOwnerClass() == StaticClass())
+		{
+			continue;
+		}
+
+		const FProperty* BuildSystemProperty = InBuildSystem.GetClass()->FindPropertyByName(PresetProperty->GetFName());
+		if (!BuildSystemProperty || !BuildSystemProperty->SameType(PresetProperty))
+		{
+			UE_LOG(LogMBS, Verbose, TEXT("%s: %s has no %s property of the same type, skipping it."), *GetName(),
+				*InBuildSystem.GetName(), *PresetProperty->GetName());
+			continue;
+		}
+
+		const FProperty* SourceProperty = bToPreset ? BuildSystemProperty : PresetProperty;
+		const FProperty* TargetProperty = bToPreset ? PresetProperty : BuildSystemProperty;
+		void* TargetValue = TargetProperty->ContainerPtrToValuePtr<void>(&Target);
+		TargetProperty->CopyCompleteValue(TargetValue, SourceProperty->ContainerPtrToValuePtr<void>(&Source));
+
+		// Instanced objects are owned by the target, otherwise editing the build system would change the preset
+		const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(TargetProperty);
+		if (ObjectProperty && ObjectProperty->HasAnyPropertyFlags(CPF_InstancedReference))
+		{
+			if (UObject* Value = ObjectProperty->GetObjectPropertyValue(TargetValue))
+			{
+				ObjectProperty->SetObjectPropertyValue(TargetValue, DuplicateObject(Value, &Target));
+			}
+		}
+	}
+}
@@ -251,6 +251,25 @@ FModularLevel& FModularLevel::SetInstancedStaticMeshComponent(UStaticMesh* InSta
 			*UMBSFunctionLibrary::GetDisplayName(InBuildSystem), *Name.ToString());
 		return *this;
 	}
+
+	if (InBuildSystem->GetMeshConfiguration().UsesSingleComponentPerUniqueMesh())
+	{
+		// Levels with the same mesh are sharing a single component owned by the build system sections, so the mesh of
+		// a shared component is never changed, instead instances of this level are moved to the component of the new mesh.
+		AModularBuildSystemActor* System = Cast<AModularBuildSystemActor>(InBuildSystem.GetObject());
+		check(System);
+		UInstancedStaticMeshComponent* SharedComponent = System->Sections.GetOrCreateSharedComponent(InStaticMesh);
+		if (SharedComponent != InstancedStaticMeshComponent)
+		{
+			if (::IsValid(InstancedStaticMeshComponent) && IsValidLevelId(Id))
+			{
+				System->Sections.MoveInstancesOfLevel(Id, InStaticMesh);
+			}
+			bUpdated = true;
+			InstancedStaticMeshComponent = SharedComponent;
+		}
+		return *this;
+	}
 	
 	if (InstancedStaticMeshComponent)
 	{
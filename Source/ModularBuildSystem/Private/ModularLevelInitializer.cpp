@@ -45,26 +45,44 @@ void MBS::FModularLevelInitializer::InitMultipleLevels(const FName& InLevelName,
 	uint8& InShiftCount, float InZMultiplier, UModularSectionResolution* InPreviousLevelResolution, 
 	float& OutZMultiplier, int32& OutCount, TFunction<void(const FInitModularSectionsArgs&)> InAppendFunction)
 {
-	OutCount = InLevels.Num() - InShiftCount;
-	OutZMultiplier = InZMultiplier;
-	
-	UE_LOG(LogMBS, Verbose, TEXT("%s: (%s level) initializing multiple levels, InLevel.Num()=%d, OutCount=%d, InShiftCount=%d"),
-		*BuildSystem.GetObject()->GetName(), *InLevelName.ToString(), InLevels.Num(), OutCount, InShiftCount);
-	
-	for (int32 i = 0; i < OutCount; i++)
+	int32 Index = INDEX_NONE;
+	while (!InitNextOfMultipleLevels(InLevelName, InLevels, Index, InShiftCount, InZMultiplier,
+		InPreviousLevelResolution, OutZMultiplier, OutCount, InAppendFunction))
+	{
+	}
+}
+
+bool MBS::FModularLevelInitializer::InitNextOfMultipleLevels(const FName& InLevelName, TArray<FModularLevel>& InLevels,
+	int32& InOutIndex, uint8& InShiftCount, float InZMultiplier, UModularSectionResolution* InPreviousLevelResolution,
+	float& OutZMultiplier, int32& OutCount, TFunction<void(const FInitModularSectionsArgs&)> InAppendFunction)
+{
+	if (InOutIndex == INDEX_NONE)
+	{
+		OutCount = InLevels.Num() - InShiftCount;
+		OutZMultiplier = InZMultiplier;
+		InOutIndex = 0;
+
+		UE_LOG(LogMBS, Verbose, TEXT("%s: (%s level) initializing multiple levels, InLevel.Num()=%d, OutCount=%d, InShiftCount=%d"),
+			*BuildSystem.GetObject()->GetName(), *InLevelName.ToString(), InLevels.Num(), OutCount, InShiftCount);
+	}
+
+	if (InOutIndex < OutCount)
 	{
+		// Z multiplier of the previous level is the input of this one
+		const float LevelZMultiplier = OutZMultiplier;
 		InitSingleLevel(
 			InLevelName,
-			InLevels[i],
-			i + 1 - InShiftCount,
+			InLevels[InOutIndex],
+			InOutIndex + 1 - InShiftCount,
 			InShiftCount,
-			InZMultiplier,
+			LevelZMultiplier,
 			InPreviousLevelResolution,
 			OutZMultiplier,
 			InAppendFunction);
 		
-		InZMultiplier = OutZMultiplier;
+		InOutIndex++;
 	}
+	return InOutIndex >= OutCount;
 }
 
 void MBS::FModularLevelInitializer::PostInitSingleLevel(const FName& InLevelName, const FModularLevel& InLevel,
@@ -131,6 +131,109 @@ void FModularSectionBase::ScaleActor(AActor* OfActor, FVector ScaleOffset, bool
 		: OfActor->SetActorScale3D(1.f * ScaleOffset);
 }
 
+void FModularSectionBase::GetTransforms(TConstArrayView<int32> InIndices, TArray<FTransform>& OutTransforms) const
+{
+	OutTransforms.Reserve(OutTransforms.Num() + InIndices.Num());
+	for (const int32 Index : InIndices)
+	{
+		OutTransforms.Add(GetTransform(Index));
+	}
+}
+
+void FModularSectionBase::SetTransforms(TConstArrayView<int32> InIndices, TConstArrayView<FTransform> NewTransforms, bool bRelative)
+{
+	check(InIndices.Num() == NewTransforms.Num());
+	for (int32 i = 0; i < InIndices.Num(); i++)
+	{
+		SetTransform(NewTransforms[i], bRelative, InIndices[i]);
+	}
+}
+
+void FModularSectionBase::OffsetRange(TConstArrayView<int32> InIndices, FVector Offset, bool bRelative)
+{
+	for (const int32 Index : InIndices)
+	{
+		this->Offset(Offset, bRelative, Index);
+	}
+}
+
+void FModularSectionBase::ScaleRange(TConstArrayView<int32> InIndices, FVector ScaleOffset, bool bRelative)
+{
+	for (const int32 Index : InIndices)
+	{
+		Scale(ScaleOffset, bRelative, Index);
+	}
+}
+
+void FModularSectionBase::SetActorTransforms(TConstArrayView<AActor*> OfActors, TConstArrayView<FTransform> NewTransforms,
+	bool bRelative)
+{
+	check(OfActors.Num() == NewTransforms.Num());
+	for (int32 i = 0; i < OfActors.Num(); i++)
+	{
+		AActor* OfActor = OfActors[i];
+		if (!OfActor || !OfActor->GetRootComponent())
+		{
+			continue;
+		}
+
+		OfActor->Modify();
+		OfActor->GetRootComponent()->Modify();
+		SetActorTransform(OfActor, NewTransforms[i], bRelative);
+	}
+}
+
+void FModularSectionBase::OffsetActors(TConstArrayView<AActor*> OfActors, FVector Offset, bool bRelative)
+{
+	TArray<FTransform> NewTransforms;
+	NewTransforms.Reserve(OfActors.Num());
+	for (const AActor* OfActor : OfActors)
+	{
+		check(OfActor);
+		FTransform NewTransform = OfActor->GetActorTransform();
+		
+		// Relative offset is applied in actor's local space, the same way as AddActorLocalOffset does
+		NewTransform.AddToTranslation(bRelative ? NewTransform.TransformVectorNoScale(Offset) : Offset);
+		NewTransforms.Add(NewTransform);
+	}
+	SetActorTransforms(OfActors, NewTransforms, false);
+}
+
+void FModularSection::BatchSetTransforms(TConstArrayView<FModularSection*> InSections, TConstArrayView<FTransform> NewTransforms,
+	bool bRelative)
+{
+	SetActorTransforms(GetActors(InSections), NewTransforms, bRelative);
+}
+
+void FModularSection::BatchOffset(TConstArrayView<FModularSection*> InSections, FVector Offset, bool bRelative)
+{
+	OffsetActors(GetActors(InSections), Offset, bRelative);
+}
+
+void FModularSection::BatchSetMesh(TConstArrayView<FModularSection*> InSections, UStaticMesh* NewStaticMesh)
+{
+	for (const FModularSection* Section : InSections)
+	{
+		check(Section && Section->StaticMesh);
+		UStaticMeshComponent* Component = Section->StaticMesh->GetStaticMeshComponent();
+		if (Component->GetStaticMesh() != NewStaticMesh)
+		{
+			Component->SetStaticMesh(NewStaticMesh);
+		}
+	}
+}
+
+TArray<AActor*> FModularSection::GetActors(TConstArrayView<FModularSection*> InSections)
+{
+	TArray<AActor*> OutActors;
+	OutActors.Reserve(InSections.Num());
+	for (const FModularSection* Section : InSections)
+	{
+		OutActors.Add(Section ? Section->StaticMesh.Get() : nullptr);
+	}
+	return OutActors;
+}
+
 void FModularSection::Offset(FVector Offset, bool bRelative, int32 Index)
 {
 	OffsetActor(StaticMesh, Offset, bRelative);
@@ -301,7 +404,7 @@ FTransform FModularSectionInstanced::GetSectionTransform(int32 AtIndex) const
 	if (InstancedStaticMeshComponent)
 	{
 		FTransform OutTransform;
-		InstancedStaticMeshComponent->GetInstanceTransform(AtIndex, OutTransform);
+		InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(AtIndex), OutTransform);
 		return OutTransform;
 	}
 	UE_LOG(LogModularSection, Error, TEXT("%s: InstancedStaticMeshComponent was nullptr on GetSectionTransform"), *GetName());
@@ -331,46 +434,41 @@ FVector FModularSectionInstanced::GetLocation(int32 Index) const
 {
 	check(InstancedStaticMeshComponent);
 	FTransform InstanceTransform;
-	InstancedStaticMeshComponent->GetInstanceTransform(Index, InstanceTransform);
+	InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(Index), InstanceTransform);
 	return InstanceTransform.GetLocation();
 }
 
 void FModularSectionInstanced::SetLocation(FVector NewLocation, bool bRelative, int32 Index)
 {
 	check(InstancedStaticMeshComponent);
-	FTransform NewInstanceTransform = GetTransform(Index);
+	FTransform NewInstanceTransform;
+	InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(Index), NewInstanceTransform, !bRelative);
 	NewInstanceTransform.SetLocation(NewLocation);
-	InstancedStaticMeshComponent->UpdateInstanceTransform(Index, NewInstanceTransform, bRelative, Index == GetInstanceCount() - 1);
+	SetTransform(NewInstanceTransform, bRelative, Index);
 }
 
 FTransform FModularSectionInstanced::GetTransform(int32 Index) const
 {
 	check(InstancedStaticMeshComponent);
 	FTransform InstanceTransform;
-	InstancedStaticMeshComponent->GetInstanceTransform(Index, InstanceTransform);
+	InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(Index), InstanceTransform);
 	return InstanceTransform;
 }
 
 void FModularSectionInstanced::SetTransform(const FTransform& NewTransform, bool bRelative, int32 Index)
 {
 	check(InstancedStaticMeshComponent);
-	InstancedStaticMeshComponent->UpdateInstanceTransform(Index, NewTransform, bRelative, Index == GetInstanceCount() - 1);
+	InstancedStaticMeshComponent->UpdateInstanceTransform(ToComponentIndex(Index), NewTransform, !bRelative, Index == GetInstanceCount() - 1);
 }
 
 void FModularSectionInstanced::Offset(FVector Offset, bool bRelative, int32 Index)
 {
-	check(InstancedStaticMeshComponent);
-	FTransform InstanceTransform = GetTransform(Index);
-	InstanceTransform.AddToTranslation(Offset);
-	InstancedStaticMeshComponent->UpdateInstanceTransform(Index, InstanceTransform, bRelative, Index == GetInstanceCount() - 1);
+	OffsetRange(MakeArrayView(&Index, 1), Offset, bRelative);
 }
 
 void FModularSectionInstanced::Scale(FVector ScaleOffset, bool bRelative, int32 Index)
 {
-	check(InstancedStaticMeshComponent);
-	FTransform InstanceTransform = GetTransform(Index);
-	InstanceTransform.SetScale3D(ScaleOffset);
-	InstancedStaticMeshComponent->UpdateInstanceTransform(Index, InstanceTransform, bRelative, Index == GetInstanceCount() - 1);
+	ScaleRange(MakeArrayView(&Index, 1), ScaleOffset, bRelative);
 }
 
 void FModularSectionInstanced::SetPivot(FVector PivotOffset, int32 Index)
@@ -388,7 +486,7 @@ FVector FModularSectionInstanced::GetForwardVector(int32 Index) const
 {
 	check(InstancedStaticMeshComponent);
 	FTransform InstanceTransform;
-	InstancedStaticMeshComponent->GetInstanceTransform(Index, InstanceTransform);
+	InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(Index), InstanceTransform);
 	return InstanceTransform.Rotator().Vector();
 }
 
@@ -396,7 +494,7 @@ FVector FModularSectionInstanced::GetRightVector(int32 Index) const
 {
 	check(InstancedStaticMeshComponent);
 	FTransform InstanceTransform;
-	InstancedStaticMeshComponent->GetInstanceTransform(Index, InstanceTransform);
+	InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(Index), InstanceTransform);
 	return FRotationMatrix(InstanceTransform.Rotator()).GetScaledAxis(EAxis::Y);
 }
 
@@ -404,13 +502,22 @@ FVector FModularSectionInstanced::GetUpVector(int32 Index) const
 {
 	check(InstancedStaticMeshComponent);
 	FTransform InstanceTransform;
-	InstancedStaticMeshComponent->GetInstanceTransform(Index, InstanceTransform);
+	InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(Index), InstanceTransform);
 	return FRotationMatrix(InstanceTransform.Rotator()).GetScaledAxis(EAxis::Z);
 }
 
 void FModularSectionInstanced::Reset()
 {
 	check(InstancedStaticMeshComponent);
+	if (IsInstanceRange())
+	{
+		// Shared component is owned by FMBSSections, so only forget about it here
+		InstancedStaticMeshComponent = nullptr;
+		SetInstanceRange(0, 0);
+		HiddenTransforms.Empty();
+		bHidden = false;
+		return;
+	}
 	InstancedStaticMeshComponent->ClearInstances();
 	InstancedStaticMeshComponent->UnregisterComponent();
 	InstancedStaticMeshComponent->DestroyComponent();
@@ -420,11 +527,158 @@ void FModularSectionInstanced::Reset()
 void FModularSectionInstanced::SetMesh(UStaticMesh* NewStaticMesh) const
 {
 	check(InstancedStaticMeshComponent);
+	if (IsInstanceRange())
+	{
+		// Changing mesh of a shared component will affect all other levels, so instances must be moved instead
+		UE_LOG(LogModularSection, Error, TEXT("%s: SetMesh is not supported for instance ranges of a shared component. Use FMBSSections::MoveInstancesOfLevel instead."),
+			*GetName());
+		return;
+	}
 	InstancedStaticMeshComponent->SetStaticMesh(NewStaticMesh);
 }
 
+void FModularSectionInstanced::GetTransforms(TConstArrayView<int32> InIndices, TArray<FTransform>& OutTransforms) const
+{
+	check(InstancedStaticMeshComponent);
+	OutTransforms.Reserve(OutTransforms.Num() + InIndices.Num());
+	for (const int32 Index : InIndices)
+	{
+		FTransform InstanceTransform;
+		InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(Index), InstanceTransform);
+		OutTransforms.Add(InstanceTransform);
+	}
+}
+
+void FModularSectionInstanced::SetTransforms(TConstArrayView<int32> InIndices, TConstArrayView<FTransform> NewTransforms,
+	bool bRelative)
+{
+	check(InstancedStaticMeshComponent);
+	check(InIndices.Num() == NewTransforms.Num());
+	if (InIndices.IsEmpty())
+	{
+		return;
+	}
+
+	bool bContiguous = true;
+	for (int32 i = 1; i < InIndices.Num() && bContiguous; i++)
+	{
+		bContiguous = InIndices[i] == InIndices[i - 1] + 1;
+	}
+
+	if (bContiguous)
+	{
+		InstancedStaticMeshComponent->BatchUpdateInstancesTransforms(ToComponentIndex(InIndices[0]),
+			TArray<FTransform>(NewTransforms), !bRelative, true);
+	}
+	else
+	{
+		for (int32 i = 0; i < InIndices.Num(); i++)
+		{
+			InstancedStaticMeshComponent->UpdateInstanceTransform(ToComponentIndex(InIndices[i]), NewTransforms[i], !bRelative, false);
+		}
+		InstancedStaticMeshComponent->MarkRenderStateDirty();
+	}
+}
+
+void FModularSectionInstanced::OffsetRange(TConstArrayView<int32> InIndices, FVector Offset, bool bRelative)
+{
+	check(InstancedStaticMeshComponent);
+	TArray<FTransform> Transforms;
+	GetTransforms(InIndices, Transforms);
+
+	// Instance transforms are stored relative to the component, so world offset must be converted first
+	const FVector LocalOffset = bRelative ? Offset : InstancedStaticMeshComponent->GetComponentTransform().InverseTransformVector(Offset);
+	for (FTransform& Transform : Transforms)
+	{
+		Transform.AddToTranslation(LocalOffset);
+	}
+	SetTransforms(InIndices, Transforms, true);
+}
+
+void FModularSectionInstanced::ScaleRange(TConstArrayView<int32> InIndices, FVector ScaleOffset, bool bRelative)
+{
+	check(InstancedStaticMeshComponent);
+	TArray<FTransform> Transforms;
+	GetTransforms(InIndices, Transforms);
+	for (FTransform& Transform : Transforms)
+	{
+		Transform.SetScale3D(ScaleOffset);
+	}
+	SetTransforms(InIndices, Transforms, true);
+}
+
 int32 FModularSectionInstanced::GetInstanceCount() const
 {
 	check(InstancedStaticMeshComponent);
-	return InstancedStaticMeshComponent->GetInstanceCount();
+	return IsInstanceRange() ? OwnedInstanceCount : InstancedStaticMeshComponent->GetInstanceCount();
+}
+
+FBox FModularSectionInstanced::GetBounds() const
+{
+	check(InstancedStaticMeshComponent);
+	if (!IsInstanceRange())
+	{
+		return InstancedStaticMeshComponent->Bounds.GetBox();
+	}
+
+	FBox OutBox(ForceInit);
+	const UStaticMesh* StaticMesh = InstancedStaticMeshComponent->GetStaticMesh();
+	if (!StaticMesh)
+	{
+		return OutBox;
+	}
+
+	const FBox MeshBox = StaticMesh->GetBoundingBox();
+	for (int32 i = 0; i < OwnedInstanceCount; i++)
+	{
+		FTransform InstanceTransform;
+		if (InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(i), InstanceTransform, true))
+		{
+			OutBox += MeshBox.TransformBy(InstanceTransform);
+		}
+	}
+	return OutBox;
+}
+
+void FModularSectionInstanced::SetInstanceRange(int32 InFirstInstanceIndex, int32 InCount)
+{
+	check(InFirstInstanceIndex >= 0 && InCount >= 0);
+	FirstInstanceIndex = InFirstInstanceIndex;
+	OwnedInstanceCount = InCount;
+}
+
+void FModularSectionInstanced::SetRangeVisibility(bool bVisible)
+{
+	check(InstancedStaticMeshComponent);
+	if (bVisible != bHidden)
+	{
+		return;
+	}
+
+	const int32 Count = GetInstanceCount();
+	if (bVisible)
+	{
+		ensure(HiddenTransforms.Num() == Count);
+		if (Count > 0)
+		{
+			InstancedStaticMeshComponent->BatchUpdateInstancesTransforms(FirstInstanceIndex, HiddenTransforms, false, true);
+		}
+		HiddenTransforms.Empty();
+	}
+	else
+	{
+		HiddenTransforms.SetNum(Count);
+		TArray<FTransform> CollapsedTransforms;
+		CollapsedTransforms.Reserve(Count);
+		for (int32 i = 0; i < Count; i++)
+		{
+			InstancedStaticMeshComponent->GetInstanceTransform(ToComponentIndex(i), HiddenTransforms[i], false);
+			CollapsedTransforms.Add_GetRef(HiddenTransforms[i]).SetScale3D(FVector::ZeroVector);
+		}
+		if (Count > 0)
+		{
+			InstancedStaticMeshComponent->BatchUpdateInstancesTransforms(FirstInstanceIndex, CollapsedTransforms, false, true);
+		}
+	}
+	bHidden = !bVisible;
 }
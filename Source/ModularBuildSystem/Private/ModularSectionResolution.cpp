@@ -48,6 +48,66 @@ FNextTransformArgs::FNextTransformArgs(const FTransform& Transform, int32 Index,
 {
 }
 
+FNextTransformArgs::FNextTransformArgs(const FNextTransformContext& InContext, int32 Index)
+    : InTransform(InContext.Transform)
+    , InIndex(Index)
+    , InMaxInRow(InContext.MaxInRow)
+    , InMaxCount(InContext.MaxCount)
+    , InLevelZMultiplier(InContext.LevelZMultiplier)
+    , InPreviousLevelResolution(InContext.PreviousLevelResolution)
+    , InResolution(InContext.Resolution)
+    , InSolver(InContext.Solver)
+    , InSpline(InContext.Spline)
+    , OutLocation(InTransform.GetLocation())
+    , OutRotation(InTransform.GetRotation().Rotator())
+    , OutScale(InTransform.GetScale3D())
+    , Context(&InContext)
+{
+    check(InContext.BuildStats);
+}
+
+void FNextTransformArgs::Reset(int32 Index)
+{
+    InIndex = Index;
+    bOutShouldBeSkipped = false;
+    OutLocation = InTransform.GetLocation();
+    OutRotation = InTransform.GetRotation().Rotator();
+    OutScale = InTransform.GetScale3D();
+}
+
+void FNextTransformArgs::FillBuildStats()
+{
+    if (Context)
+    {
+        InBuildStats = *Context->BuildStats;
+    }
+}
+
+FNextTransformContext::FNextTransformContext(const FTransform& InTransform, int32 InMaxInRow, int32 InMaxCount,
+        float InLevelZMultiplier, const FModularBuildStats& InBuildStats,
+        const UModularSectionResolution* InPreviousLevelResolution, const UModularSectionResolution* InResolution,
+        UMBSTransformSolver* InSolver)
+    : Transform(InTransform)
+    , MaxInRow(InMaxInRow != 0 ? InMaxInRow : 1)
+    , MaxCount(InMaxCount)
+    , LevelZMultiplier(InLevelZMultiplier)
+    , BuildStats(&InBuildStats)
+    , PreviousLevelResolution(InPreviousLevelResolution)
+    , Resolution(InResolution)
+    , Solver(InSolver)
+{
+}
+
+FNextTransformContext::FNextTransformContext(const FTransform& InTransform, const FModularLevel& Level,
+        const FModularBuildStats& InBuildStats, const UModularSectionResolution* InPreviousLevelResolution,
+        USplineComponent* InSpline)
+    : FNextTransformContext(InTransform, Level.GetInitializer().GetMaxInRow(), Level.GetInitializer().GetTotalCount(),
+        Level.GetZMultiplier(), InBuildStats, InPreviousLevelResolution, Level.GetInitializer().GetResolution(),
+        Level.GetSolver())
+{
+    Spline = InSpline;
+}
+
 FTransform UModularSectionResolution::GetNextTransform(const FTransform& InTransform, int32 InIndex, int32 MaxInRow,
     int32 InMaxCount, float InLevelZMultiplier, const FModularBuildStats& InStats, UMBSTransformSolver* InSolver, 
     const UModularSectionResolution* InPreviousLevelResolution) const
@@ -58,25 +118,71 @@ FTransform UModularSectionResolution::GetNextTransform(const FTransform& InTrans
         MaxInRow = 1;
     }
 
-    // Set initial location as the InTransform location
-    // From now - they are set inside FNextTransformArgs ctor
-    //const FVector OutLocation = InTransform.GetLocation();
-    //const FRotator OutRotation = InTransform.GetRotation().Rotator();
+    const FNextTransformContext Context(InTransform, MaxInRow, InMaxCount, InLevelZMultiplier, InStats,
+        InPreviousLevelResolution, this, InSolver);
+    return GetNextTransform(Context, InIndex);
+}
 
-    FNextTransformArgs Args = FNextTransformArgs(
-        InTransform, 
-        InIndex, 
-        MaxInRow, 
-        InMaxCount, 
-        InLevelZMultiplier,
-        InStats,
-        InPreviousLevelResolution,
-        this,
-        InSolver);
+void UModularSectionResolution::GetNextTransforms(const FTransform& InTransform, int32 InCount, int32 MaxInRow,
+    int32 InMaxCount, float InLevelZMultiplier, const FModularBuildStats& InStats, UMBSTransformSolver* InSolver,
+    const UModularSectionResolution* InPreviousLevelResolution, TArray<FTransform>& OutTransforms) const
+{
+    const FNextTransformContext Context(InTransform, MaxInRow, InMaxCount, InLevelZMultiplier, InStats,
+        InPreviousLevelResolution, this, InSolver);
+    GetNextTransforms(Context, InCount, OutTransforms);
+}
 
-    if (InSolver)
+FTransform UModularSectionResolution::GetNextTransform(const FNextTransformContext& Context, int32 InIndex) const
+{
+    FNextTransformArgs Args(Context, InIndex);
+    if (Context.Solver && !Context.Solver->HasNativeBatch())
     {
-        InSolver->GetNextTransform(Args);
+        Args.FillBuildStats();
+    }
+    return SolveNextTransform(Args);
+}
+
+void UModularSectionResolution::GetNextTransforms(const FNextTransformContext& Context, int32 InCount,
+    TArray<FTransform>& OutTransforms) const
+{
+    if (Context.Solver && Context.Solver->HasNativeBatch())
+    {
+        const int32 FirstIndex = OutTransforms.Num();
+        Context.Solver->GetNextTransforms(Context, 0, InCount, OutTransforms);
+
+        // Same as in GetNextTransform, scale is not taken from solvers
+        for (int32 i = FirstIndex; i < OutTransforms.Num(); i++)
+        {
+            OutTransforms[i].SetScale3D(FVector::OneVector);
+        }
+        return;
+    }
+
+    OutTransforms.Reserve(OutTransforms.Num() + InCount);
+    
+    // Blueprint solvers can modify any of the arguments, so they are made anew for each index
+    if (Context.Solver)
+    {
+        for (int32 i = 0; i < InCount; i++)
+        {
+            OutTransforms.Add(GetNextTransform(Context, i));
+        }
+        return;
+    }
+
+    FNextTransformArgs Args(Context, 0);
+    for (int32 i = 0; i < InCount; i++)
+    {
+        Args.Reset(i);
+        OutTransforms.Add(SolveNextTransform(Args));
+    }
+}
+
+FTransform UModularSectionResolution::SolveNextTransform(FNextTransformArgs& Args) const
+{
+    if (Args.InSolver)
+    {
+        Args.InSolver->GetNextTransform(Args);
         return FTransform(Args.OutRotation, Args.OutLocation);
     }
 
@@ -182,7 +288,7 @@ void UModularSectionResolution::GetNextWallTransform_DEPRECATED(FNextTransformAr
     
             ///uint8 RemainderShift = (bool)(Args.InMaxCount % Args.InMaxInRow);
             ///Args.OutLocation.Y += (DefaultSectionSize * CurrentRow) + (DefaultSectionSize * RemainderShift);        // here Y need to be adjusted
-            Args.OutLocation.Y += (DefaultSectionSize * /*GetWallMaxRow(Args.InMaxCount, Args.InMaxInRow)*/Args.InBuildStats.Bounds.Y) - DefaultSectionSize;
+            Args.OutLocation.Y += (DefaultSectionSize * /*GetWallMaxRow(Args.InMaxCount, Args.InMaxInRow)*/Args.GetBuildStats().Bounds.Y) - DefaultSectionSize;
         }
         else // We are somewhere in the middle. Suppose to be remainder of a division (CurrentRow == MaxRow) that goes to the Back side of a house
         {
@@ -196,8 +302,8 @@ void UModularSectionResolution::GetNextWallTransform_DEPRECATED(FNextTransformAr
                 const uint8 Remainder = Args.InMaxCount - Args.InIndex;
                 ///Args.OutLocation.Y += (DefaultSectionSize * GetWallCurrentRow(AdjustedIndex, Args.InMaxInRow, Args.InMaxCount));
     
-                const int32 BoundsDifference = Args.InBuildStats.Bounds.Y - Args.InBuildStats.Bounds.X;
-                const int32 WallCurrentRow = FMath::Clamp(GetWallCurrentRow(Args.InIndex, Args.InMaxInRow), 0, Args.InBuildStats.Bounds.Y);
+                const int32 BoundsDifference = Args.GetBuildStats().Bounds.Y - Args.GetBuildStats().Bounds.X;
+                const int32 WallCurrentRow = FMath::Clamp(GetWallCurrentRow(Args.InIndex, Args.InMaxInRow), 0, Args.GetBuildStats().Bounds.Y);
                 UE_LOG(LogSectionResolution, VeryVerbose, TEXT("%s: WallCurrentRow = %d"), *GetName(), WallCurrentRow);
     
                 Args.OutLocation.Y += (DefaultSectionSize * WallCurrentRow - DefaultSectionSize)/* + DefaultSectionSize * BoundsDifference*/;
@@ -238,7 +344,7 @@ void UModularSectionResolution::GetNextWallTransform_Gen2(FNextTransformArgs& Ar
         else if (IsFacingBack(AdjustedIndex, Args.InMaxInRow))
         {
             Args.OutRotation.Yaw -= 90.f;
-            Args.OutLocation.X += (DefaultSectionSize * (Args.InBuildStats.Bounds.X + 1)) - DefaultSectionSize;
+            Args.OutLocation.X += (DefaultSectionSize * (Args.GetBuildStats().Bounds.X + 1)) - DefaultSectionSize;
         }
         else if (IsFacingLeft(GetCurrentRow(Args.InIndex, Args.InMaxInRow)))
         {
@@ -253,20 +359,20 @@ void UModularSectionResolution::GetNextWallTransform_Gen2(FNextTransformArgs& Ar
         const int32 RightAdjustedIndex = (AdjustedIndex + Remainder) % Args.InMaxInRow;
 
         // FixSectionCount = 6 - ((6 - 2) + 1) = 1
-        const int32 FixSectionCount = Args.InMaxCount - ((Args.InMaxCount - Args.InBuildStats.Bounds.X) + 1);
+        const int32 FixSectionCount = Args.InMaxCount - ((Args.InMaxCount - Args.GetBuildStats().Bounds.X) + 1);
 
         // TODO: New check for Y=1
-        if (Args.InBuildStats.Bounds.Y == 1 && Args.InMaxCount - Args.InIndex <= FixSectionCount)
+        if (Args.GetBuildStats().Bounds.Y == 1 && Args.InMaxCount - Args.InIndex <= FixSectionCount)
         {
             UE_LOG(LogMBS, VeryVerbose, TEXT("%s: InMaxCount=%d, InIndex=%d, FixSectionCount=%d, Bounds.X=%d, RightAdjustedIndex=%d"
             ", AdjustedIndex=%d, Remainder=%d"), 
-                *GetName(), Args.InMaxCount, Args.InIndex, FixSectionCount, Args.InBuildStats.Bounds.X, RightAdjustedIndex, AdjustedIndex, Remainder);
+                *GetName(), Args.InMaxCount, Args.InIndex, FixSectionCount, Args.GetBuildStats().Bounds.X, RightAdjustedIndex, AdjustedIndex, Remainder);
             UE_LOG(LogMBS, VeryVerbose, TEXT("%s: %d - %d <= %d"), *GetName(), Args.InMaxCount, Args.InIndex, FixSectionCount);
 
             UE_LOG(LogMBS, VeryVerbose, TEXT("%s: TRUE"), *GetName());
             // We are facing the right side
             Args.OutLocation.X += (DefaultSectionSize * /*RightAdjustedIndex*/AdjustedIndex) - DefaultSectionSize;
-            Args.OutLocation.Y += (DefaultSectionSize * Args.InBuildStats.Bounds.Y) - DefaultSectionSize;
+            Args.OutLocation.Y += (DefaultSectionSize * Args.GetBuildStats().Bounds.Y) - DefaultSectionSize;
         }
         else if (IsFacingFront(RightAdjustedIndex))
         {
@@ -274,7 +380,7 @@ void UModularSectionResolution::GetNextWallTransform_Gen2(FNextTransformArgs& Ar
             // In case of Bounds.X = 2 and Bounds.Y = 1
             // Index=7 goes here, but need to be at IsFacingRight
             Args.OutRotation.Yaw += 90.f;
-            Args.OutLocation.Y += (DefaultSectionSize * (Args.InBuildStats.Bounds.Y - 1)) - DefaultSectionSize;
+            Args.OutLocation.Y += (DefaultSectionSize * (Args.GetBuildStats().Bounds.Y - 1)) - DefaultSectionSize;
         }
         else if (IsFacingBack(RightAdjustedIndex, Args.InMaxInRow))
         {
@@ -282,13 +388,13 @@ void UModularSectionResolution::GetNextWallTransform_Gen2(FNextTransformArgs& Ar
             // In case of Bounds.X = 2 and Bounds.Y = 1
             // Index=6 goes here, but need to be at IsFacingRight
             Args.OutRotation.Yaw -= 90.f;
-            Args.OutLocation.X += (DefaultSectionSize * (Args.InBuildStats.Bounds.X + 1)) - DefaultSectionSize;
-            Args.OutLocation.Y += (DefaultSectionSize * (Args.InBuildStats.Bounds.Y - 1));
+            Args.OutLocation.X += (DefaultSectionSize * (Args.GetBuildStats().Bounds.X + 1)) - DefaultSectionSize;
+            Args.OutLocation.Y += (DefaultSectionSize * (Args.GetBuildStats().Bounds.Y - 1));
         }
         else // We are facing the right side
         {
             Args.OutLocation.X += (DefaultSectionSize * RightAdjustedIndex) - DefaultSectionSize;
-            Args.OutLocation.Y += (DefaultSectionSize * Args.InBuildStats.Bounds.Y) - DefaultSectionSize;
+            Args.OutLocation.Y += (DefaultSectionSize * Args.GetBuildStats().Bounds.Y) - DefaultSectionSize;
         }
     }
     else // Middle
@@ -326,7 +432,7 @@ void UModularSectionResolution::GetNextWallTransform(FNextTransformArgs& Args) c
         else if (IsFacingBack(AdjustedIndex, Args.InMaxInRow))
         {
             Args.OutRotation.Yaw -= 90.f;
-            Args.OutLocation.X += DefaultSectionSize * Args.InBuildStats.Bounds.X;
+            Args.OutLocation.X += DefaultSectionSize * Args.GetBuildStats().Bounds.X;
         }
         else if (IsFacingLeft(GetCurrentRow(Args.InIndex, Args.InMaxInRow)))
         {
@@ -347,7 +453,7 @@ void UModularSectionResolution::GetNextWallTransform(FNextTransformArgs& Args) c
                 (MiddleWallsCount > 0 || (Remainder == 0 && MiddleWallsCount == 0) ? 2 : 0));
             
             Args.OutLocation.X += (DefaultSectionSize * ShiftMultiplier);
-            Args.OutLocation.Y += (DefaultSectionSize * Args.InBuildStats.Bounds.Y) - DefaultSectionSize;
+            Args.OutLocation.Y += (DefaultSectionSize * Args.GetBuildStats().Bounds.Y) - DefaultSectionSize;
         }
     }
     else // Middle
@@ -451,7 +557,7 @@ void UModularSectionResolution::GetNextCornerTransform(FNextTransformArgs& Args)
     // on the back side on the max resolution (from the stats)
     if (IsFacingBack(AdjustedIndex, Args.InMaxInRow))
     {
-        Args.OutLocation.X += (DefaultSectionSize * Args.InBuildStats.MaxCountInRow) - DefaultSectionSize * 2.f;
+        Args.OutLocation.X += (DefaultSectionSize * Args.GetBuildStats().MaxCountInRow) - DefaultSectionSize * 2.f;
         if (IsFacingLeft(CurrentRow))
         {
             Args.OutRotation.Yaw += 90.f;
@@ -470,9 +576,9 @@ void UModularSectionResolution::GetNextCornerTransform(FNextTransformArgs& Args)
         // With such bounds BuildStats have MaxTotalRows property equals 2 and need to be 1
         UE_LOG(LogSectionResolution, VeryVerbose, TEXT("%s: InBuildStats.MaxTotalRows = %d, InBuildStats.Bounds.Y = %d"),
             *GetName(), 
-            Args.InBuildStats.MaxTotalRows, Args.InBuildStats.Bounds.Y);
-        ///Args.OutLocation.Y += (DefaultSectionSize * Args.InBuildStats.MaxTotalRows) - DefaultSectionSize;
-        Args.OutLocation.Y += (DefaultSectionSize * Args.InBuildStats.Bounds.Y) - DefaultSectionSize;
+            Args.GetBuildStats().MaxTotalRows, Args.GetBuildStats().Bounds.Y);
+        ///Args.OutLocation.Y += (DefaultSectionSize * Args.GetBuildStats().MaxTotalRows) - DefaultSectionSize;
+        Args.OutLocation.Y += (DefaultSectionSize * Args.GetBuildStats().Bounds.Y) - DefaultSectionSize;
     }
     else if (IsFacingFront(AdjustedIndex) || IsFacingLeft(CurrentRow))
     {
@@ -597,6 +703,16 @@ EModularSectionResolutionSnapMode UModularSectionResolution::GetSnapMode() const
     return SnapMode;
 }
 
+FName UModularSectionResolution::GetValueTagName()
+{
+    return GET_MEMBER_NAME_CHECKED(UModularSectionResolution, Resolution);
+}
+
+FName UModularSectionResolution::GetSnapModeTagName()
+{
+    return GET_MEMBER_NAME_CHECKED(UModularSectionResolution, SnapMode);
+}
+
 FIntVector UModularSectionResolution::GetResolutionFromMesh(UStaticMesh* InMesh)
 {
     if (InMesh)
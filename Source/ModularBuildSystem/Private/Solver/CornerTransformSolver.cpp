@@ -13,7 +13,7 @@ FTransform UCornerTransformSolver::GetNextTransform_Implementation(FNextTransfor
 	// on the back side on the max resolution (from the stats)
 	if (IsFacingBack())
 	{
-		Args.OutLocation.X += (DSS * Args.InBuildStats.MaxCountInRow) - DSS * 2.f;
+		Args.OutLocation.X += (DSS * Args.GetBuildStats().MaxCountInRow) - DSS * 2.f;
 		if (IsFacingLeft())
 		{
 			Args.OutRotation.Yaw += 90.f;
@@ -32,9 +32,9 @@ FTransform UCornerTransformSolver::GetNextTransform_Implementation(FNextTransfor
 		// With such bounds BuildStats have MaxTotalRows property equals 2 and need to be 1
 		UE_LOG(LogSectionResolution, VeryVerbose, TEXT("%s: InBuildStats.MaxTotalRows = %d, InBuildStats.Bounds.Y = %d"),
 			*GetName(), 
-			Args.InBuildStats.MaxTotalRows, Args.InBuildStats.Bounds.Y);
+			Args.GetBuildStats().MaxTotalRows, Args.GetBuildStats().Bounds.Y);
 
-		Args.OutLocation.Y += (DSS * Args.InBuildStats.Bounds.Y) - DSS;
+		Args.OutLocation.Y += (DSS * Args.GetBuildStats().Bounds.Y) - DSS;
 	}
 	else if (IsFacingFront() || IsFacingLeft())
 	{
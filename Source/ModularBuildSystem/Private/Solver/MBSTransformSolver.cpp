@@ -20,6 +20,25 @@
 #define WITH_ARGS_VOID {}
 #endif
 
+void UMBSTransformSolver::GetNextTransforms(const FNextTransformContext& InContext, int32 InFirstIndex, int32 InCount,
+	TArray<FTransform>& OutTransforms)
+{
+	check(HasNativeBatch());
+	OutTransforms.Reserve(OutTransforms.Num() + InCount);
+	FNextTransformArgs Args(InContext, InFirstIndex);
+	for (int32 i = 0; i < InCount; i++)
+	{
+		Args.Reset(InFirstIndex + i);
+		OutTransforms.Add(GetNextTransform_Implementation(Args));
+	}
+	Arguments = nullptr;
+}
+
+bool UMBSTransformSolver::HasNativeBatch() const
+{
+	return GetClass()->HasAnyClassFlags(CLASS_Native);
+}
+
 void UMBSTransformSolver::In(FNextTransformArgs& Args)
 {
 	Arguments = &Args;
@@ -63,7 +82,7 @@ float UMBSTransformSolver::GetLevelZMultiplier() const
 FModularBuildStats UMBSTransformSolver::GetBuildStats() const
 {
 	WITH_ARGS
-	return Arguments->InBuildStats;
+	return Arguments->GetBuildStats();
 }
 
 UModularSectionResolution* UMBSTransformSolver::GetPreviousLevelResolution() const
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModularBuildSystemActor.h"
+#include "House/HouseBuildSystemGenerator.h"
+#include "MBSTestHouseGenerator.generated.h"
+
+/**
+ * House generator that exposes the layout taken by the generation, and generates a single detail section per tier
+ * above the shell. Is used by automation tests only.
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UMBSTestHouseGenerator : public UHouseBuildSystemGenerator
+{
+	GENERATED_BODY()
+
+public:
+	FHouseBuildSystemLayout TakeGenerationLayout() { return TakeLayout(); }
+
+	virtual bool GenerateTierDetails() override
+	{
+		AModularBuildSystemActor* BuildSystem = Cast<AModularBuildSystemActor>(GetBuildSystemPtr().GetObject());
+		if (!BuildSystem || !DetailMesh)
+		{
+			return false;
+		}
+
+		const FVector Location(0.f, 0.f, 100.f * static_cast<int32>(GetGenerationTier()));
+		BuildSystem->InitModularSection(DetailMesh, FTransform(Location), DetailLevelId, true, true);
+		return true;
+	}
+
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> DetailMesh;
+
+	int32 DetailLevelId = 0;
+};
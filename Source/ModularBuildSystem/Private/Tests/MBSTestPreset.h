@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModularBuildSystemPreset.h"
+#include "ModularLevel.h"
+#include "MBSTestPreset.generated.h"
+
+class UHouseBuildSystemGenerator;
+class UModularBuildSystemMeshList;
+
+/**
+ * Preset of a house build system that relies on the default copying of properties. Is used by automation tests only.
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UMBSTestPreset : public UModularBuildSystemPreset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Instanced)
+	TObjectPtr<UHouseBuildSystemGenerator> Generator;
+
+	UPROPERTY()
+	FModularLevel Roof;
+
+	/**
+	 * Has the name of a build system property of another type, so it is never copied.
+	 */
+	UPROPERTY()
+	int32 Walls = 0;
+
+	/**
+	 * Is not a build system property, only a part of the configuration.
+	 */
+	UPROPERTY()
+	TObjectPtr<UModularBuildSystemMeshList> MeshList;
+
+	uint32 GetConfigurationCrc() const { return CalculateConfigurationCrc(); }
+	const FMBSPresetLayout& GetLayout() const { return Layout; }
+	void SetSaveLayout(bool bInSaveLayout) { bSaveLayout = bInSaveLayout; }
+	void SetSavedLayoutVersion(int32 InVersion) { SavedLayoutVersion = InVersion; }
+};
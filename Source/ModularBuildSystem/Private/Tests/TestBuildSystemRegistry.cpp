@@ -0,0 +1,36 @@
+#include "MBSBuildSystemRegistry.h"
+#include "MBSFunctionLibrary.h"
+#include "ModularBuildSystemActor.h"
+#include "House/HouseBuildSystemActor.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRegisterBuildSystem, "ModularBuildSystem.BuildSystemRegistry.Register",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FRegisterBuildSystem::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	const UMBSBuildSystemRegistry* Registry = UMBSBuildSystemRegistry::Get(World);
+	UTEST_NOT_NULL("Registry is valid", Registry);
+
+	const int32 TotalCountBefore = Registry->GetTotalCount();
+	const int32 HouseCountBefore = Registry->GetCountOf(AHouseBuildSystemActor::StaticClass());
+	const int32 UnmergedCountBefore = Registry->GetUnmergedCount();
+
+	// Spawn new build system
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+
+	TestEqual("Total count after spawn", Registry->GetTotalCount(), TotalCountBefore + 1);
+	TestEqual("House count after spawn", Registry->GetCountOf(AHouseBuildSystemActor::StaticClass()), HouseCountBefore + 1);
+	TestEqual("Unmerged count after spawn", Registry->GetUnmergedCount(), UnmergedCountBefore + 1);
+	TestTrue("Build system is listed", Registry->GetBuildSystems().Contains(BuildSystem));
+
+	BuildSystem->Destroy();
+	TestEqual("Total count after destroy", Registry->GetTotalCount(), TotalCountBefore);
+	TestEqual("House count after destroy", Registry->GetCountOf(AHouseBuildSystemActor::StaticClass()), HouseCountBefore);
+	TestFalse("Build system is not listed", Registry->GetBuildSystems().Contains(BuildSystem));
+	
+	return true;
+}
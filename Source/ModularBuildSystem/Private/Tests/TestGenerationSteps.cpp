@@ -0,0 +1,97 @@
+#include "MBSGenerationSteps.h"
+#include "MBSFunctionLibrary.h"
+#include "MBSRegenerationScheduler.h"
+#include "House/HouseBuildSystemActor.h"
+#include "House/HouseBuildSystemGenerator.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResumableGenerationSteps, "ModularBuildSystem.GenerationSteps.Resumable",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FResumableGenerationSteps::RunTest(const FString& Parameters)
+{
+	TArray<FString> Log;
+	int32 LevelIndex = 0;
+	constexpr int32 LevelCount = 3;
+
+	FMBSGenerationSteps Steps;
+	Steps.Add(TEXT("First"), [&Log]
+	{
+		Log.Add(TEXT("First"));
+	});
+	Steps.AddResumable(TEXT("Levels"), [&Log, &LevelIndex]
+	{
+		Log.Add(FString::Printf(TEXT("Level%d"), LevelIndex));
+		return ++LevelIndex < LevelCount ? EMBSGenerationStepResult::Pending : EMBSGenerationStepResult::Finished;
+	});
+	Steps.Add(TEXT("Last"), [&Log]
+	{
+		Log.Add(TEXT("Last"));
+	});
+
+	TestFalse("Steps are not done before execution", Steps.IsDone());
+	TestTrue("First step is current", Steps.GetCurrentStepName() == TEXT("First"));
+
+	// Pending step is executed again until it is finished
+	TestTrue("Remaining steps are done", Steps.RunToCompletion());
+	TestTrue("Steps are done", Steps.IsDone());
+	const TArray<FString> Expected = { TEXT("First"), TEXT("Level0"), TEXT("Level1"), TEXT("Level2"), TEXT("Last") };
+	TestTrue("Execution order", Log == Expected);
+
+	// Failed step skips the remaining ones
+	Log.Reset();
+	Steps.Reset();
+	Steps.AddResumable(TEXT("Fail"), []
+	{
+		return EMBSGenerationStepResult::Failed;
+	});
+	Steps.Add(TEXT("Skipped"), [&Log]
+	{
+		Log.Add(TEXT("Skipped"));
+	});
+	TestFalse("Failed steps are not completed", Steps.RunToCompletion());
+	TestTrue("Failed steps are done", Steps.IsDone());
+	TestTrue("Failure is reported", Steps.HasFailed());
+	TestEqual("Steps after failure are skipped", Log.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRegenerateWhileStepsArePending, "ModularBuildSystem.GenerationSteps.RegenerateWhilePending",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FRegenerateWhileStepsArePending::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	const UMBSRegenerationScheduler* Scheduler = UMBSRegenerationScheduler::Get(World);
+	UTEST_NOT_NULL("Scheduler is valid", Scheduler);
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+
+	// Generator without properties can't generate, so only the pending steps are tested
+	BuildSystem->Generator = NewObject<UHouseBuildSystemGenerator>(BuildSystem);
+	BuildSystem->Generator->Bounds = FIntPoint::ZeroValue;
+
+	TestTrue("Time-sliced generation has started", BuildSystem->GenerateTimeSliced());
+	TestTrue("Steps are pending", BuildSystem->IsGeneratingTimeSliced());
+	TestTrue("Scheduler advances the generation", Scheduler->IsTimeSliced(BuildSystem));
+
+	BuildSystem->Generate();
+	TestFalse("Regeneration cancels pending steps", BuildSystem->IsGeneratingTimeSliced());
+	TestFalse("Scheduler does not advance the cancelled generation", Scheduler->IsTimeSliced(BuildSystem));
+
+	TestTrue("Time-sliced generation has started again", BuildSystem->GenerateTimeSliced());
+	BuildSystem->SetGenerationTier(EMBSGenerationTier::Shell);
+	TestFalse("Switching generation tier cancels pending steps", BuildSystem->IsGeneratingTimeSliced());
+	TestFalse("Scheduler does not advance the cancelled generation after tier switch", Scheduler->IsTimeSliced(BuildSystem));
+
+	// Edits regenerate through the generator directly, which must cancel the pending steps as well
+	TestTrue("Time-sliced generation has started before the edit", BuildSystem->GenerateTimeSliced());
+	BuildSystem->RunScheduledRegeneration(EMBSRegenerationType::Full);
+	TestFalse("Regeneration on change cancels pending steps", BuildSystem->IsGeneratingTimeSliced());
+	TestFalse("Scheduler does not advance the generation cancelled by an edit", Scheduler->IsTimeSliced(BuildSystem));
+
+	BuildSystem->Destroy();
+	return true;
+}
@@ -0,0 +1,174 @@
+#include "MBSFunctionLibrary.h"
+#include "MBSSections.h"
+#include "MBSTestHouseGenerator.h"
+#include "ModularLevel.h"
+#include "Config/MBSGenerationTierConfiguration.h"
+#include "House/HouseBuildSystemActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	using FTierCache = TMap<EMBSGenerationTier, FMBSGenerationTierCache>;
+
+	FMBSSections* GetSections(AModularBuildSystemActor* BuildSystem)
+	{
+		const FStructProperty* Property = FindFProperty<FStructProperty>(AModularBuildSystemActor::StaticClass(), TEXT("Sections"));
+		return Property ? Property->ContainerPtrToValuePtr<FMBSSections>(BuildSystem) : nullptr;
+	}
+
+	const FTierCache* GetTierCache(const AModularBuildSystemActor* BuildSystem)
+	{
+		const FMapProperty* Property = FindFProperty<FMapProperty>(AModularBuildSystemActor::StaticClass(), TEXT("GenerationTierCache"));
+		return Property ? Property->ContainerPtrToValuePtr<FTierCache>(BuildSystem) : nullptr;
+	}
+
+	FVector GetInstanceScale(const UInstancedStaticMeshComponent* Component, int32 Index)
+	{
+		FTransform OutTransform;
+		Component->GetInstanceTransform(Index, OutTransform);
+		return OutTransform.GetScale3D();
+	}
+
+	UStaticMesh* GetSectionMesh(const FModularSection& Section)
+	{
+		return Section.GetStaticMeshActor()->GetStaticMeshComponent()->GetStaticMesh();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTierShellOverrides, "ModularBuildSystem.GenerationTiers.ShellOverrides",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FTierShellOverrides::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UStaticMesh* Plane = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+	UTEST_NOT_NULL("Cube mesh is valid", Cube);
+	UTEST_NOT_NULL("Plane mesh is valid", Plane);
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+	FMBSSections* Sections = GetSections(BuildSystem);
+	UTEST_NOT_NULL("Sections are valid", Sections);
+
+	constexpr int32 LevelId = 0;
+	FModularLevel Level;
+	Level.OverrideLevelId(LevelId);
+
+	// Shell
+	Sections->InitStatic(Cube, FTransform::Identity, LevelId, true, true);
+	UInstancedStaticMeshComponent* Component = Cast<UInstancedStaticMeshComponent>(
+		BuildSystem->AddComponentByClass(UInstancedStaticMeshComponent::StaticClass(), false, FTransform::Identity, false));
+	UTEST_NOT_NULL("Component is valid", Component);
+	Component->SetStaticMesh(Cube);
+	Component->AddInstances({ FTransform(FVector(100.f, 0.f, 0.f)), FTransform(FVector(200.f, 0.f, 0.f)) }, false);
+	Sections->Add(FModularSectionInstanced(LevelId, Component));
+	TestFalse("Shell is not marked before details", Sections->HasShell());
+
+	// Details
+	Sections->BeginTierDetails();
+	TestTrue("Shell is marked", Sections->HasShell());
+	FTransform ReplacedTransform;
+	TestNotNull("Instance is replaced", Sections->ReplaceWithNonInstancedSection(Plane, 1, LevelId, Component, ReplacedTransform));
+	Sections->AddNewInstance(FTransform(FVector(300.f, 0.f, 0.f)), true, Component);
+	Sections->SetMeshAt(Level, 0, Plane);
+	Sections->EndTierDetails();
+
+	TestEqual("Replaced instance is kept", Component->GetInstanceCount(), 3);
+	TestTrue("Replaced instance is hidden", GetInstanceScale(Component, 1).IsZero());
+	TestEqual("Detail section is added", Sections->GetStatic().Num(), 2);
+
+	TArray<FMBSShellOverride> Overrides;
+	FMBSSections Details = Sections->DetachTierDetails(Overrides);
+	TestEqual("All changes of the shell are recorded", Overrides.Num(), 3);
+	TestEqual("Only shell sections are left", Sections->GetStatic().Num(), 1);
+	TestEqual("Detail sections are detached", Details.GetStatic().Num(), 1);
+	TestEqual("Replaced instance is shown", GetInstanceScale(Component, 1), FVector::OneVector);
+	TestTrue("Added instance is hidden", GetInstanceScale(Component, 2).IsZero());
+	TestTrue("Shell mesh is restored", GetSectionMesh(Sections->GetStatic()[0]) == Cube);
+
+	Sections->AttachTierDetails(MoveTemp(Details), MoveTemp(Overrides));
+	TestEqual("Detail sections are attached", Sections->GetStatic().Num(), 2);
+	TestTrue("Replaced instance is hidden again", GetInstanceScale(Component, 1).IsZero());
+	TestEqual("Added instance is shown again", GetInstanceScale(Component, 2), FVector::OneVector);
+	TestTrue("Detail mesh is set again", GetSectionMesh(Sections->GetStatic()[0]) == Plane);
+
+	Sections->Reset(true, true, true);
+	TestFalse("Reset clears the shell", Sections->HasShell());
+	BuildSystem->Destroy();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchGenerationTiers, "ModularBuildSystem.GenerationTiers.Switch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FSwitchGenerationTiers::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh is valid", Cube);
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+	const FTierCache* Cache = GetTierCache(BuildSystem);
+	UTEST_NOT_NULL("Tier cache is valid", Cache);
+
+	UMBSTestHouseGenerator* Generator = NewObject<UMBSTestHouseGenerator>(BuildSystem);
+	Generator->DetailMesh = Cube;
+	BuildSystem->Generator = Generator;
+
+	// Shell without any details
+	BuildSystem->InitModularSection(Cube, FTransform::Identity, Generator->DetailLevelId, true, true);
+	BuildSystem->BeginTierDetails();
+	BuildSystem->EndTierDetails();
+	const AStaticMeshActor* ShellActor = BuildSystem->GetStaticSections()[0].GetStaticMeshActor();
+
+	BuildSystem->SetGenerationTier(EMBSGenerationTier::Shell);
+	TestEqual("Shell is kept", BuildSystem->GetStaticSections().Num(), 1);
+	TestTrue("Full tier is cached", Cache->Contains(EMBSGenerationTier::Full));
+	BuildSystem->ClearGenerationTierCache();
+	TestEqual("Cache is cleared", Cache->Num(), 0);
+
+	// Details are generated on top of the shell
+	BuildSystem->SetGenerationTier(EMBSGenerationTier::Facade);
+	UTEST_EQUAL("Facade details are generated", BuildSystem->GetStaticSections().Num(), 2);
+	TestTrue("Shell is shared with the facade tier", BuildSystem->GetStaticSections()[0].GetStaticMeshActor() == ShellActor);
+	const AStaticMeshActor* FacadeActor = BuildSystem->GetStaticSections()[1].GetStaticMeshActor();
+
+	BuildSystem->SetGenerationTier(EMBSGenerationTier::Full);
+	UTEST_EQUAL("Full details are generated", BuildSystem->GetStaticSections().Num(), 2);
+	TestTrue("Shell is shared with the full tier", BuildSystem->GetStaticSections()[0].GetStaticMeshActor() == ShellActor);
+	TestEqual("Full details are placed", BuildSystem->GetStaticSections()[1].GetLocation().Z, 200.0);
+
+	// Only details of the previous tier are cached
+	const FMBSGenerationTierCache* FacadeCache = Cache->Find(EMBSGenerationTier::Facade);
+	UTEST_NOT_NULL("Facade tier is cached", FacadeCache);
+	UTEST_EQUAL("Only facade details are cached", FacadeCache->Sections.GetStatic().Num(), 1);
+	TestTrue("Cached section is the facade detail", FacadeCache->Sections.GetStatic()[0].GetStaticMeshActor() == FacadeActor);
+	TestFalse("Cached details are hidden", FacadeActor->GetRootComponent()->IsVisible());
+	TestTrue("Cached details are not saved", FacadeActor->HasAnyFlags(RF_Transient));
+
+	// Cached details are restored instead of being generated again
+	BuildSystem->SetGenerationTier(EMBSGenerationTier::Facade);
+	UTEST_EQUAL("Facade details are restored", BuildSystem->GetStaticSections().Num(), 2);
+	TestTrue("Restored detail is the cached one", BuildSystem->GetStaticSections()[1].GetStaticMeshActor() == FacadeActor);
+	TestTrue("Restored details are visible", FacadeActor->GetRootComponent()->IsVisible());
+	TestFalse("Restored details are saved", FacadeActor->HasAnyFlags(RF_Transient));
+	TestFalse("Restored tier is removed from the cache", Cache->Contains(EMBSGenerationTier::Facade));
+	TestTrue("Full tier is cached", Cache->Contains(EMBSGenerationTier::Full));
+
+	BuildSystem->SetGenerationTier(EMBSGenerationTier::Shell);
+	TestEqual("Only the shell is shown", BuildSystem->GetStaticSections().Num(), 1);
+	TestTrue("Shell is kept with the shell tier", BuildSystem->GetStaticSections()[0].GetStaticMeshActor() == ShellActor);
+	TestEqual("Details of both tiers are cached", Cache->Num(), 2);
+
+	BuildSystem->ClearGenerationTierCache();
+	BuildSystem->ResetBuildSystem();
+	BuildSystem->Destroy();
+
+	return true;
+}
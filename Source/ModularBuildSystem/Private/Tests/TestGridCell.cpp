@@ -0,0 +1,29 @@
+#include "MBSGridCell.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridCellKeyPacking, "ModularBuildSystem.GridCell.Key",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FGridCellKeyPacking::RunTest(const FString& Parameters)
+{
+	const MBS::FGridCellKey Key(-3, 7, -1);
+	TestTrue("Key is unpacked", Key.GetIndexXYZ() == FIntVector(-3, 7, -1));
+	TestTrue("Lowest index", MBS::FGridCellKey(FIntVector(MBS::FGridCellKey::MinIndex)).GetIndexXYZ()
+		== FIntVector(MBS::FGridCellKey::MinIndex));
+	TestTrue("Highest index", MBS::FGridCellKey(FIntVector(MBS::FGridCellKey::MaxIndex)).GetIndexXYZ()
+		== FIntVector(MBS::FGridCellKey::MaxIndex));
+
+	// Keys are ordered by Z, then by Y, then by X
+	TestTrue("Z is compared first", MBS::FGridCellKey(5, 5, 0) < MBS::FGridCellKey(0, 0, 1));
+	TestTrue("Y is compared before X", MBS::FGridCellKey(5, 0, 0) < MBS::FGridCellKey(0, 1, 0));
+	TestTrue("Negative indices are lower", MBS::FGridCellKey(-1, 0, 0) < MBS::FGridCellKey(0, 0, 0));
+
+	// Key of a location is the same as the index of the cell constructed at it
+	const FTransform RelativeTo(FVector(100.f, -300.f, 50.f));
+	const FVector Multiplier(1.f, 2.f, 1.f);
+	for (const FVector& Location : { FVector(0.f), FVector(1250.f, -2000.f, 450.f), FVector(-820.f, 3900.f, 1200.f) })
+	{
+		const MBS::FGridCell3D Cell(Location, RelativeTo, Multiplier, true);
+		TestTrue("Key at " + Location.ToString(), MBS::FGridCell3D::GetKeyAt(Location, RelativeTo, Multiplier) == Cell.GetKey());
+	}
+	return true;
+}
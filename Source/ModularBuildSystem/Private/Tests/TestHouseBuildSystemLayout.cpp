@@ -0,0 +1,147 @@
+#include "House/HouseBuildSystemLayout.h"
+#include "MBSFunctionLibrary.h"
+#include "MBSRandomIndexCalculation.h"
+#include "MBSTestHouseGenerator.h"
+#include "House/HouseBuildSystemActor.h"
+#include "House/GenProperty/HouseEntranceGeneratorProperty.h"
+#include "House/GenProperty/HouseWallGeneratorProperty.h"
+#include "House/GenProperty/HouseWindowGeneratorProperty.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	void SetGeneratorProperty(UHouseBuildSystemGenerator* Generator, const FName& Name, UMBSGeneratorProperty* Value)
+	{
+		FObjectProperty* Property = FindFProperty<FObjectProperty>(UHouseBuildSystemGenerator::StaticClass(), Name);
+		check(Property);
+		Property->SetObjectPropertyValue_InContainer(Generator, Value);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHouseBuildSystemLayoutCompute, "ModularBuildSystem.HouseBuildSystemLayout.Compute",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FHouseBuildSystemLayoutCompute::RunTest(const FString& Parameters)
+{
+	FHouseBuildSystemLayoutInput Input;
+	Input.Tier = EMBSGenerationTier::Full;
+	Input.Seed = 42;
+	Input.WallInitializer.SetTotalCount(20);
+	Input.WallInitializer.SetMaxInRow(6);
+	Input.FloorInitializer.SetTotalCount(16);
+	Input.FloorInitializer.SetMaxInRow(4);
+	Input.RoofInitializer = Input.WallInitializer;
+	Input.WallLevelCount = 2;
+	Input.FloorLevelCount = 3;
+	Input.bEntrances = true;
+	Input.bWindows = true;
+	Input.WindowCount = 4;
+	Input.WindowCountPerLevel = 2;
+	Input.bChimney = true;
+	Input.bVegetation = true;
+	Input.VegetationCount = 2;
+	Input.bFloorHoles = true;
+
+	// Layout without index calculations doesn't need the game thread
+	TestTrue("Input without index calculations is thread safe", Input.IsThreadSafe());
+
+	const FHouseBuildSystemLayout Layout = FHouseBuildSystemLayout::Compute(Input);
+	TestTrue("Layout is computed", Layout.bComputed);
+	TestEqual("Entrance is in the middle of the front row", Layout.EntranceIndex, 6);
+	TestEqual("Window count", Layout.WindowIndices.Num(), Input.WindowCount);
+	TestFalse("Windows don't overlap the entrance", Layout.WindowIndices.Contains(Layout.EntranceIndex));
+	TestTrue("Chimney is on the roof", Layout.ChimneyIndex >= 0 && Layout.ChimneyIndex < 20);
+	TestEqual("Vegetation of each wall level", Layout.VegetationIndices.Num(), Input.WallLevelCount);
+	TestEqual("Floor hole of each floor except the first one", Layout.FloorHoleIndices.Num(), Input.FloorLevelCount - 1);
+
+	// Layout depends on the seed only, so it can be computed ahead of the generation
+	const FHouseBuildSystemLayout SameSeedLayout = FHouseBuildSystemLayout::Compute(Input);
+	TestEqual("Same chimney with the same seed", SameSeedLayout.ChimneyIndex, Layout.ChimneyIndex);
+	TestTrue("Same windows with the same seed", SameSeedLayout.WindowIndices == Layout.WindowIndices);
+	TestTrue("Same vegetation with the same seed", SameSeedLayout.VegetationIndices == Layout.VegetationIndices);
+
+	// Seed doesn't make the layout outdated
+	FHouseBuildSystemLayoutInput OtherSeedInput = Input;
+	OtherSeedInput.Seed = 7;
+	TestEqual("Seed is not hashed", OtherSeedInput.GetLayoutHash(), Layout.InputHash);
+
+	FHouseBuildSystemLayoutInput OtherBoundsInput = Input;
+	OtherBoundsInput.WallInitializer.SetTotalCount(24);
+	TestNotEqual("Bounds are hashed", OtherBoundsInput.GetLayoutHash(), Layout.InputHash);
+
+	// Shell tier has no details
+	FHouseBuildSystemLayoutInput ShellInput = Input;
+	ShellInput.Tier = EMBSGenerationTier::Shell;
+	const FHouseBuildSystemLayout ShellLayout = FHouseBuildSystemLayout::Compute(ShellInput);
+	TestEqual("Shell has no entrance", ShellLayout.EntranceIndex, static_cast<int32>(INDEX_NONE));
+	TestEqual("Shell has no windows", ShellLayout.WindowIndices.Num(), 0);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHouseBuildSystemLayoutPrecomputed, "ModularBuildSystem.HouseBuildSystemLayout.Precomputed",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FHouseBuildSystemLayoutPrecomputed::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+
+	UMBSTestHouseGenerator* Generator = NewObject<UMBSTestHouseGenerator>(BuildSystem);
+	BuildSystem->Generator = Generator;
+	Generator->SetBuildSystemPtr(BuildSystem);
+	Generator->Bounds = FIntPoint(4, 3);
+	Generator->LevelCount = 2;
+
+	// Windows use the native index calculation, so the layout is computed on the thread pool
+	UHouseEntranceGeneratorProperty* Entrances = NewObject<UHouseEntranceGeneratorProperty>(Generator);
+	Entrances->bEnabled = true;
+	UHouseWindowGeneratorProperty* Windows = NewObject<UHouseWindowGeneratorProperty>(Generator);
+	Windows->bEnabled = true;
+	Windows->WindowCount = 4;
+	Windows->WindowCountPerLevel = 2;
+	Windows->Data.IndexCalculation = NewObject<UMBSRandomIndexCalculation>(Windows);
+	SetGeneratorProperty(Generator, TEXT("Walls_New"), NewObject<UHouseWallGeneratorProperty>(Generator));
+	SetGeneratorProperty(Generator, TEXT("Entrances_New"), Entrances);
+	SetGeneratorProperty(Generator, TEXT("Windows_New"), Windows);
+
+	const FHouseBuildSystemLayoutInput Input = Generator->MakeLayoutInput();
+	TestTrue("Input with native index calculations is thread safe", Input.IsThreadSafe());
+
+	FHouseBuildSystemLayout Layout = Generator->ComputeLayoutAsync().Get();
+	TestTrue("Async layout is computed", Layout.bComputed);
+	TestEqual("Async layout is computed from the same input", Layout.InputHash, Input.GetLayoutHash());
+	TestEqual("Window count", Layout.WindowIndices.Num(), Windows->WindowCount);
+
+	// Levels of the build system are prepared after the layout is started, which must not make it outdated
+	BuildSystem->Walls.SetNum(Generator->LevelCount);
+	for (FModularLevel& Wall : BuildSystem->Walls)
+	{
+		Wall.SetTotalCount(1).SetMaxInRow(1);
+	}
+	TestEqual("Prepared levels don't change the input", Generator->MakeLayoutInput().GetLayoutHash(), Layout.InputHash);
+
+	// Marked layout tells if the generation has taken the precomputed one
+	constexpr int32 PrecomputedChimneyIndex = 1234;
+	Layout.ChimneyIndex = PrecomputedChimneyIndex;
+	Generator->SetPrecomputedLayout(Layout);
+	TestEqual("Precomputed layout is used by the generation", Generator->TakeGenerationLayout().ChimneyIndex,
+		PrecomputedChimneyIndex);
+	TestNotEqual("Precomputed layout is used once", Generator->TakeGenerationLayout().ChimneyIndex,
+		PrecomputedChimneyIndex);
+
+	Generator->SetPrecomputedLayout(Layout);
+	Generator->Bounds = FIntPoint(5, 3);
+	TestNotEqual("Outdated precomputed layout is not used", Generator->TakeGenerationLayout().ChimneyIndex,
+		PrecomputedChimneyIndex);
+
+	// Time-sliced generation computes the layout while its levels are initialized
+	TestTrue("Time-sliced generation has started", BuildSystem->GenerateTimeSliced());
+	TestTrue("Layout is computed ahead of the details", Generator->IsComputingLayout());
+	BuildSystem->CancelTimeSlicedGeneration();
+
+	BuildSystem->Destroy();
+	return true;
+}
@@ -0,0 +1,140 @@
+#include "MBSFunctionLibrary.h"
+#include "MBSInstancingSubsystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Config/MBSSettings.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	// Far from the origin, so chunks of other build systems in the test world are not affected
+	const FVector TestOrigin(-1.0e6, -1.0e6, 0.0);
+
+	TArray<FTransform> MakeRow(int32 Count, const FVector& Start)
+	{
+		TArray<FTransform> OutTransforms;
+		for (int32 i = 0; i < Count; i++)
+		{
+			OutTransforms.Add(FTransform(Start + FVector(i * 100.0, 0.0, 0.0)));
+		}
+		return OutTransforms;
+	}
+
+	FVector GetComponentInstanceLocation(const FMBSSharedInstancesChunk& Chunk, int32 Index)
+	{
+		FTransform OutTransform;
+		Chunk.Component->GetInstanceTransform(Index, OutTransform, true);
+		return OutTransform.GetLocation();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSharedInstancesHandleRanges, "ModularBuildSystem.InstancingSubsystem.HandleRanges",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FSharedInstancesHandleRanges::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+	UMBSInstancingSubsystem* Subsystem = World->GetSubsystem<UMBSInstancingSubsystem>();
+	UTEST_NOT_NULL("Subsystem is valid", Subsystem);
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh is valid", Cube);
+
+	const int32 InstanceCountBefore = Subsystem->GetInstanceCount();
+	const int32 ChunkCountBefore = Subsystem->GetChunkCount();
+
+	FMBSSharedInstancesHandle First = Subsystem->CreateHandle();
+	FMBSSharedInstancesHandle Second = Subsystem->CreateHandle();
+	Subsystem->SetInstances(First, Cube, nullptr, MakeRow(3, TestOrigin));
+	Subsystem->SetInstances(Second, Cube, nullptr, MakeRow(2, TestOrigin + FVector(0.0, 100.0, 0.0)));
+	Subsystem->Flush();
+
+	TestEqual("Instance count", Subsystem->GetInstanceCount(), InstanceCountBefore + 5);
+	TestEqual("Chunk count", Subsystem->GetChunkCount(), ChunkCountBefore + 1);
+	const FMBSSharedInstancesChunk* Chunk = Subsystem->FindChunk(Cube, nullptr, TestOrigin);
+	UTEST_NOT_NULL("Chunk is valid", Chunk);
+	UTEST_TRUE("Chunk component is valid", Chunk->Component.IsValid());
+	TestEqual("Component instance count", Chunk->Component->GetInstanceCount(), 5);
+	TestEqual("Range count", Chunk->ComponentRanges.Num(), 2);
+	TestTrue("Chunk is not dirty", Chunk->DirtyHandles.IsEmpty());
+
+	// Same number of instances is updated in place, so the ranges stay in the same order
+	const TArray<TPair<int32, int32>> RangesBefore = Chunk->ComponentRanges;
+	const int32 FirstStart = RangesBefore[0].Key == First.Id ? 0 : RangesBefore[0].Value;
+	const int32 SecondStart = RangesBefore[0].Key == Second.Id ? 0 : RangesBefore[0].Value;
+	const FVector Moved = TestOrigin + FVector(0.0, 500.0, 0.0);
+	Subsystem->SetInstances(First, Cube, nullptr, MakeRow(3, Moved));
+	Subsystem->Flush();
+
+	TestEqual("Component instance count after move", Chunk->Component->GetInstanceCount(), 5);
+	TestTrue("Ranges are kept after move", Chunk->ComponentRanges == RangesBefore);
+	TestTrue("First instances were moved", GetComponentInstanceLocation(*Chunk, FirstStart).Equals(Moved));
+	TestTrue("Second instances were kept",
+		GetComponentInstanceLocation(*Chunk, SecondStart).Equals(TestOrigin + FVector(0.0, 100.0, 0.0)));
+
+	// Resized range is added again, while the other one is kept
+	Subsystem->SetInstances(First, Cube, nullptr, MakeRow(1, Moved));
+	Subsystem->Flush();
+
+	TestEqual("Component instance count after resize", Chunk->Component->GetInstanceCount(), 3);
+	TestEqual("Range count after resize", Chunk->ComponentRanges.Num(), 2);
+	for (const TPair<int32, int32>& Range : Chunk->ComponentRanges)
+	{
+		TestEqual("Range instance count after resize", Range.Value, Range.Key == First.Id ? 1 : 2);
+	}
+	TestEqual("Instance count after resize", Subsystem->GetInstanceCount(), InstanceCountBefore + 3);
+
+	Subsystem->RemoveInstances(Second);
+	Subsystem->Flush();
+
+	TestTrue("Second handle is still valid", Second.IsValid());
+	TestEqual("Component instance count after remove", Chunk->Component->GetInstanceCount(), 1);
+	TestTrue("First instance was kept", GetComponentInstanceLocation(*Chunk, 0).Equals(Moved));
+
+	Subsystem->ReleaseHandle(First);
+	Subsystem->ReleaseHandle(Second);
+	Subsystem->Flush();
+
+	TestFalse("First handle is invalidated", First.IsValid());
+	TestNull("Empty chunk is removed", Subsystem->FindChunk(Cube, nullptr, TestOrigin));
+	TestEqual("Instance count after release", Subsystem->GetInstanceCount(), InstanceCountBefore);
+	TestEqual("Chunk count after release", Subsystem->GetChunkCount(), ChunkCountBefore);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSharedInstancesCells, "ModularBuildSystem.InstancingSubsystem.Cells",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FSharedInstancesCells::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+	UMBSInstancingSubsystem* Subsystem = World->GetSubsystem<UMBSInstancingSubsystem>();
+	UTEST_NOT_NULL("Subsystem is valid", Subsystem);
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh is valid", Cube);
+
+	const int32 ChunkCountBefore = Subsystem->GetChunkCount();
+	const double ChunkSize = FMath::Max(GetDefault<UMBSSettings>()->SharedInstancingChunkSize, 100.f);
+	const FVector FarLocation = TestOrigin + FVector(ChunkSize * 2.0, 0.0, 0.0);
+
+	FMBSSharedInstancesHandle Handle = Subsystem->CreateHandle();
+	TArray<FTransform> Transforms = MakeRow(2, TestOrigin);
+	Transforms.Append(MakeRow(3, FarLocation));
+	Subsystem->SetInstances(Handle, Cube, nullptr, Transforms);
+	Subsystem->Flush();
+
+	TestEqual("Chunk count", Subsystem->GetChunkCount(), ChunkCountBefore + 2);
+	const FMBSSharedInstancesChunk* NearChunk = Subsystem->FindChunk(Cube, nullptr, TestOrigin);
+	const FMBSSharedInstancesChunk* FarChunk = Subsystem->FindChunk(Cube, nullptr, FarLocation);
+	UTEST_NOT_NULL("Near chunk is valid", NearChunk);
+	UTEST_NOT_NULL("Far chunk is valid", FarChunk);
+	TestTrue("Chunks are different", NearChunk != FarChunk);
+	TestEqual("Near chunk instance count", NearChunk->Component->GetInstanceCount(), 2);
+	TestEqual("Far chunk instance count", FarChunk->Component->GetInstanceCount(), 3);
+
+	Subsystem->ReleaseHandle(Handle);
+	Subsystem->Flush();
+	TestEqual("Chunk count after release", Subsystem->GetChunkCount(), ChunkCountBefore);
+
+	return true;
+}
@@ -0,0 +1,113 @@
+#include "List/MBSListLookup.h"
+#include "List/ModularBuildSystemMeshList.h"
+#include "ModularSectionResolution.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FListLookupElements, "ModularBuildSystem.ListLookup.Elements",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FListLookupElements::RunTest(const FString& Parameters)
+{
+	UModularSectionResolution* Wall = NewObject<UModularSectionResolution>();
+	UModularSectionResolution* Floor = NewObject<UModularSectionResolution>();
+	UModularSectionResolution* Missing = NewObject<UModularSectionResolution>();
+
+	TMap<UModularSectionResolution*, TArray<int32>> Elements;
+	Elements.Add(Wall, { 1, 2, 3 });
+	Elements.Add(Floor, { 10 });
+
+	const TMBSListLookup<int32> Lookup(Elements, [](const TArray<int32>& Value) -> const TArray<int32>&
+	{
+		return Value;
+	},
+	[](const TArray<int32>& Value)
+	{
+		return TConstArrayView<float>();
+	});
+	TestEqual("Resolution count", Lookup.GetResolutionCount(), 2);
+
+	const int32 WallId = Lookup.FindResolutionId(Wall);
+	const int32 FloorId = Lookup.FindResolutionId(Floor);
+	TestEqual("Missing resolution", Lookup.FindResolutionId(Missing), static_cast<int32>(INDEX_NONE));
+	TestEqual("Element count", Lookup.Num(WallId), 3);
+	TestTrue("Elements of a resolution", TArray<int32>(Lookup.GetElements(WallId)) == Elements[Wall]);
+	TestEqual("Element of other resolution", *Lookup.Find(FloorId, 0), 10);
+	TestNull("Index outside of a resolution", Lookup.Find(FloorId, 1));
+	TestNull("Element of a missing resolution", Lookup.Find(INDEX_NONE, 0));
+
+	const int32* Random = Lookup.FindRandom(WallId);
+	TestTrue("Random element is of the resolution", Random && Elements[Wall].Contains(*Random));
+	TestNull("No random element of a missing resolution", Lookup.FindRandom(INDEX_NONE));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FListLookupAliasTable, "ModularBuildSystem.ListLookup.AliasTable",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FListLookupAliasTable::RunTest(const FString& Parameters)
+{
+	const TArray<float> Weights = { 1.f, 0.f, 3.f };
+	TArray<float> Probabilities;
+	TArray<int32> Aliases;
+	Probabilities.SetNumZeroed(Weights.Num());
+	Aliases.SetNumZeroed(Weights.Num());
+	FMBSAliasTable::Build(Weights, Probabilities, Aliases);
+
+	// Each index is picked with each fraction, so picks are counted exactly
+	constexpr int32 FractionCount = 100;
+	TArray<int32> Picks;
+	Picks.SetNumZeroed(Weights.Num());
+	for (int32 Index = 0; Index < Weights.Num(); Index++)
+	{
+		for (int32 i = 0; i < FractionCount; i++)
+		{
+			Picks[FMBSAliasTable::Pick(Probabilities, Aliases, Index, static_cast<float>(i) / FractionCount)]++;
+		}
+	}
+	TestEqual("Picks of the first weight", Picks[0], 75);
+	TestEqual("Zero weight is never picked", Picks[1], 0);
+	TestEqual("Picks of the largest weight", Picks[2], 225);
+
+	// Without any weight all elements have the same probability
+	const TArray<float> ZeroWeights = { 0.f, 0.f };
+	Probabilities.SetNumZeroed(ZeroWeights.Num());
+	Aliases.SetNumZeroed(ZeroWeights.Num());
+	FMBSAliasTable::Build(ZeroWeights, Probabilities, Aliases);
+	TestEqual("Uniform probability", Probabilities[0], 1.f);
+	TestEqual("Uniform pick", FMBSAliasTable::Pick(Probabilities, Aliases, 1, 0.99f), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FListLookupInvalidation, "ModularBuildSystem.ListLookup.Invalidation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FListLookupInvalidation::RunTest(const FString& Parameters)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull("Cube mesh", Cube))
+	{
+		return false;
+	}
+
+	UModularSectionResolution* Wall = NewObject<UModularSectionResolution>();
+	UModularBuildSystemMeshList* List = NewObject<UModularBuildSystemMeshList>();
+
+	FMBSResolutionIdCache ResolutionId;
+	const uint32 EmptyRevision = List->GetLookup().GetRevision();
+	TestEqual("Resolution of an empty list", ResolutionId.Get(List->GetLookup(), Wall),
+		static_cast<int32>(INDEX_NONE));
+	TestEqual("Lookup is kept until the elements change", List->GetLookup().GetRevision(), EmptyRevision);
+
+	TMap<UModularSectionResolution*, FModularBuildSystemMeshListElement> Elements;
+	Elements.Add(Wall).StaticMeshes.Add(Cube);
+	List->SetElements(Elements);
+
+	const UModularBuildSystemMeshList::FLookup& Lookup = List->GetLookup();
+	TestNotEqual("Lookup is rebuilt after the elements are set", Lookup.GetRevision(), EmptyRevision);
+	const int32 WallId = ResolutionId.Get(Lookup, Wall);
+	TestEqual("Cached id is found again in the rebuilt lookup", WallId, 0);
+	TestTrue("Mesh of the cached id", Lookup.Find(WallId, 0) && *Lookup.Find(WallId, 0) == Cube);
+	TestEqual("Length of the resolution", List->GetLength(Wall), 1);
+
+	return true;
+}
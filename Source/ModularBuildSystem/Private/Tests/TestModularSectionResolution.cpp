@@ -3,7 +3,14 @@
 #include "ModularSectionResolution.h"
 #include "ModularBuildStats.h"
 #include "House/HouseWallTransformSolver.h"
+#include "House/HouseBuildSystemActor.h"
+#include "MBSFunctionLibrary.h"
+#include "MBSSections.h"
+#include "ModularLevel.h"
+#include "ModularSection.h"
 #include "Misc/AutomationTest.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
 #include "Solver/CornerTransformSolver.h"
 #include "Solver/RooftopTransformSolver.h"
 
@@ -224,3 +231,185 @@ bool FGetNextRooftopTransform::RunTest(const FString& Parameters)
 }
 
 
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGetNextTransforms, "ModularBuildSystem.SectionResolution.GetNextTransforms",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FGetNextTransforms::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxInRow = 4;
+	constexpr int32 TotalCount = 12;
+	const FModularBuildStats BuildStats(FIntPoint(2, 4), TotalCount, MaxInRow, 2);
+	const UModularSectionResolution* Resolution = MBS::UTestSectionResolution::GetNew4x4x4(EModularSectionResolutionSnapMode::Wall);
+	UHouseWallTransformSolver* Solver = NewObject<UHouseWallTransformSolver>();
+	TestTrue("Native solver has batch", Solver->HasNativeBatch());
+
+	// Whole level in a single call must be the same as calculating each index separately
+	TArray<FTransform> Batch;
+	Resolution->GetNextTransforms(FTransform(), TotalCount, MaxInRow, TotalCount, 1.f, BuildStats, Solver, nullptr, Batch);
+	TestEqual("Transform for each index", Batch.Num(), TotalCount);
+	for (int32 i = 0; i < FMath::Min(Batch.Num(), TotalCount); i++)
+	{
+		const FTransform Single = Resolution->GetNextTransform(FTransform(), i, MaxInRow, TotalCount, 1.f, BuildStats,
+			Solver, nullptr);
+		TestTrue(FString::Printf(TEXT("Index %d"), i), Batch[i].Equals(Single));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNextTransformContextArgs, "ModularBuildSystem.SectionResolution.NextTransformContext",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FNextTransformContextArgs::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxInRow = 4;
+	constexpr int32 TotalCount = 12;
+	const FModularBuildStats BuildStats(FIntPoint(2, 4), TotalCount, MaxInRow, 2);
+	const UModularSectionResolution* Resolution = MBS::UTestSectionResolution::GetNew4x4x4(EModularSectionResolutionSnapMode::Wall);
+	const FNextTransformContext Context(FTransform(), MaxInRow, TotalCount, 1.f, BuildStats, nullptr, Resolution, nullptr);
+
+	// Stats are referenced by the args, not copied
+	FNextTransformArgs Args(Context, 3);
+	TestTrue("Args stats are not copied", Args.InBuildStats.Bounds == FIntPoint::ZeroValue);
+	TestTrue("Args stats are taken from the context", Args.GetBuildStats().Bounds == BuildStats.Bounds);
+	Args.FillBuildStats();
+	TestTrue("Filled args stats", Args.InBuildStats.Bounds == BuildStats.Bounds);
+
+	// Reused args must give the same transforms as the args made for each index
+	TArray<FTransform> Transforms;
+	Resolution->GetNextTransforms(Context, TotalCount, Transforms);
+	TestEqual("Transform for each index", Transforms.Num(), TotalCount);
+	for (int32 i = 0; i < FMath::Min(Transforms.Num(), TotalCount); i++)
+	{
+		const FTransform Single = Resolution->GetNextTransform(FTransform(), i, MaxInRow, TotalCount, 1.f, BuildStats,
+			nullptr, nullptr);
+		TestTrue(FString::Printf(TEXT("Index %d"), i), Transforms[i].Equals(Single));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLargeLevel, "ModularBuildSystem.SectionResolution.LargeLevel",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FLargeLevel::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxInRow = 64;
+	constexpr int32 TotalCount = 4096;
+
+	// Initializer counts are not clamped
+	FModularSectionInitializer Initializer;
+	Initializer.SetTotalCount(TotalCount);
+	Initializer.SetMaxInRow(MaxInRow);
+	TestEqual("Total count", Initializer.GetTotalCount(), TotalCount);
+	TestEqual("Max in row", Initializer.GetMaxInRow(), MaxInRow);
+
+	const FModularBuildStats BuildStats(FIntPoint(MaxInRow, TotalCount / MaxInRow), TotalCount, TotalCount / MaxInRow, MaxInRow);
+	const UModularSectionResolution* Resolution = MBS::UTestSectionResolution::GetNew4x4x4(EModularSectionResolutionSnapMode::Default);
+	const FNextTransformContext Context(FTransform(), MaxInRow, TotalCount, 0.f, BuildStats, nullptr, Resolution, nullptr);
+
+	TArray<FTransform> Transforms;
+	Resolution->GetNextTransforms(Context, TotalCount, Transforms);
+	TestEqual("Transform for each index", Transforms.Num(), TotalCount);
+	for (int32 i = 0; i < Transforms.Num(); i += 97)
+	{
+		TestTrue(FString::Printf(TEXT("Index %d"), i), Transforms[i].Equals(Resolution->GetNextTransform(Context, i)));
+	}
+	TestTrue("Last index", Transforms.Last().Equals(Resolution->GetNextTransform(Context, TotalCount - 1)));
+
+	// All instances of the level are added and updated in single batches
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+	AActor* Actor = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UInstancedStaticMeshComponent* Component = Cast<UInstancedStaticMeshComponent>(
+		Actor->AddComponentByClass(UInstancedStaticMeshComponent::StaticClass(), false, FTransform::Identity, false));
+
+	FMBSSections Sections;
+	Sections.AddNewInstances(Transforms, true, Component);
+	TestEqual("Instance count", Component->GetInstanceCount(), TotalCount);
+
+	TArray<int32> Indices;
+	TArray<FTransform> MovedTransforms;
+	for (int32 i = 0; i < TotalCount; i++)
+	{
+		Indices.Add(i);
+		MovedTransforms.Add(Transforms[i] * FTransform(FVector(0.f, 0.f, 100.f)));
+	}
+
+	FModularSectionInstanced Instanced(FModularLevel::InvalidLevelId, Component);
+	Instanced.SetTransforms(Indices, MovedTransforms);
+	TestTrue("Last instance is moved", Instanced.GetTransform(TotalCount - 1).Equals(MovedTransforms.Last()));
+
+	Instanced.Reset();
+	Actor->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLargeLevelOfBuildSystem, "ModularBuildSystem.SectionResolution.LargeLevelOfBuildSystem",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FLargeLevelOfBuildSystem::RunTest(const FString& Parameters)
+{
+	constexpr int32 LevelId = 0;
+	constexpr int32 MaxInRow = 64;
+	constexpr int32 TotalCount = 4096;
+
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh is valid", Cube);
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+	const FStructProperty* SectionsProperty = FindFProperty<FStructProperty>(AModularBuildSystemActor::StaticClass(), TEXT("Sections"));
+	UTEST_NOT_NULL("Sections property is valid", SectionsProperty);
+	FMBSSections& Sections = *SectionsProperty->ContainerPtrToValuePtr<FMBSSections>(BuildSystem);
+
+	UInstancedStaticMeshComponent* Component = Cast<UInstancedStaticMeshComponent>(
+		BuildSystem->AddComponentByClass(UInstancedStaticMeshComponent::StaticClass(), false, FTransform::Identity, false));
+	UTEST_NOT_NULL("Component is valid", Component);
+	Component->SetStaticMesh(Cube);
+
+	// Level is found by its id when it is updated
+	FModularLevel& Level = BuildSystem->Walls.AddDefaulted_GetRef();
+	Level.OverrideLevelId(LevelId);
+	Level.InstancedStaticMeshComponent = Component;
+
+	FModularSectionInitializer Initializer;
+	Initializer.SetResolution(MBS::UTestSectionResolution::GetNew4x4x4(EModularSectionResolutionSnapMode::Default));
+	Initializer.SetTotalCount(TotalCount);
+	Initializer.SetMaxInRow(MaxInRow);
+	UMBSTransformSolver* Solver = NewObject<UDefaultTransformSolver>();
+
+	const FInitModularSectionsArgs InitArgs(Initializer, LevelId, 0.f, nullptr, nullptr, Component,
+		EModularSectionPivotLocation::Default, Solver);
+	Sections.Append(BuildSystem->InitInstancedModularSections(InitArgs));
+	UTEST_EQUAL("Instance count", Component->GetInstanceCount(), TotalCount);
+	TestEqual("Level is a single instanced section", Sections.GetInstancedSectionsOfLevel(LevelId).Num(), 1);
+	TestEqual("No section is skipped", Initializer.GetSkippedCount(), 0);
+
+	TArray<FTransform> InitTransforms;
+	InitTransforms.SetNum(TotalCount);
+	for (int32 i = 0; i < TotalCount; i++)
+	{
+		Component->GetInstanceTransform(i, InitTransforms[i]);
+	}
+
+	// Level is moved one level up, all of its instances are updated in place
+	const FInitModularSectionsArgs UpdateArgs(Initializer, LevelId, 1.f, nullptr, nullptr, Component,
+		EModularSectionPivotLocation::Default, Solver);
+	BuildSystem->UpdateInstancedModularSections(UpdateArgs);
+	TestEqual("Instance count after update", Component->GetInstanceCount(), TotalCount);
+	TestEqual("Level is still a single instanced section", Sections.GetInstancedSectionsOfLevel(LevelId).Num(), 1);
+
+	const FVector Offset(0.f, 0.f, UModularSectionResolution::DefaultSectionSize);
+	for (int32 i = 0; i < TotalCount; i += 97)
+	{
+		FTransform UpdatedTransform;
+		Component->GetInstanceTransform(i, UpdatedTransform);
+		TestTrue(FString::Printf(TEXT("Index %d is moved"), i),
+			UpdatedTransform.GetLocation().Equals(InitTransforms[i].GetLocation() + Offset));
+	}
+	FTransform LastTransform;
+	Component->GetInstanceTransform(TotalCount - 1, LastTransform);
+	TestTrue("Last index is moved", LastTransform.GetLocation().Equals(InitTransforms.Last().GetLocation() + Offset));
+
+	Sections.Reset(true, true, true);
+	BuildSystem->Destroy();
+	return true;
+}
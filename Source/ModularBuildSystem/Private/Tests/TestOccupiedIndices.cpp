@@ -0,0 +1,82 @@
+#include "MBSIndexCalculation.h"
+#include "MBSRandomIndexCalculation.h"
+#include "House/HouseBuildSystemLayout.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOccupiedIndicesFreeSlot, "ModularBuildSystem.OccupiedIndices.FreeSlot",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FOccupiedIndicesFreeSlot::RunTest(const FString& Parameters)
+{
+	constexpr int32 Count = 128;
+
+	// Everything except the single free index
+	constexpr int32 LastFreeIndex = 37;
+	TArray<int32> Indices;
+	for (int32 i = 0; i < Count; i++)
+	{
+		if (i != LastFreeIndex)
+		{
+			Indices.Add(i);
+		}
+	}
+
+	FMBSOccupiedIndices Occupied(Count, Indices);
+	TestEqual("Free count", Occupied.GetFreeCount(), 1);
+	TestEqual("Next free index is found after the start", Occupied.FindNextFree(10), LastFreeIndex);
+	TestEqual("Next free index is found by wrapping around", Occupied.FindNextFree(100), LastFreeIndex);
+	TestEqual("Random free index is the only free one", Occupied.PickRandomFree(FRandomStream(3)), LastFreeIndex);
+
+	Occupied.Occupy(LastFreeIndex);
+	TestEqual("No free index", Occupied.FindNextFree(0), static_cast<int32>(INDEX_NONE));
+	TestEqual("No random free index", Occupied.PickRandomFree(FRandomStream(3)), static_cast<int32>(INDEX_NONE));
+
+	Occupied.Free(5);
+	Occupied.Occupy(Count + 10);
+	TestTrue("Freed index is free", !Occupied.IsOccupied(5));
+	TestEqual("Indices outside of the level are ignored", Occupied.GetFreeCount(), 1);
+	TestEqual("Freed index is found", Occupied.FindNextFree(6), 5);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOccupiedIndicesOfPass, "ModularBuildSystem.OccupiedIndices.Pass",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FOccupiedIndicesOfPass::RunTest(const FString& Parameters)
+{
+	constexpr int32 Count = 8;
+	FModularSectionInitializer Initializer;
+	Initializer.SetTotalCount(Count);
+	Initializer.SetMaxInRow(4);
+
+	// Native calculation uses the bitset kept by the caller instead of the array
+	FMBSOccupiedIndices Occupied(Count);
+	for (int32 i = 0; i < Count - 1; i++)
+	{
+		Occupied.Occupy(i);
+	}
+	TArray<int32> OccupiedIndices;
+	const FRandomStream Stream(7);
+	UMBSRandomIndexCalculation* Calculation = NewObject<UMBSRandomIndexCalculation>();
+	TestEqual("Free index of the kept bitset", Calculation->CalculateSingle(
+		FMBSIndexCalculationArgs(nullptr, 0, &OccupiedIndices, &Initializer, &Stream, &Occupied)), Count - 1);
+
+	// Each level keeps its own occupied indices for the whole pass
+	FHouseBuildSystemLayoutInput Input;
+	Input.Tier = EMBSGenerationTier::Full;
+	Input.Seed = 3;
+	Input.WallInitializer = Initializer;
+	Input.WallLevelCount = 3;
+	Input.bVegetation = true;
+	Input.VegetationCount = Count;
+	Input.VegetationIndexCalculation = Calculation;
+
+	const FHouseBuildSystemLayout Layout = FHouseBuildSystemLayout::Compute(Input);
+	UTEST_EQUAL("Vegetation of each wall level", Layout.VegetationIndices.Num(), Input.WallLevelCount);
+	for (const TArray<int32>& LevelIndices : Layout.VegetationIndices)
+	{
+		TSet<int32> UniqueIndices(LevelIndices);
+		TestEqual("All indices of the level are used once", UniqueIndices.Num(), Count);
+	}
+
+	return true;
+}
@@ -0,0 +1,202 @@
+#include "MBSFunctionLibrary.h"
+#include "MBSPresetLayout.h"
+#include "MBSTestPreset.h"
+#include "ModularSectionResolution.h"
+#include "House/HouseBuildSystemActor.h"
+#include "House/HouseBuildSystemGenerator.h"
+#include "List/ModularBuildSystemMeshList.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	constexpr int32 TestRoofId = 3;
+
+	AHouseBuildSystemActor* SpawnHouseWithRoof(UWorld* World)
+	{
+		AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+		if (BuildSystem && BuildSystem->Roof.GetId() == FModularLevel::InvalidLevelId)
+		{
+			BuildSystem->Roof.OverrideLevelId(TestRoofId);
+		}
+		return BuildSystem;
+	}
+
+	bool HasSections(const AHouseBuildSystemActor& BuildSystem)
+	{
+		FMBSPresetLayout Captured;
+		BuildSystem.CapturePresetLayout(Captured);
+		return !Captured.IsEmpty();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPresetLayoutEntries, "ModularBuildSystem.PresetLayout.Entries",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FPresetLayoutEntries::RunTest(const FString& Parameters)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UStaticMesh* Plane = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+	if (!TestNotNull("Cube mesh", Cube) || !TestNotNull("Plane mesh", Plane))
+	{
+		return false;
+	}
+
+	FMBSPresetLayout Layout;
+	TestTrue("New layout is empty", Layout.IsEmpty());
+	TestTrue("Empty layout is valid", Layout.IsValid());
+
+	Layout.AddStatic(Cube, 0, FTransform::Identity);
+	Layout.AddStatic(Plane, 1, FTransform(FVector(400.f, 0.f, 0.f)));
+	Layout.AddStatic(Cube, 1, FTransform(FVector(800.f, 0.f, 0.f)));
+	Layout.AddActor(AStaticMeshActor::StaticClass(), 2, FTransform::Identity);
+
+	TestFalse("Layout with entries is not empty", Layout.IsEmpty());
+	TestEqual("Meshes are deduplicated", Layout.Meshes.Num(), 2);
+	TestTrue("Mesh ids", Layout.StaticMeshIds == TArray<int32>({ 0, 1, 0 }));
+	TestEqual("Actor class count", Layout.ActorClasses.Num(), 1);
+	TestTrue("Layout is valid", Layout.IsValid());
+
+	Layout.Meshes[1] = nullptr;
+	TestFalse("Layout with a missing mesh is not valid", Layout.IsValid());
+
+	Layout.Reset();
+	TestTrue("Reset layout is empty", Layout.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPresetLayoutApply, "ModularBuildSystem.PresetLayout.Apply",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FPresetLayoutApply::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh", Cube);
+
+	AHouseBuildSystemActor* BuildSystem = SpawnHouseWithRoof(World);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+	const int32 RoofId = BuildSystem->Roof.GetId();
+
+	FMBSPresetLayout Layout;
+	Layout.AddStatic(Cube, RoofId, FTransform::Identity);
+	Layout.AddStatic(Cube, RoofId + 1000, FTransform(FVector(400.f, 0.f, 0.f)));
+	TestFalse("Layout with a missing level is not applied", BuildSystem->ApplyPresetLayout(Layout));
+	TestFalse("Nothing is spawned from a rejected layout", HasSections(*BuildSystem));
+
+	Layout.Reset();
+	Layout.AddStatic(Cube, RoofId, FTransform::Identity);
+	Layout.BuildStats.MaxTotalCount = 1;
+	TestTrue("Layout is applied", BuildSystem->ApplyPresetLayout(Layout));
+	TestTrue("Sections are spawned from the layout", HasSections(*BuildSystem));
+	TestEqual("Build stats are restored", BuildSystem->GetBuildStats().MaxTotalCount, 1);
+
+	BuildSystem->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPresetCopyProperties, "ModularBuildSystem.PresetLayout.CopyProperties",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FPresetCopyProperties::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	AHouseBuildSystemActor* Source = SpawnHouseWithRoof(World);
+	AHouseBuildSystemActor* Target = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Source build system is valid", Source);
+	UTEST_NOT_NULL("Target build system is valid", Target);
+	Source->Generator = NewObject<UHouseBuildSystemGenerator>(Source);
+
+	UMBSTestPreset* Preset = NewObject<UMBSTestPreset>();
+	Preset->SaveProperties(Source);
+	TestEqual("Level is copied to the preset", Preset->Roof.GetId(), Source->Roof.GetId());
+	TestTrue("Instanced generator is duplicated into the preset",
+		Preset->Generator && Preset->Generator != Source->Generator && Preset->Generator->GetOuter() == Preset);
+	TestEqual("Property of another type is not copied", Preset->Walls, 0);
+
+	Preset->LoadProperties(Target);
+	TestEqual("Level is copied to the build system", Target->Roof.GetId(), Source->Roof.GetId());
+	TestTrue("Instanced generator is duplicated into the build system",
+		Target->Generator && Target->Generator != Preset->Generator && Target->Generator->GetOuter() == Target);
+
+	Source->Destroy();
+	Target->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPresetConfigurationCrc, "ModularBuildSystem.PresetLayout.ConfigurationCrc",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FPresetConfigurationCrc::RunTest(const FString& Parameters)
+{
+	UMBSTestPreset* Preset = NewObject<UMBSTestPreset>();
+	const uint32 InitialCrc = Preset->GetConfigurationCrc();
+	TestEqual("Checksum is stable", Preset->GetConfigurationCrc(), InitialCrc);
+
+	Preset->SetSaveLayout(false);
+	TestEqual("Layout properties are not a part of the configuration", Preset->GetConfigurationCrc(), InitialCrc);
+
+	Preset->Walls = 1;
+	const uint32 ChangedCrc = Preset->GetConfigurationCrc();
+	TestNotEqual("Changed configuration has another checksum", ChangedCrc, InitialCrc);
+
+	UModularSectionResolution* Resolution = NewObject<UModularSectionResolution>();
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh", Cube);
+
+	Preset->MeshList = NewObject<UModularBuildSystemMeshList>();
+	const uint32 ListCrc = Preset->GetConfigurationCrc();
+	TestNotEqual("Referenced list is a part of the configuration", ListCrc, ChangedCrc);
+
+	TMap<UModularSectionResolution*, FModularBuildSystemMeshListElement> Elements;
+	Elements.Add(Resolution).StaticMeshes.Add(Cube);
+	Preset->MeshList->SetElements(Elements);
+	TestNotEqual("Elements of the referenced list are a part of the configuration", Preset->GetConfigurationCrc(),
+		ListCrc);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPresetOutdatedLayout, "ModularBuildSystem.PresetLayout.OutdatedLayout",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FPresetOutdatedLayout::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh", Cube);
+
+	AHouseBuildSystemActor* Source = SpawnHouseWithRoof(World);
+	UTEST_NOT_NULL("Source build system is valid", Source);
+
+	FMBSPresetLayout SourceLayout;
+	SourceLayout.AddStatic(Cube, Source->Roof.GetId(), FTransform::Identity);
+	UTEST_TRUE("Source sections are spawned", Source->ApplyPresetLayout(SourceLayout));
+
+	UMBSTestPreset* Preset = NewObject<UMBSTestPreset>();
+	Preset->Save(Source);
+	TestFalse("Layout is saved", Preset->GetLayout().IsEmpty());
+	TestTrue("Saved layout is valid", Preset->HasValidLayout());
+
+	Preset->Walls = 1;
+	TestFalse("Layout is outdated after the configuration is changed", Preset->HasValidLayout());
+
+	AHouseBuildSystemActor* Target = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Target build system is valid", Target);
+	TestFalse("Outdated layout is not applied", Preset->Apply(Target));
+	TestFalse("Nothing is spawned from an outdated layout", HasSections(*Target));
+	TestEqual("Configuration is still loaded", Target->Roof.GetId(), Source->Roof.GetId());
+
+	Preset->Walls = 0;
+	TestTrue("Layout is valid again with the saved configuration", Preset->HasValidLayout());
+
+	Preset->SetSavedLayoutVersion(UModularBuildSystemPreset::LayoutVersion - 1);
+	TestFalse("Layout of an older version is outdated", Preset->HasValidLayout());
+
+	Source->Destroy();
+	Target->Destroy();
+	return true;
+}
@@ -0,0 +1,44 @@
+#include "MBSRegenerationScheduler.h"
+#include "MBSFunctionLibrary.h"
+#include "ModularBuildSystemActor.h"
+#include "House/HouseBuildSystemActor.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCoalesceRegenerationRequests, "ModularBuildSystem.RegenerationScheduler.Coalesce",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FCoalesceRegenerationRequests::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	UMBSRegenerationScheduler* Scheduler = UMBSRegenerationScheduler::Get(World);
+	UTEST_NOT_NULL("Scheduler is valid", Scheduler);
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+
+	const int32 PendingCountBefore = Scheduler->GetPendingCount();
+
+	// Many interactive edits are merged into a single request
+	Scheduler->Schedule(BuildSystem, EMBSRegenerationType::Preview);
+	Scheduler->Schedule(BuildSystem, EMBSRegenerationType::Preview);
+	TestEqual("Pending count after previews", Scheduler->GetPendingCount(), PendingCountBefore + 1);
+	TestTrue("Pending type after previews", Scheduler->GetPendingType(BuildSystem) == EMBSRegenerationType::Preview);
+
+	// Finalized edit upgrades pending preview, and is never downgraded back
+	Scheduler->Schedule(BuildSystem, EMBSRegenerationType::Full);
+	Scheduler->Schedule(BuildSystem, EMBSRegenerationType::Preview);
+	TestEqual("Pending count after full", Scheduler->GetPendingCount(), PendingCountBefore + 1);
+	TestTrue("Pending type after full", Scheduler->GetPendingType(BuildSystem) == EMBSRegenerationType::Full);
+
+	Scheduler->Cancel(BuildSystem);
+	TestTrue("Pending type after cancel", Scheduler->GetPendingType(BuildSystem) == EMBSRegenerationType::None);
+
+	// Pending request is consumed by flush
+	Scheduler->Schedule(BuildSystem, EMBSRegenerationType::Preview);
+	Scheduler->Flush();
+	TestTrue("Pending type after flush", Scheduler->GetPendingType(BuildSystem) == EMBSRegenerationType::None);
+
+	BuildSystem->Destroy();
+	return true;
+}
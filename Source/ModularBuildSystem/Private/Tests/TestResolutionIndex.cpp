@@ -0,0 +1,42 @@
+#include "MBSResolutionIndex.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResolutionIndexNearest, "ModularBuildSystem.ResolutionIndex.Nearest",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FResolutionIndexNearest::RunTest(const FString& Parameters)
+{
+	FIntVector Value;
+	TestTrue("Value tag is parsed", FMBSResolutionIndex::ParseValueTag(TEXT("(X=400,Y=20,Z=300)"), Value));
+	TestTrue("Parsed value", Value == FIntVector(400, 20, 300));
+	TestFalse("Invalid value tag", FMBSResolutionIndex::ParseValueTag(TEXT("(X=400)"), Value));
+
+	EModularSectionResolutionSnapMode SnapMode;
+	TestTrue("Snap mode tag is parsed", FMBSResolutionIndex::ParseSnapModeTag(TEXT("Wall"), SnapMode));
+	TestTrue("Parsed snap mode", SnapMode == EModularSectionResolutionSnapMode::Wall);
+
+	FMBSResolutionIndex Index;
+	Index.Add({ FSoftObjectPath(TEXT("/Game/MBS/Resolutions/Wall_B.Wall_B")), FIntVector(400, 20, 300), EModularSectionResolutionSnapMode::Wall });
+	Index.Add({ FSoftObjectPath(TEXT("/Game/MBS/Resolutions/Floor.Floor")), FIntVector(400, 400, 20), EModularSectionResolutionSnapMode::Default });
+	Index.Add({ FSoftObjectPath(TEXT("/Game/MBS/Resolutions/Small.Small")), FIntVector(100, 100, 100), EModularSectionResolutionSnapMode::Default });
+	Index.Add({ FSoftObjectPath(TEXT("/Game/MBS/Resolutions/Wall_A.Wall_A")), FIntVector(400, 20, 300), EModularSectionResolutionSnapMode::Roof });
+	TestEqual("Entry count", Index.Num(), 4);
+
+	const auto FindName = [&Index](const FVector& Size, float MaxDistance,
+		TOptional<EModularSectionResolutionSnapMode> InSnapMode = {}) -> FString
+	{
+		const int32 Found = Index.FindNearest(Size, MaxDistance, InSnapMode);
+		return Found == INDEX_NONE ? FString() : Index[Found].Path.GetAssetName();
+	};
+
+	// Nearest resolution is found even when another one has a closer X value
+	TestEqual("Nearest resolution", FindName(FVector(390.f, 390.f, 30.f), 0.f), TEXT("Floor"));
+	TestEqual("Nearest small resolution", FindName(FVector(130.f, 90.f, 100.f), 0.f), TEXT("Small"));
+	TestEqual("Too far resolution is not recognized", FindName(FVector(130.f, 90.f, 100.f), 1.f), FString());
+
+	// Resolutions of the same value are ordered by their path
+	TestEqual("Tie is resolved by path", FindName(FVector(400.f, 20.f, 300.f), 1.f), TEXT("Wall_A"));
+	TestEqual("Snap mode filter", FindName(FVector(400.f, 20.f, 300.f), 1.f,
+		EModularSectionResolutionSnapMode::Wall), TEXT("Wall_B"));
+
+	return true;
+}
@@ -0,0 +1,41 @@
+#include "Interior/MBSRoomOccupancy.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRoomOccupancyPlacement, "ModularBuildSystem.RoomOccupancy.Placement",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FRoomOccupancyPlacement::RunTest(const FString& Parameters)
+{
+	MBS::FRoomOccupancyGrid Grid(FBox(FVector(0.f), FVector(1000.f, 1000.f, 300.f)), 100.f);
+	TestTrue("Grid is valid", Grid.IsValid());
+	TestEqual("Cell count", Grid.GetCellCount(), FIntPoint(10, 10));
+	TestEqual("Footprint is rounded up", Grid.GetFootprint(FVector(150.f, 200.f, 80.f)), FIntPoint(2, 2));
+	TestEqual("Footprint has at least one cell", Grid.GetFootprint(FVector::ZeroVector), FIntPoint(1, 1));
+
+	Grid.Occupy(FBox(FVector(10.f, 10.f, 0.f), FVector(190.f, 90.f, 100.f)));
+	TestTrue("Overlapped cell is occupied", Grid.IsOccupied(FIntPoint(1, 0)));
+	TestFalse("Cell outside of the box is free", Grid.IsOccupied(FIntPoint(0, 1)));
+
+	// Everything except the last two rows
+	Grid.Occupy(FIntPoint(0, 0), FIntPoint(10, 8));
+	TestEqual("Fill ratio", Grid.GetFillRatio(), 0.8f);
+
+	const FIntPoint Footprint(3, 2);
+	FIntPoint FirstCell;
+	TestTrue("Footprint fits into the free rows", Grid.FindRandomPlacement(Footprint, FRandomStream(5), FirstCell));
+	bool bAllFree = true;
+	for (int32 Y = 0; Y < Footprint.Y; Y++)
+	{
+		for (int32 X = 0; X < Footprint.X; X++)
+		{
+			bAllFree &= !Grid.IsOccupied(FirstCell + FIntPoint(X, Y));
+		}
+	}
+	TestTrue("Picked placement is free", bAllFree);
+	TestFalse("Footprint taller than the free rows", Grid.FindRandomPlacement(FIntPoint(1, 3), FRandomStream(5), FirstCell));
+
+	Grid.Occupy(FIntPoint(0, 8), FIntPoint(10, 2));
+	TestEqual("No free cells", Grid.GetFreeCount(), 0);
+	TestFalse("Nothing fits into the full grid", Grid.FindRandomPlacement(FIntPoint(1, 1), FRandomStream(5), FirstCell));
+
+	return true;
+}
@@ -13,13 +13,13 @@ bool FSetMesh::RunTest(const FString& Parameters)
 	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
 	UTEST_NOT_NULL("World is valid", World);
 
-	// Spawn new build system
-	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
-
 	// Load mesh asset
 	const TSoftObjectPtr<UStaticMesh> MeshObject(FSoftObjectPath(TEXT("StaticMesh'/ModularBuildSystem/Modules/Basement/4x4x4/modular_basement_4x4x4_0_.modular_basement_4x4x4_0_'")));
 	UStaticMesh* ActualMesh = MeshObject.LoadSynchronous();
 	UTEST_NOT_NULL("ActualMeshClass is valid (Path=/ModularBuildSystem/Modules/Basement/4x4x4/modular_basement_4x4x4_0_.modular_basement_4x4x4_0_)", ActualMesh);
+
+	// Spawn new build system
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
 	
 	MBS::FSectionBuilder Builder(BuildSystem, &BuildSystem->Basement);
 	TestNull("0: Mesh is not set", Builder.GetMesh());
@@ -38,6 +38,7 @@ bool FSetMesh::RunTest(const FString& Parameters)
 
 	Builder.Mesh(nullptr, nullptr);
 	TestNull("5: Mesh is not set", Builder.GetMesh());
-	
+
+	BuildSystem->Destroy();
 	return true;
 }
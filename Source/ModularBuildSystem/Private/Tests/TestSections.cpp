@@ -1,10 +1,44 @@
 ﻿
 #include "MBSFunctionLibrary.h"
+#include "MBSSections.h"
+#include "MBSSectionsLayout.h"
 #include "ModularLevel.h"
 #include "ModularSection.h"
+#include "House/HouseBuildSystemActor.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshActor.h"
 #include "Misc/AutomationTest.h"
+#include "Serialization/ObjectReader.h"
+#include "Serialization/ObjectWriter.h"
+
+namespace
+{
+	template<typename T>
+	T* GetStructPropertyOf(AModularBuildSystemActor* BuildSystem, FName PropertyName)
+	{
+		const FStructProperty* Property = FindFProperty<FStructProperty>(AModularBuildSystemActor::StaticClass(), PropertyName);
+		return Property ? Property->ContainerPtrToValuePtr<T>(BuildSystem) : nullptr;
+	}
+
+	void UseSharedInstancedComponents(AModularBuildSystemActor* BuildSystem)
+	{
+		FMBSMeshConfiguration* MeshConfiguration = GetStructPropertyOf<FMBSMeshConfiguration>(BuildSystem, TEXT("MeshConfiguration"));
+		MeshConfiguration->Type = EMBSMeshConfigurationType::InstancedStaticMeshes;
+		MeshConfiguration->bUseSingleComponentPerUniqueMesh = true;
+	}
+
+	FModularSectionInstanced AddInstanceRange(FMBSSections& Sections, int32 LevelId, UInstancedStaticMeshComponent* Component,
+		const TArray<FTransform>& Transforms)
+	{
+		FModularSectionInstanced Range = FModularSectionInstanced(LevelId, Component);
+		Range.SetInstanceRange(Component->GetInstanceCount(), 0);
+		Component->AddInstances(Transforms, false);
+		Sections.UpdateInstanceCount(Range);
+		Sections.Add(Range);
+		return Range;
+	}
+}
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSetLocation, "ModularBuildSystem.Sections.SetLocation",
 	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority)
@@ -42,6 +76,357 @@ bool FSetLocation::RunTest(const FString& Parameters)
 	Static.Reset();
 	Actor.Reset();
 	Instanced.Reset();
+	Actor_InstancedTest->Destroy();
+	
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInstanceRange, "ModularBuildSystem.Sections.InstanceRange",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority)
+bool FInstanceRange::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	constexpr int32 LevelId = FModularLevel::InvalidLevelId;
+
+	AActor* Actor_InstancedTest = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UInstancedStaticMeshComponent* Component = Cast<UInstancedStaticMeshComponent>(
+		Actor_InstancedTest->AddComponentByClass(UInstancedStaticMeshComponent::StaticClass(), false, FTransform::Identity, false));
+	UTEST_NOT_NULL("Component is valid", Component);
+	
+	// Two sections sharing the same component, second one owns the last two instances
+	for (int32 i = 0; i < 5; i++)
+	{
+		Component->AddInstance(FTransform(FVector(i, 0.f, 0.f)), false);
+	}
+	
+	FModularSectionInstanced First = FModularSectionInstanced(LevelId, Component);
+	FModularSectionInstanced Second = FModularSectionInstanced(LevelId, Component);
+	TestFalse("Default section is not a range", First.IsInstanceRange());
+	TestEqual("Default section owns all instances", First.GetInstanceCount(), 5);
+	
+	First.SetInstanceRange(0, 3);
+	Second.SetInstanceRange(3, 2);
+	TestTrue("Range check", Second.IsInstanceRange());
+	TestEqual("First range count", First.GetInstanceCount(), 3);
+	TestEqual("Second range count", Second.GetInstanceCount(), 2);
+	TestEqual("Second range index mapping", Second.ToComponentIndex(1), 4);
+	TestEqual("Second range location", Second.GetLocation(0), FVector(3.f, 0.f, 0.f));
+
+	Second.SetLocation(FVector::OneVector, true, 1);
+	FTransform MovedInstanceTransform;
+	Component->GetInstanceTransform(4, MovedInstanceTransform, true);
+	TestEqual("Component instance moved", MovedInstanceTransform.GetLocation(), FVector::OneVector);
+
+	// Resetting a range must not clear instances of other sections in the shared component
+	Second.Reset();
+	TestEqual("Shared component instances are kept", Component->GetInstanceCount(), 5);
+	TestNull("Reset range forgets the shared component", Second.GetISMC());
+	TestEqual("Reset range start", Second.GetFirstInstanceIndex(), 0);
+
+	Component->ClearInstances();
+	Actor_InstancedTest->Destroy();
+	
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdjacentInstanceRanges, "ModularBuildSystem.Sections.AdjacentInstanceRanges",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority)
+bool FAdjacentInstanceRanges::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	AActor* Actor_InstancedTest = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UInstancedStaticMeshComponent* Component = Cast<UInstancedStaticMeshComponent>(
+		Actor_InstancedTest->AddComponentByClass(UInstancedStaticMeshComponent::StaticClass(), false, FTransform::Identity, false));
+	UTEST_NOT_NULL("Component is valid", Component);
+
+	FMBSSections Sections;
+
+	// Two levels appending their instances to the same component one after another
+	FModularSectionInstanced First = FModularSectionInstanced(0, Component);
+	First.SetInstanceRange(0, 0);
+	Component->AddInstances({ FTransform::Identity, FTransform::Identity }, false);
+	Sections.UpdateInstanceCount(First);
+	Sections.Add(First);
+
+	FModularSectionInstanced Second = FModularSectionInstanced(1, Component);
+	Second.SetInstanceRange(Component->GetInstanceCount(), 0);
+	Component->AddInstances({ FTransform::Identity, FTransform::Identity, FTransform::Identity }, false);
+	Sections.UpdateInstanceCount(Second);
+	Sections.Add(Second);
+
+	TestEqual("First range count", First.GetInstanceCount(), 2);
+	TestEqual("Second range count", Second.GetInstanceCount(), 3);
+
+	// Updating the first range again must not take instances of the second one
+	FModularSectionInstanced UpdatedFirst = Sections.GetInstanced()[0];
+	Sections.UpdateInstanceCount(UpdatedFirst);
+	TestEqual("First range is capped by the second one", UpdatedFirst.GetInstanceCount(), 2);
+
+	Component->ClearInstances();
+	Actor_InstancedTest->Destroy();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRangeOperations, "ModularBuildSystem.Sections.RangeOperations",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority)
+bool FRangeOperations::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	constexpr int32 LevelId = FModularLevel::InvalidLevelId;
+
+	// Rotated actor makes the local space of the component differ from the world space
+	AActor* Actor_InstancedTest = World->SpawnActor<AStaticMeshActor>(FVector(100.f, 0.f, 0.f), FRotator(0.f, 90.f, 0.f));
+	UInstancedStaticMeshComponent* Component = Cast<UInstancedStaticMeshComponent>(
+		Actor_InstancedTest->AddComponentByClass(UInstancedStaticMeshComponent::StaticClass(), false, FTransform::Identity, false));
+	UTEST_NOT_NULL("Component is valid", Component);
+
+	for (int32 i = 0; i < 4; i++)
+	{
+		Component->AddInstance(FTransform(FVector(i * 10.f, 0.f, 0.f)), false);
+	}
+	FModularSectionInstanced Instanced = FModularSectionInstanced(LevelId, Component);
+
+	// Relative transforms are in the local space of the component
+	const TArray<int32> Contiguous = { 1, 2 };
+	const TArray<FTransform> LocalTransforms = { FTransform(FVector(0.f, 10.f, 0.f)), FTransform(FVector(0.f, 20.f, 0.f)) };
+	Instanced.SetTransforms(Contiguous, LocalTransforms, true);
+	TestTrue("Contiguous relative transforms", Instanced.GetTransform(1).Equals(LocalTransforms[0])
+		&& Instanced.GetTransform(2).Equals(LocalTransforms[1]));
+
+	const TArray<int32> Scattered = { 0, 3 };
+	const TArray<FTransform> WorldTransforms = { FTransform(FVector(0.f, 0.f, 50.f)), FTransform(FVector(0.f, 0.f, 60.f)) };
+	Instanced.SetTransforms(Scattered, WorldTransforms, false);
+	FTransform WorldTransform;
+	Component->GetInstanceTransform(3, WorldTransform, true);
+	TestTrue("Scattered world transforms", WorldTransform.Equals(WorldTransforms[1]));
+
+	Instanced.SetTransform(WorldTransforms[0], false, 1);
+	Component->GetInstanceTransform(1, WorldTransform, true);
+	TestTrue("Single index version has the same space", WorldTransform.Equals(WorldTransforms[0]));
+
+	// Offsets
+	const FVector LocalLocation = Instanced.GetLocation(2);
+	Instanced.OffsetRange(Contiguous, FVector(5.f, 0.f, 0.f), true);
+	TestEqual("Relative offset is in the local space", Instanced.GetLocation(2), LocalLocation + FVector(5.f, 0.f, 0.f));
+
+	Component->GetInstanceTransform(2, WorldTransform, true);
+	const FVector WorldLocation = WorldTransform.GetLocation();
+	Instanced.OffsetRange(Contiguous, FVector(5.f, 0.f, 0.f), false);
+	Component->GetInstanceTransform(2, WorldTransform, true);
+	TestTrue("World offset is in the world space", WorldTransform.GetLocation().Equals(WorldLocation + FVector(5.f, 0.f, 0.f)));
+
+	Instanced.Offset(FVector(0.f, 0.f, 1.f), true, 3);
+	TestEqual("Single index offset", Instanced.GetLocation(3).Z, WorldTransforms[1].GetLocation().Z + 1.f);
+
+	// Scale
+	Instanced.ScaleRange(Scattered, FVector(2.f), true);
+	TestEqual("First scaled instance", Instanced.GetTransform(0).GetScale3D(), FVector(2.f));
+	TestEqual("Last scaled instance", Instanced.GetTransform(3).GetScale3D(), FVector(2.f));
+	TestEqual("Other instances are not scaled", Instanced.GetTransform(1).GetScale3D(), FVector::OneVector);
+
+	// Batches of static sections
+	FModularSection First = FModularSection(LevelId, World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator));
+	FModularSection Second = FModularSection(LevelId, World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator));
+	const TArray<FModularSection*> Statics = { &First, &Second };
+	const TArray<FTransform> StaticTransforms = { FTransform(FVector(10.f, 0.f, 0.f)), FTransform(FVector(20.f, 0.f, 0.f)) };
+	FModularSection::BatchSetTransforms(Statics, StaticTransforms, false);
+	TestTrue("First static section is moved", First.GetTransform().Equals(StaticTransforms[0]));
+	TestTrue("Second static section is moved", Second.GetTransform().Equals(StaticTransforms[1]));
+
+	FModularSection::BatchOffset(Statics, FVector(0.f, 0.f, 10.f), false);
+	TestEqual("Static sections are offset", Second.GetLocation(), FVector(20.f, 0.f, 10.f));
+
+	First.Reset();
+	Second.Reset();
+	Instanced.Reset();
+	Actor_InstancedTest->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSectionsLayout, "ModularBuildSystem.Sections.Layout",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority)
+bool FSectionsLayout::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	TArray<FModularSection> Static;
+	for (int32 i = 0; i < 4; i++)
+	{
+		Static.Add(FModularSection(i % 2, World->SpawnActor<AStaticMeshActor>(FVector(i, 0.f, 0.f), FRotator::ZeroRotator)));
+	}
+
+	TArray<FModularSectionActor> Actor;
+	Actor.Add(FModularSectionActor(1, World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator)));
+
+	FMBSSectionsLayout Layout;
+	TestTrue("Layout is dirty by default", Layout.IsDirty());
+	Layout.Update(Static, Actor);
+	TestFalse("Layout is not dirty after update", Layout.IsDirty());
+	TestEqual("Layout entry count", Layout.Num(), 5);
+	TestEqual("Layout static count", Layout.GetStaticNum(), 4);
+	TestTrue("Actor section entry", Layout.IsActorAt(4));
+	TestTrue("Actor of entry", Layout.GetHandleAt(2) == Static[2].GetStaticMeshActor());
+
+	TArray<int32> StaticIndices;
+	Layout.GetIndicesOfLevel(1, StaticIndices, true);
+	TestEqual("Static indices of level", StaticIndices, TArray<int32>{1, 3});
+
+	TArray<int32> AllIndices;
+	Layout.GetIndicesOfLevel(1, AllIndices, false);
+	TestEqual("All indices of level", AllIndices, TArray<int32>{1, 3, 4});
+
+	// Layout only depends on which sections exist, so it is rebuilt after sections were removed
+	Static[0].Reset();
+	Static.RemoveAt(0);
+	Layout.MarkDirty();
+	TestTrue("Layout is dirty after removal", Layout.IsDirty());
+	Layout.Update(Static, Actor);
+	TestEqual("Layout entry count after removal", Layout.Num(), 4);
+	TestEqual("Level id after removal", Layout.GetLevelIdAt(0), 1);
+
+	for (FModularSection& Section : Static)
+	{
+		Section.Reset();
+	}
+	for (FModularSectionActor& Section : Actor)
+	{
+		Section.Reset();
+	}
 	
 	return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSharedComponentsReload, "ModularBuildSystem.Sections.SharedComponentsReload",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FSharedComponentsReload::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UTEST_NOT_NULL("Cube mesh", Cube);
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+	UseSharedInstancedComponents(BuildSystem);
+
+	FMBSSections* Sections = GetStructPropertyOf<FMBSSections>(BuildSystem, TEXT("Sections"));
+	UTEST_NOT_NULL("Sections are valid", Sections);
+
+	UInstancedStaticMeshComponent* Component = Sections->GetOrCreateSharedComponent(Cube);
+	UTEST_NOT_NULL("Shared component is valid", Component);
+	AddInstanceRange(*Sections, 0, Component, { FTransform::Identity, FTransform(FVector(100.f, 0.f, 0.f)) });
+
+	// Save and reload the build system, so its sections are recreated from the serialized ones on PostLoad
+	TArray<uint8> Bytes;
+	FObjectWriter Writer(BuildSystem, Bytes);
+	*Sections = FMBSSections();
+	FObjectReader Reader(BuildSystem, Bytes);
+	BuildSystem->PostLoad();
+	UseSharedInstancedComponents(BuildSystem);
+
+	TestEqual("Instance range is reloaded", Sections->GetInstancedSectionsOfLevel(0).Num(), 1);
+	TestTrue("Shared component is reused after reload", Sections->GetOrCreateSharedComponent(Cube) == Component);
+
+	// Regenerate the level into the same shared component
+	Sections->ResetInstancedSectionOfLevel(0);
+	AddInstanceRange(*Sections, 0, Sections->GetOrCreateSharedComponent(Cube), { FTransform::Identity });
+
+	TArray<UInstancedStaticMeshComponent*> Components;
+	BuildSystem->GetComponents(Components);
+	TestEqual("No duplicate shared components", Components.FilterByPredicate([](const UInstancedStaticMeshComponent* InComponent)
+	{
+		return InComponent->GetName().StartsWith(TEXT("Shared_"));
+	}).Num(), 1);
+	TestEqual("Regenerated instance count", Component->GetInstanceCount(), 1);
+
+	BuildSystem->Destroy();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLevelInstanceRanges, "ModularBuildSystem.Sections.LevelInstanceRanges",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FLevelInstanceRanges::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UStaticMesh* Plane = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+	if (!TestNotNull("Cube mesh", Cube) || !TestNotNull("Plane mesh", Plane))
+	{
+		return false;
+	}
+
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+	UseSharedInstancedComponents(BuildSystem);
+
+	FMBSSections* Sections = GetStructPropertyOf<FMBSSections>(BuildSystem, TEXT("Sections"));
+	UTEST_NOT_NULL("Sections are valid", Sections);
+
+	UInstancedStaticMeshComponent* CubeComponent = Sections->GetOrCreateSharedComponent(Cube);
+	UTEST_NOT_NULL("Shared component is valid", CubeComponent);
+
+	TArray<FTransform> LevelTransforms;
+	for (int32 i = 0; i < 4; i++)
+	{
+		LevelTransforms.Add(FTransform(FVector(i * 100.f, 0.f, 0.f)));
+	}
+	AddInstanceRange(*Sections, 0, CubeComponent, LevelTransforms);
+	AddInstanceRange(*Sections, 1, CubeComponent, { FTransform(FVector(0.f, 100.f, 0.f)) });
+
+	// Instances 0 and 2 of the level are moved into a new range, 1 and 3 are left in the first one
+	Sections->MoveInstancesOfLevel(0, Plane, 2);
+	UInstancedStaticMeshComponent* PlaneComponent = Sections->GetOrCreateSharedComponent(Plane);
+	TestEqual("Level owns two ranges", Sections->GetInstancedSectionsOfLevel(0).Num(), 2);
+
+	int32 Index = 2;
+	const FModularSectionInstanced* Found = Sections->FindInstancedSectionOfLevel(0, Index);
+	UTEST_NOT_NULL("Instance is found through all ranges", Found);
+	TestTrue("Instance is in the second range", Found->GetISMC() == PlaneComponent);
+	TestEqual("Index within the second range", Index, 0);
+
+	Index = 4;
+	TestNull("Index past the level is not found", Sections->FindInstancedSectionOfLevel(0, Index));
+
+	FModularLevel Level;
+	Level.OverrideLevelId(0);
+
+	FTransform InstanceTransform;
+	Sections->SetVisibility(Level, false);
+	for (const FModularSectionInstanced* Range : Sections->GetInstancedSectionsOfLevel(0))
+	{
+		TestTrue("Range is hidden", Range->IsHidden());
+		Range->GetISMC()->GetInstanceTransform(Range->ToComponentIndex(0), InstanceTransform);
+		TestTrue("Hidden instance is collapsed", InstanceTransform.GetScale3D().IsZero());
+	}
+	const FModularSectionInstanced* OtherLevelRange = Sections->GetInstancedSectionOfLevel(1);
+	UTEST_NOT_NULL("Other level range is valid", OtherLevelRange);
+	CubeComponent->GetInstanceTransform(OtherLevelRange->ToComponentIndex(0), InstanceTransform);
+	TestEqual("Other level stays visible", InstanceTransform.GetScale3D(), FVector::OneVector);
+
+	// Removing instances of a hidden level must keep the transforms of its remaining instances
+	Sections->RemoveInstancedSectionInstancesAfterIndex(1, 0);
+	Sections->SetVisibility(Level, true);
+	Index = 0;
+	Found = Sections->FindInstancedSectionOfLevel(0, Index);
+	UTEST_NOT_NULL("First instance is kept", Found);
+	Found->GetISMC()->GetInstanceTransform(Found->ToComponentIndex(Index), InstanceTransform);
+	TestEqual("Instance is restored", InstanceTransform.GetLocation(), FVector(100.f, 0.f, 0.f));
+	TestEqual("Instance scale is restored", InstanceTransform.GetScale3D(), FVector::OneVector);
+	TestEqual("Other level instance is kept", CubeComponent->GetInstanceCount(), 2);
+
+	BuildSystem->Destroy();
+
+	return true;
+}
@@ -0,0 +1,77 @@
+#include "MBSFunctionLibrary.h"
+#include "MBSSectionsBVH.h"
+#include "ModularBuildSystemActor.h"
+#include "Engine/StaticMeshActor.h"
+#include "House/HouseBuildSystemActor.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSectionsBVHRaycast, "ModularBuildSystem.SectionsBVH.Raycast",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FSectionsBVHRaycast::RunTest(const FString& Parameters)
+{
+	UWorld* World = UMBSFunctionLibrary::GetTestWorld();
+	UTEST_NOT_NULL("World is valid", World);
+
+	// Spawn new build system
+	AHouseBuildSystemActor* BuildSystem = World->SpawnActor<AHouseBuildSystemActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UTEST_NOT_NULL("Build system is valid", BuildSystem);
+
+	// Load mesh asset
+	const TSoftObjectPtr<UStaticMesh> MeshObject(FSoftObjectPath(TEXT("StaticMesh'/ModularBuildSystem/Modules/Basement/4x4x4/modular_basement_4x4x4_0_.modular_basement_4x4x4_0_'")));
+	UStaticMesh* ActualMesh = MeshObject.LoadSynchronous();
+	UTEST_NOT_NULL("ActualMesh is valid", ActualMesh);
+
+	constexpr int32 SectionCount = 16;
+	constexpr int32 LevelId = 0;
+	for (int32 i = 0; i < SectionCount; i++)
+	{
+		BuildSystem->InitModularSection(ActualMesh, FTransform(FVector(i * 1000.f, 0.f, 0.f)), LevelId, true, true);
+	}
+
+	FMBSSectionsBVH BVH;
+	TestTrue("BVH is outdated before build", BVH.IsOutdated(BuildSystem));
+	BVH.Build(BuildSystem);
+	TestFalse("BVH is up to date after build", BVH.IsOutdated(BuildSystem));
+	TestEqual("All sections are in BVH", BVH.GetPrimitiveCount(), SectionCount);
+
+	// Cast a ray down to the center of the section in the middle
+	constexpr int32 TargetIndex = SectionCount / 2;
+	AStaticMeshActor* TargetActor = BuildSystem->GetSections().GetStatic()[TargetIndex].GetStaticMeshActor();
+	UTEST_NOT_NULL("Target actor is valid", TargetActor);
+	const FVector TargetCenter = TargetActor->GetComponentsBoundingBox(true).GetCenter();
+
+	FMBSSectionHit Hit;
+	TestTrue("Ray hits a section", BVH.Raycast(TargetCenter + FVector(0.f, 0.f, 10000.f), FVector::DownVector, 100000.0, Hit));
+	TestEqual("Hit section index", Hit.SectionIndex, TargetIndex);
+	TestEqual("Hit level id", Hit.LevelId, LevelId);
+	TestTrue("Hit section type", Hit.Type == EMBSSectionHitType::Static);
+	TestEqual("Hit actor", Hit.Actor.Get(), static_cast<AActor*>(TargetActor));
+
+	FMBSSectionHit Miss;
+	TestFalse("Ray misses all sections", BVH.Raycast(TargetCenter + FVector(0.f, 100000.f, 0.f), FVector::UpVector, 100000.0, Miss));
+
+	double BoundsDistance;
+	TestTrue("Ray hits bounds of the build system",
+		BVH.RaycastBounds(TargetCenter + FVector(0.f, 0.f, 10000.f), FVector::DownVector, 100000.0, BoundsDistance));
+	TestTrue("Bounds are not farther than the hit section", BoundsDistance <= Hit.Distance);
+	TestFalse("Ray misses bounds of the build system",
+		BVH.RaycastBounds(TargetCenter + FVector(0.f, 100000.f, 0.f), FVector::UpVector, 100000.0, BoundsDistance));
+
+	// Build system marked as changed without any change of its sections keeps the hierarchy
+	BuildSystem->MarkChanged();
+	TestFalse("BVH is kept if only the revision has changed", BVH.Update(BuildSystem));
+	TestFalse("BVH is up to date after the revision was refreshed", BVH.IsOutdated(BuildSystem));
+
+	// Adding a section changes layout revision, so BVH must be rebuilt
+	BuildSystem->InitModularSection(ActualMesh, FTransform(FVector(SectionCount * 1000.f, 0.f, 0.f)), LevelId, true, true);
+	TestTrue("BVH is outdated after adding a section", BVH.IsOutdated(BuildSystem));
+	TestTrue("BVH is rebuilt on update", BVH.Update(BuildSystem));
+	TestEqual("New section is in BVH", BVH.GetPrimitiveCount(), SectionCount + 1);
+
+	// Moved build system is detected without a revision change
+	BuildSystem->SetActorLocation(FVector(0.f, 0.f, 100.f));
+	TestTrue("BVH is outdated after moving the build system", BVH.IsOutdated(BuildSystem));
+
+	BuildSystem->Destroy();
+	return true;
+}
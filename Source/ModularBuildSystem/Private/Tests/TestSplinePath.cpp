@@ -0,0 +1,49 @@
+#include "MBSSplinePath.h"
+#include "Components/SplineComponent.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplinePathPlacement, "ModularBuildSystem.SplinePath.Placement",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FSplinePathPlacement::RunTest(const FString& Parameters)
+{
+	constexpr float SectionLength = 100.f;
+
+	// Two straight segments of 1000 units with a corner between them
+	USplineComponent* Spline = NewObject<USplineComponent>();
+	Spline->SetSplinePoints({ FVector(0.f, 0.f, 0.f), FVector(1000.f, 0.f, 0.f), FVector(1000.f, 1000.f, 0.f) },
+		ESplineCoordinateSpace::Local);
+	for (int32 i = 0; i < Spline->GetNumberOfSplinePoints(); i++)
+	{
+		Spline->SetSplinePointType(i, ESplinePointType::Linear);
+	}
+
+	FMBSSplinePath Path;
+	Path.Build(*Spline, SectionLength);
+	TestTrue("Path is valid", Path.IsValid());
+	TestEqual("Section count of both segments", Path.GetSectionCount(), 20);
+	TestEqual("Section of the second segment", Path.GetSegmentAt(1550.f), 1);
+
+	// Table is interpolated between samples
+	const FVector MiddleOfFirstSegment = Path.GetTable().GetTransformAtDistance(500.f).GetLocation();
+	TestTrue("Location at distance", MiddleOfFirstSegment.Equals(FVector(500.f, 0.f, 0.f), 1.f));
+
+	// Straight location is moved onto the spline and offset to the side of it
+	const FTransform Warped = Path.Warp(FTransform(FVector(1500.f, 0.f, 50.f)));
+	TestTrue("Warped location", Warped.GetLocation().Equals(FVector(1000.f, 500.f, 50.f), 1.f));
+	TestTrue("Warped rotation follows the spline", Warped.GetRotation().GetForwardVector().Equals(FVector::YAxisVector, 0.01f));
+
+	// Moving the last point only changes the second segment, without changing the count of its sections
+	Spline->SetLocationAtSplinePoint(2, FVector(1000.f, 1000.f, 300.f), ESplineCoordinateSpace::Local);
+	FMBSSplinePath ChangedPath;
+	ChangedPath.Build(*Spline, SectionLength);
+	TestTrue("Same sections", Path.HasSameSections(ChangedPath));
+
+	TArray<int32> ChangedSegments;
+	Path.GetChangedSegments(ChangedPath, ChangedSegments);
+	TestTrue("Only the second segment is changed", ChangedSegments == TArray<int32>({ 1 }));
+
+	// Sections of the unchanged segment stay in place
+	const FTransform Straight(FVector(350.f, 100.f, 0.f));
+	TestTrue("Unchanged segment", Path.Warp(Straight).Equals(ChangedPath.Warp(Straight), 0.01f));
+	return true;
+}
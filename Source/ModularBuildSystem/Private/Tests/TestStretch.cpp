@@ -81,6 +81,11 @@ bool FStretchSectionsUsingScaleCoefficients::RunTest(const FString& Parameters)
 	TestEqual("Coefficients X=1.0, Y=1.5, Z=1.0, (Section 1)", Section1.GetLocation(), FVector(600.f, 0.f, 0.f));
 	TestEqual("Coefficients X=1.0, Y=1.5, Z=1.0, (Section 2)", Section2.GetLocation(), FVector(0.f, 400.f, 0.f));
 	TestEqual("Coefficients X=1.0, Y=1.5, Z=1.0, (Section 3)", Section3.GetLocation(), FVector(600.f, 400.f, 0.f));
+
+	Section0.Reset();
+	Section1.Reset();
+	Section2.Reset();
+	Section3.Reset();
 	return true;
 }
 
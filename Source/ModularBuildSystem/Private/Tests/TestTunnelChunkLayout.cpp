@@ -0,0 +1,25 @@
+#include "Tunnel/TunnelChunkLayout.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTunnelChunkLayoutCompute, "ModularBuildSystem.TunnelChunkLayout.Compute",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::MediumPriority)
+bool FTunnelChunkLayoutCompute::RunTest(const FString& Parameters)
+{
+	constexpr float SectionLength = 400.f;
+	constexpr float CellSize = 12800.f;
+
+	// Tunnel starting at a cell border fills whole cells
+	const FTunnelChunkLayout Aligned = FTunnelChunkLayout::Compute(100, SectionLength, 0.f, 1.f, CellSize);
+	TestTrue("Chunks of aligned tunnel", Aligned.Chunks == TArray<FTunnelChunk>({ {0, 32}, {32, 32}, {64, 32}, {96, 4} }));
+
+	// First chunk ends at the border of the first cell
+	const FTunnelChunkLayout Offset = FTunnelChunkLayout::Compute(50, SectionLength, 6000.f, 1.f, CellSize);
+	TestTrue("Chunks of offset tunnel", Offset.Chunks == TArray<FTunnelChunk>({ {0, 17}, {17, 32}, {49, 1} }));
+
+	// Cells are crossed in the opposite direction
+	const FTunnelChunkLayout Reversed = FTunnelChunkLayout::Compute(50, SectionLength, 6000.f, -1.f, CellSize);
+	TestTrue("Chunks of reversed tunnel", Reversed.Chunks == TArray<FTunnelChunk>({ {0, 15}, {15, 32}, {47, 3} }));
+
+	TestEqual("No chunks without sections", FTunnelChunkLayout::Compute(0, SectionLength, 0.f, 1.f, CellSize).Chunks.Num(), 0);
+	return true;
+}
@@ -333,15 +333,14 @@ void UMBSTreemap::AdjustPartitionsByShape(TArray<FMBSTreemapPartition>& Partitio
 	const int32 Count = Partitions.Num();
 	for (int32 i = 0; i < Count; i++)
 	{
-		MBS::FGridCell3D Cell(Partitions[i].Bounds, FloorTransform, ScaleCoefficients);
-		MBS::FGridCell3D CellMin(Partitions[i].Bounds.Min, FloorTransform, ScaleCoefficients, true);
-		MBS::FGridCell3D CellMax(Partitions[i].Bounds.Max, FloorTransform, ScaleCoefficients, true);
-		UE_LOG(LogMBSTreemap, VeryVerbose, TEXT("%s: [i=%d] Partition=%s, Cell=%s"), *GetName(), i, *Partitions[i].ToString(), *Cell.ToString());
-		UE_LOG(LogMBSTreemap, VeryVerbose, TEXT("%s: [i=%d] Partition=%s, Cell.Min=%s"), *GetName(), i, *Partitions[i].ToString(), *CellMin.ToString());
-		UE_LOG(LogMBSTreemap, VeryVerbose, TEXT("%s: [i=%d] Partition=%s, Cell.Max=%s"), *GetName(), i, *Partitions[i].ToString(), *CellMax.ToString());
+		// Only indices of the cells at the partition corners are needed, so cells themselves are not constructed
+		const MBS::FGridCellKey CellMin = MBS::FGridCell3D::GetKeyAt(Partitions[i].Bounds.Min, FloorTransform, ScaleCoefficients);
+		const MBS::FGridCellKey CellMax = MBS::FGridCell3D::GetKeyAt(Partitions[i].Bounds.Max, FloorTransform, ScaleCoefficients);
+		UE_LOG(LogMBSTreemap, VeryVerbose, TEXT("%s: [i=%d] Partition=%s, Cell.Min=%s, Cell.Max=%s"), *GetName(), i,
+			*Partitions[i].ToString(), *CellMin.GetIndexXYZ().ToString(), *CellMax.GetIndexXYZ().ToString());
 
 		// Divide horizontally if division line is in middle of current partition
-		if (CellMin.GetIndexXYZ().Y < MaxIndexY && CellMax.GetIndexXYZ().Y > MaxIndexY)
+		if (CellMin.GetY() < MaxIndexY && CellMax.GetY() > MaxIndexY)
 		{
 			// TODO: Implement
 			TPair<FMBSTreemapPartition, FMBSTreemapPartition> Divided =
@@ -358,7 +357,7 @@ void UMBSTreemap::AdjustPartitionsByShape(TArray<FMBSTreemapPartition>& Partitio
 		}
 		// TODO: Also divide, if division line is horizontal and passes through the current partition
 		// Divide if division line is right on the left border of a partition
-		else if (CellMin.GetIndexXYZ().Y >= MaxIndexY)
+		else if (CellMin.GetY() >= MaxIndexY)
 		{
 			TPair<FMBSTreemapPartition, FMBSTreemapPartition> Divided =
 				MBS::FTreemapPartitionDivider::Divide(Partitions[i], HorizontalDivLine, true);
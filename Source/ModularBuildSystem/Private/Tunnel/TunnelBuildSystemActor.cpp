@@ -9,6 +9,7 @@
 #include "Shape/ModularLevelShape.h"
 #include "Components/SplineComponent.h"
 #include "ModularBuildSystem.h"
+#include "ModularSectionResolution.h"
 
 ATunnelBuildSystemActor::ATunnelBuildSystemActor()
 {
@@ -16,19 +17,60 @@ ATunnelBuildSystemActor::ATunnelBuildSystemActor()
 	Spline->SetupAttachment(GetRootComponent());
 }
 
+void ATunnelBuildSystemActor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+	UpdateSplineSections();
+}
+
+void ATunnelBuildSystemActor::Destroyed()
+{
+	if (ATunnelBuildSystemActor* Tunnel = ChunkOwner.Get())
+	{
+		Tunnel->OnChunkDestroyed(this);
+	}
+	DestroyChunks();
+	Super::Destroyed();
+}
+
+void ATunnelBuildSystemActor::PostDuplicate(bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+	if (bDuplicateForPIE)
+	{
+		return;
+	}
+
+	// Chunks still belong to the original tunnel, so the copy spawns its own ones
+	ChunkOwner.Reset();
+	Chunks.Reset();
+	ChunkHashes.Reset();
+	if (bChunked)
+	{
+		RequestRegeneration(EMBSRegenerationType::Full);
+	}
+}
+
 void ATunnelBuildSystemActor::PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent)
 {
 	if (PropertyChangedEvent.Property != nullptr)
 	{
 		const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+		const FName MemberPropertyName = PropertyChangedEvent.GetMemberPropertyName();
+		// Bounds only change the chunk layout, so only the chunks which sections were changed are generated again
+		if ((MemberPropertyName == GET_MEMBER_NAME_CHECKED(ATunnelBuildSystemActor, Generator)
+				&& PropertyName != GET_MEMBER_NAME_CHECKED(UTunnelBuildSystemGenerator, Bounds)
+				&& PropertyName != GET_MEMBER_NAME_CHECKED(UTunnelBuildSystemGenerator, LevelCount))
+			|| MemberPropertyName == GET_MEMBER_NAME_CHECKED(ATunnelBuildSystemActor, MeshConfiguration))
+		{
+			ChunkSettingsRevision++;
+		}
+		
 		if (bGenerateOnChange && PropertyName == GET_MEMBER_NAME_CHECKED(ATunnelBuildSystemActor, Generator))
 		{
 			if (Generator)
 			{
-				UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Root component before generation = %s"),
-					*GetName(), *GetRootComponent()->GetName());
-				Generator->SetBuildSystemPtr(this);
-				IBuildingGeneratorInterface::Execute_Generate(Generator);
+				RequestRegeneration(GetRegenerationTypeForChange(PropertyChangedEvent));
 			}
 		}
 	}
@@ -36,49 +78,95 @@ void ATunnelBuildSystemActor::PostEditChangeChainProperty(FPropertyChangedChainE
 	Super::PostEditChangeChainProperty(PropertyChangedEvent);
 }
 
+void ATunnelBuildSystemActor::RegenerateOnChange()
+{
+	if (Generator)
+	{
+		UE_LOG(LogMBS, VeryVerbose, TEXT("%s: Root component before generation = %s"),
+			*GetName(), *GetRootComponent()->GetName());
+		Generator->SetBuildSystemPtr(this);
+		IBuildingGeneratorInterface::Execute_Generate(Generator);
+		MarkChanged();
+	}
+}
+
 void ATunnelBuildSystemActor::Init()
 {
-	Super::Init();
-
-	uint8 ShiftCount = 0;
-	float BasementZMultiplier = 0.f;
-	LevelInitializer.InitSingleLevel(TEXT("Basement"),
-		TunnelBasement,
-		0,
-		ShiftCount,
-		0.f,
-		nullptr,
-		BasementZMultiplier);
-	
-	int32 WallsCount = 0;
-	float WallsZMultiplier = 0.f;
-	LevelInitializer.InitMultipleLevels(TEXT("Walls"),
-		TunnelWalls,
-		ShiftCount,
-		0.f,
-		nullptr,
-		WallsZMultiplier,
-		WallsCount);
-
-	float RoofZMultiplier = 0.f;
-	LevelInitializer.InitSingleLevel(TEXT("Roof"),
-		TunnelRoof,
-		WallsCount + 1,
-		ShiftCount,
-		WallsZMultiplier,
-		nullptr,
-		RoofZMultiplier);
-
-	float RooftopZMultiplier = 0.f;
-	LevelInitializer.InitSingleLevel(TEXT("Rooftop"),
-		TunnelRooftop,
-		WallsCount + 2,
-		ShiftCount,
-		RoofZMultiplier,
-		TunnelRoof.GetInitializer().GetResolution(),
-		RooftopZMultiplier);
-	
-	EndInit();
+	// Same steps as the ones of the time-sliced generation, executed at once
+	FMBSGenerationSteps Steps;
+	AddInitSteps(Steps);
+	Steps.RunToCompletion();
+}
+
+void ATunnelBuildSystemActor::AddInitSteps(FMBSGenerationSteps& OutSteps)
+{
+	// State shared between steps, as each step is executed separately in case of time-sliced generation
+	struct FInitState
+	{
+		uint8 ShiftCount = 0;
+		float BasementZMultiplier = 0.f;
+		int32 WallsIndex = INDEX_NONE;
+		int32 WallsCount = 0;
+		float WallsZMultiplier = 0.f;
+		float RoofZMultiplier = 0.f;
+		float RooftopZMultiplier = 0.f;
+	};
+	const TSharedRef<FInitState> State = MakeShared<FInitState>();
+
+	OutSteps.Add(TEXT("Init"), [this]
+	{
+		Super::Init();
+	});
+
+	OutSteps.Add(TEXT("Basement"), [this, State]
+	{
+		LevelInitializer.InitSingleLevel(TEXT("Basement"),
+			TunnelBasement,
+			0,
+			State->ShiftCount,
+			0.f,
+			nullptr,
+			State->BasementZMultiplier);
+	});
+
+	OutSteps.AddResumable(TEXT("Walls"), [this, State]
+	{
+		return LevelInitializer.InitNextOfMultipleLevels(TEXT("Walls"),
+			TunnelWalls,
+			State->WallsIndex,
+			State->ShiftCount,
+			0.f,
+			nullptr,
+			State->WallsZMultiplier,
+			State->WallsCount) ? EMBSGenerationStepResult::Finished : EMBSGenerationStepResult::Pending;
+	});
+
+	OutSteps.Add(TEXT("Roof"), [this, State]
+	{
+		LevelInitializer.InitSingleLevel(TEXT("Roof"),
+			TunnelRoof,
+			State->WallsCount + 1,
+			State->ShiftCount,
+			State->WallsZMultiplier,
+			nullptr,
+			State->RoofZMultiplier);
+	});
+
+	OutSteps.Add(TEXT("Rooftop"), [this, State]
+	{
+		LevelInitializer.InitSingleLevel(TEXT("Rooftop"),
+			TunnelRooftop,
+			State->WallsCount + 2,
+			State->ShiftCount,
+			State->RoofZMultiplier,
+			TunnelRoof.GetInitializer().GetResolution(),
+			State->RooftopZMultiplier);
+	});
+
+	OutSteps.Add(TEXT("EndInit"), [this]
+	{
+		EndInit();
+	});
 }
 
 TScriptInterface<IBuildingGeneratorInterface> ATunnelBuildSystemActor::GetGenerator() const
@@ -116,7 +204,7 @@ void ATunnelBuildSystemActor::CollectStats()
 	if (Generator)
 	{
 		// Set build stats bounds and level count
-		BuildStats.OverrideBounds(Generator->GetBounds());
+		BuildStats.OverrideBounds(Generator->GetTunnelBounds());
 		BuildStats.OverrideLevelCount(Generator->GetLevelCount());
 	}
 }
@@ -129,15 +217,200 @@ void ATunnelBuildSystemActor::OnUpdateTransformBounds()
 	/*Generator->*/Generate();
 }
 
-/*void ATunnelBuildSystemActor::SetupSpline()
+void ATunnelBuildSystemActor::BuildSplinePath()
+{
+	StraightTransforms.Reset();
+	if (bUseSpline && !bChunked && Spline)
+	{
+		SplinePath.Build(*Spline, UModularSectionResolution::DefaultSectionSize);
+	}
+	else
+	{
+		SplinePath.Reset();
+	}
+}
+
+void ATunnelBuildSystemActor::PlaceAlongSpline()
 {
-	/*if (bUseSpline && !Spline)
+	StraightTransforms.Reset();
+	if (bUseSpline && Spline && SplinePath.IsValid())
 	{
-		Spline = NewObject<USplineComponent>(this);
+		PlaceSectionsAlongSpline(*Spline, SplinePath, StraightTransforms);
 	}
-	else if (!bUseSpline && Spline)
+}
+
+void ATunnelBuildSystemActor::UpdateSplineSections()
+{
+	if (!bUseSpline || !Spline || StraightTransforms.IsEmpty())
 	{
-		Spline->UnregisterComponent();
-		Spline->DestroyComponent();
-	}#1#
-}*/
+		return;
+	}
+
+	FMBSSplinePath NewPath;
+	NewPath.Build(*Spline, UModularSectionResolution::DefaultSectionSize);
+
+	// Path is not kept after load, while sections are already placed along the spline
+	if (!SplinePath.IsValid())
+	{
+		SplinePath = MoveTemp(NewPath);
+		return;
+	}
+
+	if (!SplinePath.HasSameSections(NewPath))
+	{
+		UE_LOG(LogMBS, Verbose, TEXT("%s: Count of sections along the spline was changed (%d -> %d), regenerating"),
+			*GetName(), SplinePath.GetSectionCount(), NewPath.GetSectionCount());
+		RequestRegeneration(EMBSRegenerationType::Full);
+		return;
+	}
+
+	TArray<int32> ChangedSegments;
+	SplinePath.GetChangedSegments(NewPath, ChangedSegments);
+	SplinePath = MoveTemp(NewPath);
+	if (ChangedSegments.IsEmpty())
+	{
+		return;
+	}
+
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Placing sections of %d changed spline segments"), *GetName(), ChangedSegments.Num());
+	if (!PlaceSectionsAlongSpline(*Spline, SplinePath, StraightTransforms, ChangedSegments))
+	{
+		RequestRegeneration(EMBSRegenerationType::Full);
+	}
+}
+
+void ATunnelBuildSystemActor::UpdateChunkLayout()
+{
+	// Chunks are split along the world axis the tunnel is the most aligned with
+	const FVector Forward = GetActorForwardVector();
+	const int32 Axis = FMath::Abs(Forward.X) >= FMath::Abs(Forward.Y) ? 0 : 1;
+	ChunkLayout = FTunnelChunkLayout::Compute(
+		Generator->GetBounds().X,
+		UModularSectionResolution::DefaultSectionSize * GetActorScale3D().X,
+		GetActorLocation()[Axis],
+		Forward[Axis],
+		ChunkCellSize);
+
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Chunk layout of %d sections has %d chunks"),
+		*GetName(), Generator->GetBounds().X, ChunkLayout.Chunks.Num());
+
+	DestroyChunks(ChunkLayout.Chunks.Num());
+	Chunks.SetNum(ChunkLayout.Chunks.Num());
+	ChunkHashes.SetNumZeroed(ChunkLayout.Chunks.Num());
+}
+
+bool ATunnelBuildSystemActor::GenerateChunk(int32 Index)
+{
+	if (!ChunkLayout.Chunks.IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	const FTunnelChunk& Chunk = ChunkLayout.Chunks[Index];
+	const bool bFirst = Index == 0;
+	const bool bLast = Index == ChunkLayout.Chunks.Num() - 1;
+
+	ATunnelBuildSystemActor* ChunkActor = Chunks[Index].Get();
+	if (!ChunkActor && !Chunks[Index].IsNull())
+	{
+		// Chunk will be generated on the next generation after it is loaded
+		UE_LOG(LogMBS, Warning, TEXT("%s: Chunk %d is not loaded and can't be generated"), *GetName(), Index);
+		ChunkHashes[Index] = 0;
+		return !bLast;
+	}
+
+	// Chunks are moved with the tunnel without being generated again
+	const FTransform ChunkTransform = GetChunkTransform(Chunk.FirstSection);
+	if (ChunkActor)
+	{
+		ChunkActor->SetActorTransform(ChunkTransform);
+	}
+
+	uint32 Hash = HashCombine(ChunkSettingsRevision, GetTypeHash(Chunk.FirstSection));
+	Hash = HashCombine(Hash, GetTypeHash(Chunk.SectionCount));
+	Hash = HashCombine(Hash, GetTypeHash(Generator->GetBounds().Y));
+	Hash = HashCombine(Hash, GetTypeHash(Generator->GetLevelCount()));
+	Hash = HashCombine(Hash, GetTypeHash(MeshConfiguration));
+	Hash = HashCombine(Hash, GetTypeHash(bFirst));
+	Hash = HashCombine(Hash, GetTypeHash(bLast));
+	if (ChunkActor && ChunkHashes[Index] == Hash)
+	{
+		return !bLast;
+	}
+
+	if (!ChunkActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.OverrideLevel = GetLevel();
+		ChunkActor = GetWorld()->SpawnActor<ATunnelBuildSystemActor>(GetClass(), ChunkTransform, SpawnParams);
+		if (!ChunkActor)
+		{
+			UE_LOG(LogMBS, Error, TEXT("%s: Failed to spawn chunk %d"), *GetName(), Index);
+			return !bLast;
+		}
+#if WITH_EDITOR
+		ChunkActor->SetActorLabel(FString::Printf(TEXT("%s_Chunk%d"), *GetActorLabel(), Index));
+#endif
+		ChunkActor->ChunkOwner = this;
+		Chunks[Index] = ChunkActor;
+	}
+
+	UE_LOG(LogMBS, Verbose, TEXT("%s: Generating chunk %d (sections %d - %d)"),
+		*GetName(), Index, Chunk.FirstSection, Chunk.FirstSection + Chunk.SectionCount - 1);
+
+	ChunkActor->bChunked = false;
+	ChunkActor->bUseSpline = false;
+	ChunkActor->MeshConfiguration = MeshConfiguration;
+	ChunkActor->Generator = DuplicateObject(Generator.Get(), ChunkActor);
+	ChunkActor->Generator->SetBounds(FIntPoint(Chunk.SectionCount, Generator->GetBounds().Y));
+	ChunkActor->Generator->SetLevelCount(Generator->GetLevelCount());
+	ChunkActor->Generator->SetEntrances(bFirst, bLast);
+	ChunkActor->RegenerateOnChange();
+
+	ChunkHashes[Index] = Hash;
+	return !bLast;
+}
+
+void ATunnelBuildSystemActor::DestroyChunks(int32 FirstIndex)
+{
+	for (int32 i = Chunks.Num() - 1; i >= FirstIndex; i--)
+	{
+		if (ATunnelBuildSystemActor* ChunkActor = Chunks[i].Get())
+		{
+			// Chunk is removed here, so it must not notify this tunnel
+			ChunkActor->ChunkOwner.Reset();
+			ChunkActor->ResetBuildSystem();
+			ChunkActor->Destroy();
+		}
+		else if (!Chunks[i].IsNull())
+		{
+			UE_LOG(LogMBS, Warning, TEXT("%s: Chunk %d is not loaded and can't be destroyed"), *GetName(), i);
+		}
+	}
+
+	if (FirstIndex < Chunks.Num())
+	{
+		Chunks.SetNum(FirstIndex);
+		ChunkHashes.SetNum(FMath::Min(FirstIndex, ChunkHashes.Num()));
+	}
+}
+
+void ATunnelBuildSystemActor::OnChunkDestroyed(const ATunnelBuildSystemActor* InChunk)
+{
+	for (int32 i = 0; i < Chunks.Num(); i++)
+	{
+		if (Chunks[i].Get() == InChunk)
+		{
+			Chunks[i].Reset();
+			if (ChunkHashes.IsValidIndex(i))
+			{
+				ChunkHashes[i] = 0;
+			}
+		}
+	}
+}
+
+FTransform ATunnelBuildSystemActor::GetChunkTransform(int32 FirstSection) const
+{
+	return FTransform(FVector(FirstSection * UModularSectionResolution::DefaultSectionSize, 0.f, 0.f)) * GetActorTransform();
+}
@@ -24,15 +24,63 @@ FGeneratedModularSections UTunnelBuildSystemGenerator::Generate_Implementation()
 		return FGeneratedModularSections();
 	}
 
+	FMBSGenerationSteps Steps;
+	AddGenerationSteps(Steps);
+	Steps.RunToCompletion();
+	
+	return FGeneratedModularSections(BuildSystemPtr.Get());
+}
+
+void UTunnelBuildSystemGenerator::AddGenerationSteps(FMBSGenerationSteps& OutSteps)
+{
+	if (BuildSystemPtr->IsChunked())
+	{
+		// Sections are generated by chunks, one chunk per step
+		const TSharedRef<int32> ChunkIndex = MakeShared<int32>(0);
+		OutSteps.Add(TEXT("ChunkLayout"), [this]
+		{
+			BuildSystemPtr->UpdateChunkLayout();
+		});
+
+		OutSteps.AddResumable(TEXT("Chunks"), [this, ChunkIndex]
+		{
+			return BuildSystemPtr->GenerateChunk((*ChunkIndex)++)
+				? EMBSGenerationStepResult::Pending
+				: EMBSGenerationStepResult::Finished;
+		});
+
+		OutSteps.Add(TEXT("FinishGeneration"), [this]
+		{
+			FinishGeneration();
+		});
+		return;
+	}
+
+	// Chunks are left from the previous chunked generation
+	OutSteps.Add(TEXT("RemoveChunks"), [this]
+	{
+		BuildSystemPtr->DestroyChunks();
+	});
+
 	// Generate
 	//FMBSGeneratorPropertyInitArgs EntranceArgs;
 	//EntranceArgs.Generator = this;
-	Entrance->CustomInit(this, BuildSystemPtr);
+	OutSteps.Add(TEXT("Entrance"), [this]
+	{
+		Entrance->CustomInit(this, BuildSystemPtr);
+	});
+
+	// Sections are generated straight and then are moved onto the spline
+	OutSteps.Add(TEXT("Spline"), [this]
+	{
+		BuildSystemPtr->PlaceAlongSpline();
+	});
 
 	//LogGenerationSummary();
-	FinishGeneration();
-	
-	return FGeneratedModularSections(BuildSystemPtr.Get());
+	OutSteps.Add(TEXT("FinishGeneration"), [this]
+	{
+		FinishGeneration();
+	});
 }
 
 bool UTunnelBuildSystemGenerator::SetBuildSystemPtr(TScriptInterface<IModularBuildSystemInterface> InBuildSystemPtr)
@@ -62,11 +110,16 @@ bool UTunnelBuildSystemGenerator::CheckLists() const
 
 void UTunnelBuildSystemGenerator::PrepareBuildSystem() const
 {
-	const int32 Area = Bounds.X * Bounds.Y;
-	const int32 Perimeter = (Bounds.X + Bounds.Y) * 2;
+	BuildSystemPtr->BuildSplinePath();
+
+	// Chunked tunnel has no sections of its own
+	const FIntPoint TunnelBounds = BuildSystemPtr->IsChunked() ? FIntPoint(0, Bounds.Y) : GetTunnelBounds();
+	
+	const int32 Area = TunnelBounds.X * TunnelBounds.Y;
+	const int32 Perimeter = (TunnelBounds.X + TunnelBounds.Y) * 2;
 	
 	const int32 TotalCount = Area;
-	const int32 MaxInRow = Bounds.X;
+	const int32 MaxInRow = TunnelBounds.X;
 	
 	BuildSystemPtr->TunnelBasement
 		.SetName(TEXT("Basement"))
@@ -79,8 +132,8 @@ void UTunnelBuildSystemGenerator::PrepareBuildSystem() const
 		.SetPivotLocation(GetPivotLocation(TunnelBasement->Data, BuildSystemPtr->TunnelBasement));
 
 	BuildSystemPtr->TunnelWalls.SetNum(LevelCount);
-	const int32 WallTotalCount = Bounds.X * 2;
-	const int32 WallMaxInRow = Bounds.X;
+	const int32 WallTotalCount = TunnelBounds.X * 2;
+	const int32 WallMaxInRow = TunnelBounds.X;
 	int32 WallIndex = 0;
 	for (auto& Wall : BuildSystemPtr->TunnelWalls)
 	{
@@ -109,7 +162,7 @@ void UTunnelBuildSystemGenerator::PrepareBuildSystem() const
 		.SetPivotLocation(GetPivotLocation(TunnelRoof->Data, BuildSystemPtr->TunnelRoof))
 		.SetSolver(TunnelRoof->Solver);
 
-	const int32 RooftopTotalCount = Bounds.Y > 2 ? (Bounds.Y - 2) * WallMaxInRow : 0;
+	const int32 RooftopTotalCount = TunnelBounds.Y > 2 ? (TunnelBounds.Y - 2) * WallMaxInRow : 0;
 	const int32 RooftopMaxInRow = WallMaxInRow;
 	BuildSystemPtr->TunnelRooftop
 		.SetName(TEXT("Rooftop"))
@@ -122,6 +175,15 @@ void UTunnelBuildSystemGenerator::PrepareBuildSystem() const
 		.SetSolver(TunnelRooftop->Solver);
 }
 
+FIntPoint UTunnelBuildSystemGenerator::GetTunnelBounds() const
+{
+	if (BuildSystemPtr && BuildSystemPtr->SplinePath.IsValid())
+	{
+		return FIntPoint(BuildSystemPtr->SplinePath.GetSectionCount(), Bounds.Y);
+	}
+	return Bounds;
+}
+
 bool UTunnelBuildSystemGenerator::CanGenerate() const
 {
 	return TunnelBasement && TunnelWall && TunnelRoof && TunnelRooftop && Entrance && Super::CanGenerate();
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tunnel/TunnelChunkLayout.h"
+
+FTunnelChunkLayout FTunnelChunkLayout::Compute(int32 SectionCount, float SectionLength, float StartCoordinate,
+	float Direction, float CellSize)
+{
+	FTunnelChunkLayout OutLayout;
+	if (SectionCount <= 0 || SectionLength <= 0.f || CellSize <= 0.f)
+	{
+		return OutLayout;
+	}
+
+	const float Sign = Direction < 0.f ? -1.f : 1.f;
+	int32 PreviousCell = 0;
+	for (int32 i = 0; i < SectionCount; i++)
+	{
+		const float Center = StartCoordinate + Sign * (i + 0.5f) * SectionLength;
+		const int32 Cell = FMath::FloorToInt(Center / CellSize);
+		if (OutLayout.Chunks.IsEmpty() || Cell != PreviousCell)
+		{
+			OutLayout.Chunks.Add({ i, 0 });
+			PreviousCell = Cell;
+		}
+		OutLayout.Chunks.Last().SectionCount++;
+	}
+	return OutLayout;
+}
@@ -5,6 +5,26 @@
 #include "ModularBuildSystem.h"
 #include "Solver/MBSTransformSolver.h"
 #include "Tunnel/TunnelBuildSystemActor.h"
+#include "Tunnel/TunnelBuildSystemGenerator.h"
+
+namespace
+{
+	/**
+	 * Removes entrance transforms of the disabled tunnel ends. First two transforms are at the start of the tunnel,
+	 * last two are at its end.
+	 */
+	void FilterEntranceEnds(TArray<FTransform>& InOutTransforms, bool bAtStart, bool bAtEnd)
+	{
+		if (!bAtEnd)
+		{
+			InOutTransforms.SetNum(2);
+		}
+		if (!bAtStart)
+		{
+			InOutTransforms.RemoveAt(0, 2);
+		}
+	}
+}
 
 bool UTunnelEntranceGeneratorProperty::CustomInit(UTunnelBuildSystemGenerator* Generator, ATunnelBuildSystemActor* BS)
 {
@@ -24,6 +44,12 @@ bool UTunnelEntranceGeneratorProperty::CustomInit(UTunnelBuildSystemGenerator* G
 	const bool bInstanced = BS->IsOfInstancedMeshConfigurationType();
 	constexpr bool bWorldSpace = false;
 	const FVector DefaultSectionSize = FVector(UModularSectionResolution::DefaultSectionSize, 0.f, 0.f);
+	const bool bAtStart = Generator->HasEntranceAtStart();
+	const bool bAtEnd = Generator->HasEntranceAtEnd();
+	if (!bAtStart && !bAtEnd)
+	{
+		return true;
+	}
 	//const FTransform& BSTransform = BS->GetActorTransform();
 
 	// Init walls (corners)
@@ -39,6 +65,7 @@ bool UTunnelEntranceGeneratorProperty::CustomInit(UTunnelBuildSystemGenerator* G
 		WallTransforms[1].MultiplyScale3D(FVector(-1.f, 1.f, 1.f));
 		WallTransforms[2].MultiplyScale3D(FVector(-1.f, 1.f, 1.f));
 		WallTransforms[3].AddToTranslation(DefaultSectionSize);
+		FilterEntranceEnds(WallTransforms, bAtStart, bAtEnd);
 		
 		BS->InitMultipleModularSections(
 			Data.GetRandomMesh(), WallTransforms, Wall.GetId(), true, !bWorldSpace);
@@ -73,6 +100,7 @@ bool UTunnelEntranceGeneratorProperty::CustomInit(UTunnelBuildSystemGenerator* G
 	RoofTransforms[1].MultiplyScale3D(FVector(-1.f, 1.f, 1.f));
 	RoofTransforms[2].MultiplyScale3D(FVector(-1.f, 1.f, 1.f));
 	RoofTransforms[3].AddToTranslation(DefaultSectionSize);
+	FilterEntranceEnds(RoofTransforms, bAtStart, bAtEnd);
 	
 	BS->InitMultipleModularSections(
 		EntranceRoof.GetRandomMesh(), RoofTransforms, Roof.GetId(), true, !bWorldSpace);
@@ -80,10 +108,22 @@ bool UTunnelEntranceGeneratorProperty::CustomInit(UTunnelBuildSystemGenerator* G
 	// Init rooftops
 	const FModularLevel& Rooftop = BS->TunnelRooftop;
 	const int32 RooftopTotalCount = Rooftop.GetInitializer().GetTotalCount();
+	const int32 RooftopMaxInRow = FMath::Max(1, Rooftop.GetInitializer().GetMaxInRow());
+	const FNextTransformContext RooftopContext(BS->GetActorTransform(), Rooftop, BS->BuildStats, nullptr, BS->Spline);
 	for (int32 i = 0; i < RooftopTotalCount; i++)
 	{
-		FNextTransformArgs EntranceRooftopArgs = FNextTransformArgs(
-			BS->GetActorTransform(), i, Rooftop, BS->BuildStats, nullptr, BS->Spline);
+		// Rooftops of the first half of a row are at the start of the tunnel
+		const int32 Column = i % RooftopMaxInRow;
+		if (!(bAtStart && Column * 2 <= RooftopMaxInRow - 1) && !(bAtEnd && Column * 2 >= RooftopMaxInRow - 1))
+		{
+			continue;
+		}
+		
+		FNextTransformArgs EntranceRooftopArgs(RooftopContext, i);
+		if (!EntranceRooftopSolver->HasNativeBatch())
+		{
+			EntranceRooftopArgs.FillBuildStats();
+		}
 		
 		FTransform NewTransform = EntranceRooftopSolver->GetNextTransform(EntranceRooftopArgs);
 		if (EntranceRooftopArgs.bOutShouldBeSkipped)
@@ -19,7 +19,7 @@ FTransform UTunnelWallTransformSolver::GetNextTransform_Implementation(FNextTran
 	else
 	{
 		Args.OutLocation.X += (DSS * GetAdjustedIndex());
-		Args.OutLocation.Y += (DSS * Args.InBuildStats.Bounds.Y) - DSS;
+		Args.OutLocation.Y += (DSS * Args.GetBuildStats().Bounds.Y) - DSS;
 	}
 	
 	Args.OutLocation.Z += DSS * Args.InLevelZMultiplier;
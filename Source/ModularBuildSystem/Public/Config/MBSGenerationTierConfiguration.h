@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MBSSections.h"
+#include "ModularBuildSystemGenerator.h"
+#include "MBSGenerationTierConfiguration.generated.h"
+
+/**
+ * Structure that holds configuration of generation tiers of a modular build system.
+ * @see EMBSGenerationTier
+ */
+USTRUCT(BlueprintType)
+struct MODULARBUILDSYSTEM_API FMBSGenerationTierConfiguration
+{
+	GENERATED_BODY()
+
+	/**
+	 * If true - generation tier is switched automatically at runtime depending on the distance to the player camera.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem")
+	bool bSwitchByDistance = false;
+
+	/**
+	 * Distance (in cm) starting from which only the shell tier is shown.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem", meta=(EditCondition="bSwitchByDistance", ClampMin=0))
+	float ShellDistance = 10000.f;
+
+	/**
+	 * Distance (in cm) starting from which the facade tier is shown. Full tier is shown below this distance.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem", meta=(EditCondition="bSwitchByDistance", ClampMin=0))
+	float FacadeDistance = 3000.f;
+
+	/**
+	 * Interval (in seconds) between distance checks.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem", meta=(EditCondition="bSwitchByDistance", ClampMin=0.05))
+	float UpdateInterval = 0.5f;
+
+	/**
+	 * If true - shell is shared by all tiers, and details of each generated tier are kept hidden after switching to
+	 * another tier, so switching back only toggles visibility instead of generating the tier again. Costs the memory
+	 * of the cached details. Shell instances replaced by details are hidden instead of being removed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem")
+	bool bCacheTiers = true;
+
+	/**
+	 * @param InDistance Distance from the build system to the viewer.
+	 * @return Generation tier that should be shown at the distance.
+	 */
+	EMBSGenerationTier GetTierForDistance(float InDistance) const;
+};
+
+/**
+ * Details of a single generation tier that are kept aside while another tier is shown. Shell is not cached.
+ * @see FMBSSections::DetachTierDetails
+ */
+USTRUCT()
+struct MODULARBUILDSYSTEM_API FMBSGenerationTierCache
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FMBSSections Sections;
+
+	/**
+	 * Changes of the shell sections made by the cached details.
+	 */
+	UPROPERTY()
+	TArray<FMBSShellOverride> ShellOverrides;
+};
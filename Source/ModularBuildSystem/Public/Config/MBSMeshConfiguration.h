@@ -34,11 +34,20 @@ struct MODULARBUILDSYSTEM_API FMBSMeshConfiguration
 
 	/**
 	 * If true - instanced static mesh component will be created only for each unique mesh.
-	 * @note That way many levels may reference the same static mesh component.
+	 * @note That way many levels may reference the same static mesh component. Each level then owns only a range
+	 * of instances of that component.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem", meta=(EditCondition="Type == EMBSMeshConfigurationType::InstancedStaticMeshes || Type == EMBSMeshConfigurationType::HierarchicalInstancedStaticMeshes"))
 	bool bUseSingleComponentPerUniqueMesh = false;
 
+	/**
+	 * If true - instanced sections are registered in the world shared instancing subsystem and rendered by the chunk
+	 * components shared with other build systems. Own instanced components of the build system are hidden but keep the collision.
+	 * @see UMBSInstancingSubsystem
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem", meta=(EditCondition="Type == EMBSMeshConfigurationType::InstancedStaticMeshes || Type == EMBSMeshConfigurationType::HierarchicalInstancedStaticMeshes"))
+	bool bUseWorldSharedInstancing = false;
+
 	/**
 	 * If true - modular section static meshes will be updated after each build system actor update.
 	 */
@@ -53,4 +62,23 @@ struct MODULARBUILDSYSTEM_API FMBSMeshConfiguration
 	 */
 	bool IsOfInstancedType() const;
 
+	/**
+	 * @return True if configuration is of instanced type and bUseSingleComponentPerUniqueMesh is set.
+	 */
+	bool UsesSingleComponentPerUniqueMesh() const;
+
+	/**
+	 * @return True if configuration is of instanced type and bUseWorldSharedInstancing is set.
+	 */
+	bool UsesWorldSharedInstancing() const;
+
+	/**
+	 * Hash of the settings that change how sections are spawned.
+	 */
+	friend uint32 GetTypeHash(const FMBSMeshConfiguration& Configuration)
+	{
+		uint32 Hash = GetTypeHash(Configuration.Type);
+		Hash = HashCombine(Hash, GetTypeHash(Configuration.bUseSingleComponentPerUniqueMesh));
+		return HashCombine(Hash, GetTypeHash(Configuration.bUseWorldSharedInstancing));
+	}
 };
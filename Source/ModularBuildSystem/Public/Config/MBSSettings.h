@@ -63,6 +63,35 @@ public:
 
 	UPROPERTY(EditAnywhere, Config, Category=MBS)
 	bool bUseSingleInstancedComponentPerUniqueMesh;
+
+	/**
+	 * Size (in cm) of a single chunk cell of the world shared instancing subsystem.
+	 * @see UMBSInstancingSubsystem
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=MBS, meta=(ClampMin=100))
+	float SharedInstancingChunkSize;
+
+	/**
+	 * Time (in ms) that regeneration requests produced by property edits can take in a single editor frame.
+	 * Requests that did not fit are processed on the next frames.
+	 * @see UMBSRegenerationScheduler
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=MBS, meta=(ClampMin=1, Units="Milliseconds"))
+	float RegenerationFrameBudget;
+
+	/**
+	 * Time (in ms) that time-sliced generations of build systems can take in a single frame.
+	 * @see AModularBuildSystemActor::GenerateTimeSliced
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=MBS, meta=(ClampMin=1, Units="Milliseconds"))
+	float TimeSlicedGenerationFrameBudget;
+
+	/**
+	 * If true - interactive edits (dragging a slider) only preview the change on existing sections,
+	 * and full regeneration runs once the change is finalized. Otherwise each edit regenerates immediately.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=MBS)
+	bool bDeferInteractiveRegeneration;
 	
 	/**
 	 * TODO: Implement. Currently not supported.
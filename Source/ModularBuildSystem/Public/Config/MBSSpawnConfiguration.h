@@ -77,5 +77,13 @@ struct FMBSSpawnConfiguration
 	UPROPERTY(EditInstanceOnly, AdvancedDisplay, Category = "ModularBuildSystem")
 	bool bResetRotationAlso = false;
 
+	/**
+	 * If true - sections of the structural levels are shown as soon as they are initialized by the time-sliced
+	 * generation. Otherwise the building stays hidden until the generation is completed.
+	 * @see AModularBuildSystemActor::GenerateTimeSliced
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "ModularBuildSystem")
+	bool bShowShellWhileGenerating = false;
+
 	FActorSpawnParameters SectionSpawnParams;
 };
@@ -6,6 +6,9 @@
 #include "MBSGeneratorProperty.h"
 #include "HouseWindowGeneratorProperty.generated.h"
 
+class UMBSIndexCalculation;
+struct FMBSOccupiedIndices;
+
 /**
  * 
  */
@@ -33,8 +36,28 @@ public:
 	virtual bool Init_Implementation(FMBSGeneratorPropertyInitArgs& Args) override;
 	virtual bool IsSet_Implementation() const override;
 
+	/**
+	 * Calculates window section indices of all wall levels (InWindowCountPerLevel windows per level) without
+	 * modifying any section. Only reads its arguments, so it can be called from any thread if InIndexCalculation
+	 * is thread safe. Each window avoids indices occupied by previous windows of the same level.
+	 * @param InBuildSystem Build system that is only passed to the index calculation.
+	 * @param InWallInitializers Initializers of all wall levels.
+	 * @param InEntranceIndices Indices that should not be occupied by windows.
+	 * @param OutIndices Calculated indices of windows.
+	 * @param InRandomStream Stream passed to the index calculation. Must be set outside of the game thread.
+	 * @see UMBSIndexCalculation::IsThreadSafe
+	 */
+	static void CalculateWindowIndices(int32 InWindowCount, int32 InWindowCountPerLevel,
+		UMBSIndexCalculation* InIndexCalculation, AModularBuildSystemActor* InBuildSystem,
+		TConstArrayView<FModularSectionInitializer> InWallInitializers, const TArray<int32>& InEntranceIndices,
+		TArray<int32>& OutIndices, const FRandomStream* InRandomStream = nullptr);
+
 private:
 	bool CheckEntrancesCount(FMBSGeneratorPropertyInitArgs& Args) const;
-	void AddNewWindowIndex(FMBSGeneratorPropertyInitArgs& Args) const;
+	static void ExcludeIndices(const TArray<int32>& InEntranceIndices, TArray<int32>& InOutIndices);
+	void SetWindows(FMBSGeneratorPropertyInitArgs& Args) const;
+	static int32 CalculateWindowIndex(UMBSIndexCalculation* InIndexCalculation, AModularBuildSystemActor* InBuildSystem,
+		const FModularSectionInitializer& InWallInitializer, int32 AtIndex, TArray<int32>& InLevelIndices,
+		const FMBSOccupiedIndices& InLevelOccupied, const FRandomStream* InRandomStream);
 	void SetSingleWindow(FMBSGeneratorPropertyInitArgs& Args) const;
 };
@@ -83,6 +83,7 @@ public:
 #endif
 
 	virtual void Init() override;
+	virtual void AddInitSteps(FMBSGenerationSteps& OutSteps) override;
 	virtual TScriptInterface<IBuildingGeneratorInterface> GetGenerator() const override;
 	virtual void CollectStats() override;
 	virtual void OnUpdateTransformBounds() override;
@@ -93,6 +94,8 @@ public:
 
 protected:
 	virtual void ApplyStretch() override;
+	virtual void RegenerateOnChange() override;
+	virtual void PreviewRegeneration() override;
 
 private:
 	void UpdateHouseDisplay() const;
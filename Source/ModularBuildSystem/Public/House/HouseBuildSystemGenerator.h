@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "ModularBuildSystemGenerator.h"
+#include "House/HouseBuildSystemLayout.h"
 #include "HouseBuildSystemGenerator.generated.h"
 
 struct FMBSLevelIdTransformPair;
@@ -23,6 +24,8 @@ class AModularBuildSystemActor;
 class AHouseBuildSystemActor;
 class UModularBuildSystemActorList;
 class UModularLevelShape;
+class UMBSGeneratorProperty;
+struct FModularLevel;
 
 /**
  * Base abstract class for house build system generators. Use this class to create your own house generators.
@@ -141,13 +144,51 @@ private:
 	UPROPERTY()
 	TObjectPtr<AHouseBuildSystemActor> BuildSystemPtr;
 
+	/**
+	 * Layout computed ahead of the generation.
+	 * @see SetPrecomputedLayout
+	 */
+	TOptional<FHouseBuildSystemLayout> PrecomputedLayout;
+
+	/**
+	 * Layout that is computed while the levels of the time-sliced generation are initialized.
+	 * @see OnBeginTimeSlicedGeneration
+	 */
+	TFuture<FHouseBuildSystemLayout> LayoutFuture;
+
 public:
 	virtual FGeneratedModularSections Generate_Implementation() override;
 	virtual bool SetBuildSystemPtr(TScriptInterface<IModularBuildSystemInterface> InBuildSystem) override;
 	virtual TScriptInterface<IModularBuildSystemInterface> GetBuildSystemPtr() const override;
+	virtual bool SupportsTimeSlicing() const override { return true; }
+	virtual bool GenerateTierDetails() override;
 
 	bool CanHaveFloors() const { return bCanHaveFloors; }
 	UHouseFloorGeneratorProperty* GetFloor() const { return Floor_New; }
+
+	/**
+	 * Makes input of the house layout from the current properties and bounds of this generator, so it is the same
+	 * before and after the levels are prepared. Must be called on the game thread.
+	 */
+	FHouseBuildSystemLayoutInput MakeLayoutInput() const;
+
+	/**
+	 * Computes house layout on the thread pool. If any of the index calculations is not thread safe, layout is
+	 * computed on the calling thread instead, and the returned future is already fulfilled.
+	 * @return Future of the layout that can be passed to SetPrecomputedLayout before the next generation.
+	 */
+	TFuture<FHouseBuildSystemLayout> ComputeLayoutAsync() const;
+
+	/**
+	 * Sets layout to use in the next generation instead of computing it on the game thread. Layout is ignored if
+	 * properties of this generator were changed after its input was made.
+	 */
+	void SetPrecomputedLayout(FHouseBuildSystemLayout InLayout);
+
+	/**
+	 * @return True if the layout of the active time-sliced generation is not taken by its details yet.
+	 */
+	bool IsComputingLayout() const { return LayoutFuture.IsValid(); }
 	
 protected:
 	virtual void LogGenerationSummary() const override;
@@ -159,22 +200,46 @@ protected:
 
 	virtual void PreGenerateClear() const override;
 	virtual void PrepareBuildSystem() const override;
+	virtual void AddGenerationSteps(FMBSGenerationSteps& OutSteps) override;
+	virtual void OnBeginTimeSlicedGeneration() override;
+
+	/**
+	 * Appends the steps that generate details of the facade and full tiers on top of the shell.
+	 */
+	void AddTierDetailSteps(FMBSGenerationSteps& OutSteps);
+	
+	/**
+	 * @return Precomputed layout if it matches the current properties, otherwise newly computed layout.
+	 */
+	FHouseBuildSystemLayout TakeLayout();
 	
-	virtual void SetEntrances(TArray<int32>& OutEntranceIndices, TArray<FTransform>& OutEntranceTransforms) const;
+	virtual void SetEntrances(const FHouseBuildSystemLayout& InLayout, TArray<int32>& OutEntranceIndices,
+		TArray<FTransform>& OutEntranceTransforms) const;
 	virtual void SetDoors(const TArray<int32>& InEntranceIndices, const TArray<FTransform>& InEntranceTransforms) const;
 	virtual void SetStairs(const TArray<int32>& InEntranceIndices, const TArray<FTransform>& InEntranceTransforms) const;
 	//virtual void SetWindows(const TArray<int32>& InEntranceIndices, TArray<int32>& OutWindowIndices) const;
-	virtual void SetChimney() const;
-	virtual void SetVegetation() const;
-	virtual void SetRoofWindows() const;
+	virtual void SetChimney(const FHouseBuildSystemLayout& InLayout) const;
+	virtual void SetVegetation(const FHouseBuildSystemLayout& InLayout) const;
+	virtual void SetRoofWindows(const FHouseBuildSystemLayout& InLayout) const;
 	virtual void SetInterWallCorners() const;
-	virtual void SetFloorHoles(TArray<FMBSLevelIdTransformPair>& OutFloorHoleIdTransforms);
+	virtual void SetFloorHoles(const FHouseBuildSystemLayout& InLayout,
+		TArray<FMBSLevelIdTransformPair>& OutFloorHoleIdTransforms);
 	virtual void SetFloorHoleDoor(const TArray<FMBSLevelIdTransformPair>& InFloorHoleIdTransforms) const;
 
 	void PrintHeader(const FString& InPropertyName) const;
 	
 private:
 	bool CheckEntrancesCount(const FString& InLevelName, const TArray<int32>& InEntranceIndices) const;
+	int32 GetFloorLevelCount() const;
+	int32 GetArea() const { return Bounds.X * Bounds.Y; }
+	int32 GetPerimeter() const { return (Bounds.X + Bounds.Y) * 2; }
+
+	/**
+	 * @return Initializer of a level prepared with InProperty, with the skipped count of the last initialization of
+	 * InLevel if it is set.
+	 */
+	static FModularSectionInitializer MakeLevelInitializer(const UMBSGeneratorProperty* InProperty,
+		int32 InMeshListIndex, int32 InTotalCount, int32 InMaxInRow, const FModularLevel* InLevel);
 	//void AddNewWindowIndex(int32 AtIndex, int32 WallLevelIndex, TArray<int32>& OutWindowIndices) const;
 	//void SetSingleWindow(int32 AtIndex, int32 WallLevelIndex, TArray<int32>& OutWindowIndices) const;
 };
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModularBuildSystemGenerator.h"
+#include "ModularSection.h"
+
+class AModularBuildSystemActor;
+class UMBSIndexCalculation;
+
+/**
+ * Everything the layout of a house is computed from. Is filled by the generator on the game thread, so the layout
+ * itself can be computed on any thread without reading properties of the generator or the build system.
+ * @see UHouseBuildSystemGenerator::MakeLayoutInput
+ */
+struct MODULARBUILDSYSTEM_API FHouseBuildSystemLayoutInput
+{
+	FString DebugName;
+
+	EMBSGenerationTier Tier = EMBSGenerationTier::Full;
+	int32 Seed = 0;
+
+	/**
+	 * Initializers the levels are prepared with (the first wall and floor level). Skipped counts are the ones of the
+	 * last initialization of the levels, as they are only known once the level shape is applied.
+	 */
+	FModularSectionInitializer WallInitializer;
+	FModularSectionInitializer FloorInitializer;
+	FModularSectionInitializer RoofInitializer;
+	int32 WallLevelCount = 0;
+	int32 FloorLevelCount = 0;
+
+	bool bEntrances = false;
+
+	/**
+	 * True if the level shape has inverted front indices, so the entrance is shifted by one section.
+	 */
+	bool bShiftEntrance = false;
+
+	bool bWindows = false;
+	int32 WindowCount = 0;
+	int32 WindowCountPerLevel = 0;
+	UMBSIndexCalculation* WindowIndexCalculation = nullptr;
+
+	bool bChimney = false;
+
+	bool bRoofWindows = false;
+	UMBSIndexCalculation* RoofWindowIndexCalculation = nullptr;
+
+	bool bVegetation = false;
+	int32 VegetationCount = 0;
+	UMBSIndexCalculation* VegetationIndexCalculation = nullptr;
+
+	bool bFloorHoles = false;
+	UMBSIndexCalculation* FloorHoleIndexCalculation = nullptr;
+
+	/**
+	 * @return True if the layout can be computed outside of the game thread.
+	 * @see UMBSIndexCalculation::IsThreadSafe
+	 */
+	bool IsThreadSafe() const;
+
+	/**
+	 * Adds all objects referenced by this input, so they can be kept alive while the layout is computed on another
+	 * thread.
+	 */
+	void GetReferencedObjects(TArray<UObject*>& OutObjects) const;
+
+	/**
+	 * @return Hash of everything that affects the layout except the random seed. Layouts of inputs with the same hash
+	 * can be used interchangeably.
+	 */
+	uint32 GetLayoutHash() const;
+};
+
+/**
+ * Plain data description of the house details decided by the generator: which sections are replaced by the entrance,
+ * windows and floor holes, and at which sections the chimney, roof windows and vegetation are placed.
+ * Contains no references to the sections, and is applied to the build system by the generator after its levels are
+ * initialized.
+ */
+struct MODULARBUILDSYSTEM_API FHouseBuildSystemLayout
+{
+	/**
+	 * Hash of the input this layout was computed from.
+	 * @see FHouseBuildSystemLayoutInput::GetLayoutHash
+	 */
+	uint32 InputHash = 0;
+	bool bComputed = false;
+
+	/**
+	 * Preferred index of the entrance at the first wall level. Is moved to the next existing section when applied.
+	 */
+	int32 EntranceIndex = INDEX_NONE;
+
+	/**
+	 * Indices of window sections, WindowCountPerLevel indices for each wall level.
+	 */
+	TArray<int32> WindowIndices;
+
+	/**
+	 * Index of the roof section the chimney is placed at.
+	 */
+	int32 ChimneyIndex = INDEX_NONE;
+	TArray<int32> RoofWindowIndices;
+
+	/**
+	 * Indices of vegetation sections of each wall level.
+	 */
+	TArray<TArray<int32>> VegetationIndices;
+
+	/**
+	 * Indices of floor hole sections of each floor except the first one.
+	 */
+	TArray<int32> FloorHoleIndices;
+
+	/**
+	 * Computes the layout. Can be called from any thread if the input is thread safe.
+	 * @param Input Input that was made by the generator.
+	 * @param BuildSystem Build system that is passed to the index calculations. Must be null outside of the game
+	 * thread.
+	 * @return Computed layout.
+	 */
+	static FHouseBuildSystemLayout Compute(const FHouseBuildSystemLayoutInput& Input,
+		AModularBuildSystemActor* BuildSystem = nullptr);
+};
@@ -7,6 +7,7 @@
 #include "HouseInteriorGenerator.generated.h"
 
 class UHouseStairsGeneratorProperty;
+namespace MBS { class FRoomOccupancyGrid; }
 class UMBSTreemap;
 class UHouseDoorGeneratorProperty;
 class UHouseEntranceGeneratorProperty;
@@ -109,6 +110,29 @@ private:
 		}
 	}
 
+	/**
+	 * Same as AddNewInteriorActorChecked, but places the actor using the room occupancy grid if it is valid.
+	 */
+	template<class T>
+	void AddNewInteriorActorChecked(T* Actor, const FInteriorLevel& InteriorLevel, const FMBSRoom& Room,
+		MBS::FRoomOccupancyGrid& Grid, const FRandomStream& Stream, TArray<T*>& InteriorActors, bool bEnableCollision) const
+	{
+		Actor->SetActorEnableCollision(bEnableCollision);
+		if (AddNewInteriorActor(Actor, InteriorLevel, Room, Grid, Stream))
+		{
+			InteriorActors.Add(Actor);
+		}
+	}
+
+	bool AddNewInteriorActor(AActor* Actor, const FInteriorLevel& InteriorLevel, const FMBSRoom& Room,
+		MBS::FRoomOccupancyGrid& Grid, const FRandomStream& Stream) const;
+
+	/**
+	 * Moves the actor to a random free place of the room occupancy grid where its footprint fits and occupies it.
+	 * @return False if there is no free place for the actor.
+	 */
+	bool PlaceInOccupancyGrid(AActor* Actor, MBS::FRoomOccupancyGrid& Grid, const FRandomStream& Stream) const;
+
 	void CreateSingleRoom(FMBSRoom& Room, const FModularLevel& CurrentLevel, int32 InFloorIndex, FBox BSBounds) const;
 	void FilterRoomBoundWalls(TArray<FTransform>& BoundWallTransforms, const FMBSRoom& Room, const FModularLevel& CurrentLevel) const;
 };
@@ -33,6 +33,11 @@ private:
 	
 	UPROPERTY(EditInstanceOnly, Category="Presets")
 	TObjectPtr<UHouseBuildSystemPresetList> PresetList;
+
+	/**
+	 * True if sections of the last loaded preset were spawned from its saved layout instead of being generated.
+	 */
+	bool bPresetLayoutApplied = false;
 	
 public:
 	virtual void SavePreset_Implementation() override;
@@ -57,6 +57,12 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category=Interior)
 	void UpdateInterior();
+
+	/**
+	 * Shows or hides all interior actors without destroying them.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Interior)
+	void SetInteriorVisibility(bool bVisible);
 	
 	UFUNCTION(BlueprintCallable, Category=Interior)
 	void ApplyInteriorPreset();
@@ -68,6 +74,7 @@ public:
 	UMBSInteriorGenerator* GetGenerator() const { return Generator; }
 
 	bool ShouldRegenerateOnBuildSystemUpdate() const { return bRegenerateOnBuildSystemUpdate; }
+	bool HasInterior() const { return !InteriorActors.IsEmpty(); }
 	TArray<FMBSRoom> GetRooms() const { return Rooms; }
 
 	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
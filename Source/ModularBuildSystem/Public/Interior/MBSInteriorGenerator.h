@@ -49,6 +49,20 @@ struct FMBSInteriorGeneratorSettings
 
 	UPROPERTY(EditAnywhere, Category=Settings)
 	FTransform InteriorAreaOffsetTransform = {};
+
+	/**
+	 * If true - props are placed at free cells of the room occupancy grid where their footprint fits, instead of
+	 * random locations that are adjusted while they overlap other props.
+	 * @see MBS::FRoomOccupancyGrid
+	 */
+	UPROPERTY(EditAnywhere, Category=Settings)
+	bool bUseOccupancyGrid = true;
+
+	/**
+	 * Size (in cm) of a single cell of the room occupancy grid.
+	 */
+	UPROPERTY(EditAnywhere, Category=Settings, meta=(ClampMin=10, EditCondition="bUseOccupancyGrid", Units="Centimeters"))
+	float OccupancyCellSize = 50.f;
 };
 
 /**
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MBS
+{
+
+/**
+ * 2D occupancy grid of a single room. Footprints of placed props are rasterized into the grid, so new props are placed
+ * only at free cells where their whole footprint fits, instead of being placed at random and tested for overlaps.
+ */
+class MODULARBUILDSYSTEM_API FRoomOccupancyGrid
+{
+	FVector Origin = FVector::ZeroVector;
+	float CellSize = 0.f;
+	FIntPoint CellCount = FIntPoint::ZeroValue;
+	TBitArray<> Occupied;
+	int32 OccupiedCount = 0;
+
+public:
+	FRoomOccupancyGrid() = default;
+
+	/**
+	 * @param InBounds Area of the room where props can be placed. Cells that don't fit into it entirely are not used.
+	 * @param InCellSize Size of a single cell along X and Y axes.
+	 */
+	FRoomOccupancyGrid(const FBox& InBounds, float InCellSize);
+
+	bool IsValid() const { return CellCount.X > 0 && CellCount.Y > 0; }
+	FIntPoint GetCellCount() const { return CellCount; }
+	float GetCellSize() const { return CellSize; }
+	int32 GetFreeCount() const { return CellCount.X * CellCount.Y - OccupiedCount; }
+	float GetFillRatio() const;
+
+	bool IsOccupied(FIntPoint Cell) const;
+
+	/**
+	 * @return Count of cells along X and Y axes that are covered by a box of the given size, at least one cell.
+	 */
+	FIntPoint GetFootprint(const FVector& Size) const;
+
+	/**
+	 * @return World bounds of the cells of a footprint, flattened at the Z location of the grid.
+	 */
+	FBox GetCellsBox(FIntPoint FirstCell, FIntPoint Footprint) const;
+
+	/**
+	 * Marks all cells overlapped by the world box as occupied.
+	 */
+	void Occupy(const FBox& Box);
+	void Occupy(FIntPoint FirstCell, FIntPoint Footprint);
+
+	/**
+	 * Picks a random placement among all placements where each cell of the footprint is free.
+	 * @param Footprint Count of cells of the footprint along X and Y axes.
+	 * @param Stream Random stream to pick the placement with.
+	 * @param OutFirstCell First cell of the picked placement.
+	 * @return False if the footprint doesn't fit anywhere.
+	 */
+	bool FindRandomPlacement(FIntPoint Footprint, const FRandomStream& Stream, FIntPoint& OutFirstCell) const;
+
+private:
+	int32 GetIndex(int32 X, int32 Y) const { return Y * CellCount.X + X; }
+};
+
+}
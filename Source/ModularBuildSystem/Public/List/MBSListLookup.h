@@ -0,0 +1,194 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectGlobals.h"
+
+class UModularSectionResolution;
+
+namespace MBS
+{
+	/**
+	 * @return Unique revision of a newly built list lookup, never 0.
+	 */
+	MODULARBUILDSYSTEM_API uint32 NextListLookupRevision();
+}
+
+/**
+ * Alias method tables of weighted random sampling. Tables are built once in linear time, and then each sample takes
+ * a single random index and a single random fraction, regardless of the count of weights.
+ */
+struct MODULARBUILDSYSTEM_API FMBSAliasTable
+{
+	/**
+	 * @param Weights Weight of each element. Negative weights are treated as zero. If all weights are zero, each
+	 * element gets the same probability.
+	 * @param OutProbabilities Probability of each index to be picked itself instead of its alias, same count as Weights.
+	 * @param OutAliases Alias of each index, same count as Weights.
+	 */
+	static void Build(TConstArrayView<float> Weights, TArrayView<float> OutProbabilities, TArrayView<int32> OutAliases);
+
+	/**
+	 * @param Index Uniformly random index of the tables.
+	 * @param Fraction Uniformly random value in [0, 1).
+	 * @return Picked index.
+	 */
+	static int32 Pick(TConstArrayView<float> Probabilities, TConstArrayView<int32> Aliases, int32 Index, float Fraction)
+	{
+		return Fraction < Probabilities[Index] ? Index : Aliases[Index];
+	}
+};
+
+/**
+ * Immutable lookup of list elements built from the resolution map of a list. Each resolution gets a dense id, and
+ * elements of all resolutions are stored in a single flat array, so an element is an array access once the id of its
+ * resolution is known. Callers that access the same resolution repeatedly should keep its id, e.g. in
+ * FMBSResolutionIdCache. Random elements are picked by their weights using alias tables of each resolution.
+ *
+ * Lookup is owned by the list, built on the game thread and used by all build systems that use the list. Each built
+ * lookup has a unique revision, so ids kept by callers are known to be outdated once the list rebuilds its lookup.
+ * @see UModularBuildSystemMeshList::GetLookup
+ */
+template<typename ElementType>
+class TMBSListLookup
+{
+	uint32 Revision = 0;
+	TArray<UModularSectionResolution*> Resolutions;
+
+	/**
+	 * Index of the first element of each resolution, resolution count + 1 values.
+	 */
+	TArray<int32> Offsets;
+	TArray<ElementType> Elements;
+
+	/**
+	 * Alias tables of each resolution, same count as Elements. Aliases are indices within the resolution.
+	 * @see FMBSAliasTable
+	 */
+	TArray<float> Probabilities;
+	TArray<int32> Aliases;
+
+public:
+	TMBSListLookup() = default;
+
+	/**
+	 * @param InElements Resolution map of the list.
+	 * @param GetArray Returns elements of a single resolution from the value of the map.
+	 * @param GetWeights Returns weights of the elements of a single resolution. Elements without a weight have
+	 * the weight of 1.
+	 */
+	template<typename MapValueType, typename GetArrayType, typename GetWeightsType>
+	TMBSListLookup(const TMap<UModularSectionResolution*, MapValueType>& InElements, GetArrayType GetArray,
+		GetWeightsType GetWeights)
+		: Revision(MBS::NextListLookupRevision())
+	{
+		Resolutions.Reserve(InElements.Num());
+		Offsets.Reserve(InElements.Num() + 1);
+		Offsets.Add(0);
+
+		TArray<float> Weights;
+		for (const auto& [Resolution, Value] : InElements)
+		{
+			Resolutions.Add(Resolution);
+			Elements.Append(GetArray(Value));
+			Offsets.Add(Elements.Num());
+
+			const int32 Count = Offsets.Last() - Offsets.Last(1);
+			const TConstArrayView<float> ElementWeights = GetWeights(Value);
+			Weights.Reset(Count);
+			for (int32 i = 0; i < Count; i++)
+			{
+				Weights.Add(ElementWeights.IsValidIndex(i) ? ElementWeights[i] : 1.f);
+			}
+
+			const int32 First = Probabilities.AddUninitialized(Count);
+			Aliases.AddUninitialized(Count);
+			FMBSAliasTable::Build(Weights, MakeArrayView(Probabilities.GetData() + First, Count),
+				MakeArrayView(Aliases.GetData() + First, Count));
+		}
+	}
+
+	uint32 GetRevision() const { return Revision; }
+	int32 GetResolutionCount() const { return Resolutions.Num(); }
+
+	/**
+	 * @return Dense id of the resolution, or INDEX_NONE if the list has no elements of the resolution. Is a scan of all
+	 * resolutions of the list, so the id should be kept when the same resolution is accessed repeatedly.
+	 */
+	int32 FindResolutionId(const UModularSectionResolution* Resolution) const
+	{
+		return Resolutions.IndexOfByKey(Resolution);
+	}
+
+	int32 Num(int32 ResolutionId) const
+	{
+		return Resolutions.IsValidIndex(ResolutionId) ? Offsets[ResolutionId + 1] - Offsets[ResolutionId] : 0;
+	}
+
+	TConstArrayView<ElementType> GetElements(int32 ResolutionId) const
+	{
+		return Resolutions.IsValidIndex(ResolutionId)
+			? MakeArrayView(Elements.GetData() + Offsets[ResolutionId], Num(ResolutionId))
+			: TConstArrayView<ElementType>();
+	}
+
+	/**
+	 * @return Element at the index of the resolution elements, or nullptr if there is no such element.
+	 */
+	const ElementType* Find(int32 ResolutionId, int32 Index) const
+	{
+		return Index >= 0 && Index < Num(ResolutionId) ? &Elements[Offsets[ResolutionId] + Index] : nullptr;
+	}
+
+	/**
+	 * @return Random element of the resolution picked by the element weights, or nullptr if the resolution has
+	 * no elements.
+	 */
+	const ElementType* FindRandom(int32 ResolutionId) const
+	{
+		const int32 Count = Num(ResolutionId);
+		if (Count <= 0)
+		{
+			return nullptr;
+		}
+		const int32 First = Offsets[ResolutionId];
+		const int32 Index = FMBSAliasTable::Pick(MakeArrayView(Probabilities.GetData() + First, Count),
+			MakeArrayView(Aliases.GetData() + First, Count), FMath::RandHelper(Count), FMath::FRand());
+		return &Elements[First + Index];
+	}
+
+	/**
+	 * Reports resolutions and elements to the garbage collector, so they stay valid even if they are removed from the
+	 * list before the lookup is rebuilt. Should be called by the list that owns the lookup.
+	 */
+	void AddReferencedObjects(FReferenceCollector& Collector)
+	{
+		Collector.AddReferencedObjects(Resolutions);
+		Collector.AddReferencedObjects(Elements);
+	}
+};
+
+/**
+ * Dense id of a resolution in a list lookup, found again only when the lookup is rebuilt or another resolution is
+ * requested.
+ */
+struct FMBSResolutionIdCache
+{
+	template<typename LookupType>
+	int32 Get(const LookupType& Lookup, const UModularSectionResolution* Resolution)
+	{
+		if (LookupRevision != Lookup.GetRevision() || CachedResolution != Resolution)
+		{
+			LookupRevision = Lookup.GetRevision();
+			CachedResolution = Resolution;
+			ResolutionId = Lookup.FindResolutionId(Resolution);
+		}
+		return ResolutionId;
+	}
+
+private:
+	uint32 LookupRevision = 0;
+	const UModularSectionResolution* CachedResolution = nullptr;
+	int32 ResolutionId = INDEX_NONE;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MBSListLookup.h"
 #include "ModularBuildSystemListBase.h"
 #include "ModularBuildSystemActorList.generated.h"
 
@@ -15,6 +16,13 @@ struct FModularBuildSystemActorListElement
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem")
 	TArray<TSubclassOf<AActor>> ActorClasses;
+
+	/**
+	 * Relative weight of the actor class at the same index when a random actor class is picked.
+	 * Actor classes without a weight have the weight of 1.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem", meta = (ClampMin = 0))
+	TArray<float> Weights;
 };
 
 /**
@@ -26,9 +34,50 @@ class MODULARBUILDSYSTEM_API UModularBuildSystemActorList : public UModularBuild
 	GENERATED_BODY()
 	
 public:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem")
+	/**
+	 * Actor classes are stored as plain classes, so they can be reported to the garbage collector.
+	 */
+	using FLookup = TMBSListLookup<UClass*>;
+
+	/**
+	 * Should be changed through SetElements at runtime, or followed by InvalidateLookup.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ModularBuildSystem")
 	TMap<UModularSectionResolution*, FModularBuildSystemActorListElement> Elements;
 
+	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
+	void SetElements(const TMap<UModularSectionResolution*, FModularBuildSystemActorListElement>& InElements);
+
 	TSubclassOf<AActor> GetActorClass(int32 AtIndex, UModularSectionResolution* Resolution) const;
+
+	/**
+	 * @return Random actor class of the resolution picked by the actor class weights, or nullptr if the resolution
+	 * has no actor classes.
+	 */
+	TSubclassOf<AActor> GetRandomActorClass(UModularSectionResolution* Resolution) const;
+
 	virtual int32 GetLength(UModularSectionResolution* Resolution) const override;
+
+	/**
+	 * @return Lookup of the Elements. Is built on the first call after the Elements were changed. Must be called on
+	 * the game thread, and the returned lookup must not be kept after the Elements are changed.
+	 */
+	const FLookup& GetLookup() const;
+
+	/**
+	 * Lookup is rebuilt automatically when the Elements are edited in the editor or set by SetElements. Should be
+	 * called after the Elements are changed directly at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
+	void InvalidateLookup();
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
+#endif
+
+private:
+	mutable TOptional<FLookup> Lookup;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MBSListLookup.h"
 #include "ModularBuildSystemListBase.h"
 #include "ModularBuildSystemMeshList.generated.h"
 
@@ -17,6 +18,13 @@ struct FModularBuildSystemMeshListElement
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem")
 	TArray<UStaticMesh*> StaticMeshes;
+
+	/**
+	 * Relative weight of the mesh at the same index when a random mesh is picked.
+	 * Meshes without a weight have the weight of 1.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem", meta = (ClampMin = 0))
+	TArray<float> Weights;
 };
 
 /**
@@ -28,9 +36,17 @@ class MODULARBUILDSYSTEM_API UModularBuildSystemMeshList : public UModularBuildS
 	GENERATED_BODY()
 
 public:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModularBuildSystem")
+	using FLookup = TMBSListLookup<UStaticMesh*>;
+
+	/**
+	 * Should be changed through SetElements at runtime, or followed by InvalidateLookup.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ModularBuildSystem")
 	TMap<UModularSectionResolution*, FModularBuildSystemMeshListElement> Elements;
 
+	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
+	void SetElements(const TMap<UModularSectionResolution*, FModularBuildSystemMeshListElement>& InElements);
+
 	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
 	int32 GetCountOfMeshesWithResolution(UModularSectionResolution* Resolution) const;
 
@@ -39,6 +55,50 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
 	UStaticMesh* GetMesh(int32 AtIndex, UModularSectionResolution* Resolution) const;
+
+	/**
+	 * @return Random mesh of the resolution picked by the mesh weights, or nullptr if the resolution has no meshes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
+	UStaticMesh* GetRandomMesh(UModularSectionResolution* Resolution) const;
+
+	/**
+	 * @return Lookup of the Elements. Is built on the first call after the Elements were changed. Must be called on
+	 * the game thread, and the returned lookup must not be kept after the Elements are changed.
+	 */
+	const FLookup& GetLookup() const;
+
+	/**
+	 * Lookup is rebuilt automatically when the Elements are edited in the editor or set by SetElements. Should be
+	 * called after the Elements are changed directly at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
+	void InvalidateLookup();
+
+	/**
+	 * Classifies all meshes of the list into buckets of the resolutions inferred from their bounds in a single pass.
+	 * @see UModularSectionResolution::GetResolutionFromMesh
+	 */
+	void ClassifyMeshes(TMap<FIntVector, TArray<UStaticMesh*>>& OutBuckets) const;
+
+	/**
+	 * Collects meshes which bounds don't match the resolution of their element.
+	 * @param Tolerance Maximum difference between the bounds and the resolution on each axis, so meshes with
+	 * slightly imprecise bounds are not reported.
+	 * @return Count of mismatched meshes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
+	int32 FindMismatchedMeshes(TArray<UStaticMesh*>& OutMeshes, float Tolerance = 1.f) const;
 	
 	virtual int32 GetLength(UModularSectionResolution* Resolution) const override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
+#endif
+
+private:
+	mutable TOptional<FLookup> Lookup;
 };
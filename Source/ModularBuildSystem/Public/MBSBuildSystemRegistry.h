@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "MBSBuildSystemRegistry.generated.h"
+
+class AModularBuildSystemActor;
+
+/**
+ * World subsystem that keeps track of all modular build system actors of a world together with aggregate counters
+ * (total, per class, merged and unmerged), so they can be queried without iterating all actors of the world.
+ *
+ * Build system actors register themselves when their components are registered and unregister when they are
+ * removed from the world. Merge state is updated by the build system actor after each merge, unmerge or reset.
+ */
+UCLASS()
+class MODULARBUILDSYSTEM_API UMBSBuildSystemRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AModularBuildSystemActor> BuildSystem;
+
+		/**
+		 * Class the build system was counted under. Is stored separately, as the class of the actor may change on reinstancing.
+		 */
+		TWeakObjectPtr<UClass> Class;
+		bool bMerged = false;
+	};
+
+	TMap<TObjectKey<AModularBuildSystemActor>, FEntry> Entries;
+	TMap<TWeakObjectPtr<UClass>, int32> CountByClass;
+	int32 MergedCount = 0;
+
+public:
+	/**
+	 * @return Registry of the InWorld, or nullptr if the world does not support it.
+	 */
+	static UMBSBuildSystemRegistry* Get(const UWorld* InWorld);
+
+	virtual void Deinitialize() override;
+
+	void Register(AModularBuildSystemActor* InBuildSystem);
+	void Unregister(AModularBuildSystemActor* InBuildSystem);
+
+	/**
+	 * Updates merged counters after InBuildSystem was merged or unmerged.
+	 */
+	void UpdateMergeState(AModularBuildSystemActor* InBuildSystem);
+
+	int32 GetTotalCount() const { return Entries.Num(); }
+	int32 GetMergedCount() const { return MergedCount; }
+	int32 GetUnmergedCount() const { return Entries.Num() - MergedCount; }
+
+	/**
+	 * @param InClass Class of build systems to count.
+	 * @return Number of registered build systems of InClass or any of its subclasses.
+	 */
+	int32 GetCountOf(TSubclassOf<AModularBuildSystemActor> InClass) const;
+
+	/**
+	 * @return All valid registered build systems.
+	 */
+	TArray<AModularBuildSystemActor*> GetBuildSystems() const;
+
+	/**
+	 * Calls InFunction for each valid registered build system. Build systems registered or unregistered
+	 * by InFunction are not affecting the iteration.
+	 */
+	void ForEachBuildSystem(TFunctionRef<void(AModularBuildSystemActor&)> InFunction) const;
+};
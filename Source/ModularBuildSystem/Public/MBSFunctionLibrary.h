@@ -32,7 +32,13 @@ public:
 
 	static void OffsetSections(const TArray<FModularSection*>& InSections, FVector Offset, bool bRelative = true);
 	static void ScaleSections(const TArray<FModularSection*>& InSections, FVector Offset, bool bRelative = true);
-	static void ForEachBuildSystem(void (*InFunction)(TActorIterator<AModularBuildSystemActor> It));
+	static void ForEachBuildSystem(TFunctionRef<void(AModularBuildSystemActor&)> InFunction);
+
+	/**
+	 * @return All build systems of the World. Uses the world build system registry when it is available.
+	 * @see UMBSBuildSystemRegistry
+	 */
+	static TArray<AModularBuildSystemActor*> GetAllBuildSystems(const UWorld* World);
 
 	static void ForEachLevel(const TArray<FModularLevel*>& InLevels, TFunction<void(FModularLevel&)> InFunction);
 	static void ForEachLevel(const TArray<FModularLevel*>& InLevels, TFunction<void(const FModularSectionInitializer&)> InFunction);
@@ -99,6 +105,25 @@ public:
 	static FTransform CalculateNewTransform(AModularBuildSystemActor* BuildSystem, const FModularBuildStats& BuildStats,
 		int32 InIndex, const FTransform& ActorTransform, const FInitModularSectionsArgs& Args, bool& bOutShouldBeSkipped);
 
+	/**
+	 * Calculates transforms of all modular sections of a level before their shape adjustment, so native transform
+	 * solvers are called only once per level.
+	 * @param BuildStats
+	 * @param ActorTransform Modular build system actor transform.
+	 * @param Args Initialization arguments.
+	 * @param OutTransforms Transform for each index of a modular section of the level.
+	 * @see ShapeNewTransform
+	 */
+	static void CalculateNewTransforms(const FModularBuildStats& BuildStats, const FTransform& ActorTransform,
+		const FInitModularSectionsArgs& Args, TArray<FTransform>& OutTransforms);
+
+	/**
+	 * Adjusts transform calculated with CalculateNewTransforms depending on the shape of a level, if provided.
+	 * @param bOutShouldBeSkipped If true - then this modular section initialization should be skipped.
+	 */
+	static void ShapeNewTransform(AModularBuildSystemActor* BuildSystem, const FModularBuildStats& BuildStats,
+		int32 InIndex, const FInitModularSectionsArgs& Args, FTransform& InOutTransform, bool& bOutShouldBeSkipped);
+
 	/**
  	 * Returns box bounds of a modular level interior.
  	 * @param BuildSystem
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EMBSGenerationStepResult : uint8
+{
+	/**
+	 * Step is done, next step can be executed.
+	 */
+	Finished,
+
+	/**
+	 * Step has more work to do (next level, for example) and should be executed again.
+	 */
+	Pending,
+
+	/**
+	 * Generation can't be continued. Remaining steps are skipped.
+	 */
+	Failed
+};
+
+/**
+ * Single named step of the resumable generation.
+ */
+struct FMBSGenerationStep
+{
+	FName Name;
+	TFunction<EMBSGenerationStepResult()> Function;
+};
+
+/**
+ * Ordered list of generation steps that can be executed either at once, or in parts under a time budget, so
+ * generation of a single building can be spread over multiple frames.
+ *
+ * Steps are executed in order they were added. Pending step (for example, the one that initializes a single level of
+ * the multiple levels on each execution) is executed again until it is finished. Steps must not add new steps to the
+ * list they are executed from.
+ *
+ * @see UModularBuildSystemGenerator::BeginTimeSlicedGeneration
+ */
+struct MODULARBUILDSYSTEM_API FMBSGenerationSteps
+{
+	/**
+	 * Adds step that is done in a single execution.
+	 */
+	void Add(const FName& InName, TFunction<void()> InFunction);
+
+	/**
+	 * Adds step that can be executed multiple times or fail.
+	 */
+	void AddResumable(const FName& InName, TFunction<EMBSGenerationStepResult()> InFunction);
+
+	/**
+	 * Executes steps until all of them are finished or the time budget is spent. At least one step execution is done
+	 * on each call.
+	 * @param InBudgetSeconds Time budget. Zero or less executes all remaining steps.
+	 * @return True if there are no steps left (either all are finished, or one of them has failed).
+	 */
+	bool Advance(double InBudgetSeconds);
+
+	/**
+	 * Executes all remaining steps.
+	 * @return False if one of the steps has failed.
+	 */
+	bool RunToCompletion();
+
+	void Reset();
+
+	bool IsDone() const { return bFailed || CurrentIndex >= Steps.Num(); }
+	bool HasFailed() const { return bFailed; }
+	int32 Num() const { return Steps.Num(); }
+	int32 GetCurrentIndex() const { return CurrentIndex; }
+	FName GetCurrentStepName() const { return Steps.IsValidIndex(CurrentIndex) ? Steps[CurrentIndex].Name : NAME_None; }
+
+private:
+	TArray<FMBSGenerationStep> Steps;
+	int32 CurrentIndex = 0;
+	bool bFailed = false;
+};
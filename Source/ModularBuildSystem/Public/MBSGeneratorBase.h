@@ -6,6 +6,7 @@
 #include "UObject/NoExportTypes.h"
 #include "ModularSection.h"
 #include "ModularSectionResolution.h"
+#include "List/MBSListLookup.h"
 #include "MBSGeneratorBase.generated.h"
 
 class IModularBuildSystemInterface;
@@ -40,6 +41,13 @@ struct FMBSGeneratorPropertyData
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Generator")
 	TObjectPtr<UModularSectionResolution> Resolution = nullptr;
 
+	/**
+	 * Pick a random element of the list by the element weights even when an element at a specific index is requested.
+	 * Lets properties that always use the same element (e.g. stairs or windows) vary their meshes and actors.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Generator")
+	bool bAlwaysPickRandom = false;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Instanced, Category = "Generator")
 	TObjectPtr<UMBSIndexCalculation> IndexCalculation = nullptr;
 
@@ -67,7 +75,7 @@ struct FMBSGeneratorPropertyData
 	UStaticMesh* GetMesh(int32 AtIndex, UModularSectionResolution* OverrideResolution = nullptr) const;
 
 	/**
-	 * @brief Gets static mesh of certain resolution from mesh list at random index.
+	 * @brief Gets static mesh of certain resolution from mesh list at random index, picked by the mesh weights.
 	 * @param OverrideResolution (Optional) Custom modular section resolution.
 	 * @return Random static mesh from mesh list.
 	 */
@@ -82,7 +90,7 @@ struct FMBSGeneratorPropertyData
 	TSubclassOf<AActor> GetActorClass(int32 AtIndex, UModularSectionResolution* OverrideResolution = nullptr) const;
 	
 	/**
-	 * @brief Gets actor class of certain resolution from actor list at random index. 
+	 * @brief Gets actor class of certain resolution from actor list at random index, picked by the actor class weights.
 	 * @param OverrideResolution (Optional) Custom modular section resolution. 
 	 * @return Random actor class from actor list. 
 	 */
@@ -92,6 +100,13 @@ struct FMBSGeneratorPropertyData
 
 	// TODO: Add IsSet method returning bool, that validates if all necessary data of this structure is set
 	bool IsSet() const;
+
+private:
+	/**
+	 * Ids of the last used resolution in the list lookups, so the resolution is not searched for each section.
+	 */
+	mutable FMBSResolutionIdCache MeshResolutionId;
+	mutable FMBSResolutionIdCache ActorResolutionId;
 };
 
 /**
@@ -10,6 +10,38 @@
 namespace MBS
 {
 
+/**
+ * Grid cell index packed into a single integer, 21 bits per axis. Keys are ordered by Z, then by Y, then by X index.
+ */
+struct MODULARBUILDSYSTEM_API FGridCellKey
+{
+	static constexpr int32 BitsPerAxis = 21;
+	static constexpr int32 MinIndex = -(1 << (BitsPerAxis - 1));
+	static constexpr int32 MaxIndex = (1 << (BitsPerAxis - 1)) - 1;
+
+	FGridCellKey() = default;
+	FGridCellKey(int32 X, int32 Y, int32 Z);
+	explicit FGridCellKey(const FIntVector& XYZ) : FGridCellKey(XYZ.X, XYZ.Y, XYZ.Z) {}
+
+	int32 GetX() const { return Unpack(0); }
+	int32 GetY() const { return Unpack(BitsPerAxis); }
+	int32 GetZ() const { return Unpack(BitsPerAxis * 2); }
+	FIntVector GetIndexXYZ() const { return FIntVector(GetX(), GetY(), GetZ()); }
+	uint64 GetPacked() const { return Packed; }
+
+	bool operator==(const FGridCellKey& Other) const { return Packed == Other.Packed; }
+	bool operator!=(const FGridCellKey& Other) const { return Packed != Other.Packed; }
+	bool operator<(const FGridCellKey& Other) const { return Packed < Other.Packed; }
+
+	friend uint32 GetTypeHash(const FGridCellKey& Key) { return GetTypeHash(Key.Packed); }
+
+private:
+	static constexpr uint64 AxisMask = (1ull << BitsPerAxis) - 1;
+	uint64 Packed = 0;
+
+	int32 Unpack(int32 Shift) const { return static_cast<int32>((Packed >> Shift) & AxisMask) + MinIndex; }
+};
+
 class MODULARBUILDSYSTEM_API FGridCellBase
 {
 protected:
@@ -39,7 +71,12 @@ public:
 	float GetSizeZ() const;
 
 	FBox GetBounds() const { return Bounds; }
-	
+
+	FGridCellKey GetKey() const { return FGridCellKey(GetIndexXYZ()); }
+
+	/**
+	 * @return Index of this cell as a string. Is used for display only, cells are identified by GetKey.
+	 */
 	FString GetCode() const
 	{
 		const FIntVector XYZ = GetIndexXYZ();
@@ -64,6 +101,7 @@ public:
 	int32 SecY(float V) const;
 	int32 SecZ(float V) const;
 	static int32 Sec(float V, const float InMultiplierComponent);
+	static int32 SecRounded(float V, const float InMultiplierComponent);
 
 protected:
 	FVector Relative(const FVector V) const;
@@ -107,6 +145,11 @@ public:
 	FGridCell3D(const FVector V, const FTransform& RelativeTo, const FVector InMultiplier, bool bFlatten = false);
 	
 	virtual FIntVector GetIndexXYZ() const override;
+
+	/**
+	 * @return Key of the cell that would be constructed at the V location, without constructing it.
+	 */
+	static FGridCellKey GetKeyAt(const FVector V, const FTransform& RelativeTo, const FVector InMultiplier = FVector::OneVector);
 };
 
 class MODULARBUILDSYSTEM_API FGridMultiCell2D
@@ -114,7 +157,7 @@ class MODULARBUILDSYSTEM_API FGridMultiCell2D
 	TArray<FBox> BoundsBoxes;
 	
 public:
-	FGridMultiCell2D(TArray<FGridCell2D> GridCells);
+	FGridMultiCell2D(TConstArrayView<FGridCell2D> GridCells);
 	FGridMultiCell2D(const FBox& Bounds);
 	FGridMultiCell2D(const FBox& Bounds, const FTransform& RelativeTo);
 };
@@ -124,7 +167,7 @@ class MODULARBUILDSYSTEM_API FGridMultiCell3D
 	TArray<FBox> BoundsBoxes;
 	
 public:
-	FGridMultiCell3D(TArray<FGridCell3D> GridCells);
+	FGridMultiCell3D(TConstArrayView<FGridCell3D> GridCells);
 	FGridMultiCell3D(const FBox& Bounds);
 	FGridMultiCell3D(const FBox& Bounds, const FTransform& RelativeTo);
 };
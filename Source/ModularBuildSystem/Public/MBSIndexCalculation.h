@@ -9,6 +9,50 @@
 
 class AModularBuildSystemActor;
 
+/**
+ * Occupied section indices of a single level, stored as one bit per section. Free index is found in a single pass
+ * over the bits, so it is always found if there is any.
+ */
+struct MODULARBUILDSYSTEM_API FMBSOccupiedIndices
+{
+	explicit FMBSOccupiedIndices(int32 InCount);
+
+	/**
+	 * @param InCount Count of sections of the level.
+	 * @param InIndices Occupied indices. Indices outside of the level are ignored.
+	 */
+	FMBSOccupiedIndices(int32 InCount, TConstArrayView<int32> InIndices);
+
+	bool IsOccupied(int32 Index) const { return Bits.IsValidIndex(Index) && Bits[Index]; }
+	void Occupy(int32 Index);
+	void Free(int32 Index);
+
+	/**
+	 * @return First free index starting from the Index, wrapping around the end of the level. INDEX_NONE if all
+	 * indices are occupied.
+	 */
+	int32 FindNextFree(int32 Index) const;
+
+	/**
+	 * @return Uniformly picked free index. INDEX_NONE if all indices are occupied.
+	 */
+	int32 PickRandomFree(const FRandomStream& Stream) const;
+
+	/**
+	 * Same as above, but uses the global random generator, so can only be called on the game thread.
+	 */
+	int32 PickRandomFree() const;
+
+	int32 Num() const { return Bits.Num(); }
+	int32 GetFreeCount() const { return Bits.Num() - OccupiedCount; }
+
+private:
+	int32 PickFree(int32 FreeIndex) const;
+	
+	TBitArray<> Bits;
+	int32 OccupiedCount = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FMBSIndexCalculationArgs
 {
@@ -16,18 +60,37 @@ struct FMBSIndexCalculationArgs
 
 	FMBSIndexCalculationArgs() {};
 	FMBSIndexCalculationArgs(AModularBuildSystemActor* BuildSystem, int32 AtIndex, TArray<int32>* OccupiedIndices,
-		const FModularSectionInitializer* Initializer)
+		const FModularSectionInitializer* Initializer, const FRandomStream* RandomStream = nullptr,
+		const FMBSOccupiedIndices* Occupied = nullptr)
 		: BuildSystem(BuildSystem)
 		, AtIndex(AtIndex)
 		, OccupiedIndices(OccupiedIndices)
-		, Initializer(Initializer) {};
+		, Initializer(Initializer)
+		, RandomStream(RandomStream)
+		, Occupied(Occupied) {};
 	
+	/**
+	 * Build system the index is calculated for. Is null if the index is calculated outside of the game thread.
+	 */
 	TObjectPtr<AModularBuildSystemActor> BuildSystem = nullptr;
 	int32 AtIndex = 0;
 	TArray<int32>* OccupiedIndices = nullptr;
 	const FModularSectionInitializer* Initializer = nullptr;
+
+	/**
+	 * Stream of the seeded layout the index is calculated for. Native calculations must use it instead of the global
+	 * random generator, as they may be called outside of the game thread.
+	 */
+	const FRandomStream* RandomStream = nullptr;
+
+	/**
+	 * Same indices as OccupiedIndices, kept by the caller for the whole generation pass of the level. Native
+	 * calculations use it instead of building a new bitset for each index.
+	 */
+	const FMBSOccupiedIndices* Occupied = nullptr;
 };
 
+
 /**
  * Base class for all objects handling custom index calculation in MBS plugin.
  */
@@ -36,9 +99,6 @@ class MODULARBUILDSYSTEM_API UMBSIndexCalculation : public UObject
 {
 	GENERATED_BODY()
 
-	UPROPERTY(EditAnywhere, Category=MBS)
-	int32 MaxAdjustIterationCount = 10;
-	
 public:
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category=MBS)
 	int32 CalculateSingle(const FMBSIndexCalculationArgs& Args);
@@ -48,13 +108,64 @@ public:
 		return 0;
 	}
 
+	/**
+	 * Calculates single index with InCalculation, or returns InDefault if it is not set.
+	 * Can be called from any thread if InCalculation is thread safe.
+	 * @see IsThreadSafe
+	 */
+	static int32 CalculateSingleOrDefault(UMBSIndexCalculation* InCalculation, const FMBSIndexCalculationArgs& Args,
+		int32 InDefault);
+
+	/**
+	 * @return True if InCalculation can be used outside of the game thread - it is either not set or implemented
+	 * natively, as Blueprint implementations can only be executed on the game thread.
+	 */
+	static bool IsThreadSafe(const UMBSIndexCalculation* InCalculation);
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category=MBS, meta=(NativeBreakFunc))
 	static void BreakIndexCalculationArgs(const FMBSIndexCalculationArgs& InArgs, AModularBuildSystemActor*& BuildSystem,
 		int32& Index, FModularSectionInitializer& Initializer, TArray<int32>& OccupiedIndices);
 
-protected:	
+protected:
+	/**
+	 * Moves Index to the next free index (wrapping around TotalCount) if it is occupied.
+	 * @return Adjusted index. Is not changed only if all indices are occupied.
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category=MBS)
 	int32 AdjustIndexIfPossible(UPARAM(ref) int32& Index, int32 TotalCount, const TArray<int32>& OccupiedIndices);
 	virtual int32 AdjustIndexIfPossible_Implementation(UPARAM(ref) int32& Index, int32 TotalCount,
 		const TArray<int32>& OccupiedIndices);
+
+	/**
+	 * Same as above for native calculations. Uses the occupied indices of the arguments.
+	 */
+	int32 AdjustIndexIfPossible(const FMBSIndexCalculationArgs& Args, int32& Index, int32 TotalCount) const;
+
+	/**
+	 * @return Uniformly picked index in range [0, TotalCount) that is not occupied, or -1 if all indices are occupied.
+	 */
+	UFUNCTION(BlueprintCallable, Category=MBS)
+	int32 GetRandomFreeIndex(int32 TotalCount, const TArray<int32>& OccupiedIndices) const;
+
+	/**
+	 * Same as above for native calculations. Picks with the random stream of the arguments if it is set.
+	 */
+	static int32 GetRandomFreeIndex(const FMBSIndexCalculationArgs& Args, int32 TotalCount);
+
+private:
+	int32 AdjustIndex(int32& Index, const FMBSOccupiedIndices& Occupied) const;
+
+	/**
+	 * Calls InFunction with the occupied indices of the Args, which are only built if the caller doesn't keep them.
+	 */
+	template<typename FunctionType>
+	static int32 WithOccupied(const FMBSIndexCalculationArgs& Args, int32 TotalCount, FunctionType&& InFunction)
+	{
+		if (Args.Occupied && Args.Occupied->Num() == TotalCount)
+		{
+			return InFunction(*Args.Occupied);
+		}
+		return InFunction(FMBSOccupiedIndices(TotalCount,
+			Args.OccupiedIndices ? TConstArrayView<int32>(*Args.OccupiedIndices) : TConstArrayView<int32>()));
+	}
 };
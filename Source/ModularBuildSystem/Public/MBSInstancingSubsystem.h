@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "MBSInstancingSubsystem.generated.h"
+
+class AModularBuildSystemActor;
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+struct FMBSSections;
+
+/**
+ * Handle of all instances that a single owner (usually a modular build system actor) has registered in the
+ * shared instancing subsystem.
+ */
+USTRUCT(BlueprintType)
+struct MODULARBUILDSYSTEM_API FMBSSharedInstancesHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleInstanceOnly, Category = "ModularBuildSystem")
+	int32 Id = INDEX_NONE;
+
+	bool IsValid() const { return Id != INDEX_NONE; }
+	void Invalidate() { Id = INDEX_NONE; }
+};
+
+/**
+ * Key of a single shared instances chunk. Instances are grouped by mesh, material and by the world cell they are placed in.
+ */
+struct FMBSSharedInstancesChunkKey
+{
+	TObjectKey<UStaticMesh> Mesh;
+	TObjectKey<UMaterialInterface> Material;
+	FIntPoint Cell = FIntPoint::ZeroValue;
+
+	bool operator==(const FMBSSharedInstancesChunkKey& Other) const
+	{
+		return Mesh == Other.Mesh && Material == Other.Material && Cell == Other.Cell;
+	}
+
+	friend uint32 GetTypeHash(const FMBSSharedInstancesChunkKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.Material)), GetTypeHash(Key.Cell));
+	}
+};
+
+/**
+ * Single spatial chunk of shared instances, rendered by one hierarchical instanced static mesh component.
+ */
+struct FMBSSharedInstancesChunk
+{
+	TWeakObjectPtr<UHierarchicalInstancedStaticMeshComponent> Component;
+	TWeakObjectPtr<UStaticMesh> Mesh;
+	TWeakObjectPtr<UMaterialInterface> Material;
+
+	/**
+	 * World space instance transforms of each handle that has instances in this chunk.
+	 */
+	TMap<int32, TArray<FTransform>> InstancesByHandle;
+
+	/**
+	 * Handle and instance count of each contiguous range of instances in the component, in the order of ranges.
+	 * Is used to update only the ranges that were changed instead of rebuilding the whole component.
+	 */
+	TArray<TPair<int32, int32>> ComponentRanges;
+
+	/**
+	 * Handles whose instances were changed since last flush.
+	 */
+	TSet<int32> DirtyHandles;
+};
+
+/**
+ * Opt-in world subsystem that renders instanced sections of many build systems with a shared set of spatially chunked
+ * hierarchical instanced static mesh components, keyed by mesh and material. That way many buildings using the same
+ * mesh (windows, for example) are drawn by a few components instead of one component per building.
+ *
+ * Each owner gets a handle it can use to replace or remove its own instances. Changes are collected and applied in
+ * a single batch per chunk on the next tick (or on explicit Flush call).
+ *
+ * @see FMBSMeshConfiguration::bUseWorldSharedInstancing
+ */
+UCLASS()
+class MODULARBUILDSYSTEM_API UMBSInstancingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/**
+	 * Transient actor that owns all shared chunk components.
+	 */
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> HostActor = nullptr;
+
+	TMap<FMBSSharedInstancesChunkKey, FMBSSharedInstancesChunk> Chunks;
+
+	/**
+	 * Chunks each handle has instances in. Is used to remove or replace instances of a handle without iterating all chunks.
+	 */
+	TMap<int32, TSet<FMBSSharedInstancesChunkKey>> ChunksByHandle;
+
+	int32 NextHandleId = 0;
+
+	/**
+	 * Size (in cm) of a single chunk cell on the XY plane.
+	 */
+	float ChunkSize = 25000.f;
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Creates new empty handle.
+	 * @return Handle that should be used to set or remove instances of a single owner.
+	 */
+	FMBSSharedInstancesHandle CreateHandle();
+
+	/**
+	 * Replaces all instances of the InHandle that use InMesh and InMaterial with InWorldTransforms.
+	 * @param InHandle Handle of the instances owner.
+	 * @param InMesh Static mesh of instances.
+	 * @param InMaterial Material of instances. Can be nullptr to use the default material of InMesh.
+	 * @param InWorldTransforms World space transforms of new instances.
+	 */
+	void SetInstances(const FMBSSharedInstancesHandle& InHandle, UStaticMesh* InMesh, UMaterialInterface* InMaterial,
+		const TArray<FTransform>& InWorldTransforms);
+
+	/**
+	 * Replaces all instances of the InHandle with instances of all instanced sections of InSections.
+	 * @param InHandle Handle of the instances owner.
+	 * @param InSections Sections of a build system. Only instanced sections are registered.
+	 */
+	void SetInstancesFromSections(const FMBSSharedInstancesHandle& InHandle, const FMBSSections& InSections);
+
+	/**
+	 * Removes all instances of the InHandle. Handle is still valid after this call.
+	 */
+	void RemoveInstances(const FMBSSharedInstancesHandle& InHandle);
+
+	/**
+	 * Removes all instances of the InOutHandle and invalidates it.
+	 */
+	void ReleaseHandle(FMBSSharedInstancesHandle& InOutHandle);
+
+	/**
+	 * Rebuilds all chunks that were changed since last flush.
+	 */
+	void Flush();
+
+	int32 GetChunkCount() const { return Chunks.Num(); }
+	int32 GetInstanceCount() const;
+
+	/**
+	 * Finds chunk that instances of InMesh and InMaterial placed at InLocation belong to.
+	 * @return Chunk or nullptr if there are no such instances.
+	 */
+	const FMBSSharedInstancesChunk* FindChunk(UStaticMesh* InMesh, UMaterialInterface* InMaterial, const FVector& InLocation) const;
+
+private:
+	FMBSSharedInstancesChunkKey MakeChunkKey(UStaticMesh* InMesh, UMaterialInterface* InMaterial, const FVector& InLocation) const;
+	void RemoveInstancesOfMesh(int32 InHandleId, UStaticMesh* InMesh, UMaterialInterface* InMaterial);
+	void RebuildChunk(FMBSSharedInstancesChunk& InChunk);
+	UHierarchicalInstancedStaticMeshComponent* CreateChunkComponent(const FMBSSharedInstancesChunk& InChunk);
+	AActor* GetOrSpawnHostActor();
+};
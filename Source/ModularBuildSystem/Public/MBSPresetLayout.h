@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModularBuildStats.h"
+#include "MBSPresetLayout.generated.h"
+
+class UStaticMesh;
+
+/**
+ * Instances of a single instanced modular level stored in a preset.
+ */
+USTRUCT()
+struct MODULARBUILDSYSTEM_API FMBSPresetInstancedLevel
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	int32 LevelId = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	TObjectPtr<UStaticMesh> Mesh;
+
+	/**
+	 * Transforms of instances in the local space of the instanced static mesh component.
+	 */
+	UPROPERTY()
+	TArray<FTransform> Transforms;
+};
+
+/**
+ * Compact snapshot of the sections of a generated build system, so a preset can be applied by spawning the sections
+ * directly instead of running the generator again.
+ *
+ * Static and actor sections are stored as separate arrays of level ids, transforms (relative to the build system actor)
+ * and indices of unique meshes or actor classes, mirroring FMBSSectionsLayout.
+ *
+ * @see AModularBuildSystemActor::CapturePresetLayout
+ * @see AModularBuildSystemActor::ApplyPresetLayout
+ */
+USTRUCT()
+struct MODULARBUILDSYSTEM_API FMBSPresetLayout
+{
+	GENERATED_BODY()
+
+	/**
+	 * Unique static meshes referenced by StaticMeshIds.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	TArray<TObjectPtr<UStaticMesh>> Meshes;
+
+	UPROPERTY()
+	TArray<int32> StaticMeshIds;
+
+	UPROPERTY()
+	TArray<int32> StaticLevelIds;
+
+	UPROPERTY()
+	TArray<FTransform> StaticTransforms;
+
+	/**
+	 * Unique actor classes referenced by ActorClassIds.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	TArray<TSubclassOf<AActor>> ActorClasses;
+
+	UPROPERTY()
+	TArray<int32> ActorClassIds;
+
+	UPROPERTY()
+	TArray<int32> ActorLevelIds;
+
+	UPROPERTY()
+	TArray<FTransform> ActorTransforms;
+
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	TArray<FMBSPresetInstancedLevel> Instanced;
+
+	/**
+	 * Build stats of the build system at the moment the layout was captured, as they are not collected when sections
+	 * are spawned from the layout.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	FModularBuildStats BuildStats;
+
+	void Reset();
+	bool IsEmpty() const;
+
+	/**
+	 * @return True if arrays of all entries have matching counts and all referenced meshes and actor classes can be
+	 * resolved, e.g. none of them was deleted since the layout was captured.
+	 */
+	bool IsValid() const;
+
+	void AddStatic(UStaticMesh* InMesh, int32 InLevelId, const FTransform& InTransform);
+	void AddActor(TSubclassOf<AActor> InClass, int32 InLevelId, const FTransform& InTransform);
+};
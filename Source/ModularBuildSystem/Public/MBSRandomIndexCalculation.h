@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MBSIndexCalculation.h"
+#include "MBSRandomIndexCalculation.generated.h"
+
+/**
+ * Picks a random free index of the level. Is implemented natively, so the house layout that uses it can be computed
+ * outside of the game thread.
+ */
+UCLASS(DisplayName="Random Free Index")
+class MODULARBUILDSYSTEM_API UMBSRandomIndexCalculation final : public UMBSIndexCalculation
+{
+	GENERATED_BODY()
+
+public:
+	virtual int32 CalculateSingle_Implementation(const FMBSIndexCalculationArgs& Args) override;
+};
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MBSRegenerationScheduler.generated.h"
+
+class AModularBuildSystemActor;
+
+/**
+ * Kind of the work that should be done after build system properties were edited.
+ * Values are ordered by their cost, so a more expensive pending request always supersedes a cheaper one.
+ */
+UENUM(BlueprintType)
+enum class EMBSRegenerationType : uint8
+{
+	None,
+
+	/**
+	 * Cheap update of existing sections (transforms only) while a property is still being dragged.
+	 */
+	Preview,
+
+	/**
+	 * Full regeneration after the property change was finalized.
+	 */
+	Full,
+};
+
+/**
+ * Regeneration request of a single build system that is waiting to be processed.
+ */
+struct FMBSPendingRegeneration
+{
+	TWeakObjectPtr<AModularBuildSystemActor> BuildSystem;
+	EMBSRegenerationType Type = EMBSRegenerationType::None;
+};
+
+/**
+ * World subsystem that coalesces regeneration requests produced by property edits of build systems.
+ *
+ * Interactive edits (dragging a slider) only request a preview, and any number of requests made for the same build
+ * system before the next tick are merged into one. Requests are processed on tick, oldest first, until the frame
+ * budget from UMBSSettings is spent, so editing many build systems at once does not stall the editor. At least one
+ * request is processed on each tick.
+ *
+ * Time-sliced generations of build systems are advanced on tick as well, oldest first, under their own budget.
+ *
+ * @see AModularBuildSystemActor::RequestRegeneration
+ * @see AModularBuildSystemActor::GenerateTimeSliced
+ */
+UCLASS()
+class MODULARBUILDSYSTEM_API UMBSRegenerationScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	TArray<FMBSPendingRegeneration> Pending;
+	TArray<TWeakObjectPtr<AModularBuildSystemActor>> TimeSliced;
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+	static UMBSRegenerationScheduler* Get(const UWorld* World);
+
+	/**
+	 * Adds regeneration request of the build system, or merges it into the already pending one.
+	 * @param InBuildSystem Build system that should be regenerated.
+	 * @param InType Requested work. Pending full regeneration is never downgraded to preview.
+	 */
+	void Schedule(AModularBuildSystemActor* InBuildSystem, EMBSRegenerationType InType);
+
+	/**
+	 * Removes pending request of the build system, if any.
+	 */
+	void Cancel(const AModularBuildSystemActor* InBuildSystem);
+
+	/**
+	 * Processes pending requests until the time budget is spent.
+	 * @param InBudgetSeconds Time budget. Zero or less processes all pending requests.
+	 * @return Number of processed requests.
+	 */
+	int32 Flush(double InBudgetSeconds = 0.0);
+
+	EMBSRegenerationType GetPendingType(const AModularBuildSystemActor* InBuildSystem) const;
+	int32 GetPendingCount() const { return Pending.Num(); }
+
+	/**
+	 * Adds build system with an active time-sliced generation, so it is advanced on each tick until it ends.
+	 */
+	void StartTimeSliced(AModularBuildSystemActor* InBuildSystem);
+
+	/**
+	 * Removes build system from time-sliced generations. Is called by the build system once its generation has ended.
+	 */
+	void StopTimeSliced(const AModularBuildSystemActor* InBuildSystem);
+
+	/**
+	 * Advances time-sliced generations until the time budget is spent.
+	 * @param InBudgetSeconds Time budget. Zero or less completes all time-sliced generations.
+	 * @return Number of completed generations.
+	 */
+	int32 AdvanceTimeSliced(double InBudgetSeconds = 0.0);
+
+	bool IsTimeSliced(const AModularBuildSystemActor* InBuildSystem) const;
+	int32 GetTimeSlicedCount() const { return TimeSliced.Num(); }
+};
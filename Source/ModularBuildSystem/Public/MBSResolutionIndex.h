@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModularSectionResolution.h"
+
+struct FAssetData;
+
+/**
+ * Single modular section resolution asset of the resolution index.
+ */
+struct MODULARBUILDSYSTEM_API FMBSResolutionIndexEntry
+{
+	FSoftObjectPath Path;
+	FIntVector Value = FIntVector::ZeroValue;
+	EModularSectionResolutionSnapMode SnapMode = EModularSectionResolutionSnapMode::Default;
+};
+
+/**
+ * Index of modular section resolution assets built from their asset registry tags, so resolutions can be found by
+ * their value without loading any of them.
+ *
+ * Entries are sorted by the X value, so the nearest resolution is found by searching only entries which X value is
+ * closer than the nearest resolution found so far.
+ */
+class MODULARBUILDSYSTEM_API FMBSResolutionIndex
+{
+	TArray<FMBSResolutionIndexEntry> Entries;
+
+public:
+	/**
+	 * Adds all resolution assets found in the section resolution directories.
+	 * Assets saved without the resolution tags are loaded to read their values.
+	 * @see MBS::FPaths::GetSectionResolutionDirectories
+	 */
+	void Build();
+	void Reset() { Entries.Reset(); }
+
+	/**
+	 * Adds a resolution asset using its resolution tags.
+	 * @return False if the asset is not a resolution or has no resolution tags.
+	 */
+	bool Add(const FAssetData& AssetData);
+	void Add(const FMBSResolutionIndexEntry& Entry);
+
+	bool IsEmpty() const { return Entries.IsEmpty(); }
+	int32 Num() const { return Entries.Num(); }
+	const FMBSResolutionIndexEntry& operator[](int32 Index) const { return Entries[Index]; }
+
+	/**
+	 * Finds the resolution which value is the nearest to the size. Resolutions with the same distance are ordered by
+	 * their asset path, so the same resolution is always found.
+	 * @param Size Size to find the resolution for, e.g. size of the static mesh bounds.
+	 * @param MaxDistance Max distance between the size and the resolution value. Not limited if zero or less.
+	 * @param SnapMode Snap mode the resolution must have. Any snap mode if not set.
+	 * @return Index of the nearest entry or INDEX_NONE if there is no resolution close enough.
+	 */
+	int32 FindNearest(const FVector& Size, float MaxDistance = 0.f,
+		TOptional<EModularSectionResolutionSnapMode> SnapMode = {}) const;
+
+	/**
+	 * Parses the resolution value from the exported text of its asset registry tag, e.g. "(X=400,Y=400,Z=400)".
+	 */
+	static bool ParseValueTag(const FString& TagValue, FIntVector& OutValue);
+	static bool ParseSnapModeTag(const FString& TagValue, EModularSectionResolutionSnapMode& OutSnapMode);
+};
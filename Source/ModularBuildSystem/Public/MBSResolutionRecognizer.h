@@ -3,13 +3,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MBSResolutionIndex.h"
 #include "UObject/NoExportTypes.h"
 #include "MBSResolutionRecognizer.generated.h"
 
 class UModularSectionResolution;
+class UStaticMesh;
 
 /**
- * 
+ * Recognizes modular section resolutions of static meshes by their bounds. Resolutions are found using the index of
+ * their asset registry tags, so only recognized resolutions are loaded.
  */
 UCLASS()
 class MODULARBUILDSYSTEM_API UMBSResolutionRecognizer : public UObject
@@ -18,8 +21,55 @@ class MODULARBUILDSYSTEM_API UMBSResolutionRecognizer : public UObject
 
 	UPROPERTY(EditAnywhere, Category=MBS)
 	bool bReturnUndefinedIfNotRecognized = false;
-	
+
+	/**
+	 * Max distance between the mesh bounds size and the resolution value for the resolution to be recognized.
+	 * The nearest resolution is recognized regardless of the distance if zero.
+	 */
+	UPROPERTY(EditAnywhere, Category=MBS, meta=(ClampMin=0, Units=cm))
+	float MaxDistance = 1.f;
+
+	/**
+	 * Recognize only resolutions with the SnapMode.
+	 */
+	UPROPERTY(EditAnywhere, Category=MBS)
+	bool bFilterBySnapMode = false;
+
+	UPROPERTY(EditAnywhere, Category=MBS, meta=(EditCondition=bFilterBySnapMode))
+	EModularSectionResolutionSnapMode SnapMode = EModularSectionResolutionSnapMode::Default;
+
+	FMBSResolutionIndex Index;
+	bool bIndexOutdated = true;
+
 public:
+	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+
 	UFUNCTION(BlueprintCallable, Category=MBS)
 	UModularSectionResolution* RecognizeFromSelection();
+
+	/**
+	 * Recognizes resolutions of all meshes at once. Each recognized resolution is loaded only once.
+	 * @param Meshes Meshes to recognize resolutions of.
+	 * @param OutResolutions Resolution of each mesh, nullptr if the mesh is not recognized.
+	 */
+	UFUNCTION(BlueprintCallable, Category=MBS)
+	void RecognizeMeshes(const TArray<UStaticMesh*>& Meshes, TArray<UModularSectionResolution*>& OutResolutions);
+
+	/**
+	 * @return Index of the recognized entry of the resolution index, or INDEX_NONE.
+	 */
+	int32 Recognize(const UStaticMesh* Mesh);
+
+	/**
+	 * Builds the resolution index again. Is called automatically when resolution assets are added, removed or renamed.
+	 */
+	UFUNCTION(BlueprintCallable, Category=MBS)
+	void RebuildIndex();
+
+	const FMBSResolutionIndex& GetIndex();
+
+private:
+	void OnAssetChanged(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
 };
@@ -3,12 +3,50 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MBSSectionsLayout.h"
 #include "ModularBuildSystemInterface.h"
 #include "ModularSection.h"
 #include "MBSSections.generated.h"
 
 class AModularBuildSystemActor;
 
+/**
+ * Change made to a shell section by the details of a generation tier. Is kept to show the shell without the details.
+ * @see FMBSSections::BeginTierDetails
+ */
+USTRUCT()
+struct MODULARBUILDSYSTEM_API FMBSShellOverride
+{
+	GENERATED_BODY()
+
+	/**
+	 * Component of an overridden instance, or nullptr if the mesh of a static section was overridden.
+	 */
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Component = nullptr;
+
+	/**
+	 * Index of an instance within the Component, or index of a static section.
+	 */
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/**
+	 * Component space transforms of an instance without and with the details. Hidden instances are scaled to zero.
+	 */
+	UPROPERTY()
+	FTransform ShellTransform;
+
+	UPROPERTY()
+	FTransform TierTransform;
+
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> ShellMesh = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> TierMesh = nullptr;
+};
+
 /**
  * Structure that holds all sections of a single modular build system actor, and provides methods to manipulate them.
  */
@@ -27,6 +65,14 @@ private:
 	UPROPERTY(VisibleInstanceOnly, AdvancedDisplay, /*DuplicateTransient, */Category = "ModularBuildSystem")
 	TArray<FModularSectionInstanced> Instanced;
 
+	/**
+	 * Instanced static mesh components shared between all levels that are using the same static mesh.
+	 * Each level owns only a range of instances in these components (see FModularSectionInstanced::GetFirstInstanceIndex).
+	 * Is used only if FMBSMeshConfiguration::bUseSingleComponentPerUniqueMesh is set.
+	 */
+	UPROPERTY(VisibleInstanceOnly, AdvancedDisplay, Category = "ModularBuildSystem")
+	TMap<TObjectPtr<UStaticMesh>, TObjectPtr<UInstancedStaticMeshComponent>> Shared;
+
 	UPROPERTY()
 	TScriptInterface<IModularBuildSystemInterface> BS = nullptr;
 	
@@ -40,6 +86,37 @@ private:
 	UPROPERTY()
 	bool bWasReset = false;
 
+	/**
+	 * Transient structure-of-arrays index of Static and Actor sections used by bulk operations over levels.
+	 * @see FMBSSectionsLayout
+	 */
+	mutable FMBSSectionsLayout Layout;
+
+	/**
+	 * Incremented each time sections or instances were added, removed or modified by the methods of this struct.
+	 * @see GetRevision
+	 */
+	mutable uint32 Revision = 0;
+
+	/**
+	 * Count of static and actor sections of the shell, or INDEX_NONE if details are not split from the shell.
+	 * @see BeginTierDetails
+	 */
+	UPROPERTY(Transient)
+	int32 ShellStaticNum = INDEX_NONE;
+
+	UPROPERTY(Transient)
+	int32 ShellActorNum = INDEX_NONE;
+
+	/**
+	 * Changes made to the shell sections by the attached details.
+	 */
+	UPROPERTY(Transient)
+	TArray<FMBSShellOverride> ShellOverrides;
+
+	UPROPERTY(Transient)
+	bool bRecordShellOverrides = false;
+
 public:
 	FMBSSections() {}
 	FMBSSections(TScriptInterface<IModularBuildSystemInterface> InBuildSystemActor);
@@ -62,18 +139,44 @@ public:
 	FTransform GetSectionTransformAtRandom(int32 InLevelId, bool bInstanced, bool bWorldSpace) const;
 	FTransform GetSectionTransformAtRandom(const FModularLevel& InLevel, bool bInstanced, bool bWorldSpace) const;
 
+	/**
+	 * Returned sections can be modified, in which case the build system should be marked as changed after.
+	 * @see AModularBuildSystemActor::MarkChanged
+	 */
 	TArray<FModularSection*> GetStaticSectionsOfLevel(const FModularLevel& InLevel) const;
 	TArray<FModularSection*> GetStaticSectionsOfLevel(const int32 InLevelId) const;
 
 	TArray<FModularSectionActor*> GetActorSectionsOfLevel(const FModularLevel& InLevel) const;
 	TArray<FModularSectionActor*> GetActorSectionsOfLevel(const int32 InLevelId) const;
 
+	/**
+	 * Returns the last instanced section of a level. Levels that are using shared instanced components may own
+	 * multiple instance ranges, so GetInstancedSectionsOfLevel or FindInstancedSectionOfLevel should be used instead.
+	 */
 	FModularSectionInstanced* GetInstancedSectionOfLevel(const FModularLevel& InLevel) const;
 	FModularSectionInstanced* GetInstancedSectionOfLevel(const int32 InLevelId) const;
 
+	/**
+	 * Returns all instanced sections of a level. With shared instanced components single level may own
+	 * multiple instance ranges (one per each unique mesh).
+	 * @param InLevelId Id of a level.
+	 * @return Pointers to all instanced sections associated with a level.
+	 */
+	TArray<FModularSectionInstanced*> GetInstancedSectionsOfLevel(const int32 InLevelId) const;
+
+	/**
+	 * Finds instanced section of a level that owns an instance at the specified index within the whole level.
+	 * Instances of a level are counted through all of its instance ranges in the same order as they are returned by
+	 * GetInstancedSectionsOfLevel.
+	 * @param InLevelId Id of a level.
+	 * @param InOutIndex Index of an instance within the level. Is converted into the index within the returned section.
+	 * @return Instanced section that owns the instance or nullptr if there is no such section.
+	 */
+	FModularSectionInstanced* FindInstancedSectionOfLevel(int32 InLevelId, int32& InOutIndex) const;
+
 	TArray<FModularSection> GetStatic() const { return Static; }
 	TArray<FModularSectionActor> GetActor() const { return Actor; }
-	TArray<FModularSectionInstanced> GetInstanced() const { return Instanced; }
+	const TArray<FModularSectionInstanced>& GetInstanced() const { return Instanced; }
 	TArray<FModularSectionBase*> GetAll();
 
 	void SelectSections(const FModularLevel& InLevel) const;
@@ -103,20 +206,20 @@ public:
 	
 	void ResetSingleLevel(int32 LevelId);
 
-	void Add(const FModularSection& InStatic) { Static.Add(InStatic); }
-	void Add(const FModularSectionActor& InActor) { Actor.Add(InActor); }
-	void Add(const FModularSectionInstanced& InInstanced) { Instanced.Add(InInstanced); }
+	void Add(const FModularSection& InStatic) { Static.Add(InStatic); MarkLayoutDirty(); }
+	void Add(const FModularSectionActor& InActor) { Actor.Add(InActor); MarkLayoutDirty(); }
+	void Add(const FModularSectionInstanced& InInstanced) { Instanced.Add(InInstanced); MarkChanged(); }
 
-	void Append(const TArray<FModularSection>& InStaticSections) { Static.Append(InStaticSections); }
-	void Append(const TArray<FModularSectionActor>& InActorSections) { Actor.Append(InActorSections); }
-	void Append(const TArray<FModularSectionInstanced>& InInstancedSections) { Instanced.Append(InInstancedSections); }
+	void Append(const TArray<FModularSection>& InStaticSections) { Static.Append(InStaticSections); MarkLayoutDirty(); }
+	void Append(const TArray<FModularSectionActor>& InActorSections) { Actor.Append(InActorSections); MarkLayoutDirty(); }
+	void Append(const TArray<FModularSectionInstanced>& InInstancedSections) { Instanced.Append(InInstancedSections); MarkChanged(); }
 	
 	bool IsAnyEmpty() const { return Static.IsEmpty() || Actor.IsEmpty() || Instanced.IsEmpty(); }
 	bool IsAnyNotEmpty() const { return !Static.IsEmpty() || !Actor.IsEmpty() || !Instanced.IsEmpty(); }
 
-	void EmptyStatic()		{ Static.Empty(); }
-	void EmptyActor()		{ Actor.Empty(); }
-	void EmptyInstanced()	{ Instanced.Empty(); }
+	void EmptyStatic()		{ Static.Empty(); MarkLayoutDirty(); }
+	void EmptyActor()		{ Actor.Empty(); MarkLayoutDirty(); }
+	void EmptyInstanced()	{ Instanced.Empty(); MarkChanged(); }
 
 	int32 GetFirstIndexOfSectionWithLevelId(const int32 InLevelId) const;
 	int32 GetLastIndexOfSectionWithLevelId(const int32 InLevelId) const;
@@ -129,8 +232,24 @@ public:
 	void RemoveInstancedSectionInstancesAfterIndex(int32 Index, int32 LevelId);
 
 	void SetVisibility(bool bVisible);
+
+	/**
+	 * Changes visibility of all sections of a level. Instance ranges of shared instanced components are hidden
+	 * per instance, so other levels that are using the same components stay visible.
+	 * @see FModularSectionInstanced::SetRangeVisibility
+	 */
 	void SetVisibility(const FModularLevel& InLevel, bool bVisible) const;
 
+	/**
+	 * Enables or disables collision of all section actors. Instanced components never have collision.
+	 */
+	void SetCollisionEnabled(bool bEnabled) const;
+
+	/**
+	 * Marks section actors and instanced components as transient, so they are not saved with the level.
+	 */
+	void SetTransient(bool bTransient) const;
+
 	/**
 	 * Reloads all section static meshes
 	 * @param InLevelId 
@@ -144,6 +263,29 @@ public:
 	 * @param bResetInstancedSections
 	 */
 	void Reset(bool bResetSections, bool bResetActorSections, bool bResetInstancedSections);
+
+	/**
+	 * Marks current sections as the shell that is shared between generation tiers, unless the shell is already marked.
+	 * Sections added after are details of a tier. Until EndTierDetails is called, changes made to the shell by
+	 * ReplaceWithNonInstancedSection, SetMeshAt and AddNewInstance(s) are recorded, and replaced instances are hidden
+	 * instead of being removed, so indices of the shell instances never change.
+	 */
+	void BeginTierDetails();
+	void EndTierDetails() { bRecordShellOverrides = false; }
+	bool HasShell() const { return ShellStaticNum != INDEX_NONE; }
+
+	/**
+	 * Moves the details out of this struct without destroying them and reverts their changes of the shell.
+	 * @param OutOverrides Changes of the shell that are applied again by AttachTierDetails.
+	 * @return Sections of the same build system that now own all detail sections.
+	 */
+	FMBSSections DetachTierDetails(TArray<FMBSShellOverride>& OutOverrides);
+
+	/**
+	 * Moves previously detached details back and applies their changes of the shell. No other details may be attached.
+	 * @see DetachTierDetails
+	 */
+	void AttachTierDetails(FMBSSections&& InDetails, TArray<FMBSShellOverride>&& InOverrides);
 	
 	void ResetInstancedSectionOfLevel(int32 LevelId);
 	void ClearInstancedSectionOfLevel(int32 LevelId);
@@ -195,7 +337,8 @@ public:
 	/**
 	 * Replaces instanced static mesh component instance at index with single modular section
 	 * @param InNewStaticMesh Static mesh to set to the modular section that will 
-	 * @param InInstanceIndex
+	 * @param InInstanceIndex Index of an instance within the level. If level owns multiple instance ranges of
+	 * shared components, instances are counted through all of them and InComponent is ignored.
 	 * @param InLevelId
 	 * @param InComponent
 	 * @param OutReplacedInstanceTransform 
@@ -216,6 +359,13 @@ public:
 	void AddNewInstance(const FTransform& InTransform, bool bWithRelativeTransform,
 		UInstancedStaticMeshComponent* InInstancedStaticMeshComponent);
 
+	/**
+	 * Adds all new instances to the instanced static mesh component at once, so its render state is updated only once.
+	 * @see AddNewInstance
+	 */
+	void AddNewInstances(const TArray<FTransform>& InTransforms, bool bWithRelativeTransform,
+		UInstancedStaticMeshComponent* InInstancedStaticMeshComponent);
+
 	/**
 	 * 
 	 * @param InLevel 
@@ -233,6 +383,29 @@ public:
 	 */
 	void SetMeshAt(const FModularLevel& InLevel, int32 InElement, int32 InRow, UStaticMesh* InMesh);
 	void SetMeshAt(const FModularLevel& InLevel, int32 InIndex, UStaticMesh* InMesh);
+
+	/**
+	 * @return True if build system uses single instanced static mesh component per each unique mesh.
+	 * @see FMBSMeshConfiguration::UsesSingleComponentPerUniqueMesh
+	 */
+	bool UsesSharedInstancedComponents() const;
+
+	/**
+	 * Returns instanced static mesh component that is shared by all levels with the same static mesh,
+	 * creating a new one if there is no such component yet.
+	 * @param InStaticMesh Static mesh of a component.
+	 * @return Shared instanced static mesh component or nullptr if InStaticMesh was nullptr.
+	 */
+	UInstancedStaticMeshComponent* GetOrCreateSharedComponent(UStaticMesh* InStaticMesh);
+
+	/**
+	 * Moves instances of a level into the shared instanced static mesh component of a new mesh.
+	 * All instances are removed and added in batches, so each affected component is rebuilt only once.
+	 * @param InLevelId Id of a level which instances should be moved.
+	 * @param InNewMesh Static mesh to move instances to.
+	 * @param InEachElement Only each N-th instance of a level will be moved.
+	 */
+	void MoveInstancesOfLevel(int32 InLevelId, UStaticMesh* InNewMesh, int32 InEachElement = 1);
 		
 	void UpdateInstanced();
 	/**
@@ -246,5 +419,49 @@ public:
 
 	bool WasReset() const { return bWasReset; }
 	void SetWasReset(bool bValue) { bWasReset = bValue; }
-	
+
+	/**
+	 * Returns structure-of-arrays index of static and actor sections, rebuilding it if sections were added or removed.
+	 * @return Up to date sections layout.
+	 */
+	const FMBSSectionsLayout& GetLayout() const;
+
+	/**
+	 * Marks sections layout as outdated. Must be called after sections arrays were changed externally (undo, for example).
+	 */
+	void MarkLayoutDirty() const { Layout.MarkDirty(); MarkChanged(); }
+
+	/**
+	 * @return Value that changes each time sections or instances were added, removed or modified by the methods of
+	 * this struct.
+	 * Changes made through the returned section pointers are not tracked.
+	 */
+	uint32 GetRevision() const { return Revision; }
+
+private:
+	void MarkChanged() const { Revision++; }
+
+	void ClearShell();
+
+	/**
+	 * Sets either the shell or the tier state of all recorded overrides.
+	 */
+	void ApplyShellOverrides(bool bTier);
+	void HideShellInstance(UInstancedStaticMeshComponent* InComponent, int32 InIndex, const FTransform& InTransform);
+	void RecordAddedInstance(UInstancedStaticMeshComponent* InComponent, int32 InIndex);
+	void RecordShellMesh(const FModularSection& InSection, UStaticMesh* InNewMesh);
+
+	/**
+	 * Removes all instances that should not be kept from the shared component and compacts instance ranges
+	 * of all sections that are using it. Instances that are not owned by any section are always kept.
+	 * @param InComponent Shared instanced static mesh component to rebuild.
+	 * @param ShouldKeep Predicate that receives owner section and index of an instance within that section.
+	 * @param OutRemovedTransforms Optional array to which component space transforms of removed instances will be added.
+	 */
+	void RebuildSharedComponent(UInstancedStaticMeshComponent* InComponent,
+		TFunctionRef<bool(const FModularSectionInstanced&, int32)> ShouldKeep, TArray<FTransform>* OutRemovedTransforms = nullptr);
+
+	void RemoveInstancesOfLevel(int32 InLevelId, bool bRemoveSections);
+	void OffsetInstancesOfLevel(int32 InLevelId, FVector Offset) const;
+	void ResetSharedComponents();
 };
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModularLevel.h"
+
+class AModularBuildSystemActor;
+class UInstancedStaticMeshComponent;
+
+enum class EMBSSectionHitType : uint8
+{
+	Static,
+	Actor,
+	Instanced
+};
+
+/**
+ * Result of a ray query against sections of a single build system.
+ */
+struct FMBSSectionHit
+{
+	TWeakObjectPtr<AModularBuildSystemActor> BuildSystem;
+	EMBSSectionHitType Type = EMBSSectionHitType::Static;
+
+	/**
+	 * Index into static, actor or instanced sections array of the build system, depending on Type.
+	 */
+	int32 SectionIndex = INDEX_NONE;
+	int32 LevelId = FModularLevel::InvalidLevelId;
+
+	/**
+	 * Index of the instance inside of the instanced section (not inside of the component), or INDEX_NONE if
+	 * non-instanced section was hit.
+	 */
+	int32 InstanceIndex = INDEX_NONE;
+
+	/**
+	 * Distance from the ray origin to the entry point of the hit section bounds.
+	 */
+	double Distance = TNumericLimits<double>::Max();
+
+	/**
+	 * Actor of the hit static or actor section.
+	 */
+	TWeakObjectPtr<AActor> Actor;
+
+	/**
+	 * Component of the hit instanced section.
+	 */
+	TWeakObjectPtr<UInstancedStaticMeshComponent> Component;
+
+	bool IsValid() const { return SectionIndex != INDEX_NONE; }
+};
+
+/**
+ * Bounding volume hierarchy over world space bounds of all visible sections (and each instance of instanced sections)
+ * of a single build system. Is used for editor picking, so sections can be resolved by a ray without physics queries,
+ * including separate instances of instanced levels.
+ *
+ * Hierarchy is rebuilt on Update only if the build system has changed since the last build: its transform, or its
+ * signature (sections layout revision, instance count and bounds of any instanced component). Signature is calculated
+ * again only after the build system was marked as changed (see AModularBuildSystemActor::GetRevision), so checking an
+ * unchanged build system is cheap. Changes that are not visible to the build system (e.g. section actor moved by hand)
+ * must be reported with MarkDirty.
+ *
+ * @note Hit test is performed against section bounds, not against the mesh triangles.
+ */
+struct MODULARBUILDSYSTEM_API FMBSSectionsBVH
+{
+	/**
+	 * Max number of primitives in a single leaf node.
+	 */
+	static constexpr int32 MaxLeafSize = 4;
+
+private:
+	struct FNode
+	{
+		FBox Bounds = FBox(ForceInit);
+
+		/**
+		 * Index of the first primitive for leaf nodes, or index of the first of two child nodes otherwise.
+		 */
+		int32 First = INDEX_NONE;
+
+		/**
+		 * Number of primitives of leaf node, or zero for inner nodes.
+		 */
+		int32 Count = 0;
+	};
+
+	struct FPrimitive
+	{
+		FBox Bounds = FBox(ForceInit);
+		EMBSSectionHitType Type = EMBSSectionHitType::Static;
+		int32 SectionIndex = INDEX_NONE;
+		int32 LevelId = FModularLevel::InvalidLevelId;
+		int32 InstanceIndex = INDEX_NONE;
+		TWeakObjectPtr<UObject> Object;
+	};
+
+	TArray<FNode> Nodes;
+	TArray<FPrimitive> Primitives;
+	TWeakObjectPtr<AModularBuildSystemActor> BuildSystem;
+	FTransform Transform;
+	uint32 Revision = 0;
+	uint32 Signature = 0;
+	bool bDirty = true;
+
+public:
+	void MarkDirty() { bDirty = true; }
+
+	/**
+	 * @return True if hierarchy was marked dirty or was built for another state of InBuildSystem.
+	 */
+	bool IsOutdated(const AModularBuildSystemActor* InBuildSystem) const;
+
+	/**
+	 * Rebuilds hierarchy from all sections of InBuildSystem.
+	 */
+	void Build(AModularBuildSystemActor* InBuildSystem);
+
+	/**
+	 * Rebuilds hierarchy only if it is outdated.
+	 * @return True if hierarchy was rebuilt.
+	 */
+	bool Update(AModularBuildSystemActor* InBuildSystem);
+
+	/**
+	 * Tests the ray against bounds of the whole hierarchy only, so build systems can be culled before their
+	 * hierarchies are walked.
+	 * @param OutDistance Distance from the ray origin to the entry point of the bounds.
+	 * @return True if bounds are intersected by the ray within InMaxDistance.
+	 */
+	bool RaycastBounds(const FVector& InOrigin, const FVector& InDirection, double InMaxDistance, double& OutDistance) const;
+
+	/**
+	 * Finds the closest section which bounds are intersected by the ray.
+	 * @param InOrigin World space ray origin.
+	 * @param InDirection Normalized ray direction.
+	 * @param InMaxDistance Max distance along the ray.
+	 * @param OutHit Closest hit. Is changed only if a hit was found.
+	 * @return True if any section was hit.
+	 */
+	bool Raycast(const FVector& InOrigin, const FVector& InDirection, double InMaxDistance, FMBSSectionHit& OutHit) const;
+
+	FBox GetBounds() const { return Nodes.IsEmpty() ? FBox(ForceInit) : Nodes[0].Bounds; }
+	int32 GetPrimitiveCount() const { return Primitives.Num(); }
+	int32 GetNodeCount() const { return Nodes.Num(); }
+
+private:
+	static uint32 CalculateSignature(const AModularBuildSystemActor* InBuildSystem);
+	static FVector GetInvDirection(const FVector& InDirection);
+	static bool IntersectRay(const FBox& InBox, const FVector& InOrigin, const FVector& InInvDirection, double InMaxDistance,
+		double& OutDistance);
+	void BuildNode(int32 NodeIndex, int32 First, int32 Count);
+};
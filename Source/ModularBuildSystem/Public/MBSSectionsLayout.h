@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FModularSection;
+struct FModularSectionActor;
+
+/**
+ * Structure-of-arrays index of static and actor sections of a single FMBSSections.
+ *
+ * Entries [0, GetStaticNum()) correspond to the static sections with the same index, all entries after that correspond
+ * to the actor sections. Level ids and actors are stored in separate contiguous arrays, so bulk operations over a level
+ * only scan the level ids instead of calling virtual methods of each section.
+ *
+ * Layout is transient and only depends on which sections exist, never on their content: transforms, meshes and
+ * visibility are always read from the sections themselves. It is rebuilt from the UPROPERTY arrays of FMBSSections
+ * after it was marked dirty (when sections are added or removed, on load or undo).
+ */
+struct MODULARBUILDSYSTEM_API FMBSSectionsLayout
+{
+private:
+	TArray<int32> LevelIds;
+
+	/**
+	 * Actors of each entry.
+	 */
+	TArray<TWeakObjectPtr<AActor>> Handles;
+
+	int32 StaticNum = 0;
+
+	/**
+	 * True if sections were added or removed, so all arrays must be rebuilt.
+	 */
+	bool bDirty = true;
+
+public:
+	void MarkDirty() { bDirty = true; }
+	bool IsDirty() const { return bDirty; }
+
+	/**
+	 * Rebuilds the layout from the sections arrays if it was marked dirty.
+	 * @param InStatic Static sections.
+	 * @param InActor Actor sections.
+	 */
+	void Update(const TArray<FModularSection>& InStatic, const TArray<FModularSectionActor>& InActor);
+
+	int32 Num() const { return LevelIds.Num(); }
+	int32 GetStaticNum() const { return StaticNum; }
+	bool IsActorAt(int32 Index) const { return Index >= StaticNum; }
+	int32 GetLevelIdAt(int32 Index) const { return LevelIds[Index]; }
+	AActor* GetHandleAt(int32 Index) const { return Handles[Index].Get(); }
+
+	/**
+	 * Collects indices of all entries associated with a level.
+	 * @param InLevelId Id of a level.
+	 * @param OutIndices Indices of entries, in the same order as sections were added.
+	 * @param bStaticOnly If true - only static sections are collected.
+	 */
+	void GetIndicesOfLevel(int32 InLevelId, TArray<int32>& OutIndices, bool bStaticOnly) const;
+};
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * Arc-length lookup table of a spline. Transforms along the spline are sampled once with a fixed step, so placing
+ * a section only interpolates between two nearest samples instead of querying the spline for each section.
+ */
+struct MODULARBUILDSYSTEM_API FMBSSplineArcLengthTable
+{
+	/**
+	 * Samples the spline in its local space.
+	 * @param Spline Spline to sample.
+	 * @param SampleLength Max distance between two samples.
+	 */
+	void Build(const USplineComponent& Spline, float SampleLength);
+	void Reset();
+
+	bool IsEmpty() const { return Distances.IsEmpty(); }
+	int32 GetSampleCount() const { return Distances.Num(); }
+	float GetLength() const { return Distances.IsEmpty() ? 0.f : Distances.Last(); }
+
+	int32 GetSegmentCount() const { return SegmentHashes.Num(); }
+	float GetSegmentStart(int32 Segment) const { return SegmentDistances[Segment]; }
+	float GetSegmentLength(int32 Segment) const { return SegmentDistances[Segment + 1] - SegmentDistances[Segment]; }
+
+	/**
+	 * @return Hash of the spline points the segment is built from. Is used to find segments that were changed.
+	 */
+	uint32 GetSegmentHash(int32 Segment) const { return SegmentHashes[Segment]; }
+
+	/**
+	 * @param Distance Distance from the start of the spline. Is clamped to the length of the spline.
+	 * @return Transform of the spline in its local space, interpolated between two nearest samples. Scale is always one.
+	 */
+	FTransform GetTransformAtDistance(float Distance) const;
+
+private:
+	TArray<float> Distances;
+	TArray<FVector> Locations;
+	TArray<FQuat> Rotations;
+
+	/**
+	 * Distance of each spline point from the start of the spline, segment count + 1 values.
+	 */
+	TArray<float> SegmentDistances;
+	TArray<uint32> SegmentHashes;
+
+	void AddSample(const USplineComponent& Spline, float Distance);
+};
+
+/**
+ * Placement of sections along a spline. Each segment of the spline gets a whole number of sections that are stretched
+ * to fill it, so sections of a segment don't move when other segments are changed.
+ *
+ * Sections are first placed in a straight layout, with the X-axis along the spline, and then are moved onto the
+ * spline with Warp. Straight X location of 0 is mapped to the first spline point.
+ */
+struct MODULARBUILDSYSTEM_API FMBSSplinePath
+{
+	/**
+	 * Count of samples of the arc-length table per section length.
+	 */
+	static constexpr int32 SamplesPerSection = 4;
+
+	/**
+	 * @param Spline Spline to place sections along.
+	 * @param InSectionLength Length of a single section in the straight layout.
+	 */
+	void Build(const USplineComponent& Spline, float InSectionLength);
+	void Reset();
+
+	bool IsValid() const { return GetSectionCount() > 0; }
+
+	/**
+	 * @return Count of sections that fit along the whole spline.
+	 */
+	int32 GetSectionCount() const { return SegmentFirstSections.IsEmpty() ? 0 : SegmentFirstSections.Last(); }
+	float GetSectionLength() const { return SectionLength; }
+	const FMBSSplineArcLengthTable& GetTable() const { return Table; }
+
+	/**
+	 * @param StraightX X location of a section in the straight layout.
+	 * @return Spline segment the section is placed on.
+	 */
+	int32 GetSegmentAt(float StraightX) const;
+
+	/**
+	 * Moves transform of the straight layout onto the spline. Locations before the first and after the last spline
+	 * point continue straight along the spline direction at these points.
+	 * @param StraightTransform Transform in the local space of the spline.
+	 * @return Transform in the local space of the spline.
+	 */
+	FTransform Warp(const FTransform& StraightTransform) const;
+
+	/**
+	 * @return True if each segment of both paths has the same count of sections, so existing sections can be moved
+	 * instead of being generated again.
+	 */
+	bool HasSameSections(const FMBSSplinePath& Other) const;
+
+	/**
+	 * Collects segments which spline points are different in the Other path.
+	 * @note Both paths must have the same sections.
+	 * @see HasSameSections
+	 */
+	void GetChangedSegments(const FMBSSplinePath& Other, TArray<int32>& OutSegments) const;
+
+private:
+	FMBSSplineArcLengthTable Table;
+	float SectionLength = 0.f;
+
+	/**
+	 * Index of the first section of each segment, segment count + 1 values.
+	 */
+	TArray<int32> SegmentFirstSections;
+
+	int32 GetSegmentOfSection(int32 SectionIndex) const;
+};
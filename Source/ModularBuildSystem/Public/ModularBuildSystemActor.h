@@ -4,8 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "MBSBounds.h"
+#include "MBSGenerationSteps.h"
+#include "MBSInstancingSubsystem.h"
 #include "MBSMerger.h"
+#include "MBSRegenerationScheduler.h"
 #include "MBSSections.h"
+#include "Config/MBSGenerationTierConfiguration.h"
 #include "Config/MBSMeshConfiguration.h"
 #include "Config/MBSSpawnConfiguration.h"
 #include "Config/MBSSettings.h"
@@ -27,6 +31,8 @@ class FModularLevelInitializer;
 }
 
 class USplineComponent;
+struct FMBSSplinePath;
+struct FMBSPresetLayout;
 class UMBSBounds;
 class AStaticMeshActor;
 class UStaticMeshComponent;
@@ -41,6 +47,9 @@ class UModularLevelShape;
 class UMBSInterior;
 class UStaticMesh;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FMBSGenerationCompletedSignature, AModularBuildSystemActor*, BuildSystem,
+	bool, bSucceeded);
+
 /**
  * Abstract base class of all build system actors of ModularBuildSystem plugin.
  * Each modular build system actor is a single separate building with optional interior.
@@ -90,6 +99,42 @@ private:
 	UPROPERTY(EditInstanceOnly, Config, Category = "Config")
 	FMBSSpawnConfiguration SpawnConfiguration;
 
+	UPROPERTY(EditInstanceOnly, Config, Category = "Config")
+	FMBSGenerationTierConfiguration TierConfiguration;
+
+	/**
+	 * Tier of the currently shown generated sections.
+	 * @see SetGenerationTier
+	 */
+	UPROPERTY(VisibleInstanceOnly, Category = "Generator")
+	EMBSGenerationTier GenerationTier = EMBSGenerationTier::Full;
+
+	/**
+	 * Hidden output of previously generated tiers. Is invalidated on each regeneration.
+	 * @see FMBSGenerationTierConfiguration::bCacheTiers
+	 */
+	UPROPERTY(VisibleInstanceOnly, AdvancedDisplay, Transient, DuplicateTransient, Category = "Generator")
+	TMap<EMBSGenerationTier, FMBSGenerationTierCache> GenerationTierCache;
+
+	FTimerHandle GenerationTierTimerHandle;
+
+	/**
+	 * Incremented each time sections, bounds or settings of this build system might have changed.
+	 * @see GetRevision
+	 */
+	uint32 ChangeRevision = 0;
+
+	/**
+	 * Scale of the root component before regeneration preview has started. Is unset if there is no active preview.
+	 */
+	TOptional<FVector> PreviewBaseScale;
+
+	/**
+	 * True while sections are hidden until the active time-sliced generation is completed.
+	 * @see GenerateTimeSliced
+	 */
+	bool bHideSectionsWhileGenerating = false;
+
 	UPROPERTY(VisibleInstanceOnly, AdvancedDisplay, DuplicateTransient, Category = "ModularBuildSystem")
 	FMBSSections Sections;
 
@@ -106,6 +151,21 @@ private:
 	 */
 	UPROPERTY(EditInstanceOnly, Instanced, Category = "Interior")
 	TObjectPtr<UMBSInterior> Interior;
+
+	/**
+	 * Handle of instances registered in the world shared instancing subsystem.
+	 * @see FMBSMeshConfiguration::bUseWorldSharedInstancing
+	 */
+	UPROPERTY(VisibleInstanceOnly, Transient, AdvancedDisplay, Category = "ModularBuildSystem")
+	FMBSSharedInstancesHandle SharedInstancesHandle;
+
+#if WITH_EDITOR
+	/**
+	 * Is bound while own instanced components are shown for saving the package of this build system.
+	 * @see PreSave, OnPackageSaved
+	 */
+	FDelegateHandle PackageSavedHandle;
+#endif
 	
 	/**
 	 * Stores this actor pre OnConstruction method call transform. Might be removed later.
@@ -117,11 +177,20 @@ public:
 	virtual void PostActorCreated() override;
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
+#if WITH_EDITOR
+	virtual void PostEditUndo() override;
+	virtual void PostEditMove(bool bFinished) override;
+#endif
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void PostRegisterAllComponents() override;
+	virtual void PostUnregisterAllComponents() override;
 	
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Destroyed() override;
 	
 public:
 	FModularSection InitModularSection(UStaticMesh* InStaticMesh, const FTransform& InTransform, int32 InLevelId,
@@ -153,6 +222,26 @@ public:
 	void AddNewInstance(const FTransform& InTransform, bool bWithRelativeTransform,
 		UInstancedStaticMeshComponent* InInstancedStaticMeshComponent);
 
+	/**
+	 * Adds new instances to instanced modular section's instanced static mesh component in a single batch.
+	 * @see AddNewInstance
+	 */
+	void AddNewInstances(const TArray<FTransform>& InTransforms, bool bWithRelativeTransform,
+		UInstancedStaticMeshComponent* InInstancedStaticMeshComponent);
+
+	/**
+	 * Initializes instanced modular sections.
+	 * @param Args Initialization args.
+	 * @return Array of initialized instanced modular sections, which are not added to the build system sections.
+	 */
+	TArray<FModularSectionInstanced> InitInstancedModularSections(const FInitModularSectionsArgs& Args);
+
+	/**
+	 * Updates existing instanced modular sections using initialization arguments.
+	 * @param Args Initialization arguments. Level with Args.InLevelId must be one of the levels of this build system.
+	 */
+	void UpdateInstancedModularSections(const FInitModularSectionsArgs& Args);
+
 	/**
 	 * Selects all modular sections of this modular build system actor.
 	 */
@@ -181,6 +270,123 @@ public:
 	UFUNCTION(CallInEditor, BlueprintNativeEvent, Category = "Generator")
 	void Generate();
 	virtual void Generate_Implementation();
+
+	/**
+	 * Switches this build system to another generation tier. Cached details of the tier are shown if they exist,
+	 * otherwise they are generated (together with the interior for the full tier).
+	 * If FMBSGenerationTierConfiguration::bCacheTiers is set, the shell is kept and only the details of the current
+	 * tier are cached and hidden. Otherwise the whole build system is generated again.
+	 * @param NewTier Tier to switch to.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generator")
+	void SetGenerationTier(EMBSGenerationTier NewTier);
+
+	UFUNCTION(BlueprintPure, Category = "Generator")
+	EMBSGenerationTier GetGenerationTier() const { return GenerationTier; }
+
+	/**
+	 * Destroys all sections of cached generation tiers.
+	 */
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Generator")
+	void ClearGenerationTierCache();
+
+	/**
+	 * Marks generated sections as the shell shared by all generation tiers if tiers are cached. Is called by
+	 * generators once the shell is generated, before any details.
+	 * @see FMBSSections::BeginTierDetails
+	 */
+	void BeginTierDetails();
+	void EndTierDetails() { Sections.EndTierDetails(); }
+
+	/**
+	 * Notifies external caches (visualizers, for example) that this build system has changed.
+	 */
+	void MarkChanged() { ChangeRevision++; }
+
+	/**
+	 * @return Value that changes each time this build system or its sections have changed.
+	 * Can be compared with a previously stored value to detect that cached data derived from sections is outdated.
+	 */
+	uint32 GetRevision() const { return HashCombine(ChangeRevision, Sections.GetRevision()); }
+
+	/**
+	 * Stores current sections and build stats of this build system into the preset layout.
+	 * @param OutLayout Layout to fill, is reset first.
+	 */
+	void CapturePresetLayout(FMBSPresetLayout& OutLayout) const;
+
+	/**
+	 * Spawns sections from the preset layout without running the generator. Should be called on a reset build system,
+	 * after properties of the preset were loaded, so levels of the layout exist.
+	 * @return False if the layout can't be applied (e.g. it references a level that does not exist), nothing is
+	 * spawned in that case.
+	 */
+	bool ApplyPresetLayout(const FMBSPresetLayout& InLayout);
+
+	/**
+	 * Requests regeneration after a property of this build system was edited. Request is coalesced with other
+	 * requests of this build system and processed by the world UMBSRegenerationScheduler on the next tick.
+	 * If scheduling is disabled in UMBSSettings (or there is no scheduler) - full regeneration runs immediately.
+	 * @param InType Preview for interactive edits, Full for finalized ones.
+	 */
+	void RequestRegeneration(EMBSRegenerationType InType);
+
+	/**
+	 * Runs previously requested regeneration. Is called by UMBSRegenerationScheduler.
+	 */
+	void RunScheduledRegeneration(EMBSRegenerationType InType);
+
+	/**
+	 * Called when time-sliced generation of this build system is completed, failed or cancelled.
+	 * @see GenerateTimeSliced
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Generator")
+	FMBSGenerationCompletedSignature OnGenerationCompleted;
+
+	/**
+	 * Generates this build system in steps that are spread over multiple frames by the world UMBSRegenerationScheduler,
+	 * so spawning buildings at runtime does not cause hitches. Sections are hidden until the generation is completed,
+	 * or until the shell is generated if FMBSSpawnConfiguration::bShowShellWhileGenerating is set.
+	 * Interior is generated in the same frame in which the last step is completed.
+	 * If the generator does not support time slicing - generates at once.
+	 * OnGenerationCompleted is called in both cases.
+	 * @return True if generation has started (or succeeded, if it was done at once).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generator")
+	bool GenerateTimeSliced();
+
+	/**
+	 * Stops the active time-sliced generation and removes already generated sections.
+	 * Is also called by the generator before each regular generation, so pending steps never continue on top of
+	 * newly generated sections.
+	 * @see UModularBuildSystemGenerator::Generate_Implementation
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generator")
+	void CancelTimeSlicedGeneration();
+
+	UFUNCTION(BlueprintPure, Category = "Generator")
+	bool IsGeneratingTimeSliced() const;
+
+	/**
+	 * Continues the active time-sliced generation. Is called by UMBSRegenerationScheduler.
+	 * @param InBudgetSeconds Time budget of this call.
+	 * @return True if the generation has ended and should not be advanced anymore.
+	 */
+	bool AdvanceTimeSlicedGeneration(double InBudgetSeconds);
+
+	/**
+	 * Appends initialization of all modular levels as separate steps of the time-sliced generation.
+	 * Can be overridden to initialize each level in its own step. Initializes everything in a single step by default.
+	 * @param OutSteps Steps to append to.
+	 */
+	virtual void AddInitSteps(FMBSGenerationSteps& OutSteps);
+
+#if WITH_EDITOR
+	/**
+	 * @return Preview for interactive property changes (dragging a slider), Full for all other changes.
+	 */
+	static EMBSRegenerationType GetRegenerationTypeForChange(const FPropertyChangedEvent& PropertyChangedEvent);
+#endif
 	
 #if WITH_EDITOR
 	UFUNCTION(CallInEditor, BlueprintNativeEvent, Category = "Display")
@@ -216,6 +422,33 @@ public:
 	virtual void ResetBuildSystem(bool bResetSections = true, bool bResetActorSections = true, bool bResetInstancedSections = true,
 		bool bResetMergedSectionsStaticMeshActor = true) override;
 
+	/**
+	 * Registers all instanced sections of this build system in the world shared instancing subsystem (replacing previously
+	 * registered ones) and hides own instanced components. Does nothing if world shared instancing is not used.
+	 * @see FMBSMeshConfiguration::bUseWorldSharedInstancing
+	 */
+	void UpdateSharedInstances();
+
+	/**
+	 * Removes all instances of this build system from the world shared instancing subsystem and shows own instanced components back.
+	 */
+	void ReleaseSharedInstances();
+
+private:
+	/**
+	 * Shows or hides own instanced components, which are hidden while their instances are rendered by the shared chunks.
+	 */
+	void SetInstancedComponentsVisibility(bool bVisible);
+
+#if WITH_EDITOR
+	/**
+	 * Hides own instanced components again once the package of this build system was saved with them visible.
+	 */
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+#endif
+
+public:
+
 	void RemoveSectionsOfLevel(int32 LevelId);
 	void RemoveActorSectionsAfterIndex(int32 Index, int32 LevelId);
 	void RemoveInstancedSectionsAfterIndex(int32 Index, int32 LevelId);
@@ -269,6 +502,7 @@ public:
 
 	FModularSectionInstanced* GetInstancedSectionOfLevel(const FModularLevel& InLevel) const;
 	FModularSectionInstanced* GetInstancedSectionOfLevel(const int32 InLevelId) const;
+	TArray<FModularSectionInstanced*> GetInstancedSectionsOfLevel(const FModularLevel& InLevel) const;
 
 	/**
 	 * Returns the bounds box based on the TransformBounds vector value adjusted by StretchManager scale coefficients.
@@ -340,6 +574,7 @@ public:
 	
 	/**
 	 * @return All modular sections of this modular build system actor, including both actor and instanced sections.
+	 * Returned sections can be modified, in which case MarkChanged should be called after.
 	 */
 	TArray<FModularSectionBase*> GetAllSections();
 	
@@ -431,6 +666,19 @@ protected:
 	 * Should be overridden by subclasses.
 	 */
 	virtual void CollectStats();
+
+	/**
+	 * Moves sections of all levels onto the spline.
+	 * @param InSpline Spline to place sections along.
+	 * @param InPath Path built from the InSpline.
+	 * @param InOutStraightTransforms Transforms of sections before they were placed along the spline, in the local
+	 * space of the spline. Is filled from the current transforms of sections if empty.
+	 * @param InSegments If not empty - only sections placed on these spline segments are moved.
+	 * @return False if sections were added or removed after InOutStraightTransforms were filled.
+	 * @see FMBSSplinePath::Warp
+	 */
+	bool PlaceSectionsAlongSpline(const USplineComponent& InSpline, const FMBSSplinePath& InPath,
+		TArray<FTransform>& InOutStraightTransforms, TConstArrayView<int32> InSegments = {});
 	
 	/**
 	 * Can be overriden to add logic on update of this modular build system actor's transform bounds.
@@ -449,6 +697,40 @@ protected:
 	 */
 	virtual void ApplyStretch() {};
 
+	/**
+	 * Regenerates this build system after its properties were edited. Generates with the Generator object by default.
+	 * @see RequestRegeneration
+	 */
+	virtual void RegenerateOnChange();
+
+	/**
+	 * Can be overriden to preview an edit that is still in progress by updating transforms of existing sections
+	 * only. Preview is reverted before the full regeneration.
+	 * @see SetRegenerationPreviewScale
+	 */
+	virtual void PreviewRegeneration() {};
+
+	/**
+	 * Scales all existing sections around the build system origin, relative to the scale they had before the preview
+	 * has started (so consecutive previews do not accumulate).
+	 */
+	void SetRegenerationPreviewScale(const FVector& InScale);
+	void ClearRegenerationPreview();
+
+	/**
+	 * Invalidates cached generation tiers and passes the current generation tier to the generator.
+	 * Should be called before each regeneration of this build system.
+	 * @param InGenerator Generator that is about to generate.
+	 */
+	void PrepareTieredGeneration(UModularBuildSystemGenerator* InGenerator);
+
+	/**
+	 * Generates the interior again if it is set to follow updates of this build system. Interior is generated
+	 * with the full generation tier only.
+	 * @see UMBSInterior::ShouldRegenerateOnBuildSystemUpdate
+	 */
+	void RegenerateInteriorOnUpdate();
+
 	/**
 	 * Toggles visibility of a single modular level.
 	 * @param InLevel Level that should be updated.
@@ -461,6 +743,41 @@ protected:
 	void UpdateMeshes(TArray<FModularLevel>& InLevels);
 
 private:
+	/**
+	 * Generates sections of the current generation tier with the Generator object.
+	 * @return True if generation succeeded.
+	 */
+	bool RunGenerator();
+
+	/**
+	 * Ends the active time-sliced generation, shows the sections and notifies OnGenerationCompleted listeners.
+	 */
+	void FinishTimeSlicedGeneration(bool bSucceeded);
+
+	/**
+	 * Moves details of the InTier into its cache and hides them, leaving only the shell.
+	 */
+	void StashGenerationTier(EMBSGenerationTier InTier);
+
+	/**
+	 * Moves details of the InTier from its cache back on top of the shell and shows them.
+	 * @return True if InTier was cached.
+	 */
+	bool RestoreGenerationTier(EMBSGenerationTier InTier);
+
+	/**
+	 * Generates details of the current generation tier on top of the shell.
+	 * @return True if details were generated.
+	 */
+	bool GenerateTierDetails();
+
+	void UpdateGenerationTierByDistance();
+
+	/**
+	 * Updates merged counters of the world build system registry after merge state of this actor might have changed.
+	 */
+	void UpdateRegistryMergeState();
+
 	void RemoveSectionsAfterIndex(int32 Index, int32 LevelId);
 	void ResetInstancedSectionOfLevel(int32 LevelId);
 	void ClearInstancedSectionOfLevel(int32 LevelId);
@@ -492,26 +809,6 @@ private:
 	 */
 	FTransform GetAdjustedBuildSystemActorTransform(
 		EModularSectionPivotLocation PivotLocation = EModularSectionPivotLocation::Default) const;
-
-	/**
-	 * Adjust existing sections using provided spline component.
-	 * @param InSpline Pointer to spline component.
-	 * TODO: Implement
-	 */
-	void AdjustSectionsUsingSpline(USplineComponent* InSpline);
-	
-	/**
-	 * Initializes instanced modular sections.
-	 * @param Args Initialization args.
-	 * @return Array of initialized instanced modular sections.
-	 */
-	TArray<FModularSectionInstanced> InitInstancedModularSections(const FInitModularSectionsArgs& Args);
-
-	/**
-	 * Updates existing instanced modular sections using initialization arguments.
-	 * @param Args Initialization arguments.
-	 */
-	void UpdateInstancedModularSections(const FInitModularSectionsArgs& Args);
 	
 	/**
 	 * Append or update initialized sections to target array of section (sections/actor sections/instanced sections)
@@ -6,12 +6,35 @@
 #include "BuildingGeneratorInterface.h"
 #include "UObject/NoExportTypes.h"
 #include "MBSGeneratorBase.h"
+#include "MBSGenerationSteps.h"
 #include "ModularBuildSystemGenerator.generated.h"
 
 class UModularBuildSystemMeshList;
 class UModularBuildSystemListBase;
 class UModularSectionResolution;
 
+/**
+ * Level of detail of a generated building. Each tier includes everything generated by the previous one.
+ */
+UENUM(BlueprintType)
+enum class EMBSGenerationTier : uint8
+{
+	/**
+	 * Only the structural levels (basement, floors, walls, corners and roof) without any details.
+	 */
+	Shell,
+
+	/**
+	 * Shell and everything visible from the outside (entrances, doors, windows, chimney, roof windows, vegetation).
+	 */
+	Facade,
+
+	/**
+	 * Complete building with stairs, floor holes and interior.
+	 */
+	Full
+};
+
 /**
  * This class handles construction of modular build system actor's modular sections.
  * Supposed to be extended by subclasses and used as a uproperty inside ModularBuildSystemActor derived classes.
@@ -29,7 +52,74 @@ public:
 	 */
 	virtual FGeneratedModularSections Generate_Implementation() override;
 
+	/**
+	 * Sets the tier of the next generation. Generators that don't support tiers always generate the full building.
+	 * @param InTier New generation tier.
+	 */
+	void SetGenerationTier(EMBSGenerationTier InTier) { GenerationTier = InTier; }
+	EMBSGenerationTier GetGenerationTier() const { return GenerationTier; }
+
+	/**
+	 * Generates only the details of the current generation tier on top of the already generated shell.
+	 * @return False if details were not generated, in which case the whole build system should be generated again.
+	 * @see FMBSSections::BeginTierDetails
+	 */
+	virtual bool GenerateTierDetails() { return false; }
+
+	/**
+	 * @return True if this generator can split its generation into steps that are executed over multiple frames.
+	 * @see BeginTimeSlicedGeneration
+	 */
+	virtual bool SupportsTimeSlicing() const { return false; }
+
+	/**
+	 * Prepares generation of the build system that is split into steps (clearing, initialization of each level,
+	 * entrances, doors, windows, e.t.c.). Nothing is generated until AdvanceTimeSlicedGeneration is called.
+	 * Previous time-sliced generation is cancelled.
+	 * @param MBS Build system that should be generated. Must be the same as the one from GetBuildSystemPtr().
+	 * @param InOnShellGenerated Called once all levels are initialized, but before any details are generated.
+	 * @return False if this generator does not support time slicing.
+	 */
+	bool BeginTimeSlicedGeneration(AModularBuildSystemActor* MBS, TFunction<void()> InOnShellGenerated = nullptr);
+
+	/**
+	 * Executes steps of the time-sliced generation until the time budget is spent.
+	 * @param InBudgetSeconds Time budget. Zero or less executes all remaining steps.
+	 * @return Pending if there are steps left, Finished or Failed once the generation has ended.
+	 */
+	EMBSGenerationStepResult AdvanceTimeSlicedGeneration(double InBudgetSeconds);
+
+	/**
+	 * Discards remaining steps of the time-sliced generation. Already generated sections are not removed.
+	 */
+	void CancelTimeSlicedGeneration();
+
+	bool IsTimeSlicedGenerationActive() const { return !TimeSlicedSteps.IsDone(); }
+
+	/**
+	 * @return True if the build system was already cleared by the active time-sliced generation.
+	 */
+	bool HasTimeSlicedGenerationModifiedBuildSystem() const { return TimeSlicedSteps.GetCurrentIndex() > 0; }
+
 protected:
+	/**
+	 * Appends the steps that generate details of the already initialized build system. Is used by both the regular
+	 * and the time-sliced generation. Last step is expected to call FinishGeneration.
+	 * @param OutSteps Steps to append to.
+	 */
+	virtual void AddGenerationSteps(FMBSGenerationSteps& OutSteps) {};
+
+	/**
+	 * Is called once the steps of the time-sliced generation are added, before any of them is executed. Work that
+	 * doesn't depend on the initialized levels can be started here and finished by one of the steps.
+	 */
+	virtual void OnBeginTimeSlicedGeneration() {};
+
+	/**
+	 * @return True if elements of the InTier should be generated with the current generation tier.
+	 */
+	bool ShouldGenerateTier(EMBSGenerationTier InTier) const { return GenerationTier >= InTier; }
+
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category="Generator")
 	void FinishGeneration();
 	virtual void FinishGeneration_Implementation();
@@ -50,4 +140,16 @@ protected:
 	 * @return True if generation can be performed.
 	 */
 	bool PreGenerate(AModularBuildSystemActor* MBS) const;
+
+private:
+	/**
+	 * Tier of the next generation, set by the build system actor before each generation.
+	 */
+	UPROPERTY(Transient)
+	EMBSGenerationTier GenerationTier = EMBSGenerationTier::Full;
+
+	/**
+	 * Remaining steps of the active time-sliced generation.
+	 */
+	FMBSGenerationSteps TimeSlicedSteps;
 };
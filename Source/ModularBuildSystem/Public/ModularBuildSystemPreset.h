@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MBSPresetLayout.h"
 #include "Engine/DataAsset.h"
 #include "ModularBuildSystemPreset.generated.h"
 
@@ -10,7 +11,14 @@ class IModularBuildSystemInterface;
 class AModularBuildSystemActor;
 
 /**
- * 
+ * Snapshot of the configuration of a build system, optionally together with the layout of its generated sections.
+ *
+ * Properties declared by subclasses are the configuration. By default they are copied to and from the build system
+ * properties with the same name and type, subclasses may override SaveProperties and LoadProperties to copy them
+ * explicitly.
+ *
+ * @see Save
+ * @see Apply
  */
 UCLASS(Abstract)
 class MODULARBUILDSYSTEM_API UModularBuildSystemPreset : public UDataAsset
@@ -18,13 +26,70 @@ class MODULARBUILDSYSTEM_API UModularBuildSystemPreset : public UDataAsset
 	GENERATED_BODY()
 
 public:
-	virtual void SaveProperties(TScriptInterface<IModularBuildSystemInterface> InBuildSystem)
-	{
-		unimplemented();
-	}
-
-	virtual void LoadProperties(TScriptInterface<IModularBuildSystemInterface> InBuildSystem)
-	{
-		unimplemented();
-	}
+	/**
+	 * Is incremented each time the format of the stored layout changes, so layouts of older presets are not applied.
+	 */
+	static constexpr int32 LayoutVersion = 1;
+
+	/**
+	 * Copies configuration properties of the build system to this preset.
+	 */
+	virtual void SaveProperties(TScriptInterface<IModularBuildSystemInterface> InBuildSystem);
+
+	/**
+	 * Copies configuration properties of this preset to the build system.
+	 */
+	virtual void LoadProperties(TScriptInterface<IModularBuildSystemInterface> InBuildSystem);
+
+	/**
+	 * Saves the configuration of the build system and, if bSaveLayout is set, the layout of its current sections.
+	 */
+	void Save(TScriptInterface<IModularBuildSystemInterface> InBuildSystem);
+
+	/**
+	 * Loads the configuration to the build system and spawns the sections of the stored layout, if it is still valid.
+	 * Build system should be reset before.
+	 * @return True if sections were spawned from the layout. Otherwise only the configuration was loaded and the build
+	 * system should be regenerated.
+	 */
+	bool Apply(TScriptInterface<IModularBuildSystemInterface> InBuildSystem);
+
+	/**
+	 * @return True if the stored layout was saved with the current LayoutVersion and the configuration of this preset
+	 * was not changed since then.
+	 */
+	bool HasValidLayout() const;
+
+protected:
+	/**
+	 * If true - layout of generated sections is saved together with the configuration, so applying this preset does not
+	 * run the generator.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Layout")
+	bool bSaveLayout = true;
+
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	FMBSPresetLayout Layout;
+
+	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "Layout")
+	int32 SavedLayoutVersion = INDEX_NONE;
+
+	/**
+	 * Checksum of the configuration properties at the moment the layout was saved.
+	 */
+	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "Layout")
+	uint32 SavedConfigurationCrc = 0;
+
+	/**
+	 * @return Checksum of the properties declared by subclasses, including the instanced objects owned by this preset
+	 * and the contents of the mesh and actor lists they reference.
+	 */
+	uint32 CalculateConfigurationCrc() const;
+
+private:
+	/**
+	 * Copies values of the configuration properties between this preset and the build system, matching them by name
+	 * and type. Instanced objects are duplicated into the target.
+	 */
+	void CopyProperties(UObject& InBuildSystem, bool bToPreset);
 };
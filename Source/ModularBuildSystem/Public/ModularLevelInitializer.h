@@ -63,6 +63,20 @@ public:
 		float InZMultiplier, UModularSectionResolution* InPreviousLevelResolution, float& OutZMultiplier,
 		int32& OutCount, TFunction<void(const FInitModularSectionsArgs&)> InAppendFunction = nullptr);
 
+	/**
+	 * Initializes the next one of multiple ModularLevels, so initialization of multiple levels can be split into
+	 * separate steps. Calling it until it returns true initializes the same levels as InitMultipleLevels.
+	 * @param InOutIndex Index of the next level that should be initialized. Must be INDEX_NONE before the first call.
+	 * @param InZMultiplier Height (Z-axis) value multiplier of the first level. Is only used on the first call.
+	 * @param OutZMultiplier Height (Z-axis) value multiplier of the next level. Must not be modified between calls.
+	 * @param OutCount Count of a modular levels that should be initialized. Is set on the first call.
+	 * @return True if all levels are initialized.
+	 * @see InitMultipleLevels
+	 */
+	bool InitNextOfMultipleLevels(const FName& InLevelName, TArray<FModularLevel>& InLevels, int32& InOutIndex,
+		uint8& InShiftCount, float InZMultiplier, UModularSectionResolution* InPreviousLevelResolution,
+		float& OutZMultiplier, int32& OutCount, TFunction<void(const FInitModularSectionsArgs&)> InAppendFunction = nullptr);
+
 	/**
  	 * Use in case modular level is already initialized but has invalid LevelId.
  	 * @param InLevel Level to fix.
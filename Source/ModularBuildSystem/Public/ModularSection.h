@@ -91,6 +91,17 @@ public:
 	virtual void Reset() { unimplemented(); }
 	virtual void SetMesh(UStaticMesh* NewStaticMesh) const { unimplemented(); }
 
+	/**
+	 * Range versions of GetTransform, SetTransform, Offset and Scale that are applied to all InIndices at once.
+	 * Default implementation calls the single index version for each index, derived sections override them
+	 * to update render state only once per call.
+	 * bRelative has the same meaning as in the single index versions.
+	 */
+	virtual void GetTransforms(TConstArrayView<int32> InIndices, TArray<FTransform>& OutTransforms) const;
+	virtual void SetTransforms(TConstArrayView<int32> InIndices, TConstArrayView<FTransform> NewTransforms, bool bRelative = true);
+	virtual void OffsetRange(TConstArrayView<int32> InIndices, FVector Offset, bool bRelative = true);
+	virtual void ScaleRange(TConstArrayView<int32> InIndices, FVector ScaleOffset, bool bRelative = true);
+
 	int32 GetLevelId() const { return LevelId; }
 
 	bool IsInLevel(const int32 InLevelId) const;
@@ -107,6 +118,13 @@ protected:
 	static void SetActorTransform(AActor* OfActor, const FTransform& NewTransform, bool bRelative);
 	static void OffsetActor(AActor* OfActor, FVector Offset, bool bRelative);
 	static void ScaleActor(AActor* OfActor, FVector ScaleOffset, bool bRelative);
+
+	/**
+	 * Sets transforms of many actors at once. Each actor is modified first, so the whole batch can be undone in the
+	 * editor, and is moved with the regular setters, so the mobility of its root component is respected.
+	 */
+	static void SetActorTransforms(TConstArrayView<AActor*> OfActors, TConstArrayView<FTransform> NewTransforms, bool bRelative);
+	static void OffsetActors(TConstArrayView<AActor*> OfActors, FVector Offset, bool bRelative);
 };
 
 /**
@@ -143,6 +161,24 @@ public:
 	virtual void SetMesh(UStaticMesh* NewStaticMesh) const override;
 
 	AStaticMeshActor* GetStaticMeshActor() const { return StaticMesh; }
+
+	/**
+	 * Sets transforms of many modular sections at once.
+	 * @param InSections Sections to update.
+	 * @param NewTransforms New transform for each of InSections.
+	 * @param bRelative Are NewTransforms relative to the build system actor?
+	 * @see FModularSectionBase::SetActorTransforms
+	 */
+	static void BatchSetTransforms(TConstArrayView<FModularSection*> InSections, TConstArrayView<FTransform> NewTransforms, bool bRelative = true);
+	static void BatchOffset(TConstArrayView<FModularSection*> InSections, FVector Offset, bool bRelative = true);
+
+	/**
+	 * Sets static mesh of many modular sections at once. Sections that already have NewStaticMesh are skipped.
+	 */
+	static void BatchSetMesh(TConstArrayView<FModularSection*> InSections, UStaticMesh* NewStaticMesh);
+
+private:
+	static TArray<AActor*> GetActors(TConstArrayView<FModularSection*> InSections);
 };
 
 /**
@@ -206,6 +242,32 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ModularBuildSystem", meta=(AllowPrivateAccess=true))
 	int32 InstanceCount = 0;
 
+	/**
+	 * Index of the first instance owned by this section inside of the instanced static mesh component.
+	 * Is always 0 unless the component is shared between multiple levels.
+	 * @see FMBSMeshConfiguration::bUseSingleComponentPerUniqueMesh
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ModularBuildSystem", meta=(AllowPrivateAccess=true))
+	int32 FirstInstanceIndex = 0;
+
+	/**
+	 * Count of instances owned by this section starting from the FirstInstanceIndex.
+	 * Equals INDEX_NONE if this section owns all instances of the instanced static mesh component.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ModularBuildSystem", meta=(AllowPrivateAccess=true))
+	int32 OwnedInstanceCount = INDEX_NONE;
+
+	/**
+	 * Component space transforms of instances of this range while it is hidden. Hidden instances are scaled to zero
+	 * instead of being removed, so indices of instances of other levels in the shared component stay the same.
+	 * @see SetRangeVisibility
+	 */
+	UPROPERTY(Transient)
+	TArray<FTransform> HiddenTransforms;
+
+	UPROPERTY(Transient)
+	bool bHidden = false;
+
 public:	
 	/**
 	 * Returns transform of a instanced static mesh component instance at specified index.
@@ -227,6 +289,11 @@ public:
 	virtual FVector GetLocation(int32 Index) const override;
 	virtual void SetLocation(FVector NewLocation, bool bRelative, int32 Index) override;
 	virtual FTransform GetTransform(int32 Index) const override;
+
+	/**
+	 * @param bRelative If true - NewTransform is in the local space of the component, otherwise in world space.
+	 * The same applies to the other transform operations of instanced sections.
+	 */
 	virtual void SetTransform(const FTransform& NewTransform, bool bRelative, int32 Index) override;
 	virtual void Offset(FVector Offset, bool bRelative, int32 Index) override;
 	virtual void Scale(FVector ScaleOffset, bool bRelative, int32 Index) override;
@@ -237,10 +304,44 @@ public:
 	virtual FVector GetUpVector(int32 Index) const override;
 	virtual void Reset() override;
 	virtual void SetMesh(UStaticMesh* NewStaticMesh) const override;
+	virtual void GetTransforms(TConstArrayView<int32> InIndices, TArray<FTransform>& OutTransforms) const override;
+	virtual void SetTransforms(TConstArrayView<int32> InIndices, TConstArrayView<FTransform> NewTransforms, bool bRelative = true) override;
+	virtual void OffsetRange(TConstArrayView<int32> InIndices, FVector Offset, bool bRelative = true) override;
+	virtual void ScaleRange(TConstArrayView<int32> InIndices, FVector ScaleOffset, bool bRelative = true) override;
 
 	UInstancedStaticMeshComponent* GetISMC() const { return InstancedStaticMeshComponent; }
 	int32 GetInstanceCount() const;
 
+	/**
+	 * @return World space bounds of instances owned by this section. Bounds of the whole component are returned
+	 * if the section is not an instance range.
+	 */
+	FBox GetBounds() const;
+
+	/**
+	 * @return True if this section owns only a range of instances of a shared instanced static mesh component.
+	 */
+	bool IsInstanceRange() const { return OwnedInstanceCount != INDEX_NONE; }
+	int32 GetFirstInstanceIndex() const { return FirstInstanceIndex; }
+
+	/**
+	 * Converts index of an instance within this section into the index of an instance within the instanced static mesh component.
+	 * @param Index Index of an instance within this section.
+	 * @return Index of an instance within the instanced static mesh component.
+	 */
+	int32 ToComponentIndex(int32 Index) const { return FirstInstanceIndex + Index; }
+	void SetInstanceRange(int32 InFirstInstanceIndex, int32 InCount);
+
+	/**
+	 * Hides or shows instances of this range only. Instances must not be changed individually while range is hidden,
+	 * except by FMBSSections, which keeps HiddenTransforms in sync.
+	 * @param bVisible New visibility of instances of this range.
+	 */
+	void SetRangeVisibility(bool bVisible);
+	bool IsHidden() const { return bHidden; }
+	const TArray<FTransform>& GetHiddenTransforms() const { return HiddenTransforms; }
+	void SetHiddenTransforms(TArray<FTransform>&& InTransforms) { HiddenTransforms = MoveTemp(InTransforms); }
+
 	// TODO: For debug purposes only. Remove later.
 	int32 GetPreviousInstanceCount() const { return InstanceCount; }
 	void SetPreviousInstanceCount(int32 Value) { InstanceCount = Value; }
@@ -274,10 +375,14 @@ private:
 	UPROPERTY(EditAnywhere, Category="ModularBuildSystem")
 	TObjectPtr<UModularSectionResolution> Resolution = nullptr;
 
-	UPROPERTY(EditAnywhere, Category="ModularBuildSystem", meta=(ClampMin=0, ClampMax=64))
+	/**
+	 * Count of sections of a level. Is not limited, but levels with thousands of sections should use an instanced
+	 * mesh configuration, as each non-instanced section is a separate actor.
+	 */
+	UPROPERTY(EditAnywhere, Category="ModularBuildSystem", meta=(ClampMin=0, UIMax=64))
 	int32 TotalCount = 0;
 
-	UPROPERTY(EditAnywhere, Category="ModularBuildSystem", meta=(ClampMin=1, ClampMax=8))
+	UPROPERTY(EditAnywhere, Category="ModularBuildSystem", meta=(ClampMin=1, UIMax=8))
 	int32 MaxInRow = 1;
 
 	/**
@@ -293,6 +398,7 @@ public:
 	int32 GetTotalCount() const { return TotalCount; }
 	void AddTotalCount(int32 Delta) { TotalCount += Delta; }
 	int32 GetMaxInRow() const { return MaxInRow; }
+	int32 GetSkippedCount() const { return SkippedCount; }
 	UModularSectionResolution* GetResolution() const { return Resolution; }
 	UModularBuildSystemMeshList* GetMeshList() const { return MeshList; }
 	int32 GetMeshListIndex() const { return MeshListIndex; }
@@ -71,8 +71,39 @@ enum class EModularSectionRelativePosition : uint8
 	Left,
 };
 
+/**
+ * Data of a modular level that is the same for each of its section indices. Is built once per level and is referenced
+ * by the FNextTransformArgs of each index, so only the index and the output are set per section.
+ * @note Must outlive all FNextTransformArgs that were made from it.
+ */
+struct MODULARBUILDSYSTEM_API FNextTransformContext
+{
+	FNextTransformContext(const FTransform& InTransform, int32 InMaxInRow, int32 InMaxCount, float InLevelZMultiplier,
+		const FModularBuildStats& InBuildStats, const UModularSectionResolution* InPreviousLevelResolution,
+		const UModularSectionResolution* InResolution, UMBSTransformSolver* InSolver);
+
+	FNextTransformContext(const FTransform& InTransform, const FModularLevel& Level,
+		const FModularBuildStats& InBuildStats, const UModularSectionResolution* InPreviousLevelResolution,
+		USplineComponent* InSpline);
+
+	FTransform Transform;
+	int32 MaxInRow = 1;
+	int32 MaxCount = 0;
+	float LevelZMultiplier = 0.f;
+
+	/**
+	 * Stats are referenced, not copied. Usually point to the BuildStats of a modular build system actor.
+	 */
+	const FModularBuildStats* BuildStats = nullptr;
+	const UModularSectionResolution* PreviousLevelResolution = nullptr;
+	const UModularSectionResolution* Resolution = nullptr;
+	UMBSTransformSolver* Solver = nullptr;
+	USplineComponent* Spline = nullptr;
+};
+
 /**
  * Structure that holds arguments passed to the GetNext*Transform methods.
+ * @note Args made from the FNextTransformContext don't copy the InBuildStats, use GetBuildStats in native code.
  */
 USTRUCT(BlueprintType)
 struct FNextTransformArgs
@@ -81,6 +112,8 @@ struct FNextTransformArgs
 
 	FNextTransformArgs();
 
+	FNextTransformArgs(const FNextTransformContext& InContext, int32 Index);
+
 	FNextTransformArgs(const FTransform& Transform, int32 Index, int32 MaxInRow, int32 MaxCount, float LevelZMultiplier,
 		const FModularBuildStats& BuildStats, const UModularSectionResolution* PreviousLevelResolution,
 		const UModularSectionResolution* Resolution, UMBSTransformSolver* Solver);
@@ -104,6 +137,11 @@ struct FNextTransformArgs
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=MBS)
 	float InLevelZMultiplier = 0.f;
 
+	/**
+	 * Is not filled if these args were made from the FNextTransformContext, unless they are passed to a Blueprint
+	 * transform solver.
+	 * @see GetBuildStats
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=MBS)
 	FModularBuildStats InBuildStats;
 
@@ -146,6 +184,25 @@ struct FNextTransformArgs
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=MBS)
 	FVector OutScale = FVector::OneVector;
 
+	/**
+	 * Level data these args were made from. Is null for args made with the other constructors.
+	 */
+	const FNextTransformContext* Context = nullptr;
+
+	/**
+	 * @return Stats of the context if these args were made from it, InBuildStats otherwise.
+	 */
+	const FModularBuildStats& GetBuildStats() const { return Context ? *Context->BuildStats : InBuildStats; }
+
+	/**
+	 * Prepares these args for the next index of the same level: clears the output and the skip flag.
+	 */
+	void Reset(int32 Index);
+
+	/**
+	 * Copies stats of the context to the InBuildStats, so they are visible to Blueprint solvers.
+	 */
+	void FillBuildStats();
 };
 
 /**
@@ -219,13 +276,13 @@ protected:
 	/**
 	 * Resolution of a section in centimeters.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ModularBuildSystem")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, AssetRegistrySearchable, Category = "ModularBuildSystem")
 	FIntVector Resolution;
 	
 	/**
 	 * Snap mode defines how new transform is calculated for each section on their initialization.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ModularBuildSystem")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, AssetRegistrySearchable, Category = "ModularBuildSystem")
 	EModularSectionResolutionSnapMode SnapMode;
 
 public:
@@ -247,6 +304,29 @@ public:
 		float InLevelZMultiplier, const FModularBuildStats& InStats, UMBSTransformSolver* InSolver, 
 		const UModularSectionResolution* InPreviousLevelResolution) const;
 
+	/**
+	 * Calculates next transforms of InCount sections of a level, starting from the index 0. Native solvers calculate
+	 * all of them in a single call.
+	 * @see GetNextTransform
+	 * @see UMBSTransformSolver::GetNextTransforms
+	 */
+	void GetNextTransforms(const FTransform& InTransform, int32 InCount, int32 MaxInRow, int32 InMaxCount,
+		float InLevelZMultiplier, const FModularBuildStats& InStats, UMBSTransformSolver* InSolver,
+		const UModularSectionResolution* InPreviousLevelResolution, TArray<FTransform>& OutTransforms) const;
+
+	/**
+	 * Calculates next modular section transform at the InIndex of a level described by the Context.
+	 * @see GetNextTransform
+	 */
+	FTransform GetNextTransform(const FNextTransformContext& Context, int32 InIndex) const;
+
+	/**
+	 * Calculates next transforms of InCount sections of a level described by the Context, starting from the index 0.
+	 * Arguments of the native snap modes are reused between indices, Blueprint solvers get new arguments per index.
+	 * @see GetNextTransforms
+	 */
+	void GetNextTransforms(const FNextTransformContext& Context, int32 InCount, TArray<FTransform>& OutTransforms) const;
+
 	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
 	void GetNextDefaultTransform(FNextTransformArgs& Args) const;
 
@@ -314,6 +394,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ModularBuildSystem")
 	EModularSectionResolutionSnapMode GetSnapMode() const;
 
+	/**
+	 * @return Names of the asset registry tags of the resolution value and snap mode.
+	 * @see FMBSResolutionIndex
+	 */
+	static FName GetValueTagName();
+	static FName GetSnapModeTagName();
+
 	UFUNCTION(BlueprintCallable, Category=Resolution, meta=(CompactNodeTitle="X"))
 	int32 GetX() const { return Resolution.X; }
 
@@ -323,6 +410,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Resolution, meta=(CompactNodeTitle="Z"))
 	int32 GetZ() const { return Resolution.Z; }
 
+	/**
+	 * @return Resolution inferred from the bounds of the mesh.
+	 * @see UModularBuildSystemMeshList::ClassifyMeshes
+	 */
 	// TODO: Use this for Auto resolution calculation mode
 	UFUNCTION(BlueprintCallable, Category=Resolution)
 	static FIntVector GetResolutionFromMesh(UStaticMesh* InMesh);
@@ -382,6 +473,11 @@ public:
 	static TArray<int32> GetWallBackIndices(int32 MaxInRow, int32 MaxCount);
 	
 private:
+	/**
+	 * Calls the solver of the Args, or the GetNext*Transform method of the current snap mode.
+	 */
+	FTransform SolveNextTransform(FNextTransformArgs& Args) const;
+
 	static constexpr int32 GetMaxRow(int32 MaxCount, int32 MaxInRow);
 	static constexpr int32 GetWallMaxRow(int32 MaxCount, int32 MaxInRow);
 
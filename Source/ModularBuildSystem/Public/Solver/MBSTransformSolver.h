@@ -34,6 +34,26 @@ public:
 		return {};
 	}
 
+	/**
+	 * Calculates transforms of InCount sections of a level at once, starting from the InFirstIndex.
+	 * Default implementation calls GetNextTransform_Implementation for each index directly, without the Blueprint
+	 * event dispatch, reusing the same arguments. Override it to share calculations between indices of the same level.
+	 * @note Is only called for native solvers.
+	 * @see HasNativeBatch
+	 * @param InContext Data of the level.
+	 * @param InFirstIndex Index of the first section.
+	 * @param InCount Count of sections.
+	 * @param OutTransforms Calculated transforms are appended here.
+	 */
+	virtual void GetNextTransforms(const FNextTransformContext& InContext, int32 InFirstIndex, int32 InCount,
+		TArray<FTransform>& OutTransforms);
+
+	/**
+	 * @return True if GetNextTransforms can be used instead of the GetNextTransform event, as it can't be overridden
+	 * by a Blueprint class.
+	 */
+	bool HasNativeBatch() const;
+
 protected:
 	/**
 	 * Sets the Arguments property of this transform solver.
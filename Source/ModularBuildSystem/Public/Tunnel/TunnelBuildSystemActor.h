@@ -3,7 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MBSSplinePath.h"
 #include "ModularBuildSystemActor.h"
+#include "Tunnel/TunnelChunkLayout.h"
 #include "TunnelBuildSystemActor.generated.h"
 
 class USplineComponent;
@@ -32,27 +34,136 @@ class MODULARBUILDSYSTEM_API ATunnelBuildSystemActor : public AModularBuildSyste
 	UPROPERTY(EditInstanceOnly, Instanced, Category=Generator)
 	TObjectPtr<UTunnelBuildSystemGenerator> Generator;
 
+	/**
+	 * If true - tunnel follows the Spline, and its length is defined by the length of the Spline.
+	 * When spline points are moved only sections of the changed spline segments are placed again.
+	 */
 	UPROPERTY(EditAnywhere, Category=Generator)
 	bool bUseSpline;
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Generator, meta=(AllowPrivateAccess=true))
 	TObjectPtr<USplineComponent> Spline;
 
+	/**
+	 * Transforms of sections before they were placed along the Spline, in the local space of the Spline.
+	 * @see AModularBuildSystemActor::PlaceSectionsAlongSpline
+	 */
+	UPROPERTY()
+	TArray<FTransform> StraightTransforms;
+
+	/**
+	 * Placement of sections along the Spline. Is compared with the path built from the changed Spline to find
+	 * segments which sections must be placed again.
+	 */
+	FMBSSplinePath SplinePath;
+
 	UPROPERTY(EditInstanceOnly, Category=Generator)
 	bool bGenerateOnChange;
+
+	/**
+	 * If true - tunnel is split into chunks along its length, each generated by a separate tunnel actor with its own
+	 * instanced components and bounds. Only chunks affected by an edit are generated again.
+	 * Chunked tunnel is always straight, the Spline is not used.
+	 */
+	UPROPERTY(EditInstanceOnly, Category=Chunks)
+	bool bChunked;
+
+	/**
+	 * Size (in cm) of a world grid cell. Chunk borders line up with cell borders, so it should match the cell size of
+	 * the world partition runtime grid to let distant chunks stream out.
+	 */
+	UPROPERTY(EditInstanceOnly, Category=Chunks, meta=(EditCondition="bChunked", ClampMin=400, Units="Centimeters"))
+	float ChunkCellSize = 12800.f;
+
+	UPROPERTY(VisibleInstanceOnly, Category=Chunks)
+	TArray<TSoftObjectPtr<ATunnelBuildSystemActor>> Chunks;
+
+	/**
+	 * Hash of the generation input of each chunk. Chunks with unchanged hash are not generated again.
+	 */
+	UPROPERTY()
+	TArray<uint32> ChunkHashes;
+
+	/**
+	 * Is incremented on each edit that affects all chunks, e.g. change of the mesh lists of the Generator.
+	 */
+	UPROPERTY()
+	uint32 ChunkSettingsRevision = 0;
+
+	/**
+	 * Tunnel this actor is a chunk of. Its chunk is generated again if this actor was destroyed.
+	 */
+	UPROPERTY(VisibleInstanceOnly, Category=Chunks)
+	TSoftObjectPtr<ATunnelBuildSystemActor> ChunkOwner;
+
+	/**
+	 * Layout of the active chunked generation.
+	 */
+	FTunnelChunkLayout ChunkLayout;
 	
 public:
 	ATunnelBuildSystemActor();
+	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void Destroyed() override;
+	virtual void PostDuplicate(bool bDuplicateForPIE) override;
 	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
 	virtual void Init() override;
+	virtual void AddInitSteps(FMBSGenerationSteps& OutSteps) override;
 	virtual TScriptInterface<IBuildingGeneratorInterface> GetGenerator() const override;
 	virtual TArray<FModularLevel*> GetAllLevels() const override;
 	virtual FModularLevel* GetLevelWithId(int32 Id) const override;
 	virtual void CollectStats() override;
 	virtual void OnUpdateTransformBounds() override;
 
+protected:
+	virtual void RegenerateOnChange() override;
+
 private:
-	//virtual void SetupSpline() override;
+	/**
+	 * Builds the SplinePath before generation, so the length of the tunnel can be taken from it.
+	 */
+	void BuildSplinePath();
+
+	/**
+	 * Places all generated sections along the Spline.
+	 */
+	void PlaceAlongSpline();
+
+	/**
+	 * Places again sections of the spline segments that were changed since the last placement. Regenerates the tunnel
+	 * if count of sections along the Spline was changed.
+	 */
+	void UpdateSplineSections();
+
+	bool IsChunked() const { return bChunked; }
+
+	/**
+	 * Computes the ChunkLayout from the bounds of the Generator and the location of the tunnel in the world.
+	 * Destroys chunks that are not a part of the new layout.
+	 */
+	void UpdateChunkLayout();
+
+	/**
+	 * Generates the chunk of the ChunkLayout if its generation input was changed. Spawns the chunk actor if it
+	 * doesn't exist yet.
+	 * @return True if there are chunks left after this one.
+	 */
+	bool GenerateChunk(int32 Index);
+
+	/**
+	 * Destroys all loaded chunk actors and forgets the unloaded ones.
+	 */
+	void DestroyChunks(int32 FirstIndex = 0);
+
+	/**
+	 * Forgets the destroyed chunk, so it is spawned again on the next generation.
+	 */
+	void OnChunkDestroyed(const ATunnelBuildSystemActor* InChunk);
+
+	/**
+	 * @return Transform of the chunk which first section is at the given index of the whole tunnel.
+	 */
+	FTransform GetChunkTransform(int32 FirstSection) const;
 
 	friend class UTunnelEntranceGeneratorProperty;
 	friend class UTunnelBuildSystemGenerator;
@@ -44,6 +44,16 @@ class MODULARBUILDSYSTEM_API UTunnelBuildSystemGenerator : public UModularBuildS
 
 	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category=Generator, meta=(AllowPrivateAccess=true))
 	int32 LevelCount;
+
+	/**
+	 * Entrance ends to generate. Chunks of a chunked tunnel only have the entrance ends of the whole tunnel.
+	 * @see ATunnelBuildSystemActor::bChunked
+	 */
+	UPROPERTY()
+	bool bEntranceAtStart = true;
+
+	UPROPERTY()
+	bool bEntranceAtEnd = true;
 	
 public:
 	UTunnelBuildSystemGenerator();
@@ -54,10 +64,23 @@ public:
 	virtual bool CheckLists() const override;
 	virtual void PrepareBuildSystem() const override;
 	virtual bool CanGenerate() const override;
+	virtual bool SupportsTimeSlicing() const override { return true; }
+	virtual void AddGenerationSteps(FMBSGenerationSteps& OutSteps) override;
 
 	FIntPoint GetBounds() const		{ return Bounds; }
+
+	/**
+	 * @return Bounds of the tunnel. Length (X) is taken from the spline of the build system, if the tunnel follows it.
+	 */
+	FIntPoint GetTunnelBounds() const;
 	void SetBounds(FIntPoint Value) { Bounds = Value; }
 	
 	int32 GetLevelCount() const		{ return LevelCount; }
 	void SetLevelCount(int32 Value) { LevelCount = Value; }
+
+	bool HasEntranceAtStart() const { return bEntranceAtStart; }
+	bool HasEntranceAtEnd() const	{ return bEntranceAtEnd; }
+	void SetEntrances(bool bAtStart, bool bAtEnd) { bEntranceAtStart = bAtStart; bEntranceAtEnd = bAtEnd; }
+
+	friend class ATunnelBuildSystemActor;
 };
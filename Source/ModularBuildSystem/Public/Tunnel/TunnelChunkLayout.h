@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Range of tunnel sections generated by a single chunk.
+ */
+struct FTunnelChunk
+{
+	int32 FirstSection = 0;
+	int32 SectionCount = 0;
+
+	bool operator==(const FTunnelChunk& Other) const
+	{
+		return FirstSection == Other.FirstSection && SectionCount == Other.SectionCount;
+	}
+};
+
+/**
+ * Split of a straight tunnel into chunks. Chunk borders line up with borders of world grid cells (e.g. world
+ * partition cells), so each chunk is inside a single cell and can be streamed separately.
+ */
+struct MODULARBUILDSYSTEM_API FTunnelChunkLayout
+{
+	TArray<FTunnelChunk> Chunks;
+
+	/**
+	 * @param SectionCount Count of sections along the tunnel.
+	 * @param SectionLength Length of a single section.
+	 * @param StartCoordinate World coordinate of the tunnel start along the grid axis.
+	 * @param Direction Direction of the tunnel along the grid axis, either 1 or -1.
+	 * @param CellSize Size of a single grid cell.
+	 * @return Layout where a new chunk is started each time the center of a section is in the next cell.
+	 */
+	static FTunnelChunkLayout Compute(int32 SectionCount, float SectionLength, float StartCoordinate, float Direction,
+		float CellSize);
+};
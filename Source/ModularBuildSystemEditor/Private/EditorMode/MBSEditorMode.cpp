@@ -9,9 +9,9 @@
 #include "MBSToolCommands.h"
 #include "Toolkits/ToolkitManager.h"
 #include "ModularBuildSystemActor.h"
+#include "MBSBuildSystemRegistry.h"
 #include "Selection.h"
 #include "Engine/StaticMeshActor.h"
-#include "Kismet/GameplayStatics.h"
 
 IMPLEMENT_HIT_PROXY(MBS::HProxy, HHitProxy);
 
@@ -34,6 +34,9 @@ void MBS::FEditorMode::Enter()
 		UICommandList = Toolkit->GetToolkitCommands();
 		BindCommands();
 	}
+
+	OnActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FEditorMode::OnActorMoved);
+	OnObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FEditorMode::OnObjectPropertyChanged);
 }
 
 void MBS::FEditorMode::Exit()
@@ -41,6 +44,12 @@ void MBS::FEditorMode::Exit()
 	// todo: fix unresolved external symbol
 	FToolkitManager::Get().CloseToolkit(Toolkit.ToSharedRef());
 	Toolkit.Reset();
+
+	GEngine->OnActorMoved().Remove(OnActorMovedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedHandle);
+	PickingBVHs.Empty();
+	LastHoverHit = FMBSSectionHit();
+	
 	FEdMode::Exit();
 }
 
@@ -62,8 +71,11 @@ bool MBS::FEditorMode::HandleClick(FEditorViewportClient* InViewportClient, HHit
 	const FViewportClick& Click)
 {
 	UE_LOG(LogMBSEditor, Warning, TEXT("HandleClick"));
-	AActor* Actor = GetActorAtLocation(Click);
-	UE_LOG(LogMBSEditor, Log, TEXT("Actor=%s"), Actor ? *Actor->GetActorLabel() : TEXT("nullptr"));
+	FMBSSectionHit Hit;
+	Raycast(Click, Hit);
+	AActor* Actor = Hit.Actor.Get();
+	UE_LOG(LogMBSEditor, Log, TEXT("Actor=%s, LevelId=%d, SectionIndex=%d, InstanceIndex=%d"),
+		Actor ? *Actor->GetActorLabel() : TEXT("nullptr"), Hit.LevelId, Hit.SectionIndex, Hit.InstanceIndex);
 	if (UISettings && UISettings->GetSelectToolSelected())
 	{
 		UE_LOG(LogMBSEditor, Warning, TEXT("HitProxy"));
@@ -107,27 +119,28 @@ bool MBS::FEditorMode::HandleClick(FEditorViewportClient* InViewportClient, HHit
 				}*/
 			}
 
-			if (Actor)
+			// If clicked section belongs to the MBS actor
+			if (AModularBuildSystemActor* MBS = Hit.BuildSystem.Get())
 			{
-				// If selected (clicked) actor is attached to the MBS actor
-				if (AModularBuildSystemActor* MBS = Cast<AModularBuildSystemActor>(Actor->GetAttachParentActor()))
+				CurrentSelectedBuildSystem = MBS;
+				CurrentSelectedSectionIndex = Hit.SectionIndex;
+				CurrentSelectedInstanceIndex = Hit.InstanceIndex;
+				
+				switch (UISettings->GetSelectionType())
 				{
-					switch (UISettings->GetSelectionType())
-					{
-					case EMBSEditorSelectionType::Section: // Selecting only sections of an MBS actor
-						GEditor->SelectActor(Actor, true, true, true);
-						break;
-					case EMBSEditorSelectionType::Side: // Selecting only single side of an MBS actor
-						// Find which side actor is pointing to
-						// TODO: implement
-						break;
-					case EMBSEditorSelectionType::System: // Selecting only a whole MBS actor
-						GEditor->SelectActor(MBS, true, true, true);
-						break;
-					default: ;
-					}
+				case EMBSEditorSelectionType::Section: // Selecting only sections of an MBS actor
+					// Instances can't be selected as actors, so the MBS actor is selected and instance index is kept in CurrentSelectedInstanceIndex
+					GEditor->SelectActor(Actor ? Actor : MBS, true, true, true);
+					break;
+				case EMBSEditorSelectionType::Side: // Selecting only single side of an MBS actor
+					// Find which side actor is pointing to
+					// TODO: implement
+					break;
+				case EMBSEditorSelectionType::System: // Selecting only a whole MBS actor
+					GEditor->SelectActor(MBS, true, true, true);
+					break;
+				default: ;
 				}
-				
 			}
 
 			Selection->GetSelectedObjects(SelectedActors);
@@ -154,17 +167,23 @@ bool MBS::FEditorMode::MouseMove(FEditorViewportClient* ViewportClient, FViewpor
 		return FEdMode::MouseMove(ViewportClient, Viewport, X, Y);
 	}
 
+	// Cursor ray has not changed since the last query, so the highlight is still up to date
+	if (!UpdateHoverHit(CursorLocation))
+	{
+		return FEdMode::MouseMove(ViewportClient, Viewport, X, Y);
+	}
+
 	switch (UISettings->GetSelectionType())
 	{
 		case EMBSEditorSelectionType::Section:
 		{
-			OnMouseMoveSectionHighlight(CursorLocation);
+			OnMouseMoveSectionHighlight(LastHoverHit);
 			break;
 		}
 		case EMBSEditorSelectionType::Side: break;
 		case EMBSEditorSelectionType::System:
 		{
-			OnMouseMoveSystemHighlight(CursorLocation);
+			OnMouseMoveSystemHighlight(LastHoverHit);
 			break;
 		}
 		default: ;
@@ -195,12 +214,13 @@ void MBS::FEditorMode::BindCommands()
 		FIsActionChecked::CreateLambda([=] { return UISettings->GetSelectToolSelected(); }));
 }
 
-void MBS::FEditorMode::OnMouseMoveSectionHighlight(const FViewportCursorLocation& CursorLocation)
+void MBS::FEditorMode::OnMouseMoveSectionHighlight(const FMBSSectionHit& Hit)
 {
 	ResetHighlightedActor();
 	
-	AActor* HitActor = GetActorAtLocation(CursorLocation);
-	UE_LOG(LogMBSEditor, VeryVerbose, TEXT("Hit.Actor=%s"), HitActor ? *HitActor->GetActorLabel() : TEXT("nullptr"));
+	AActor* HitActor = Hit.Actor.Get();
+	UE_LOG(LogMBSEditor, VeryVerbose, TEXT("Hit.Actor=%s, Hit.LevelId=%d, Hit.InstanceIndex=%d"),
+		HitActor ? *HitActor->GetActorLabel() : TEXT("nullptr"), Hit.LevelId, Hit.InstanceIndex);
 	if (HitActor)
 	{
 		if (AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(HitActor))
@@ -210,59 +230,29 @@ void MBS::FEditorMode::OnMouseMoveSectionHighlight(const FViewportCursorLocation
 	}
 }
 
-void MBS::FEditorMode::OnMouseMoveSystemHighlight(const FViewportCursorLocation& CursorLocation)
+void MBS::FEditorMode::OnMouseMoveSystemHighlight(const FMBSSectionHit& Hit)
 {
 	for (auto& Highlighted : HighlightedStaticMeshActors)
 	{
 		ResetHighlightedActor(Highlighted);
 	}
 	
-	FHitResult Hit;
-	if (GetWorld()->LineTraceSingleByChannel(
-		Hit,
-		CursorLocation.GetOrigin(),
-		CursorLocation.GetOrigin() + CursorLocation.GetDirection() * 1000000.f,
-		ECollisionChannel::ECC_Visibility))
+	// Select all static mesh actors of MBS
+	if (const AModularBuildSystemActor* ParentMBS = Hit.BuildSystem.Get())
 	{
-		// Select all static mesh actors of MBS
-		if (AActor* HitActor = Hit.GetActor())
+		TArray<AActor*> Children;
+		ParentMBS->GetAttachedActors(Children);
+		
+		UE_LOG(LogMBSEditor, Verbose, TEXT("ParentMBS=%s, Children.Num()=%d"),
+			*ParentMBS->GetActorLabel(), Children.Num());
+		
+		for (const auto& Child : Children)
 		{
-			if (const AModularBuildSystemActor* MBS = Cast<AModularBuildSystemActor>(HitActor))
+			if (AStaticMeshActor* ChildStaticMeshActor = Cast<AStaticMeshActor>(Child))
 			{
-				// If system is found, then select all children of it
-				TArray<AActor*> Children;
-				MBS->GetAllChildActors(Children);
-				for (const auto& Child : Children)
-				{
-					if (AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(Child))
-					{
-						FHighlightedActor NewHighlightedActor;
-						HighlightActor(StaticMeshActor, NewHighlightedActor);
-					}
-				}
-			}
-			else if (const AStaticMeshActor* StaticMeshActor = Cast<AStaticMeshActor>(HitActor))
-			{
-				// Find if parent actor is MBS
-				AActor* ParentActor = StaticMeshActor->GetAttachParentActor();
-				if (const AModularBuildSystemActor* ParentMBS = Cast<AModularBuildSystemActor>(ParentActor))
-				{
-					TArray<AActor*> Children;
-					ParentMBS->GetAttachedActors(Children);
-					
-					UE_LOG(LogMBSEditor, Verbose, TEXT("ParentMBS=%s, Children.Num()=%d"),
-						*ParentMBS->GetActorLabel(), Children.Num());
-					
-					for (const auto& Child : Children)
-					{
-						if (AStaticMeshActor* ChildStaticMeshActor = Cast<AStaticMeshActor>(Child))
-						{
-							UE_LOG(LogMBSEditor, VeryVerbose, TEXT("ChildStaticMeshActor=%s"), *ChildStaticMeshActor->GetActorLabel());
-							FHighlightedActor NewHighlightedActor;
-							HighlightActor(ChildStaticMeshActor, NewHighlightedActor);
-						}
-					}
-				}
+				UE_LOG(LogMBSEditor, VeryVerbose, TEXT("ChildStaticMeshActor=%s"), *ChildStaticMeshActor->GetActorLabel());
+				FHighlightedActor NewHighlightedActor;
+				HighlightActor(ChildStaticMeshActor, NewHighlightedActor);
 			}
 		}
 	}
@@ -326,19 +316,108 @@ void MBS::FEditorMode::HighlightActor(AStaticMeshActor* InNewHighlightedActor,
 	}
 }
 
-AActor* MBS::FEditorMode::GetActorAtLocation(const FViewportCursorLocation& Location) const
+bool MBS::FEditorMode::Raycast(const FViewportCursorLocation& Location, FMBSSectionHit& OutHit)
 {
-	FHitResult Hit;
-	if (GetWorld()->LineTraceSingleByChannel(
-		Hit,
-		Location.GetOrigin(),
-		Location.GetOrigin() + Location.GetDirection() * 1000000.f,
-		ECollisionChannel::ECC_Visibility))
+	const UMBSBuildSystemRegistry* Registry = UMBSBuildSystemRegistry::Get(GetWorld());
+	if (!Registry)
+	{
+		return false;
+	}
+
+	for (auto It = PickingBVHs.CreateIterator(); It; ++It)
 	{
-		// Find MBS actor under cursor (or a child of it)
-		return Hit.GetActor();
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
 	}
-	return nullptr;
+
+	// Coarse test against bounds of each build system, hierarchies are rebuilt only for changed build systems
+	const FVector Origin = Location.GetOrigin();
+	const FVector Direction = Location.GetDirection();
+	TArray<TPair<double, AModularBuildSystemActor*>> Candidates;
+	Registry->ForEachBuildSystem([&](AModularBuildSystemActor& BuildSystem)
+	{
+		FMBSSectionsBVH& BVH = PickingBVHs.FindOrAdd(&BuildSystem);
+		BVH.Update(&BuildSystem);
+
+		double BoundsDistance;
+		if (BVH.RaycastBounds(Origin, Direction, PickDistance, BoundsDistance))
+		{
+			Candidates.Emplace(BoundsDistance, &BuildSystem);
+		}
+	});
+
+	Candidates.Sort([](const TPair<double, AModularBuildSystemActor*>& A, const TPair<double, AModularBuildSystemActor*>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	bool bHit = false;
+	for (const TPair<double, AModularBuildSystemActor*>& Candidate : Candidates)
+	{
+		// Sections of this and all further build systems can't be closer than the closest hit
+		if (Candidate.Key >= OutHit.Distance)
+		{
+			break;
+		}
+
+		FMBSSectionHit Hit;
+		if (PickingBVHs.FindChecked(Candidate.Value).Raycast(Origin, Direction, FMath::Min(PickDistance, OutHit.Distance), Hit)
+			&& Hit.Distance < OutHit.Distance)
+		{
+			OutHit = Hit;
+			bHit = true;
+		}
+	}
+	return bHit;
+}
+
+bool MBS::FEditorMode::UpdateHoverHit(const FViewportCursorLocation& Location)
+{
+	if (Location.GetOrigin().Equals(LastHoverOrigin) && Location.GetDirection().Equals(LastHoverDirection))
+	{
+		return false;
+	}
+
+	LastHoverOrigin = Location.GetOrigin();
+	LastHoverDirection = Location.GetDirection();
+	LastHoverHit = FMBSSectionHit();
+	Raycast(Location, LastHoverHit);
+	return true;
+}
+
+void MBS::FEditorMode::MarkPickingDirty(UObject* InObject)
+{
+	AActor* Actor = Cast<AActor>(InObject);
+	if (!Actor)
+	{
+		return;
+	}
+
+	AModularBuildSystemActor* BuildSystem = Cast<AModularBuildSystemActor>(Actor);
+	if (!BuildSystem)
+	{
+		BuildSystem = Cast<AModularBuildSystemActor>(Actor->GetAttachParentActor());
+	}
+
+	if (FMBSSectionsBVH* BVH = BuildSystem ? PickingBVHs.Find(BuildSystem) : nullptr)
+	{
+		BVH->MarkDirty();
+
+		// Force next hover query, as the hit under the cursor might have changed
+		LastHoverDirection = FVector::ZeroVector;
+	}
+}
+
+void MBS::FEditorMode::OnActorMoved(AActor* InActor)
+{
+	MarkPickingDirty(InActor);
+}
+
+void MBS::FEditorMode::OnObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent)
+{
+	MarkPickingDirty(InObject);
 }
 
 void MBS::FEditorMode::OnSetOperationsCommand() const
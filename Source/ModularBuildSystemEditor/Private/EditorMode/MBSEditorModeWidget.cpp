@@ -5,6 +5,7 @@
 
 #include "EditorModeManager.h"
 #include "EngineUtils.h"
+#include "MBSBuildSystemRegistry.h"
 #include "MBSFunctionLibrary.h"
 #include "House/HouseBuildSystemActor.h"
 #include "MBSToolCommands.h"
@@ -12,7 +13,6 @@
 #include "ModularBuildSystemEditor.h"
 #include "ObjectEditorUtils.h"
 #include "Framework/MultiBox/SToolBarButtonBlock.h"
-#include "Kismet/GameplayStatics.h"
 #include "Slate/Private/Widgets/Views/SListPanel.h"
 #include "Widgets/Layout/SScaleBox.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -313,34 +313,28 @@ bool MBS::SEditorModeWidget::IsSelectTool()
 
 FText MBS::SEditorModeWidget::GetTotalBuildSystemCount() const
 {
+	const UMBSBuildSystemRegistry* Registry = GetRegistry();
 	return FText::FromString(
-		FString::Printf(TEXT("Total build system count: %d"), GetCountOf(AModularBuildSystemActor::StaticClass())));
+		FString::Printf(TEXT("Total build system count: %d"), Registry ? Registry->GetTotalCount() : 0));
 }
 
 FText MBS::SEditorModeWidget::GetTotalHouseCount() const
 {
+	const UMBSBuildSystemRegistry* Registry = GetRegistry();
 	return FText::FromString(
-		FString::Printf(TEXT("Total house count: %d"), GetCountOf(AHouseBuildSystemActor::StaticClass())));
+		FString::Printf(TEXT("Total house count: %d"), Registry ? Registry->GetCountOf(AHouseBuildSystemActor::StaticClass()) : 0));
 }
 
 FText MBS::SEditorModeWidget::GetTotalMergedCount() const
 {
-	const int32 Count = GetCountOf<AModularBuildSystemActor>(
-		AModularBuildSystemActor::StaticClass(), [](const AModularBuildSystemActor* Actor) -> bool
-		{
-			return Actor->IsMerged();
-		});
-	return FText::FromString(FString::Printf(TEXT("Total merged count: %d"), Count));
+	const UMBSBuildSystemRegistry* Registry = GetRegistry();
+	return FText::FromString(FString::Printf(TEXT("Total merged count: %d"), Registry ? Registry->GetMergedCount() : 0));
 }
 
 FText MBS::SEditorModeWidget::GetTotalUnmergedCount() const
 {
-	const int32 Count = GetCountOf<AModularBuildSystemActor>(
-		AModularBuildSystemActor::StaticClass(), [](const AModularBuildSystemActor* Actor) -> bool
-		{
-			return !Actor->IsMerged();
-		});
-	return FText::FromString(FString::Printf(TEXT("Total unmerged count: %d"), Count));
+	const UMBSBuildSystemRegistry* Registry = GetRegistry();
+	return FText::FromString(FString::Printf(TEXT("Total unmerged count: %d"), Registry ? Registry->GetUnmergedCount() : 0));
 }
 
 void MBS::SEditorModeWidget::RefreshDetailsPanel() const
@@ -370,11 +364,9 @@ bool MBS::SEditorModeWidget::SetIsVisible(const FPropertyAndParent& InPropertyAn
 	return true;
 }
 
-int32 MBS::SEditorModeWidget::GetCountOf(TSubclassOf<AActor> Class)
+UMBSBuildSystemRegistry* MBS::SEditorModeWidget::GetRegistry()
 {
-	TArray<AActor*> OutActors;
-	UGameplayStatics::GetAllActorsOfClass(GetEditorWorld(), Class, OutActors);
-	return OutActors.Num();
+	return UMBSBuildSystemRegistry::Get(GetEditorWorld());
 }
 
 UWorld* MBS::SEditorModeWidget::GetEditorWorld()
@@ -12,20 +12,18 @@
 #include "Engine/StaticMeshActor.h"
 #include "Components/InstancedStaticMeshComponent.h"
 
-void MBS::FHouseVisualizer::DrawVisualization(const UActorComponent* Component, const FSceneView* View,
-	FPrimitiveDrawInterface* PDI)
+void MBS::FHouseVisualizer::CacheLines(const UMBSActorVisualizationComponent* Component,
+	const AModularBuildSystemActor* BuildSystem, FVisualizerLineCache& OutCache) const
 {
-	FActorVisualizer::DrawVisualization(Component, View, PDI);
+	FActorVisualizer::CacheLines(Component, BuildSystem, OutCache);
 
 	const UHouseVisualizationComponent* VisualizationComponent = Cast<UHouseVisualizationComponent>(Component);
-	
-	// Visualize house
-	if (!VisualizationComponent->bVisualize)
+	const AHouseBuildSystemActor* MBS = Cast<const AHouseBuildSystemActor>(BuildSystem);
+	if (!VisualizationComponent || !MBS)
 	{
 		return;
 	}
 	
-	const AHouseBuildSystemActor* MBS = Cast<const AHouseBuildSystemActor>(VisualizationComponent->GetOwner());
 	const UMBSInterior* Interior = MBS->GetInterior();
 	const UMBSInteriorGenerator* InteriorGenerator = Interior ? Interior->GetGenerator() : nullptr;
 		
@@ -36,47 +34,64 @@ void MBS::FHouseVisualizer::DrawVisualization(const UActorComponent* Component,
 
 		if (MBS->IsOfInstancedMeshConfigurationType())
 		{
-			if (const FModularSectionInstanced* Section = MBS->GetInstancedSectionOfLevel(MBS->Basement))
+			// Basement may own multiple instance ranges of shared components
+			TArray<const FModularSectionInstanced*> BasementSections;
+			FBox BasementBox(ForceInit);
+			for (const FModularSectionInstanced* Section : MBS->GetInstancedSectionsOfLevel(MBS->Basement))
+			{
+				if (Section->IsValid())
+				{
+					BasementSections.Add(Section);
+					BasementBox += Section->GetBounds();
+				}
+			}
+
+			if (!BasementSections.IsEmpty())
 			{
-				const FBox& BasementBox = Section->GetISMC()->Bounds.GetBox();
-					
 				// Draw basement bounds
-				DrawBoundsBox(BasementBox, BasementBounds, PDI);
+				OutCache.AddChunk(BasementBounds, false).AddWireBox(BasementBox);
 
 				// Draw bounds at which interior can be generated
 				if (InteriorGenerator)
 				{
-					DrawInteriorAvailableBox(BasementBox, BasementBounds, InteriorBounds, InteriorGenerator, PDI);
+					CacheInteriorAvailableBox(BasementBox, BasementBounds, InteriorBounds, InteriorGenerator,
+						OutCache.AddChunk(BasementBounds.Color, InteriorBounds.LineThickness * 2.f,
+							InteriorBounds.DepthPriority, InteriorBounds.DepthBias, false));
 				}
 
 				if (BasementBounds.bVisualizeEachSection)
 				{
-					for (int32 i = 0; i < Section->GetISMC()->GetInstanceCount(); i++)
+					FVisualizerLineChunk& Chunk = OutCache.AddChunk(BasementBounds, true);
+					for (const FModularSectionInstanced* Section : BasementSections)
 					{
-						FTransform InstanceTransform;
-						Section->GetISMC()->GetInstanceTransform(i, InstanceTransform, true);
-							
-						const FBox& SingleSectionBox = FBox(InstanceTransform.GetLocation(),
-							InstanceTransform.GetLocation() + FVector(MBS->Basement.GetResolutionVec()));
-						DrawSingleModularSection(SingleSectionBox, BasementBounds, PDI);
+						for (int32 i = 0; i < Section->GetInstanceCount(); i++)
+						{
+							FTransform InstanceTransform;
+							Section->GetISMC()->GetInstanceTransform(Section->ToComponentIndex(i), InstanceTransform, true);
+
+							const FBox& SingleSectionBox = FBox(InstanceTransform.GetLocation(),
+								InstanceTransform.GetLocation() + FVector(MBS->Basement.GetResolutionVec()));
+							CacheSingleModularSection(SingleSectionBox, BasementBounds, Chunk);
+						}
 					}
 				}
 			}
 		}
 		else
 		{
+			FVisualizerLineChunk& Chunk = OutCache.AddChunk(BasementBounds, true);
 			for (const FModularSection* Section : MBS->GetSectionsOfLevel(MBS->Basement))
 			{
 				const FBox& BasementBox = Section->GetStaticMeshActor()->GetComponentsBoundingBox();
 					
 				// Draw basement bounds. TODO: Move out of loop to draw only once
-				DrawBoundsBox(BasementBox, BasementBounds, PDI);
+				Chunk.AddWireBox(BasementBox);
 
 				// Draw bounds at which interior can be generated. TODO: Move out of loop to draw only once
-				//DrawInteriorAvailableBox(BasementBox, BasementBounds, InteriorBounds, InteriorGenerator, PDI);
+				//CacheInteriorAvailableBox(BasementBox, BasementBounds, InteriorBounds, InteriorGenerator, Chunk);
 
 				// Draw single section
-				DrawSingleModularSection(BasementBox, BasementBounds, PDI);
+				CacheSingleModularSection(BasementBox, BasementBounds, Chunk);
 			}
 		}
 	}
@@ -85,7 +100,7 @@ void MBS::FHouseVisualizer::DrawVisualization(const UActorComponent* Component,
 	{
 		for (const auto& Wall : MBS->Walls)
 		{
-			DrawSingleModularLevel(MBS, Wall, VisualizationComponent->WallBounds, PDI);
+			CacheSingleModularLevel(MBS, Wall, VisualizationComponent->WallBounds, OutCache);
 		}
 	}
 
@@ -93,7 +108,7 @@ void MBS::FHouseVisualizer::DrawVisualization(const UActorComponent* Component,
 	{
 		for (const auto& Floor : MBS->Floors)
 		{
-			DrawSingleModularLevel(MBS, Floor, VisualizationComponent->FloorBounds, PDI);
+			CacheSingleModularLevel(MBS, Floor, VisualizationComponent->FloorBounds, OutCache);
 		}
 	}
 
@@ -101,61 +116,43 @@ void MBS::FHouseVisualizer::DrawVisualization(const UActorComponent* Component,
 	{
 		for (const auto& Corner : MBS->Corners)
 		{
-			DrawSingleModularLevel(MBS, Corner, VisualizationComponent->CornerBounds, PDI);
+			CacheSingleModularLevel(MBS, Corner, VisualizationComponent->CornerBounds, OutCache);
 		}
 	}
 
 	if (VisualizationComponent->bShowRoofBounds)
 	{
-		DrawSingleModularLevel(MBS, MBS->Roof, VisualizationComponent->RoofBounds, PDI);
+		CacheSingleModularLevel(MBS, MBS->Roof, VisualizationComponent->RoofBounds, OutCache);
 	}
 
 	if (VisualizationComponent->bShowRooftopBounds)
 	{
-		DrawSingleModularLevel(MBS, MBS->Rooftop, VisualizationComponent->RooftopBounds, PDI);
+		CacheSingleModularLevel(MBS, MBS->Rooftop, VisualizationComponent->RooftopBounds, OutCache);
 	}
 }
 
-void MBS::FHouseVisualizer::DrawBoundsBox(const FBox Box, const FMBSBoundsVisData& Bounds,
-	FPrimitiveDrawInterface* PDI)
-{
-	DrawWireBox(PDI,
-		Box,
-		Bounds.Color,
-		Bounds.DepthPriority,
-		Bounds.LineThickness,
-		Bounds.DepthBias);
-}
-
-void MBS::FHouseVisualizer::DrawInteriorAvailableBox(FBox Box, const FMBSBoundsVisData& BasementBounds,
+void MBS::FHouseVisualizer::CacheInteriorAvailableBox(FBox Box, const FMBSBoundsVisData& BasementBounds,
 	const FMBSBoundsVisData& InteriorBounds, const UMBSInteriorGenerator* InteriorGenerator, 
-	FPrimitiveDrawInterface* PDI)
+	FVisualizerLineChunk& OutChunk)
 {
 	check(InteriorGenerator);
 	InteriorGenerator->AdjustBoxToInteriorAllowedArea(Box, nullptr);
-	DrawDashedLine(PDI,
+	OutChunk.AddDashedLine(
 		FVector(Box.Min.X, Box.Min.Y, Box.Max.Z),
 		Box.Max,
 		BasementBounds.Color,
-		InteriorBounds.LineThickness * 4.f,
-		InteriorBounds.DepthPriority,
-		InteriorBounds.DepthBias);
+		InteriorBounds.LineThickness * 4.f);
 				
-	DrawDashedLine(PDI,
+	OutChunk.AddDashedLine(
 		FVector(Box.Min.X, Box.Max.Y, Box.Max.Z),
 		FVector(Box.Max.X, Box.Min.Y, Box.Max.Z),
 		BasementBounds.Color,
-		InteriorBounds.LineThickness * 4.f,
-		InteriorBounds.DepthPriority,
-		InteriorBounds.DepthBias);
+		InteriorBounds.LineThickness * 4.f);
 
 	// Set Min.Z to Max.Z as we only need plane
 	Box.Min.Z = Box.Max.Z;
-	DrawWireBox(PDI,
+	OutChunk.AddWireBox(
 		Box,
 		BasementBounds.Color,
-		InteriorBounds.DepthPriority,
-		InteriorBounds.LineThickness * 2.f,
-		InteriorBounds.DepthBias);
+		InteriorBounds.LineThickness * 2.f);
 }
-
@@ -51,6 +51,7 @@ void UMBSActorVisualizationComponent::PostEditChangeChainProperty(FPropertyChang
 	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
 	const auto StructProperty = PropertyChangedEvent.PropertyChain.GetHead()->GetValue();
 	const FName StructName = StructProperty->GetFName();
+	Revision++;
 	
 	UE_LOG(LogMBSEditor, Verbose, TEXT("%s: Property %s has been changed!"), *GetName(), *PropertyName.ToString());
 	if (GET_MEMBER_NAME_CHECKED(UMBSActorVisualizationComponent, bShowDimensions) == PropertyName
@@ -108,6 +109,7 @@ void UMBSActorVisualizationComponent::PostEditChangeChainProperty(FPropertyChang
 void UMBSActorVisualizationComponent::ResetColors()
 {
 	InteriorRoomColors.Empty();
+	Revision++;
 }
 
 FColor UMBSActorVisualizationComponent::GetOrMakeInteriorRoomColor(int32 AtIndex)
@@ -27,26 +27,36 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 	{
 		return;
 	}
-	
+
 	const AModularBuildSystemActor* MBS = Cast<const AModularBuildSystemActor>(VisualizationComponent->GetOwner());
 	if (!MBS)
 	{
 		UE_LOG(LogMBSEditor, Error, TEXT("MBS is nullptr!"));
 		return;
 	}
-	
+
+	FVisualizerLineCache& Cache = FindOrAddLineCache(VisualizationComponent);
+	const uint32 Revision = HashCombine(MBS->GetRevision(), VisualizationComponent->GetRevision());
+	if (Cache.IsOutdated(Revision, MBS->GetActorTransform()))
+	{
+		Cache.Reset(Revision, MBS->GetActorTransform());
+		CacheLines(VisualizationComponent, MBS, Cache);
+		UE_LOG(LogMBSEditor, VeryVerbose, TEXT("%s: Visualizer line cache was rebuilt with %d chunks and %d lines."),
+			*MBS->GetName(), Cache.GetChunkCount(), Cache.GetLineCount());
+	}
+
+	Cache.Draw(View, PDI, VisualizationComponent->GetCulling());
+}
+
+void MBS::FActorVisualizer::CacheLines(const UMBSActorVisualizationComponent* VisualizationComponent,
+	const AModularBuildSystemActor* MBS, FVisualizerLineCache& OutCache) const
+{
 	// Draw box
 	if (VisualizationComponent->bShowBuildSystemBounds)
 	{
 		const FMBSBoundsVisData& BuildSystemBounds = VisualizationComponent->BuildSystemBounds;
 		const FBox& Bounds = MBS->GetBoundsBox(false);
-		DrawWireBox(PDI,
-			//VisualizationComponent->GetOwner()->GetComponentsBoundingBox(),
-			Bounds,
-			BuildSystemBounds.Color,
-			BuildSystemBounds.DepthPriority,
-			BuildSystemBounds.LineThickness,
-			BuildSystemBounds.DepthBias);
+		OutCache.AddChunk(BuildSystemBounds, false).AddWireBox(Bounds);
 	}
 
 	const FMBSBoundsVisData& InteriorBounds = VisualizationComponent->InteriorBounds;
@@ -54,14 +64,13 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 	{
 		if (const UMBSInterior* Interior = MBS->GetInterior())
 		{
+			FVisualizerLineChunk& Chunk = OutCache.AddChunk(InteriorBounds, true);
 			for (const auto& Actor : Interior->GetInteriorActors())
 			{
-				DrawWireBox(PDI,
-					Actor->GetComponentsBoundingBox(),
-					InteriorBounds.Color,
-					InteriorBounds.DepthPriority,
-					InteriorBounds.LineThickness,
-					InteriorBounds.DepthBias);
+				if (Actor)
+				{
+					Chunk.AddWireBox(Actor->GetComponentsBoundingBox());
+				}
 			}
 		}
 	}
@@ -79,23 +88,12 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 			{
 				//FColor::MakeRandomColor();
 				const FColor Color = UMBSActorVisualizationComponent::GetOrMakeInteriorRoomColor(i);
-					
-				DrawWireBox(PDI,
-					Rooms[i].Bounds,
-					Color,
-					InteriorBounds.DepthPriority,
-					InteriorBounds.LineThickness,
-					InteriorBounds.DepthBias);
-
-				DrawDashedLine(PDI,
-					Rooms[i].Bounds.Min,
-					Rooms[i].Bounds.Max,
-					Color,
-					InteriorBounds.LineThickness,
-					InteriorBounds.DepthPriority,
-					InteriorBounds.DepthBias);
-					
-				//DrawLine(Rooms[i].Bounds.Min, Rooms[i].Bounds.Max, InteriorBounds, PDI);
+
+				// Each room is a separate chunk, so rooms out of view are culled individually
+				FVisualizerLineChunk& Chunk = OutCache.AddChunk(Color, InteriorBounds.LineThickness,
+					InteriorBounds.DepthPriority, InteriorBounds.DepthBias, false);
+				Chunk.AddWireBox(Rooms[i].Bounds);
+				Chunk.AddDashedLine(Rooms[i].Bounds.Min, Rooms[i].Bounds.Max, Color, InteriorBounds.LineThickness);
 			}
 		}
 	}
@@ -108,6 +106,7 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 			const FMBSBoundsVisData& VisData = VisualizationComponent->TransformBounds;
 			const FVector BuildSystemLocation = MBS->GetActorLocation();
 			//const FRotator BuildSystemRotation = MBS->GetActorRotation();
+			FVisualizerLineChunk& Chunk = OutCache.AddChunk(VisData, false);
 
 			// TODO: Currently, those locations are relative to the MBS, and I need the world coords of them
 			const FVector Front = Bounds.GetTransforms().FrontLocation + BuildSystemLocation;
@@ -115,17 +114,17 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 			const FVector Back = Bounds.GetTransforms().BackLocation + BuildSystemLocation;
 			const FVector Left = Bounds.GetTransforms().LeftLocation + BuildSystemLocation;
 			// TODO: Rotate the coords by the MBS actor rotation
-			DrawRectangle(Front, Right, Back, Left, VisData, PDI);
-				
+			CacheRectangle(Front, Right, Back, Left, Chunk);
+
 			// Then again the same way at the Top.Z location
 			// TODO: Same as with the above locations
 			const FVector Top = Bounds.GetTransforms().TopLocation + BuildSystemLocation;
-			DrawRectangle(
+			CacheRectangle(
 				FVector(Front.X, Front.Y, Top.Z),
 				FVector(Right.X, Right.Y, Top.Z),
 				FVector(Back.X, Back.Y, Top.Z),
 				FVector(Left.X, Left.Y, Top.Z),
-				VisData, PDI);
+				Chunk);
 		}
 	}
 
@@ -139,14 +138,17 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 			//check(VisData.XText && VisData.YText && VisData.ZText);
 			if (VisData.IsValid())
 			{
+				FVisualizerLineChunk& Chunk = OutCache.AddChunk(FLinearColor::White, VisData.LineThickness,
+					VisData.DepthPriority, VisData.DepthBias, false);
 				auto DrawDimensionLines = [&](const FVector Start, const FVector End, const FVector Moustache,
 					const FLinearColor& Color)
 				{
-					DrawLine(Start, End, VisData, Color, PDI);
-					DrawLine(Start - Moustache, Start + Moustache, VisData, Color, PDI);
-					DrawLine(End - Moustache, End + Moustache, VisData, Color, PDI);
+					Chunk.AddDashedLine(Start, End, Color, VisData.LineThickness);
+					Chunk.AddDashedLine(Start - Moustache, Start + Moustache, Color, VisData.LineThickness);
+					Chunk.AddDashedLine(End - Moustache, End + Moustache, Color, VisData.LineThickness);
 				};
 
+				// Text components are only updated together with the cache, instead of on each draw
 				// X
 				{
 					// Init XText
@@ -183,7 +185,7 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 					VisData.ZText->SetText(FText::FromString(FString::FromInt(Bounds.GetBounds().Z)));
 					VisData.ZText->SetRelativeLocation(Bounds.GetTransforms().TopLocation - FVector(VisData.TextOffsets.Z, 0.f, 0.f));
 					VisData.ZText->SetRelativeRotation(FRotator(0.f, 180.f, 0.f));
-						
+
 					// Draw ZText
 					const FVector LeftFrontZ = Bounds.GetTransforms().LeftFront() + BuildSystemLocation + FVector(0.f, 0.f, 50.f);
 					const FVector TopLeftFront = Bounds.GetTransforms().TopLeftFront() + BuildSystemLocation + FVector(0.f, 0.f, -50.f);
@@ -199,6 +201,7 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 		const FMBSGridVisData& VisData = VisualizationComponent->Grid;
 		const FTransform& MBSTransform = MBS->GetActorTransform();
 		const FVector StretchCoefficients = MBS->GetStretchManager().GetScaleCoefficientsSwappedXY();
+		FVisualizerLineChunk& Chunk = OutCache.AddChunk(VisData, true);
 		for (int32 x = 0; x < VisData.CellCount; x++)
 		{
 			for (int32 y = 0; y < VisData.CellCount; y++)
@@ -208,7 +211,7 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 				const FVector Right = Cell.BottomRightRelative();
 				const FVector Back = Cell.TopRightRelative();
 				const FVector Left = Cell.TopLeftRelative();
-				DrawRectangle(Front, Right, Back, Left, static_cast<FMBSVisDataBase>(VisData), PDI);
+				CacheRectangle(Front, Right, Back, Left, Chunk);
 			}
 		}
 	}
@@ -219,15 +222,16 @@ void MBS::FActorVisualizer::DrawVisualization(const UActorComponent* Component,
 		const FVector& MBSLoc = MBS->GetActorTransform().GetLocation();
 		for (const auto& Elem : VisData.CustomDrawElements)
 		{
+			FVisualizerLineChunk& Chunk = OutCache.AddChunk(Elem, false);
 			for (const auto& Line : Elem.LinesToDraw)
 			{
 				if (Elem.bRelative)
 				{
-					DrawLine(Line.v1 + MBSLoc, Line.v2 + MBSLoc, static_cast<FMBSVisDataBase>(Elem), PDI);
+					Chunk.AddDashedLine(Line.v1 + MBSLoc, Line.v2 + MBSLoc, Elem.Color, Elem.LineThickness);
 				}
 				else
 				{
-					DrawLine(Line.v1, Line.v2, static_cast<FMBSVisDataBase>(Elem), PDI);
+					Chunk.AddDashedLine(Line.v1, Line.v2, Elem.Color, Elem.LineThickness);
 				}
 			}
 		}
@@ -244,14 +248,19 @@ void MBS::FActorVisualizer::DrawVisualizationHUD(const UActorComponent* Componen
 	{
 		return;
 	}
-	
+
 	const AModularBuildSystemActor* MBS = Cast<const AModularBuildSystemActor>(VisualizationComponent->GetOwner());
+	const FMBSCullingVisData& Culling = VisualizationComponent->GetCulling();
 	if (const UMBSInterior* Interior = MBS->GetInterior())
 	{
 		if (VisualizationComponent->bShowInteriorActorNames)
 		{
 			for (const auto& Actor : Interior->GetInteriorActors())
 			{
+				if (!Actor || !FVisualizerLineCache::IsWithinDrawDistance(View, Actor->GetActorLocation(), Culling))
+				{
+					continue;
+				}
 				DrawText(
 					Actor->GetActorLocation(),
 					Actor->GetName(),
@@ -266,8 +275,13 @@ void MBS::FActorVisualizer::DrawVisualizationHUD(const UActorComponent* Componen
 		{
 			for (int32 i = 0; i < Interior->GetRooms().Num(); i++)
 			{
+				const FVector RoomCenter = Interior->GetRooms()[i].Bounds.GetCenter();
+				if (!FVisualizerLineCache::IsWithinDrawDistance(View, RoomCenter, Culling))
+				{
+					continue;
+				}
 				DrawText(
-					Interior->GetRooms()[i].Bounds.GetCenter(),
+					RoomCenter,
 					Interior->GetRooms()[i].Name.ToString(),
 					UMBSActorVisualizationComponent::GetOrMakeInteriorRoomColor(i),
 					Viewport,
@@ -290,67 +304,78 @@ void MBS::FActorVisualizer::DrawVisualizationHUD(const UActorComponent* Componen
 				for (int32 y = 0; y < VisData.CellCount; y++)
 				{
 					const MBS::FGridCell3D Cell(x, y, VisData.ZIndex, MBSTransform, StretchCoefficients, true);
-					DrawText(Cell.CenterRelative(), Cell.GetCode(), VisData.TextColor, Viewport, View, Canvas);
+					if (FVisualizerLineCache::IsWithinDrawDistance(View, Cell.CenterRelative(), Culling))
+					{
+						DrawText(Cell.CenterRelative(), Cell.GetCode(), VisData.TextColor, Viewport, View, Canvas);
+					}
 				}
 			}
 		}
 	}
 }
 
-void MBS::FActorVisualizer::DrawDiamond(FVector Front, FVector Right, FVector Back, FVector Left,
-	FMBSVisDataBase VisData, FPrimitiveDrawInterface* PDI)
+MBS::FVisualizerLineCache& MBS::FActorVisualizer::FindOrAddLineCache(const UActorComponent* Component)
+{
+	const TObjectKey<UActorComponent> Key(Component);
+	if (FVisualizerLineCache* ExistingCache = LineCaches.Find(Key))
+	{
+		return *ExistingCache;
+	}
+
+	// Remove caches of destroyed components before adding a new one, so the map does not grow over the editor session
+	for (auto It = LineCaches.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	return LineCaches.Add(Key);
+}
+
+void MBS::FActorVisualizer::CacheDiamond(FVector Front, FVector Right, FVector Back, FVector Left,
+	FVisualizerLineChunk& OutChunk)
 {
 	// From front to right
-	DrawDashedLine(
-		PDI, Front, Right, VisData.Color, VisData.LineThickness, VisData.DepthPriority, VisData.DepthBias);
+	OutChunk.AddDashedLine(Front, Right, OutChunk.Color, OutChunk.Thickness);
 
 	// Front right to back
-	DrawDashedLine(
-		PDI, Right, Back, VisData.Color, VisData.LineThickness, VisData.DepthPriority, VisData.DepthBias);
+	OutChunk.AddDashedLine(Right, Back, OutChunk.Color, OutChunk.Thickness);
 
 	// From back to left
-	DrawDashedLine(
-		PDI, Back, Left, VisData.Color, VisData.LineThickness, VisData.DepthPriority, VisData.DepthBias);
+	OutChunk.AddDashedLine(Back, Left, OutChunk.Color, OutChunk.Thickness);
 
 	// From left to front
-	DrawDashedLine(
-		PDI, Left, Front, VisData.Color, VisData.LineThickness, VisData.DepthPriority, VisData.DepthBias);
+	OutChunk.AddDashedLine(Left, Front, OutChunk.Color, OutChunk.Thickness);
 }
 
-void MBS::FActorVisualizer::DrawRectangle(FVector Front, FVector Right, FVector Back, FVector Left,
-	FMBSVisDataBase VisData, FPrimitiveDrawInterface* PDI)
+void MBS::FActorVisualizer::CacheRectangle(FVector Front, FVector Right, FVector Back, FVector Left,
+	FVisualizerLineChunk& OutChunk)
 {
+	const auto AddLine = [&OutChunk](const FVector& Start, const FVector& End)
+	{
+		OutChunk.AddDashedLine(Start, End, OutChunk.Color, OutChunk.Thickness);
+	};
+
 	// From front to right
 	const FVector FrontRightEdge = FVector(Front.X, Right.Y, Right.Z);
-	DrawLine(Front, FrontRightEdge, VisData, PDI);
-	DrawLine(FrontRightEdge, Right, VisData, PDI);
+	AddLine(Front, FrontRightEdge);
+	AddLine(FrontRightEdge, Right);
 
 	// Front right to back
 	const FVector RightBackEdge = FVector(Back.X, Right.Y, Back.Z);
-	DrawLine(Right, RightBackEdge, VisData, PDI);
-	DrawLine(RightBackEdge, Back, VisData, PDI);
+	AddLine(Right, RightBackEdge);
+	AddLine(RightBackEdge, Back);
 
 	// From back to left
 	const FVector BackLeftEdge = FVector(Back.X, Left.Y, Left.Z);
-	DrawLine(Back, BackLeftEdge, VisData, PDI);
-	DrawLine(BackLeftEdge, Left, VisData, PDI);
+	AddLine(Back, BackLeftEdge);
+	AddLine(BackLeftEdge, Left);
 
 	// From left to front
 	const FVector LeftFrontEdge = FVector(Front.X, Left.Y, Front.Z);
-	DrawLine(Left, LeftFrontEdge, VisData, PDI);
-	DrawLine(LeftFrontEdge, Front, VisData, PDI);
-}
-
-void MBS::FActorVisualizer::DrawLine(FVector Start, FVector End, FMBSVisDataBase VisData,
-	FPrimitiveDrawInterface* PDI)
-{
-	DrawDashedLine(PDI, Start, End, VisData.Color, VisData.LineThickness, VisData.DepthPriority, VisData.DepthBias);
-}
-
-void MBS::FActorVisualizer::DrawLine(FVector Start, FVector End, FMBSDimensionsVisData VisData,
-	const FLinearColor& Color, FPrimitiveDrawInterface* PDI)
-{
-	DrawDashedLine(PDI, Start, End, Color, VisData.LineThickness, VisData.DepthPriority, VisData.DepthBias);
+	AddLine(Left, LeftFrontEdge);
+	AddLine(LeftFrontEdge, Front);
 }
 
 void MBS::FActorVisualizer::DrawText(const FVector Location, const FString DisplayString, const FLinearColor FontColor,
@@ -358,7 +383,7 @@ void MBS::FActorVisualizer::DrawText(const FVector Location, const FString Displ
 {
 	const int32 HalfX = 0.5f * Viewport->GetSizeXY().X;
 	const int32 HalfY = 0.5f * Viewport->GetSizeXY().Y;
- 
+
 	const FPlane Proj = View->Project(Location);
 	if (Proj.W > 0.f)
 	{
@@ -371,47 +396,38 @@ void MBS::FActorVisualizer::DrawText(const FVector Location, const FString Displ
 	}
 }
 
-void MBS::FActorVisualizer::DrawSingleModularSection(const FBox Box, const FMBSBoundsVisData& Bounds,
-	FPrimitiveDrawInterface* PDI)
+void MBS::FActorVisualizer::CacheSingleModularSection(const FBox Box, const FMBSBoundsVisData& Bounds,
+	FVisualizerLineChunk& OutChunk)
 {
-	const auto DrawSingleLine = [&](const FVector& Start, const FVector& End)
-	{
-		DrawDashedLine(PDI,
-			Start,
-			End,
-			Bounds.Color,
-			Bounds.LineThickness * 2.f,
-			Bounds.DepthPriority,
-			Bounds.DepthBias);
-	};
-	
-	DrawWireBox(PDI,
-		Box,
-		Bounds.Color,
-		Bounds.DepthPriority,
-		Bounds.LineThickness,
-		Bounds.DepthBias);
-
-	DrawSingleLine(
+	OutChunk.AddWireBox(Box, Bounds.Color, Bounds.LineThickness);
+	OutChunk.AddDashedLine(
 		FVector(Box.Min.X, Box.Min.Y, Box.Max.Z),
-		FVector(Box.Max.X, Box.Max.Y, Box.Max.Z));
+		FVector(Box.Max.X, Box.Max.Y, Box.Max.Z),
+		Bounds.Color,
+		Bounds.LineThickness * 2.f);
 }
 
-void MBS::FActorVisualizer::DrawSingleModularLevel(const AModularBuildSystemActor* BS, const FModularLevel& InLevel,
-	const FMBSBoundsVisData& Bounds, FPrimitiveDrawInterface* PDI)
+void MBS::FActorVisualizer::CacheSingleModularLevel(const AModularBuildSystemActor* BS, const FModularLevel& InLevel,
+	const FMBSBoundsVisData& Bounds, FVisualizerLineCache& OutCache)
 {
+	// Each level is a separate chunk, so it can be culled and collapsed to a single box independently
+	FVisualizerLineChunk& Chunk = OutCache.AddChunk(Bounds, true);
 	if (BS->IsOfInstancedMeshConfigurationType())
 	{
-		if (const FModularSectionInstanced* Section = BS->GetInstancedSectionOfLevel(InLevel))
+		// Level may own multiple instance ranges of shared components, so each of them is drawn
+		for (const FModularSectionInstanced* Section : BS->GetInstancedSectionsOfLevel(InLevel))
 		{
-			DrawSingleModularSection(Section->GetISMC()->Bounds.GetBox(), Bounds, PDI);
+			if (Section->IsValid())
+			{
+				CacheSingleModularSection(Section->GetBounds(), Bounds, Chunk);
+			}
 		}
 	}
 	else
 	{
 		for (const FModularSection* Section : BS->GetSectionsOfLevel(InLevel))
 		{
-			DrawSingleModularSection(Section->GetStaticMeshActor()->GetComponentsBoundingBox(), Bounds, PDI);
+			CacheSingleModularSection(Section->GetStaticMeshActor()->GetComponentsBoundingBox(), Bounds, Chunk);
 		}
 	}
 }
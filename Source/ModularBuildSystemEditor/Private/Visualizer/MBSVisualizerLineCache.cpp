@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Visualizer/MBSVisualizerLineCache.h"
+
+#include "Containers/SortedMap.h"
+#include "SceneManagement.h"
+#include "SceneView.h"
+#include "Visualizer/MBSActorVisualizationComponent.h"
+
+namespace
+{
+template<typename FuncType>
+void ForEachBoxEdge(const FBox& Box, FuncType&& Func)
+{
+	const FVector& Min = Box.Min;
+	const FVector& Max = Box.Max;
+
+	// Bottom
+	Func(FVector(Min.X, Min.Y, Min.Z), FVector(Max.X, Min.Y, Min.Z));
+	Func(FVector(Max.X, Min.Y, Min.Z), FVector(Max.X, Max.Y, Min.Z));
+	Func(FVector(Max.X, Max.Y, Min.Z), FVector(Min.X, Max.Y, Min.Z));
+	Func(FVector(Min.X, Max.Y, Min.Z), FVector(Min.X, Min.Y, Min.Z));
+
+	// Top
+	Func(FVector(Min.X, Min.Y, Max.Z), FVector(Max.X, Min.Y, Max.Z));
+	Func(FVector(Max.X, Min.Y, Max.Z), FVector(Max.X, Max.Y, Max.Z));
+	Func(FVector(Max.X, Max.Y, Max.Z), FVector(Min.X, Max.Y, Max.Z));
+	Func(FVector(Min.X, Max.Y, Max.Z), FVector(Min.X, Min.Y, Max.Z));
+
+	// Sides
+	Func(FVector(Min.X, Min.Y, Min.Z), FVector(Min.X, Min.Y, Max.Z));
+	Func(FVector(Max.X, Min.Y, Min.Z), FVector(Max.X, Min.Y, Max.Z));
+	Func(FVector(Max.X, Max.Y, Min.Z), FVector(Max.X, Max.Y, Max.Z));
+	Func(FVector(Min.X, Max.Y, Min.Z), FVector(Min.X, Max.Y, Max.Z));
+}
+
+constexpr int32 BoxEdgeCount = 12;
+}
+
+void MBS::FVisualizerLineChunk::AddLine(const FVector& Start, const FVector& End, const FLinearColor& InColor,
+	float InThickness)
+{
+	Lines.Add({Start, End, InColor, InThickness});
+	Bounds += Start;
+	Bounds += End;
+}
+
+void MBS::FVisualizerLineChunk::AddDashedLine(const FVector& Start, const FVector& End, const FLinearColor& InColor,
+	float DashSize)
+{
+	FVector LineDir = End - Start;
+	double LineLeft = LineDir.Size();
+	if (LineLeft <= 0.0 || DashSize <= 0.f)
+	{
+		return;
+	}
+	LineDir /= LineLeft;
+
+	Lines.Reserve(Lines.Num() + FMath::CeilToInt32(LineLeft / (DashSize * 2.0)));
+	const FVector Dash = DashSize * LineDir;
+	FVector DrawStart = Start;
+	while (LineLeft > DashSize)
+	{
+		const FVector DrawEnd = DrawStart + Dash;
+		Lines.Add({DrawStart, DrawEnd, InColor, 0.f});
+		LineLeft -= 2.0 * DashSize;
+		DrawStart = DrawEnd + Dash;
+	}
+	if (LineLeft > 0.0)
+	{
+		Lines.Add({DrawStart, End, InColor, 0.f});
+	}
+
+	Bounds += Start;
+	Bounds += End;
+}
+
+void MBS::FVisualizerLineChunk::AddWireBox(const FBox& Box, const FLinearColor& InColor, float InThickness)
+{
+	if (!Box.IsValid)
+	{
+		return;
+	}
+
+	Lines.Reserve(Lines.Num() + BoxEdgeCount);
+	ForEachBoxEdge(Box, [&](const FVector& Start, const FVector& End)
+	{
+		Lines.Add({Start, End, InColor, InThickness});
+	});
+	Bounds += Box;
+}
+
+bool MBS::FVisualizerLineCache::IsOutdated(uint32 InRevision, const FTransform& InTransform) const
+{
+	return !bValid || Revision != InRevision || !Transform.Equals(InTransform);
+}
+
+void MBS::FVisualizerLineCache::Reset(uint32 InRevision, const FTransform& InTransform)
+{
+	Chunks.Reset();
+	Revision = InRevision;
+	Transform = InTransform;
+	bValid = true;
+}
+
+MBS::FVisualizerLineChunk& MBS::FVisualizerLineCache::AddChunk(const FMBSVisDataBase& VisData, bool bCollapsible)
+{
+	return AddChunk(VisData.Color, VisData.LineThickness, VisData.DepthPriority, VisData.DepthBias, bCollapsible);
+}
+
+MBS::FVisualizerLineChunk& MBS::FVisualizerLineCache::AddChunk(const FLinearColor& InColor, float InThickness,
+	uint8 InDepthPriority, float InDepthBias, bool bCollapsible)
+{
+	FVisualizerLineChunk& NewChunk = Chunks.AddDefaulted_GetRef();
+	NewChunk.Color = InColor;
+	NewChunk.Thickness = InThickness;
+	NewChunk.DepthPriority = InDepthPriority;
+	NewChunk.DepthBias = InDepthBias;
+	NewChunk.bCollapsible = bCollapsible;
+	return NewChunk;
+}
+
+void MBS::FVisualizerLineCache::Draw(const FSceneView* View, FPrimitiveDrawInterface* PDI,
+	const FMBSCullingVisData& Culling) const
+{
+	// Distance based culling and collapsing make no sense in orthographic viewports
+	const bool bUseDistance = View->IsPerspectiveProjection();
+	const FVector ViewOrigin = View->ViewMatrices.GetViewOrigin();
+	const double MaxDistanceSquared = Culling.MaxDrawDistance > 0.f
+		? FMath::Square(static_cast<double>(Culling.MaxDrawDistance))
+		: TNumericLimits<double>::Max();
+	const double SummaryDistanceSquared = Culling.SummaryDistance > 0.f
+		? FMath::Square(static_cast<double>(Culling.SummaryDistance))
+		: TNumericLimits<double>::Max();
+
+	struct FVisibleChunk
+	{
+		const FVisualizerLineChunk* Chunk;
+		bool bCollapsed;
+	};
+
+	struct FReservation
+	{
+		int32 LineCount = 0;
+		bool bDepthBiased = false;
+		bool bThickLines = false;
+	};
+
+	// Collect visible chunks first, so the lines of each depth priority group are reserved only once
+	TArray<FVisibleChunk, TInlineAllocator<32>> VisibleChunks;
+	TSortedMap<uint8, FReservation> Reservations;
+	for (const FVisualizerLineChunk& Chunk : Chunks)
+	{
+		if (Chunk.Lines.IsEmpty() || !Chunk.Bounds.IsValid)
+		{
+			continue;
+		}
+
+		if (Culling.bFrustumCulling && !View->ViewFrustum.IntersectBox(Chunk.Bounds.GetCenter(), Chunk.Bounds.GetExtent()))
+		{
+			continue;
+		}
+
+		bool bCollapsed = false;
+		if (bUseDistance)
+		{
+			const double DistanceSquared = Chunk.Bounds.ComputeSquaredDistanceToPoint(ViewOrigin);
+			if (DistanceSquared > MaxDistanceSquared)
+			{
+				continue;
+			}
+			bCollapsed = Chunk.bCollapsible && Chunk.Lines.Num() > BoxEdgeCount && DistanceSquared > SummaryDistanceSquared;
+		}
+
+		VisibleChunks.Add({&Chunk, bCollapsed});
+		FReservation& Reservation = Reservations.FindOrAdd(Chunk.DepthPriority);
+		Reservation.LineCount += bCollapsed ? BoxEdgeCount : Chunk.Lines.Num();
+		Reservation.bDepthBiased |= Chunk.DepthBias != 0.f;
+		Reservation.bThickLines |= Chunk.Thickness > 0.f;
+	}
+
+	for (const auto& Pair : Reservations)
+	{
+		PDI->AddReserveLines(Pair.Key, Pair.Value.LineCount, Pair.Value.bDepthBiased, Pair.Value.bThickLines);
+	}
+
+	for (const FVisibleChunk& Visible : VisibleChunks)
+	{
+		const FVisualizerLineChunk& Chunk = *Visible.Chunk;
+		if (Visible.bCollapsed)
+		{
+			ForEachBoxEdge(Chunk.Bounds, [&](const FVector& Start, const FVector& End)
+			{
+				PDI->DrawLine(Start, End, Chunk.Color, Chunk.DepthPriority, Chunk.Thickness, Chunk.DepthBias);
+			});
+			continue;
+		}
+
+		for (const FVisualizerLine& Line : Chunk.Lines)
+		{
+			PDI->DrawLine(Line.Start, Line.End, Line.Color, Chunk.DepthPriority, Line.Thickness, Chunk.DepthBias);
+		}
+	}
+}
+
+int32 MBS::FVisualizerLineCache::GetLineCount() const
+{
+	int32 OutCount = 0;
+	for (const FVisualizerLineChunk& Chunk : Chunks)
+	{
+		OutCount += Chunk.Lines.Num();
+	}
+	return OutCount;
+}
+
+bool MBS::FVisualizerLineCache::IsWithinDrawDistance(const FSceneView* View, const FVector& Location,
+	const FMBSCullingVisData& Culling)
+{
+	if (!View->IsPerspectiveProjection() || Culling.MaxDrawDistance <= 0.f)
+	{
+		return true;
+	}
+	return FVector::DistSquared(View->ViewMatrices.GetViewOrigin(), Location) <= FMath::Square(Culling.MaxDrawDistance);
+}
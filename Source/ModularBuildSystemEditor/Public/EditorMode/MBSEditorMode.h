@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "EdMode.h"
 #include "MBSEditorObject.h"
+#include "MBSSectionsBVH.h"
 
 class AModularBuildSystemActor;
 
@@ -35,7 +36,18 @@ public:
 	
 private:	
 	TWeakObjectPtr<AModularBuildSystemActor> CurrentSelectedBuildSystem;
-	int32 CurrentSelectedIndex = -1;
+
+	/**
+	 * Index of the selected section in the sections array of its type.
+	 * @see FMBSSectionHit::SectionIndex
+	 */
+	int32 CurrentSelectedSectionIndex = INDEX_NONE;
+
+	/**
+	 * Index of the selected instance inside of the selected instanced section, or INDEX_NONE if non-instanced section
+	 * is selected.
+	 */
+	int32 CurrentSelectedInstanceIndex = INDEX_NONE;
 	
 	FIntRect ViewRect;
 	FViewMatrices ViewMatrices;
@@ -49,6 +61,23 @@ private:
 	TArray<FHighlightedActor> HighlightedStaticMeshActors;
 	TObjectPtr<AStaticMeshActor> HighlightedActor = nullptr;
 	TObjectPtr<UMaterialInterface> HighlightedActorOriginalMaterial = nullptr;
+
+	/**
+	 * Picking hierarchies of each build system. Each one is rebuilt only when its build system has changed.
+	 */
+	TMap<TWeakObjectPtr<AModularBuildSystemActor>, FMBSSectionsBVH> PickingBVHs;
+
+	/**
+	 * Cursor ray and hit of the last hover query. Hover query is skipped if the cursor ray has not changed since then.
+	 */
+	FVector LastHoverOrigin = FVector::ZeroVector;
+	FVector LastHoverDirection = FVector::ZeroVector;
+	FMBSSectionHit LastHoverHit;
+
+	FDelegateHandle OnActorMovedHandle;
+	FDelegateHandle OnObjectPropertyChangedHandle;
+
+	static constexpr double PickDistance = 1000000.0;
 	
 public:
 	FEditorMode();
@@ -63,14 +92,35 @@ public:
 
 private:
 	void BindCommands();
-	void OnMouseMoveSectionHighlight(const FViewportCursorLocation& CursorLocation);
-	void OnMouseMoveSystemHighlight(const FViewportCursorLocation& CursorLocation);
+	void OnMouseMoveSectionHighlight(const FMBSSectionHit& Hit);
+	void OnMouseMoveSystemHighlight(const FMBSSectionHit& Hit);
 	void ResetHighlightedActor(FHighlightedActor& InHighlightedActor);
 	static void ResetHighlightedActor(TObjectPtr<AStaticMeshActor>& InHighlightedActor, TObjectPtr<UMaterialInterface>& InHighlightedActorOriginalMaterial);
 	void ResetHighlightedActor();
 	void HighlightActor(AStaticMeshActor* InNewHighlightedActor, FHighlightedActor& InHighlightedActor);
 	void HighlightActor(AStaticMeshActor* InNewHighlightedActor, TObjectPtr<AStaticMeshActor>& InHighlightedActor, TObjectPtr<UMaterialInterface>& InHighlightedActorOriginalMaterial);
-	AActor* GetActorAtLocation(const FViewportCursorLocation& Location) const;
+	/**
+	 * Finds the closest section of any build system under the cursor using picking hierarchies of build systems.
+	 * Build systems are tested in the order of distance to their bounds, so hierarchies of build systems behind the
+	 * closest hit are not walked.
+	 * @param Location Cursor location.
+	 * @param OutHit Closest hit.
+	 * @return True if any section was hit.
+	 */
+	bool Raycast(const FViewportCursorLocation& Location, FMBSSectionHit& OutHit);
+
+	/**
+	 * Updates LastHoverHit with the hit under the cursor. Query is skipped if the cursor ray has not changed.
+	 * @return True if query was performed.
+	 */
+	bool UpdateHoverHit(const FViewportCursorLocation& Location);
+
+	/**
+	 * Marks picking hierarchy of a build system related to the actor (either the build system itself or its section) as outdated.
+	 */
+	void MarkPickingDirty(UObject* InObject);
+	void OnActorMoved(AActor* InActor);
+	void OnObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent);
 
 	void OnSetOperationsCommand() const;
 	void OnSetSelectCommand() const;
@@ -7,6 +7,7 @@
 #include "StatusBarSubsystem.h"
 
 class AModularBuildSystemActor;
+class UMBSBuildSystemRegistry;
 
 namespace MBS
 {
@@ -56,23 +57,11 @@ private:
 	void RefreshDetailsPanel() const;
 	bool SetIsVisible(const FPropertyAndParent& InPropertyAndParent) const;
 
-	static int32 GetCountOf(TSubclassOf<AActor> Class);
-
-	template<class T>
-	static int32 GetCountOf(TSubclassOf<T> Class, TFunction<bool(T*)> ForEach)
-	{
-		TArray<AActor*> OutActors;
-		UGameplayStatics::GetAllActorsOfClass(GetEditorWorld(), Class, OutActors);
-		int32 OutCount = 0;
-		for (int32 i = 0; i < OutActors.Num(); i++)
-		{
-			if (ForEach(Cast<T>(OutActors[i])))
-			{
-				OutCount++;
-			}
-		}
-		return OutCount;
-	}
+	/**
+	 * @return Build system registry of the editor world. Counters of the registry are cached, so they are cheap
+	 * enough to be read on each paint.
+	 */
+	static UMBSBuildSystemRegistry* GetRegistry();
 	static UWorld* GetEditorWorld();
 };
 }
@@ -16,15 +16,13 @@ namespace MBS
  */
 class MODULARBUILDSYSTEMEDITOR_API FHouseVisualizer : public FActorVisualizer
 {
-public:
-	virtual void DrawVisualization(const UActorComponent* Component, const FSceneView* View,
-		FPrimitiveDrawInterface* PDI) override;
+protected:
+	virtual void CacheLines(const UMBSActorVisualizationComponent* VisualizationComponent,
+		const AModularBuildSystemActor* MBS, FVisualizerLineCache& OutCache) const override;
 
 private:
-	static void DrawBoundsBox(const FBox Box, const FMBSBoundsVisData& Bounds, FPrimitiveDrawInterface* PDI);
-	
-	static void DrawInteriorAvailableBox(FBox Box, const FMBSBoundsVisData& BasementBounds,
+	static void CacheInteriorAvailableBox(FBox Box, const FMBSBoundsVisData& BasementBounds,
 		const FMBSBoundsVisData& InteriorBounds, const UMBSInteriorGenerator* InteriorGenerator, 
-		FPrimitiveDrawInterface* PDI);
+		FVisualizerLineChunk& OutChunk);
 };
 }
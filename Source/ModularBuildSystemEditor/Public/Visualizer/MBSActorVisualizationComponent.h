@@ -102,6 +102,28 @@ struct FMBSGridVisData : public FMBSVisDataBase
 	bool bShowText = true;
 };
 
+USTRUCT(BlueprintType)
+struct FMBSCullingVisData
+{
+	GENERATED_BODY()
+
+	/**
+	 * Geometry and text further than this distance from the viewport camera are not drawn. Zero means no limit.
+	 */
+	UPROPERTY(EditAnywhere, Category=Visualizer, meta=(ClampMin=0, Units="Centimeters"))
+	float MaxDrawDistance = 200000.f;
+
+	/**
+	 * Levels further than this distance from the viewport camera are drawn as a single box instead of each section.
+	 * Zero means levels are never collapsed.
+	 */
+	UPROPERTY(EditAnywhere, Category=Visualizer, meta=(ClampMin=0, Units="Centimeters"))
+	float SummaryDistance = 20000.f;
+
+	UPROPERTY(EditAnywhere, Category=Visualizer)
+	bool bFrustumCulling = true;
+};
+
 USTRUCT(BlueprintType)
 struct FMBSCustomVisDataElement : public FMBSVisDataBase
 {
@@ -186,6 +208,14 @@ private:
 	
 	UPROPERTY(EditAnywhere, Category="Visualizer|Custom")
 	FMBSCustomVisData Custom;
+
+	UPROPERTY(EditAnywhere, Category="Visualizer|Culling")
+	FMBSCullingVisData Culling;
+
+	/**
+	 * Incremented on each change of visualizer settings, so cached visualizer geometry is rebuilt.
+	 */
+	uint32 Revision = 0;
 	
 protected:
 	// Called when the game starts
@@ -196,6 +226,8 @@ public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	const FMBSBoundsVisData& GetInteriorBounds() const { return InteriorBounds; }
+	const FMBSCullingVisData& GetCulling() const { return Culling; }
+	uint32 GetRevision() const { return Revision; }
 	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
 
 	static FColor GetOrMakeInteriorRoomColor(int32 AtIndex);
@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "ComponentVisualizer.h"
+#include "MBSVisualizerLineCache.h"
 #include "UObject/NoExportTypes.h"
+#include "UObject/ObjectKey.h"
 
 class AModularBuildSystemActor;
+class UMBSActorVisualizationComponent;
 struct FModularLevel;
 struct FMBSBoundsVisData;
 struct FMBSVisDataBase;
@@ -15,10 +18,13 @@ struct FMBSDimensionsVisData;
 namespace MBS
 {
 /**
- * 
+ * Draws build system bounds, interior, grid and other helpers of the UMBSActorVisualizationComponent.
+ * Line geometry is cached per component and is rebuilt only after the build system or the component reports a change.
  */
 class MODULARBUILDSYSTEMEDITOR_API FActorVisualizer : public FComponentVisualizer
 {
+	TMap<TObjectKey<UActorComponent>, FVisualizerLineCache> LineCaches;
+
 public:
 	virtual void DrawVisualization(const UActorComponent* Component, const FSceneView* View,
 		FPrimitiveDrawInterface* PDI) override;
@@ -27,24 +33,26 @@ public:
 		const FSceneView* View, FCanvas* Canvas) override;
 
 protected:
-	static void DrawSingleModularSection(const FBox Box, const FMBSBoundsVisData& Bounds,
-		FPrimitiveDrawInterface* PDI);
+	/**
+	 * Fills the line cache of the visualization component. Is only called when the cache is outdated.
+	 */
+	virtual void CacheLines(const UMBSActorVisualizationComponent* VisualizationComponent,
+		const AModularBuildSystemActor* MBS, FVisualizerLineCache& OutCache) const;
+
+	static void CacheSingleModularSection(const FBox Box, const FMBSBoundsVisData& Bounds,
+		FVisualizerLineChunk& OutChunk);
 
-	static void DrawSingleModularLevel(const AModularBuildSystemActor* BS, const FModularLevel& InLevel,
-		const FMBSBoundsVisData& Bounds, FPrimitiveDrawInterface* PDI);
+	static void CacheSingleModularLevel(const AModularBuildSystemActor* BS, const FModularLevel& InLevel,
+		const FMBSBoundsVisData& Bounds, FVisualizerLineCache& OutCache);
 	
 private:
-	static void DrawDiamond(FVector Front, FVector Right, FVector Back, FVector Left,
-		FMBSVisDataBase VisData, FPrimitiveDrawInterface* PDI);
-
-	static void DrawRectangle(FVector Front, FVector Right, FVector Back, FVector Left,
-		FMBSVisDataBase VisData, FPrimitiveDrawInterface* PDI);
+	FVisualizerLineCache& FindOrAddLineCache(const UActorComponent* Component);
 
-	static void DrawLine(FVector Start, FVector End, FMBSVisDataBase VisData,
-		FPrimitiveDrawInterface* PDI);
+	static void CacheDiamond(FVector Front, FVector Right, FVector Back, FVector Left,
+		FVisualizerLineChunk& OutChunk);
 
-	static void DrawLine(FVector Start, FVector End, FMBSDimensionsVisData VisData,
-		const FLinearColor& Color, FPrimitiveDrawInterface* PDI);
+	static void CacheRectangle(FVector Front, FVector Right, FVector Back, FVector Left,
+		FVisualizerLineChunk& OutChunk);
 
 	static void DrawText(const FVector Location, const FString DisplayString, const FLinearColor FontColor,
 		const FViewport* Viewport, const FSceneView* View, FCanvas* Canvas, const UFont* Font = GEngine->GetSmallFont());
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FPrimitiveDrawInterface;
+class FSceneView;
+struct FMBSVisDataBase;
+struct FMBSCullingVisData;
+
+namespace MBS
+{
+/**
+ * Single world space line of the visualizer line cache.
+ */
+struct FVisualizerLine
+{
+	FVector Start;
+	FVector End;
+	FLinearColor Color;
+	float Thickness;
+};
+
+/**
+ * Group of lines that are culled together (usually all lines of a single modular level or of a single room).
+ */
+struct FVisualizerLineChunk
+{
+	TArray<FVisualizerLine> Lines;
+	FBox Bounds = FBox(ForceInit);
+
+	FLinearColor Color = FLinearColor::White;
+	float Thickness = 0.f;
+	uint8 DepthPriority = 0;
+	float DepthBias = 0.f;
+
+	/**
+	 * If true - chunk is drawn as a single wire box of its bounds when it is further than the summary distance.
+	 */
+	bool bCollapsible = false;
+
+	void AddLine(const FVector& Start, const FVector& End, const FLinearColor& InColor, float InThickness);
+	void AddLine(const FVector& Start, const FVector& End) { AddLine(Start, End, Color, Thickness); }
+
+	/**
+	 * Splits the line into dashes the same way DrawDashedLine does, so it can be drawn with the rest of the batch.
+	 */
+	void AddDashedLine(const FVector& Start, const FVector& End, const FLinearColor& InColor, float DashSize);
+	void AddWireBox(const FBox& Box, const FLinearColor& InColor, float InThickness);
+	void AddWireBox(const FBox& Box) { AddWireBox(Box, Color, Thickness); }
+};
+
+/**
+ * Cached line geometry of a single visualization component. Lines are built once after the build system reports
+ * a change and are then frustum and distance culled per chunk and submitted as a single batch on each draw.
+ */
+class MODULARBUILDSYSTEMEDITOR_API FVisualizerLineCache
+{
+	TArray<FVisualizerLineChunk> Chunks;
+	uint32 Revision = 0;
+	FTransform Transform;
+	bool bValid = false;
+
+public:
+	/**
+	 * @param InRevision Combined revision of the build system and of the visualization component.
+	 * @param InTransform Current transform of the build system actor.
+	 * @return True if the cache was built for another revision or transform and must be rebuilt.
+	 */
+	bool IsOutdated(uint32 InRevision, const FTransform& InTransform) const;
+
+	/**
+	 * Removes all chunks and marks the cache as built for the revision and transform.
+	 */
+	void Reset(uint32 InRevision, const FTransform& InTransform);
+
+	/**
+	 * Adds new empty chunk that uses the color, thickness and depth settings of VisData for its own lines.
+	 */
+	FVisualizerLineChunk& AddChunk(const FMBSVisDataBase& VisData, bool bCollapsible);
+	FVisualizerLineChunk& AddChunk(const FLinearColor& InColor, float InThickness, uint8 InDepthPriority,
+		float InDepthBias, bool bCollapsible);
+
+	/**
+	 * Draws all visible chunks, reserving lines once per depth priority group.
+	 */
+	void Draw(const FSceneView* View, FPrimitiveDrawInterface* PDI, const FMBSCullingVisData& Culling) const;
+
+	int32 GetChunkCount() const { return Chunks.Num(); }
+	int32 GetLineCount() const;
+
+	/**
+	 * @return True if the location is close enough to the view to draw text or geometry at it.
+	 */
+	static bool IsWithinDrawDistance(const FSceneView* View, const FVector& Location, const FMBSCullingVisData& Culling);
+};
+}